@@ -36,6 +36,10 @@
 #include <OpenSim/Analyses/BodyKinematics.h>
 #include <OpenSim/Analyses/MuscleAnalysis.h>
 #include <OpenSim/Analyses/IMUDataReporter.h>
+#include <OpenSim/Analyses/Kinematics.h>
+#include <OpenSim/Analyses/StatesReporter.h>
+#include <OpenSim/Simulation/RealizationTimer.h>
+#include <OpenSim/Common/Reporter.h>
 #include <OpenSim/Actuators/ModelFactory.h>
 #include <OpenSim/Simulation/Control/PrescribedController.h>
 #include <OpenSim/Actuators/CoordinateActuator.h>
@@ -58,6 +62,8 @@ void testIMUDataReporter();
 
 void testMuscleAnalysisSerialization();
 
+void testRealizationStages();
+
 int main()
 {
     SimTK::Array_<std::string> failures;
@@ -110,6 +116,12 @@ int main()
         cout << e.what() << endl;
         failures.push_back("testMuscleAnalysisSerialization");
     }   
+    try {
+        testRealizationStages();
+    } catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testRealizationStages");
+    }
 
     if (!failures.empty()) {
         cout << "Done, with failure(s): " << failures << endl;
@@ -609,4 +621,69 @@ void testMuscleAnalysisSerialization()
     // Check deserialization and copying
     roundTrip = MuscleAnalysis("manalysis.xml");
     ASSERT(!roundTrip.getComputeMoments());
-}
\ No newline at end of file
+}
+
+void testRealizationStages()
+{
+    Model pendulum = ModelFactory::createNLinkPendulum(1);
+    const auto& coord = pendulum.getCoordinateSet()[0];
+
+    // The analyses that are on determine the stage.
+    StatesReporter* statesReporter = new StatesReporter(&pendulum);
+    pendulum.addAnalysis(statesReporter);
+    ASSERT(pendulum.getAnalysisSet().getRequiredStage() ==
+            SimTK::Stage::Time);
+    Kinematics* kinematics = new Kinematics(&pendulum);
+    pendulum.addAnalysis(kinematics);
+    ASSERT(pendulum.getAnalysisSet().getRequiredStage() ==
+            SimTK::Stage::Acceleration);
+    kinematics->setRecordAccelerations(false);
+    ASSERT(pendulum.getAnalysisSet().getRequiredStage() ==
+            SimTK::Stage::Velocity);
+    kinematics->setOn(false);
+    ASSERT(pendulum.getAnalysisSet().getRequiredStage() ==
+            SimTK::Stage::Time);
+
+    // An OutputReporter requires the stages its Outputs depend on.
+    OutputReporter* outputReporter = new OutputReporter(&pendulum);
+    outputReporter->append_output_paths(
+            coord.getAbsolutePathString() + "|value");
+    pendulum.addAnalysis(outputReporter);
+    ASSERT(pendulum.getAnalysisSet().getRequiredStage() ==
+            SimTK::Stage::Time);
+    outputReporter->append_output_paths(
+            coord.getAbsolutePathString() + "|acceleration");
+    ASSERT(pendulum.getAnalysisSet().getRequiredStage() ==
+            SimTK::Stage::Acceleration);
+    outputReporter->setOn(false);
+    ASSERT(pendulum.getAnalysisSet().getRequiredStage() ==
+            SimTK::Stage::Time);
+
+    auto* reporter = new TableReporter();
+    reporter->setName("reporter");
+    reporter->addToReport(coord.getOutput("value"));
+    reporter->addToReport(coord.getOutput("speed"));
+    pendulum.addComponent(reporter);
+    SimTK::State& s = pendulum.initSystem();
+
+    // Each stage is realized (and timed) only once.
+    s.setTime(0.5);
+    RealizationTimer timer;
+    timer.realize(pendulum.getSystem(), s, SimTK::Stage::Velocity);
+    ASSERT(s.getSystemStage() == SimTK::Stage::Velocity);
+    timer.realize(pendulum.getSystem(), s, SimTK::Stage::Dynamics);
+    timer.realize(pendulum.getSystem(), s, SimTK::Stage::Dynamics);
+    ASSERT(timer.getNumRealizations(SimTK::Stage::Time) == 1);
+    ASSERT(timer.getNumRealizations(SimTK::Stage::Position) == 1);
+    ASSERT(timer.getNumRealizations(SimTK::Stage::Velocity) == 1);
+    ASSERT(timer.getNumRealizations(SimTK::Stage::Dynamics) == 1);
+    ASSERT(timer.getNumRealizations(SimTK::Stage::Acceleration) == 0);
+    ASSERT(timer.getTotalTime() >= timer.getTime(SimTK::Stage::Position));
+    ASSERT(timer.getSummary().find("Dynamics") != std::string::npos);
+    ASSERT(timer.getSummary().find("Acceleration") == std::string::npos);
+    reporter->report(s);
+    ASSERT(reporter->getTable().getNumRows() == 1);
+    timer.reset();
+    ASSERT(timer.getNumRealizations(SimTK::Stage::Dynamics) == 0);
+    ASSERT(timer.getTotalTime() == 0);
+}
@@ -23,6 +23,10 @@
 
 
 // INCLUDES
+#include <cstdio>
+#include <fstream>
+#include <regex>
+#include <sstream>
 #include <string>
 #include <OpenSim/version.h>
 #include <OpenSim/Common/Storage.h>
@@ -53,6 +57,7 @@ using std::cout; using std::endl;
 void scaleGait2354();
 void scaleGait2354_GUI(bool useMarkerPlacement);
 void scaleModelWithLigament();
+void scaleMultipleSubjects();
 bool compareStdScaleToComputed(const ScaleSet& std, const ScaleSet& comp);
 
 // Test scaling PhysicalOffsetFrames and models with atypical ownership trees.
@@ -67,6 +72,7 @@ int main()
         scaleGait2354();
         scaleGait2354_GUI(false);
         scaleModelWithLigament();
+        scaleMultipleSubjects();
         scalePhysicalOffsetFrames();
         scaleJointsAndConstraints();
     }
@@ -257,6 +263,46 @@ void scaleGait2354_GUI(bool useMarkerPlacement)
                            "std_subject01_simbody.osim", 1.0e-6);
 }
 
+// Scale copies of subject01 concurrently with ScaleTool::runSubjects(); each
+// copy writes its results to its own files.
+void scaleMultipleSubjects()
+{
+    std::stringstream setup;
+    setup << std::ifstream("subject01_Setup_Scale.xml").rdbuf();
+    std::vector<std::string> setupFileNames;
+    std::vector<std::string> subjects{"subject01a", "subject01b", "subject01c"};
+    for (const auto& subject : subjects) {
+        std::string text = std::regex_replace(setup.str(),
+                std::regex("(<output_\\w+>\\s*)subject01_"),
+                "$1" + subject + "_");
+        text = std::regex_replace(text,
+                std::regex("<ScaleTool name=\"subject01\">"),
+                "<ScaleTool name=\"" + subject + "\">");
+        setupFileNames.push_back(subject + "_Setup_Scale.xml");
+        std::ofstream(setupFileNames.back()) << text;
+        // Remove old results if any
+        std::remove((subject + "_scaleSet_applied.xml").c_str());
+        std::remove((subject + "_simbody.osim").c_str());
+    }
+
+    ASSERT(ScaleTool::runSubjects(setupFileNames, 2));
+
+    ScaleSet stdScaleSet("std_subject01_scaleSet_applied.xml");
+    for (const auto& subject : subjects) {
+        ScaleSet computedScaleSet(subject + "_scaleSet_applied.xml");
+        ASSERT(compareStdScaleToComputed(stdScaleSet, computedScaleSet));
+        compareModelToStandard(subject + "_simbody.osim",
+                               "std_subject01_simbody.osim", 1.0e-6);
+    }
+
+    // A missing generic model fails only that subject.
+    std::string text = std::regex_replace(setup.str(),
+            std::regex("gait2354_simbody\\.osim"), "missing_model.osim");
+    std::ofstream("subject01_missingModel_Setup_Scale.xml") << text;
+    setupFileNames.push_back("subject01_missingModel_Setup_Scale.xml");
+    ASSERT(!ScaleTool::runSubjects(setupFileNames, 0));
+}
+
 void scaleModelWithLigament()
 {
     // SET OUTPUT FORMATTING
@@ -64,6 +64,27 @@ int main()
     ik_hjc_nf.set_results_directory("ik_hjc_nf_" + facingX.getName());
     ik_hjc_nf.run(false);
 
+    // Tracking in chunks on multiple threads should reproduce tracking all
+    // frames in sequence; only the first frame of each chunk is found by
+    // assembly rather than by tracking from the previous frame.
+    IMUInverseKinematicsTool ik_chunks(
+            "setup_IMUInverseKinematics_HJC_trial.xml");
+    ik_chunks.setModel(facingX);
+    ik_chunks.set_results_directory("ik_chunks_" + facingX.getName());
+    ik_chunks.set_num_threads(2);
+    ik_chunks.set_chunk_size(25);
+    ik_chunks.run(false);
+
+    Storage ik_sequential("ik_hjc_" + facingX.getName() +
+        "/ik_MT_012005D6_009-quaternions_RHJCSwinger.mot");
+    Storage ik_chunked("ik_chunks_" + facingX.getName() +
+        "/ik_MT_012005D6_009-quaternions_RHJCSwinger.mot");
+    ASSERT(ik_chunked.getSize() == ik_sequential.getSize());
+    CHECK_STORAGE_AGAINST_STANDARD(ik_chunked, ik_sequential,
+        std::vector<double>(ik_sequential.getColumnLabels().size(), 1.0),
+        __FILE__, __LINE__,
+        "testOpenSense::IK solutions differed when tracked in chunks.");
+
     // Now facing the opposite direction (negative X)
     IMUPlacer placerNegX("imuPlacerFaceNegX.xml");
     placerNegX.run(false);
@@ -24,6 +24,7 @@
  * -------------------------------------------------------------------------- */
 
 #include <iostream>
+#include <sstream>
 
 #include <docopt.h>
 #include "parse_arguments.h"
@@ -32,12 +33,13 @@ static const char HELP_RUN_TOOL[] =
 R"(Run a tool (e.g., Inverse Kinematics) from an XML setup file.
 
 Usage:
-  opensim-cmd [options]... run-tool <setup-xml-file>
+  opensim-cmd [options]... run-tool [--profile=<file>] <setup-xml-file>
   opensim-cmd run-tool -h | --help
 
 Options:
   -L <path>, --library <path>  Load a plugin.
   -o <level>, --log <level>  Logging level.
+  -p <file>, --profile <file>  Profile the components of the model.
 
 Description:
   The Tool to run is detected from the setup file you provide. Supported tools
@@ -56,13 +58,48 @@ Description:
 
   Use `opensim-cmd print-xml` to generate a template <setup-xml-file>.
 
+  With --profile, the time spent in each component of the model (see
+  OpenSim::Profiler) is logged after the tool finishes and written to <file>:
+  as a trace for Chrome's about:tracing page or Perfetto if <file> ends with
+  .json, and otherwise as folded stacks for flame graph tools.
+
 Examples:
   opensim-cmd run-tool CMC_setup.xml
   opensim-cmd -L C:\Plugins\osimMyCustomForce.dll run-tool CMC_setup.xml
   opensim-cmd --library ../plugins/libosimMyPlugin.so run-tool Forward_setup.xml
   opensim-cmd --library=libosimMyCustomForce.dylib run-tool CMC_setup.xml
+  opensim-cmd run-tool --profile=forward_trace.json Forward_setup.xml
 )";
 
+// Run the tool, profiling it if a profile file was requested.
+template <typename RunFunction>
+bool run_and_profile(std::map<std::string, docopt::value>& args,
+        RunFunction run) {
+    using namespace OpenSim;
+    if (!args["--profile"]) return run();
+    const auto& profileFile = args["--profile"].asString();
+    Profiler::reset();
+    Profiler::setEnabled(true);
+    bool success;
+    try {
+        success = run();
+    } catch (...) {
+        Profiler::setEnabled(false);
+        throw;
+    }
+    Profiler::setEnabled(false);
+    std::stringstream summary;
+    Profiler::printSummary(summary);
+    log_info("Profile:\n{}", summary.str());
+    if (IO::GetSuffix(profileFile, 5) == ".json") {
+        Profiler::printChromeTrace(profileFile);
+    } else {
+        Profiler::printFlameGraph(profileFile);
+    }
+    log_info("Wrote profile to '{}'.", profileFile);
+    return success;
+}
+
 int run_tool(int argc, const char** argv) {
 
     using namespace OpenSim;
@@ -101,25 +138,29 @@ int run_tool(int argc, const char** argv) {
                      "constructed properly.");
             concreteTool.reset(tool->clone());
         }
-        const bool success = concreteTool->run();
+        const bool success = run_and_profile(args,
+                [&] { return concreteTool->run(); });
         if (success) return EXIT_SUCCESS;
         else return EXIT_FAILURE;
     } else if (auto* tool = dynamic_cast<Tool*>(obj.get())) {
         // Tool.
         log_info("Preparing to run {}.", tool->getConcreteClassName());
-        const bool success = tool->run();
+        const bool success = run_and_profile(args,
+                [&] { return tool->run(); });
         if (success) return EXIT_SUCCESS;
         else return EXIT_FAILURE;
     } else if (auto* scale = dynamic_cast<ScaleTool*>(obj.get())) {
         // ScaleTool.
         log_info("Preparing to run {}.", scale->getConcreteClassName());
-        const bool success = scale->run();
+        const bool success = run_and_profile(args,
+                [&] { return scale->run(); });
         if (success) return EXIT_SUCCESS;
         else return EXIT_FAILURE;
     } else if (auto* study = dynamic_cast<MocoStudy*>(obj.get())) {
         log_info("Preparing to run {}.", study->getConcreteClassName());
-        const auto solution = study->solve();
-        if (solution.success()) return EXIT_SUCCESS;
+        const bool success = run_and_profile(args,
+                [&] { return study->solve().success(); });
+        if (success) return EXIT_SUCCESS;
         else return EXIT_FAILURE;
 
     } else {
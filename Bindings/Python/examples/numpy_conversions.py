@@ -56,3 +56,20 @@ print(osimMatrix)
 npArray4 = osimMatrix.to_numpy()
 print(npArray4)
 
+
+# The conversions above copy the data. For large data, you can instead obtain
+# a NumPy view that shares memory with the OpenSim object (no copy). The
+# view keeps the OpenSim object alive, and changes to the view are reflected
+# in the OpenSim object.
+matrixView = osimMatrix.as_numpy_view()
+matrixView[0, 0] = 10
+print(osimMatrix.get(0, 0))
+
+# Tables can be created from NumPy arrays in bulk, and their data can be
+# viewed without copying.
+table = osim.TimeSeriesTable.createFromMat(np.array([0.0, 0.1, 0.2]),
+                                           npArray2D, ['a', 'b'])
+print(table)
+tableData = table.getMatrixView()
+tableTime = table.getIndependentColumnView()
+print(tableTime, tableData)
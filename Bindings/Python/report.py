@@ -27,14 +27,8 @@ from collections import defaultdict, OrderedDict
 ## Helper functions.
 # ==================
 # Convert a SimTK::Vector to a NumPy array for plotting.
-# TODO: put something similar in the bindings.
 def convert(simtkVector):
-    n = simtkVector.size()
-    vec = np.empty(n)
-    for elt in range(n):
-        vec[elt] = simtkVector[elt]
-
-    return vec
+    return simtkVector.to_numpy()
 
 # Get a plot label given a OpenSim::Coordinate::MotionType enum and a kinematic
 # level ('value' or 'speed')
@@ -230,7 +224,7 @@ class Report(object):
         elif type == 'multiplier':
             var = convert(self.trajectory.getMultiplier(path))
         elif type == 'derivative':
-            derivativesTraj = self.trajectory.getDerivativesTrajectory()
+            derivativesTraj = self.trajectory.getDerivativesTrajectoryView()
             derivativeNames = self.trajectory.getDerivativeNames()
             count = 0
             col = 0
@@ -239,10 +233,7 @@ class Report(object):
                     col = count
                 count += 1
 
-            n = derivativesTraj.nrow()
-            var = np.empty(n)
-            for row in range(n):
-                var[row] = derivativesTraj.get(row, col)
+            var = np.array(derivativesTraj[:, col])
         elif type == 'slack':
             var = convert(self.trajectory.getSlack(path))
         elif type == 'parameter':
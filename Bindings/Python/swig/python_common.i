@@ -19,6 +19,12 @@ using namespace OpenSim;
 using namespace SimTK;
 %}
 
+// Add support for converting between NumPy and C arrays (for DataTable).
+%include "numpy.i"
+%init %{
+    import_array();
+%}
+
 %include "python_preliminaries.i"
 
 // Tell SWIG about the simbody module.
@@ -289,6 +295,61 @@ note: ## is a "glue" operator: `a ## b` --> `ab`.
     }
 }
 
+// NumPy interoperability for tables of doubles. The views share memory with
+// the table (no copy) and are invalidated by any operation that changes the
+// size of the table (e.g., appendRow(), appendColumn(), removeRow()).
+%apply (double** ARGOUTVIEW_ARRAY1, int* DIM1) {
+    (double** viewout, int* n)
+};
+%apply (double** ARGOUTVIEW_FARRAY2, int* DIM1, int* DIM2) {
+    (double** viewout, int* nrow, int* ncol)
+};
+%apply (int DIM1, double* IN_ARRAY1) {
+    (int ntime, double* timedata)
+};
+%apply (int DIM1, int DIM2, double* IN_ARRAY2) {
+    (int nrow, int ncol, double* depdata)
+};
+%extend OpenSim::DataTable_<double, double> {
+    void _getMatrixView(double** viewout, int* nrow, int* ncol) {
+        auto& mat = $self->updMatrix();
+        OPENSIM_THROW_IF(!mat.hasContiguousData(), OpenSim::Exception,
+                "Table data is not contiguous.");
+        *viewout = mat.updContiguousScalarData();
+        *nrow = mat.nrow();
+        *ncol = mat.ncol();
+    }
+    void _getIndependentColumnView(double** viewout, int* n) const {
+        const auto& ind = $self->getIndependentColumn();
+        *viewout = const_cast<double*>(ind.data());
+        *n = (int)ind.size();
+    }
+%pythoncode %{
+    def getMatrixView(self):
+        """Get the dependent data of this table as a 2D NumPy array
+        (rows x columns) that shares memory with the table (no copy).
+        Changes to the array are reflected in the table."""
+        from .simbody import _numpy_view
+        return _numpy_view(self._getMatrixView(), self)
+    def getIndependentColumnView(self):
+        """Get the independent column (e.g., time) of this table as a
+        read-only NumPy array that shares memory with the table."""
+        from .simbody import _numpy_view
+        return _numpy_view(self._getIndependentColumnView(), self,
+                           writeable=False)
+%};
+}
+%extend OpenSim::TimeSeriesTable_<double> {
+    static TimeSeriesTable_<double> createFromMat(
+            int ntime, double* timedata,
+            int nrow, int ncol, double* depdata,
+            std::vector<std::string> labels) {
+        return TimeSeriesTable_<double>(
+                std::vector<double>(timedata, timedata + ntime),
+                SimTK::Matrix(nrow, ncol, depdata), labels);
+    }
+}
+
 // Include all the OpenSim code.
 // =============================
 %include <Bindings/preliminaries.i>
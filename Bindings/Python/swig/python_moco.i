@@ -314,6 +314,15 @@ using namespace SimTK;
     (int nrow, int ncol, double* multsOut),
     (int nrow, int ncol, double* derivsOut)
 };
+// For getTimeView(), getStatesTrajectoryView(), etc.
+// These return read-only NumPy arrays that share memory with the
+// MocoTrajectory instead of copying (see _numpy_view() in simbody).
+%apply (double** ARGOUTVIEW_ARRAY1, int* DIM1) {
+    (double** viewout, int* n)
+};
+%apply (double** ARGOUTVIEW_FARRAY2, int* DIM1, int* DIM2) {
+    (double** viewout, int* nrow, int* ncol)
+};
 %extend OpenSim::MocoTrajectory {
     MocoTrajectory(
             int ntime,
@@ -448,7 +457,60 @@ using namespace SimTK;
                 "ncol != number of derivs");
         std::copy_n(derivs.getContiguousScalarData(), nrow * ncol, derivsOut);
     }
+    void _getTimeView(double** viewout, int* n) const {
+        const auto& time = $self->getTime();
+        *viewout = const_cast<double*>(time.getContiguousScalarData());
+        *n = time.size();
+    }
+    void _getStatesTrajectoryView(
+            double** viewout, int* nrow, int* ncol) const {
+        const auto& states = $self->getStatesTrajectory();
+        *viewout = const_cast<double*>(states.getContiguousScalarData());
+        *nrow = states.nrow();
+        *ncol = states.ncol();
+    }
+    void _getControlsTrajectoryView(
+            double** viewout, int* nrow, int* ncol) const {
+        const auto& controls = $self->getControlsTrajectory();
+        *viewout = const_cast<double*>(controls.getContiguousScalarData());
+        *nrow = controls.nrow();
+        *ncol = controls.ncol();
+    }
+    void _getMultipliersTrajectoryView(
+            double** viewout, int* nrow, int* ncol) const {
+        const auto& mults = $self->getMultipliersTrajectory();
+        *viewout = const_cast<double*>(mults.getContiguousScalarData());
+        *nrow = mults.nrow();
+        *ncol = mults.ncol();
+    }
+    void _getDerivativesTrajectoryView(
+            double** viewout, int* nrow, int* ncol) const {
+        const auto& derivs = $self->getDerivativesTrajectory();
+        *viewout = const_cast<double*>(derivs.getContiguousScalarData());
+        *nrow = derivs.nrow();
+        *ncol = derivs.ncol();
+    }
 %pythoncode %{
+    def getTimeView(self):
+        from .simbody import _numpy_view
+        return _numpy_view(self._getTimeView(), self, writeable=False)
+    def getStatesTrajectoryView(self):
+        from .simbody import _numpy_view
+        return _numpy_view(self._getStatesTrajectoryView(), self,
+                           writeable=False)
+    def getControlsTrajectoryView(self):
+        from .simbody import _numpy_view
+        return _numpy_view(self._getControlsTrajectoryView(), self,
+                           writeable=False)
+    def getMultipliersTrajectoryView(self):
+        from .simbody import _numpy_view
+        return _numpy_view(self._getMultipliersTrajectoryView(), self,
+                           writeable=False)
+    def getDerivativesTrajectoryView(self):
+        from .simbody import _numpy_view
+        return _numpy_view(self._getDerivativesTrajectoryView(), self,
+                           writeable=False)
+
     def getTimeMat(self):
         return self._getTimeMat(self.getNumTimes())
     def getStateMat(self, name):
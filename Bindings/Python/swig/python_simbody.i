@@ -74,6 +74,41 @@ using namespace SimTK;
     (int nrow, int ncol, double* numpyout)
 };
 
+// Zero-copy views: functions taking (double** viewout, int* n) or
+// (double** viewout, int* nrow, int* ncol) return a NumPy array that points
+// directly into the memory of the C++ object instead of a copy. These hidden
+// C++ functions (e.g., _as_numpy_view()) are wrapped by Python functions
+// (e.g., as_numpy_view()) that keep the C++ object alive for as long as the
+// NumPy array exists; see _numpy_view() below. SimTK matrices are stored in
+// column order, so 2D views are Fortran-ordered NumPy arrays.
+%apply (double** ARGOUTVIEW_ARRAY1, int* DIM1) {
+    (double** viewout, int* n)
+};
+%apply (double** ARGOUTVIEW_FARRAY2, int* DIM1, int* DIM2) {
+    (double** viewout, int* nrow, int* ncol)
+};
+
+%pythoncode %{
+_NumPyView = None
+def _numpy_view(array, owner, writeable=True):
+    """Return the NumPy array `array`, which points into memory owned by
+    `owner`, as a view that holds a reference to `owner`. This prevents
+    `owner` from being garbage-collected while the view (or any slice of it)
+    is alive. The view becomes invalid if `owner` is resized."""
+    global _NumPyView
+    if _NumPyView is None:
+        import numpy as np
+        class NumPyView(np.ndarray):
+            def __array_finalize__(self, obj):
+                self._owner = getattr(obj, '_owner', None)
+        _NumPyView = NumPyView
+    view = array.view(_NumPyView)
+    view._owner = owner
+    if not writeable:
+        view.flags.writeable = False
+    return view
+%}
+
 // An alternative is to use typemaps to allow OpenSim functions to accept and
 // return Python/NumPy types. For example, such typemaps allow passing a Python
 // list of 3 floats into an OpenSim function that takes a Vec3.
@@ -200,9 +235,20 @@ namespace SimTK {
                              $self->size());
         std::copy_n($self->getContiguousScalarData(), n, numpyout);
     }
+    void _as_numpy_view(double** viewout, int* n) {
+        SimTK_ERRCHK_ALWAYS($self->hasContiguousData(), "as_numpy_view()",
+                "Vector data is not contiguous; use to_numpy() instead.");
+        *viewout = $self->updContiguousScalarData();
+        *n = $self->size();
+    }
 %pythoncode %{
     def to_numpy(self):
         return self._to_numpy(self.size())
+    def as_numpy_view(self):
+        """Get a NumPy array that shares memory with this vector (no
+        copy). Changes to the array are reflected in this vector. The
+        array is invalidated if this vector is resized."""
+        return _numpy_view(self._as_numpy_view(), self)
 %};
 }
 
@@ -229,9 +275,20 @@ namespace SimTK {
                              $self->size());
         std::copy_n($self->getContiguousScalarData(), n, numpyout);
     }
+    void _as_numpy_view(double** viewout, int* n) {
+        SimTK_ERRCHK_ALWAYS($self->hasContiguousData(), "as_numpy_view()",
+                "RowVector data is not contiguous; use to_numpy() instead.");
+        *viewout = $self->updContiguousScalarData();
+        *n = $self->size();
+    }
 %pythoncode %{
     def to_numpy(self):
         return self._to_numpy(self.size())
+    def as_numpy_view(self):
+        """Get a NumPy array that shares memory with this row vector (no
+        copy). Changes to the array are reflected in this row vector. The
+        array is invalidated if this row vector is resized."""
+        return _numpy_view(self._as_numpy_view(), self)
 %};
 }
 
@@ -249,12 +306,24 @@ namespace SimTK {
                 "Number of columns must be %i.", $self->ncol());
         std::copy_n($self->getContiguousScalarData(), nrow * ncol, numpyout);
     }
+    void _as_numpy_view(double** viewout, int* nrow, int* ncol) {
+        SimTK_ERRCHK_ALWAYS($self->hasContiguousData(), "as_numpy_view()",
+                "Matrix data is not contiguous; use to_numpy() instead.");
+        *viewout = $self->updContiguousScalarData();
+        *nrow = $self->nrow();
+        *ncol = $self->ncol();
+    }
 %pythoncode %{
     def to_numpy(self):
         import numpy as np
         mat = np.empty([self.nrow(), self.ncol()])
         self._to_numpy(mat)
         return mat
+    def as_numpy_view(self):
+        """Get a 2D NumPy array that shares memory with this matrix (no
+        copy). Changes to the array are reflected in this matrix. The array
+        is invalidated if this matrix is resized."""
+        return _numpy_view(self._as_numpy_view(), self)
 %};
 }
 
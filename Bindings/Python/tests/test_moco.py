@@ -216,6 +216,15 @@ class TestSwigAddtlInterface(unittest.TestCase):
         assert (it.getDerivativesTrajectoryMat() == dt).all()
         assert (it.getParametersMat() == p).all()
 
+        # Views share memory with the trajectory (no copy).
+        assert (it.getTimeView() == time).all()
+        assert (it.getStatesTrajectoryView() == st).all()
+        assert (it.getControlsTrajectoryView() == ct).all()
+        assert (it.getMultipliersTrajectoryView() == mt).all()
+        assert (it.getDerivativesTrajectoryView() == dt).all()
+        it.setState('s1', [0.1, 0.2, 0.3])
+        assert it.getStatesTrajectoryView()[2, 1] == 0.3
+
     def test_createRep(self):
         model = osim.Model()
         model.setName('sliding_mass')
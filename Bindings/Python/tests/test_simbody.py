@@ -133,6 +133,58 @@ class TestSimbody(unittest.TestCase):
         with self.assertRaises(TypeError):
             osim.Matrix.createFromMat(npm)
 
+    def test_numpy_views(self):
+        # Vector.
+        v = osim.Vector(4, 1.5)
+        view = v.as_numpy_view()
+        assert view.shape == (4,)
+        assert (view == 1.5).all()
+        view[2] = 7.0
+        assert v[2] == 7.0
+        v[0] = -3.0
+        assert view[0] == -3.0
+        # The view keeps the vector alive.
+        del v
+        assert view[2] == 7.0
+
+        # RowVector.
+        rv = osim.RowVector.createFromMat(np.array([1.0, 2.0, 3.0]))
+        view = rv.as_numpy_view()
+        view[1] = 5.0
+        assert rv.to_numpy()[1] == 5.0
+
+        # Matrix.
+        npm = np.array([[5, 3], [3, 6], [8, 1]], dtype=float)
+        m = osim.Matrix.createFromMat(npm)
+        view = m.as_numpy_view()
+        assert view.shape == (3, 2)
+        assert (view == npm).all()
+        view[2, 1] = 4.0
+        assert m.get(2, 1) == 4.0
+
+    def test_table_numpy(self):
+        time = np.array([0.0, 0.5, 1.0])
+        data = np.array([[1, 2], [3, 4], [5, 6]], dtype=float)
+        table = osim.TimeSeriesTable.createFromMat(time, data, ['a', 'b'])
+        assert table.getNumRows() == 3
+        assert table.getNumColumns() == 2
+        assert table.getColumnLabel(1) == 'b'
+        assert table.getRowAtIndex(1).to_numpy()[1] == 4
+
+        view = table.getMatrixView()
+        assert (view == data).all()
+        view[0, 1] = 20.0
+        assert table.getDependentColumn('b').to_numpy()[0] == 20.0
+
+        timeView = table.getIndependentColumnView()
+        assert (timeView == time).all()
+        with self.assertRaises(ValueError):
+            timeView[0] = 1.0
+
+        # Mismatched number of rows.
+        with self.assertRaises(RuntimeError):
+            osim.TimeSeriesTable.createFromMat(time[:2], data, ['a', 'b'])
+
     def test_vector_operators(self):
         v = osim.Vector(5, 3)
 
@@ -11,6 +11,8 @@
 %include <OpenSim/Common/About.h>
 %include <OpenSim/Common/Exception.h>
 
+// Its std::function argument has no typemaps.
+%ignore OpenSim::writeFileAtomically;
 %include <OpenSim/Common/CommonUtilities.h>
 
 %shared_ptr(OpenSim::LogSink);
@@ -0,0 +1,136 @@
+/* -------------------------------------------------------------------------- *
+ * OpenSim: ModelProcessor.cpp                                                *
+ * -------------------------------------------------------------------------- *
+ * Copyright (c) 2019 Stanford University and the Authors                     *
+ *                                                                            *
+ * Author(s): Christopher Dembia                                              *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0          *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "ModelProcessor.h"
+
+#include <OpenSim/Common/CommonUtilities.h>
+#include <OpenSim/Common/IO.h>
+
+using namespace OpenSim;
+
+namespace {
+MemoizationCache<Model> memoizedModels;
+}
+
+void ModelProcessor::setMemoizationEnabled(bool enabled) {
+    memoizedModels.setEnabled(enabled);
+}
+
+bool ModelProcessor::getMemoizationEnabled() {
+    return memoizedModels.getEnabled();
+}
+
+void ModelProcessor::setCacheDirectory(std::string directory) {
+    memoizedModels.setDirectory(std::move(directory));
+}
+
+std::string ModelProcessor::getCacheDirectory() {
+    return memoizedModels.getDirectory();
+}
+
+void ModelProcessor::clearMemoizedModels() { memoizedModels.clear(); }
+
+std::string ModelProcessor::getSourcePath(
+        const std::string& relativeToDirectory) const {
+    if (get_filepath().empty()) {
+        OPENSIM_THROW_IF_FRMOBJ(getProperty_model().empty(), Exception,
+                "No source model.");
+        return {};
+    }
+    OPENSIM_THROW_IF_FRMOBJ(!getProperty_model().empty(), Exception,
+            "Expected either a Model object or a filepath, but "
+            "both were provided.");
+    std::string path = get_filepath();
+    if (!relativeToDirectory.empty()) {
+        using SimTK::Pathname;
+        path = Pathname::getAbsolutePathnameUsingSpecifiedWorkingDirectory(
+                relativeToDirectory, path);
+    }
+    return path;
+}
+
+std::string ModelProcessor::computeHash(
+        const std::string& relativeToDirectory) const {
+    const std::string path = getSourcePath(relativeToDirectory);
+    ContentHash hash;
+    hash.update(getConcreteClassName());
+    if (path.empty()) {
+        hash.update(get_model().dump());
+    } else {
+        hash.update(path);
+        hash.updateWithFile(path);
+    }
+    for (int i = 0; i < getProperty_operators().size(); ++i) {
+        hash.update(get_operators(i).dump());
+    }
+    hash.update(relativeToDirectory);
+    return hash.toString();
+}
+
+Model ModelProcessor::process(const std::string& relativeToDirectory) const {
+    if (!memoizedModels.getEnabled()) {
+        return processWithoutMemoization(relativeToDirectory);
+    }
+    const std::string hash = computeHash(relativeToDirectory);
+    if (auto memoized = memoizedModels.find(hash)) {
+        log_debug("ModelProcessor: using the memoized model {}.", hash);
+        return *memoized;
+    }
+
+    Model model;
+    const std::string directory = memoizedModels.getDirectory();
+    const std::string cachePath =
+            directory.empty() ? "" : directory + "/" + hash + ".osim";
+    if (!cachePath.empty() && IO::FileExists(cachePath)) {
+        log_debug("ModelProcessor: reading the cached model '{}'.", cachePath);
+        Model modelFromFile(cachePath);
+        model = std::move(modelFromFile);
+        model.finalizeFromProperties();
+        model.finalizeConnections();
+    } else {
+        model = processWithoutMemoization(relativeToDirectory);
+        if (!cachePath.empty()) {
+            // Write the connectee paths to properties.
+            model.finalizeFromProperties();
+            model.finalizeConnections();
+            writeFileAtomically(cachePath,
+                    [&](const std::string& path) { model.print(path); });
+        }
+    }
+    memoizedModels.insert(hash, std::make_shared<const Model>(model));
+    return model;
+}
+
+Model ModelProcessor::processWithoutMemoization(
+        const std::string& relativeToDirectory) const {
+    const std::string path = getSourcePath(relativeToDirectory);
+    Model model;
+    if (path.empty()) {
+        model = get_model();
+    } else {
+        Model modelFromFile(path);
+        model = std::move(modelFromFile);
+        model.finalizeFromProperties();
+        model.finalizeConnections();
+    }
+
+    for (int i = 0; i < getProperty_operators().size(); ++i) {
+        get_operators(i).operate(model, relativeToDirectory);
+    }
+    return model;
+}
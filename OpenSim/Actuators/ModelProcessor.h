@@ -105,36 +105,7 @@ public:
     /** Process and obtain the model. If the base model is specified via the
     filepath property, the filepath will be evaluated relative to
     `relativeToDirectory`, if provided. */
-    Model process(const std::string& relativeToDirectory = {}) const {
-        Model model;
-        if (get_filepath().empty()) {
-            if (!getProperty_model().empty()) {
-                model = get_model();
-            } else {
-                OPENSIM_THROW_FRMOBJ(Exception, "No source model.");
-            }
-        } else {
-            OPENSIM_THROW_IF_FRMOBJ(!getProperty_model().empty(), Exception,
-                    "Expected either a Model object or a filepath, but "
-                    "both were provided.");
-            std::string path = get_filepath();
-            if (!relativeToDirectory.empty()) {
-                using SimTK::Pathname;
-                path = Pathname::
-                        getAbsolutePathnameUsingSpecifiedWorkingDirectory(
-                                relativeToDirectory, path);
-            }
-            Model modelFromFile(path);
-            model = std::move(modelFromFile);
-            model.finalizeFromProperties();
-            model.finalizeConnections();
-        }
-
-        for (int i = 0; i < getProperty_operators().size(); ++i) {
-            get_operators(i).operate(model, relativeToDirectory);
-        }
-        return model;
-    }
+    Model process(const std::string& relativeToDirectory = {}) const;
 
     /** Append an operation to the end of the operations in this processor. */
     ModelProcessor& append(const ModelOperator& op) {
@@ -149,8 +120,49 @@ public:
         return append(right);
     }
 
+    /// @name Memoization
+    /// When memoization is enabled, process() returns a copy of a model that
+    /// was processed earlier (by any ModelProcessor) with the same inputs,
+    /// instead of reading and processing the source model again. The inputs
+    /// are identified by computeHash(). Memoization assumes that each
+    /// operator's result depends only on the operator's properties, the model,
+    /// and `relativeToDirectory`; files read by an operator (e.g.,
+    /// ModOpAddExternalLoads) are not hashed. The memoized models have not
+    /// been initialized (initSystem() has not been called on them).
+    /// Only the result of the full sequence of operators is memoized; two
+    /// processors that share leading operators do not share the model produced
+    /// by those operators.
+    /// @{
+    /** Enable or disable memoization for all ModelProcessor%s. Memoization is
+    disabled by default. */
+    static void setMemoizationEnabled(bool enabled);
+    static bool getMemoizationEnabled();
+    /** If not empty, processed models are also written to this (existing)
+    directory, as `<hash>.osim` files, and process() reads the file for a hash
+    that is not in memory (e.g., in a later run) instead of processing the
+    source model. Geometry files of models read from this directory are
+    searched for relative to this directory. Each file is written to a
+    temporary file and then renamed, so that processes sharing the directory
+    never read a partially written file. The files are never removed by
+    OpenSim. This is empty by default. */
+    static void setCacheDirectory(std::string directory);
+    static std::string getCacheDirectory();
+    /** Remove all memoized models from memory. */
+    static void clearMemoizedModels();
+    /** A hash of the source model (the contents of the file, if a filepath is
+    provided), the operators and their properties, and `relativeToDirectory`.
+    Two calls to process() with the same hash produce the same model. */
+    std::string computeHash(const std::string& relativeToDirectory = {}) const;
+    /// @}
+
 private:
     OpenSim_DECLARE_OPTIONAL_PROPERTY(model, Model, "Base model to process.");
+
+    // Throw if the source model is missing, and obtain the absolute path to
+    // the source model (empty if the model was provided as a property).
+    std::string getSourcePath(const std::string& relativeToDirectory) const;
+    Model processWithoutMemoization(
+            const std::string& relativeToDirectory) const;
 };
 
 } // namespace OpenSim
@@ -27,6 +27,10 @@
 
 using namespace OpenSim;
 
+namespace {
+int numOperations = 0;
+}
+
 TEST_CASE("ModelProcessor") {
 
     Object::registerType(ModelProcessor());
@@ -36,6 +40,7 @@ TEST_CASE("ModelProcessor") {
 
     public:
         void operate(Model& model, const std::string&) const override {
+            ++numOperations;
             model.addAnalysis(new MuscleAnalysis());
         }
     };
@@ -78,6 +83,42 @@ TEST_CASE("ModelProcessor") {
             CHECK(modelDeserialized.getAnalysisSet().getSize() == 1);
         }
     }
+
+    SECTION("Memoization") {
+        model.print("testModelProcessor_memoization.osim");
+        ModelProcessor::setMemoizationEnabled(true);
+        numOperations = 0;
+        ModelProcessor proc =
+                ModelProcessor("testModelProcessor_memoization.osim") |
+                MyModelOperator();
+        CHECK(proc.process().getAnalysisSet().getSize() == 1);
+        CHECK(proc.process().getAnalysisSet().getSize() == 1);
+        CHECK(numOperations == 1);
+
+        // A different operator changes the hash.
+        ModelProcessor other =
+                ModelProcessor("testModelProcessor_memoization.osim") |
+                ModOpRemoveMuscles();
+        CHECK(other.computeHash() != proc.computeHash());
+
+        // Processed models are read from the cache directory.
+        ModelProcessor::clearMemoizedModels();
+        ModelProcessor::setCacheDirectory(".");
+        proc.process();
+        CHECK(numOperations == 2);
+        const std::string cachePath = "./" + proc.computeHash() + ".osim";
+        ModelProcessor::clearMemoizedModels();
+        Model modelFromCache = proc.process();
+        CHECK(numOperations == 2);
+        CHECK(modelFromCache.getAnalysisSet().getSize() == 1);
+        CHECK(modelFromCache.getJointSet().getSize() ==
+                model.getJointSet().getSize());
+
+        ModelProcessor::setCacheDirectory("");
+        ModelProcessor::setMemoizationEnabled(false);
+        ModelProcessor::clearMemoizedModels();
+        std::remove(cachePath.c_str());
+    }
 }
 
 Model createElbowModel() {
@@ -115,6 +115,8 @@ class Storage;
             step(const SimTK::State& s, int setNumber) override;
         int
             end(const SimTK::State& s) override;
+        SimTK::Stage getRequiredStage() const override
+        {   return SimTK::Stage::Dynamics; }
     protected:
         virtual int
             record(const SimTK::State& s);
@@ -249,6 +249,10 @@ constructColumnLabels()
 void BodyKinematics::
 allocateStorage()
 {
+    // The storages are deleted by deleteStorage().
+    _storageList.setMemoryOwner(false);
+    _storageList.setSize(0);
+
     // ACCELERATIONS
     _aStore = new Storage(1000,"Accelerations");
     _aStore->setDescription(getDescription());
@@ -263,6 +267,10 @@ allocateStorage()
     _pStore = new Storage(1000,"Positions");
     _pStore->setDescription(getDescription());
     _pStore->setColumnLabels(getColumnLabels());
+
+    _storageList.append(_aStore);
+    _storageList.append(_vStore);
+    _storageList.append(_pStore);
 }
 
 
@@ -276,6 +284,7 @@ allocateStorage()
 void BodyKinematics::
 deleteStorage()
 {
+    _storageList.setSize(0);
     if(_aStore!=NULL) { delete _aStore;  _aStore=NULL; }
     if(_vStore!=NULL) { delete _vStore;  _vStore=NULL; }
     if(_pStore!=NULL) { delete _pStore;  _pStore=NULL; }
@@ -118,6 +118,11 @@ public:
     int begin(const SimTK::State& s ) override;
     int step(const SimTK::State& s, int setNumber ) override;
     int end(const SimTK::State& s ) override;
+    /** Constraint forces require Stage::Acceleration. */
+    SimTK::Stage getRequiredStage() const override {
+        return _includeConstraintForces ? SimTK::Stage::Acceleration
+                                        : SimTK::Stage::Dynamics;
+    }
 
 protected:
     virtual int
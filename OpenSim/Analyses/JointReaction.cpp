@@ -488,6 +488,10 @@ setupStorage()
     _storeReactionLoads.setDescription(getDescription());
     _storeReactionLoads.setColumnLabels(getColumnLabels());
 
+    _storageList.setMemoryOwner(false);
+    _storageList.setSize(0);
+    _storageList.append(&_storeReactionLoads);
+
     // Actuator forces - if a forces file is specified, load the forces storage data to _storeActuation
     if(!(_forcesFileName == "")) loadForcesFromFile();
 
@@ -120,6 +120,31 @@ int OutputReporter::end(const SimTK::State& s)
     return 0;
 }
 
+SimTK::Stage OutputReporter::getRequiredStage() const
+{
+    if (_model == nullptr) return Super::getRequiredStage();
+
+    SimTK::Stage stage = SimTK::Stage::Time;
+    for (int i = 0; i < getProperty_output_paths().size(); ++i) {
+        std::string componentPath;
+        std::string outputName;
+        std::string channelName;
+        std::string alias;
+        AbstractInput::parseConnecteePath(get_output_paths(i),
+                                          componentPath, outputName,
+                                          channelName, alias);
+        if (componentPath.empty() || componentPath[0] != '/') {
+            componentPath = "/" + componentPath;
+        }
+        const auto& out =
+                _model->getComponent(componentPath).getOutput(outputName);
+        if (out.getDependsOnStage() > stage) {
+            stage = out.getDependsOnStage();
+        }
+    }
+    return stage;
+}
+
 int OutputReporter::printResults(const std::string& baseName,
     const std::string& dir,  double dT, const std::string& extension)
 {
@@ -94,6 +94,9 @@ protected:
     int begin(const SimTK::State& s) override final;
     int step(const SimTK::State& s, int setNumber) override final;
     int end(const SimTK::State& s) override final;
+    /** The highest stage that the reported Outputs depend on (at least
+    SimTK::Stage::Time). */
+    SimTK::Stage getRequiredStage() const override;
 
     int printResults(const std::string& baseName,
         const std::string& dir = "",
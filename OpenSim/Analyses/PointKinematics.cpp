@@ -260,6 +260,10 @@ constructColumnLabels()
 void PointKinematics::
 allocateStorage()
 {
+    // The storages are deleted by deleteStorage().
+    _storageList.setMemoryOwner(false);
+    _storageList.setSize(0);
+
     // ACCELERATIONS
     _aStore = new Storage(1000,"PointAcceleration");
     _aStore->setDescription(getDescription());
@@ -274,6 +278,10 @@ allocateStorage()
     _pStore = new Storage(1000,"PointPosition");
     _pStore->setDescription(getDescription());
     _pStore->setColumnLabels(getColumnLabels());
+
+    _storageList.append(_aStore);
+    _storageList.append(_vStore);
+    _storageList.append(_pStore);
 }
 
 
@@ -287,6 +295,7 @@ allocateStorage()
 void PointKinematics::
 deleteStorage()
 {
+    _storageList.setSize(0);
     if(_aStore!=NULL) { delete _aStore;  _aStore=NULL; }
     if(_vStore!=NULL) { delete _vStore;  _vStore=NULL; }
     if(_pStore!=NULL) { delete _pStore;  _pStore=NULL; }
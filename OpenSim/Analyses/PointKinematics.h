@@ -147,6 +147,8 @@ public:
     int begin(const SimTK::State& s) override;
     int step(const SimTK::State& s, int setNumber) override;
     int end(const SimTK::State& s) override;
+    SimTK::Stage getRequiredStage() const override
+    {   return SimTK::Stage::Acceleration; }
 protected:
     virtual int
         record(const SimTK::State& s );
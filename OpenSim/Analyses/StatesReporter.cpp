@@ -198,9 +198,7 @@ record(const SimTK::State& s)
 {
     if(_model==NULL) return(-1);
 
-    // MAKE SURE ALL StatesReporter QUANTITIES ARE VALID
-    _model->getMultibodySystem().realize(s, SimTK::Stage::Velocity );
-
+    // The state variable values are valid without realizing the state.
     SimTK::Vector stateValues = _model->getStateVariableValues(s);
     StateVector nextRow(s.getTime(), stateValues);
     _statesStore.append(nextRow);
@@ -104,6 +104,9 @@ public:
         step(const SimTK::State& s, int setNumber ) override;
     int
         end(const SimTK::State& s ) override;
+    /** The state variable values require no realization. */
+    SimTK::Stage getRequiredStage() const override
+    {   return SimTK::Stage::Time; }
 protected:
     virtual int
         record(const SimTK::State& s );
@@ -2,6 +2,7 @@
 #include "Simbody.h"
 #include "Exception.h"
 #include "FileAdapter.h"
+#include "RotationKernels.h"
 #include "TimeSeriesTable.h"
 #include "APDMDataReader.h"
 
@@ -53,7 +54,9 @@ APDMDataReader::extendRead(const std::string& fileName) const {
     int last_size = 1024;
     // Will read data into pre-allocated Matrices in-memory rather than appendRow
     // on the fly which copies the whole table on every call.
-    SimTK::Matrix_<SimTK::Quaternion> rotationsData{ last_size, n_imus };
+    // Orientations are collected per imu and normalized in batch once all
+    // rows are read.
+    std::vector<QuaternionArrays> imuQuaternions(n_imus);
     SimTK::Matrix_<SimTK::Vec3> linearAccelerationData{ last_size, n_imus };
     SimTK::Matrix_<SimTK::Vec3> magneticHeadingData{ last_size, n_imus };
     SimTK::Matrix_<SimTK::Vec3> angularVelocityData{ last_size, n_imus };
@@ -138,8 +141,6 @@ APDMDataReader::extendRead(const std::string& fileName) const {
     int rowNumber = 0;
     while (!done){
         // Make vectors one per table
-        TimeSeriesTableQuaternion::RowVector
-            orientation_row_vector{ n_imus, SimTK::Quaternion() };
         TimeSeriesTableVec3::RowVector
             accel_row_vector{ n_imus, SimTK::Vec3(SimTK::NaN) };
         TimeSeriesTableVec3::RowVector
@@ -163,12 +164,13 @@ APDMDataReader::extendRead(const std::string& fileName) const {
             if (foundAngularVelocityData)
                 gyro_row_vector[imu_index] = SimTK::Vec3(std::stod(nextRow[gyroIndex[imu_index]]),
                     std::stod(nextRow[gyroIndex[imu_index] + 1]), std::stod(nextRow[gyroIndex[imu_index] + 2]));
-            // Create Quaternion from values in file, assume order in file W, X, Y, Z
-            orientation_row_vector[imu_index] = 
-                SimTK::Quaternion(std::stod(nextRow[orientationsIndex[imu_index]]),
-                    std::stod(nextRow[orientationsIndex[imu_index] + 1]),
-                    std::stod(nextRow[orientationsIndex[imu_index] + 2]),
-                    std::stod(nextRow[orientationsIndex[imu_index] + 3]));
+            // Quaternion values in file, assume order in file W, X, Y, Z
+            QuaternionArrays& imu_quaternions = imuQuaternions[imu_index];
+            const int quatIndex = orientationsIndex[imu_index];
+            imu_quaternions.w.push_back(std::stod(nextRow[quatIndex]));
+            imu_quaternions.x.push_back(std::stod(nextRow[quatIndex + 1]));
+            imu_quaternions.y.push_back(std::stod(nextRow[quatIndex + 2]));
+            imu_quaternions.z.push_back(std::stod(nextRow[quatIndex + 3]));
         }
         // append to the tables
         times[rowNumber] = time;
@@ -178,7 +180,6 @@ APDMDataReader::extendRead(const std::string& fileName) const {
             magneticHeadingData[rowNumber] = magneto_row_vector;
         if (foundAngularVelocityData) 
             angularVelocityData[rowNumber] = gyro_row_vector;
-        rotationsData[rowNumber] = orientation_row_vector;
         // We could get some indication of time from file or generate time based on rate
         // Here we use the latter mechanism.
         time += timeIncrement;
@@ -191,7 +192,6 @@ APDMDataReader::extendRead(const std::string& fileName) const {
             if (foundLinearAccelerationData) linearAccelerationData.resizeKeep(newSize, n_imus);
             if (foundMagneticHeadingData) magneticHeadingData.resizeKeep(newSize, n_imus);
             if (foundAngularVelocityData) angularVelocityData.resizeKeep(newSize, n_imus);
-            rotationsData.resizeKeep(newSize, n_imus);
             last_size = newSize;
         }
     }
@@ -204,7 +204,13 @@ APDMDataReader::extendRead(const std::string& fileName) const {
             n_imus);
     angularVelocityData.resizeKeep(foundAngularVelocityData? rowNumber :0,
         n_imus);
-    rotationsData.resizeKeep(rowNumber, n_imus);
+    // Normalize the quaternions, as SimTK::Quaternion does, an imu at a time.
+    SimTK::Matrix_<SimTK::Quaternion> rotationsData{ rowNumber, n_imus };
+    for (int imu_index = 0; imu_index < n_imus; ++imu_index) {
+        RotationKernels::normalize(imuQuaternions[imu_index]);
+        RotationKernels::storeColumn(
+                imuQuaternions[imu_index], imu_index, rotationsData);
+    }
     // Now create the tables from matrices
     // Create 4 tables for Rotations, LinearAccelerations, AngularVelocity, MagneticHeading
     // Tables could be empty if data is not present in file(s)
@@ -32,6 +32,7 @@
 #include <iostream>
 #include "Logger.h"
 #include <sstream>
+#include <utility>
 
 static const int Array_CAPMIN = 1;
 
@@ -127,6 +128,20 @@ Array(const Array<T> &aArray)
     setNull();
     *this = aArray;
 }
+#ifndef SWIG
+//_____________________________________________________________________________
+/**
+ * Move constructor. The elements of aArray are taken over without copying
+ * them, and aArray is left empty.
+ *
+ * @param aArray Array to be moved.
+ */
+Array(Array<T>&& aArray)
+{
+    setNull();
+    *this = std::move(aArray);
+}
+#endif
 
 private:
 //_____________________________________________________________________________
@@ -207,6 +222,33 @@ Array<T>& operator=(const Array<T> &aArray)
 
     return(*this);
 }
+#ifndef SWIG
+//_____________________________________________________________________________
+/**
+ * Move the contents of a specified array into this array. The elements of
+ * aArray are taken over without copying them, and aArray is left empty.
+ *
+ * @param aArray Array to be moved.
+ * @return Reference to this array.
+ */
+Array<T>& operator=(Array<T>&& aArray)
+{
+    if(&aArray == this) return(*this);
+    _size = aArray._size;
+    _capacity = aArray._capacity;
+    _capacityIncrement = aArray._capacityIncrement;
+    _defaultValue = aArray._defaultValue;
+
+    // ARRAY
+    if(_array!=NULL) delete[] _array;
+    _array = aArray._array;
+    aArray._array = NULL;
+    aArray._size = 0;
+    aArray._capacity = 0;
+
+    return(*this);
+}
+#endif
 
 //-----------------------------------------------------------------------------
 // EQUALITY (==)
@@ -349,7 +391,7 @@ bool ensureCapacity(int aCapacity)
 
     // COPY CURRENT ARRAY
     if(_array!=NULL) {
-        for(i=0;i<_size;i++) newArray[i] = _array[i];
+        for(i=0;i<_size;i++) newArray[i] = std::move(_array[i]);
         for(i=_size;i<aCapacity;i++) newArray[i] = _defaultValue;
         delete []_array;  _array=NULL;
     } else {
@@ -519,6 +561,34 @@ int append(const T &aValue)
 
     return(_size);
 }
+#ifndef SWIG
+//_____________________________________________________________________________
+/**
+ * Append a value onto the array, moving rather than copying it.
+ *
+ * @param aValue Value to be moved onto the end of the array.
+ * @return New size of the array, or, equivalently, the index to the new
+ * first empty element of the array.
+ */
+int append(T&& aValue)
+{
+    // ENSURE CAPACITY
+    if((_size+1)>=_capacity) {
+        int newCapacity;
+        bool success;
+        success = computeNewCapacity(_size+1,newCapacity);
+        if(!success) return(_size);
+        success = ensureCapacity(newCapacity);
+        if(!success) return(_size);
+    }
+
+    // SET
+    _array[_size] = std::move(aValue);
+    _size++;
+
+    return(_size);
+}
+#endif
 //_____________________________________________________________________________
 /**
  * Append an array of values.
@@ -5,6 +5,9 @@
 #endif
 #include "STOFileAdapter.h"
 
+#include <algorithm>
+#include <cmath>
+
 namespace {
 
 #ifdef WITH_EZC3D
@@ -37,7 +40,54 @@ convertToSimtkMatrix(const std::vector<ezc3d::Vector3d>& all_vec) {
 
     return simtkMat;
 }
+
+SimTK::Vec3 convertToSimtkVec3(const ezc3d::Vector3d& vec) {
+    return SimTK::Vec3{vec(0), vec(1), vec(2)};
+}
 #endif
+
+// Get the range [first, last) of the frames, sampled every timeStep seconds
+// starting at time 0, whose times lie within [initialTime, finalTime].
+std::pair<int, int> getFrameRange(int numFrames, double timeStep,
+                                  double initialTime, double finalTime) {
+    // Allow for round-off in times that were computed from frame indices.
+    const double tol = 1e-9;
+    const double lastTime = (numFrames - 1) * timeStep;
+    int first = 0;
+    int last = numFrames;
+    if (initialTime > lastTime)
+        first = numFrames;
+    else if (initialTime > 0)
+        first = static_cast<int>(std::ceil(initialTime / timeStep - tol));
+    if (finalTime < 0)
+        last = 0;
+    else if (finalTime < lastTime)
+        last = static_cast<int>(std::floor(finalTime / timeStep + tol)) + 1;
+    return {first, std::max(first, last)};
+}
+
+// Get the indices of the selected labels within labels, in the order in
+// which they were selected. If no labels were selected, all indices are
+// returned.
+std::vector<int> getSelectedIndices(const std::vector<std::string>& labels,
+                                    const std::vector<std::string>& selected,
+                                    const std::string& kind) {
+    std::vector<int> indices;
+    if (selected.empty()) {
+        indices.resize(labels.size());
+        for (int i = 0; i < (int)labels.size(); ++i) indices[i] = i;
+        return indices;
+    }
+    indices.reserve(selected.size());
+    for (const auto& label : selected) {
+        auto it = std::find(labels.begin(), labels.end(), label);
+        OPENSIM_THROW_IF(it == labels.end(), OpenSim::Exception,
+                "C3DFileAdapter: " + kind + " '" + label +
+                "' not found in file.");
+        indices.push_back(static_cast<int>(std::distance(labels.begin(), it)));
+    }
+    return indices;
+}
 } // anonymous namespace
 
 
@@ -105,39 +155,52 @@ C3DFileAdapter::extendRead(const std::string& fileName) const {
 
     if(numMarkers != 0) {
 
-        int marker_nrow = numFrames;
-        int marker_ncol = numMarkers;
-
-        std::vector<double> marker_times(marker_nrow);
-        SimTK::Matrix_<SimTK::Vec3> marker_matrix(marker_nrow, marker_ncol);
-
-        std::vector<std::string> marker_labels{};
+        std::vector<std::string> all_marker_labels{};
         for (auto label : c3d.parameters().group("POINT")
                 .parameter("LABELS").valuesAsString()) {
-            marker_labels.push_back(SimTK::Value<std::string>(label));
+            all_marker_labels.push_back(SimTK::Value<std::string>(label));
+        }
+
+        std::vector<int> marker_indices(numMarkers);
+        std::vector<std::string> marker_labels{};
+        if (_markerNames.empty()) {
+            for (int m = 0; m < numMarkers; ++m) marker_indices[m] = m;
+            marker_labels = all_marker_labels;
+        } else {
+            marker_indices = getSelectedIndices(
+                    all_marker_labels, _markerNames, "marker");
+            marker_labels = _markerNames;
         }
 
         double time_step{1.0 / pointFrequency};
-        for(int f = 0; f < marker_nrow; ++f) {
-            SimTK::RowVector_<SimTK::Vec3> row{ numMarkers,
-                                                SimTK::Vec3(SimTK::NaN) };
-            int m{0};
+        const auto marker_frames = getFrameRange(
+                numFrames, time_step, _initialTime, _finalTime);
+
+        int marker_nrow = marker_frames.second - marker_frames.first;
+        int marker_ncol = static_cast<int>(marker_indices.size());
+
+        std::vector<double> marker_times(marker_nrow);
+        SimTK::Matrix_<SimTK::Vec3> marker_matrix(marker_nrow, marker_ncol,
+                                                  SimTK::Vec3(SimTK::NaN));
+
+        for(int r = 0; r < marker_nrow; ++r) {
+            const int f = marker_frames.first + r;
+            const auto& points = c3d.data().frame(f).points();
             // C3D standard is to read empty values as zero, but sets a
             // "residual" value to -1 and it is how it knows to export these
             // values as blank, instead of 0,  when exporting to .trc
             // See: C3D documention 3D Point Residuals
             // Read in value if it is not zero or residual is not -1
-            for(auto pt : c3d.data().frame(f).points().points()) {
+            for(int m = 0; m < marker_ncol; ++m) {
+                const auto& pt = points.point(marker_indices[m]);
                 if (!pt.isEmpty() ) {//residual is not -1
-                    row[m] = SimTK::Vec3{ static_cast<double>(pt.x()),
-                                          static_cast<double>(pt.y()),
-                                          static_cast<double>(pt.z()) };
+                    marker_matrix(r, m) = SimTK::Vec3{
+                            static_cast<double>(pt.x()),
+                            static_cast<double>(pt.y()),
+                            static_cast<double>(pt.z()) };
                 }
-                ++m;
             }
-
-            marker_matrix.updRow(f) = row;
-            marker_times[f] = 0 + f * time_step; //TODO: 0 should be start_time
+            marker_times[r] = 0 + f * time_step; //TODO: 0 should be start_time
         }
 
         // Create the data
@@ -236,46 +299,52 @@ C3DFileAdapter::extendRead(const std::string& fileName) const {
         
         const auto& pf_ref(force_platforms_extractor.forcePlatforms());
 
-        std::vector<double> force_times(nf);
-        SimTK::Matrix_<SimTK::Vec3> force_matrix(nf, (int)labels.size());
-
         double time_step{1.0 / analogFrequency};
+        const auto force_frames = getFrameRange(
+                nf, time_step, _initialTime, _finalTime);
+        const int force_nrow = force_frames.second - force_frames.first;
+
+        std::vector<double> force_times(force_nrow);
+        SimTK::Matrix_<SimTK::Vec3> force_matrix(force_nrow, (int)labels.size());
+
+        if (forceLocation != ForceLocation::CenterOfPressure &&
+                forceLocation != ForceLocation::OriginOfForcePlate) {
+            OPENSIM_THROW(Exception,
+                          "The selected force location is not "
+                          "implemented for ezc3d files");
+        }
 
-        for(int f = 0; f < nf;  ++f) {
-            SimTK::RowVector_<SimTK::Vec3>
-                    row{numPlatform * 3};
-            int col{0};
-            for (size_t i = 0; i < (size_t)numPlatform; ++i){
-                row[col] = SimTK::Vec3{pf_ref[i].forces()[f](0),
-                                       pf_ref[i].forces()[f](1),
-                                       pf_ref[i].forces()[f](2)};
-                ++col;
-                if (forceLocation == ForceLocation::CenterOfPressure){
-                    row[col] = SimTK::Vec3{pf_ref[i].CoP()[f](0),
-                                           pf_ref[i].CoP()[f](1),
-                                           pf_ref[i].CoP()[f](2)};
-                    ++col;
-                    row[col] = SimTK::Vec3{pf_ref[i].Tz()[f](0),
-                                           pf_ref[i].Tz()[f](1),
-                                           pf_ref[i].Tz()[f](2)};
-                    ++col;
-                } else if (forceLocation == ForceLocation::OriginOfForcePlate){
-                    row[col] = SimTK::Vec3{pf_ref[i].meanCorners()(0),
-                                           pf_ref[i].meanCorners()(1),
-                                           pf_ref[i].meanCorners()(2)};
-                    ++col;
-                    row[col] = SimTK::Vec3{pf_ref[i].moments()[f](0),
-                                           pf_ref[i].moments()[f](1),
-                                           pf_ref[i].moments()[f](2)};
-                    ++col;
-                } else {
-                    OPENSIM_THROW(Exception,
-                                  "The selected force location is not "
-                                  "implemented for ezc3d files");
+        // Fill the table one column (quantity of a platform) at a time,
+        // copying only the frames within the time range.
+        for (int i = 0; i < numPlatform; ++i) {
+            const auto& platform = pf_ref[i];
+            const int fcol = 3 * i;
+            const auto& forces = platform.forces();
+            for (int r = 0; r < force_nrow; ++r) {
+                force_matrix(r, fcol) =
+                        convertToSimtkVec3(forces[force_frames.first + r]);
+            }
+            if (forceLocation == ForceLocation::CenterOfPressure) {
+                const auto& cop = platform.CoP();
+                const auto& tz = platform.Tz();
+                for (int r = 0; r < force_nrow; ++r) {
+                    const int f = force_frames.first + r;
+                    force_matrix(r, fcol + 1) = convertToSimtkVec3(cop[f]);
+                    force_matrix(r, fcol + 2) = convertToSimtkVec3(tz[f]);
+                }
+            } else {
+                const auto& moments = platform.moments();
+                force_matrix.updCol(fcol + 1) =
+                        convertToSimtkVec3(platform.meanCorners());
+                for (int r = 0; r < force_nrow; ++r) {
+                    force_matrix(r, fcol + 2) = convertToSimtkVec3(
+                            moments[force_frames.first + r]);
                 }
             }
-            force_matrix.updRow(f) = row;
-            force_times[f] = 0 + f * time_step; //TODO: 0 should be start_time
+        }
+        for (int r = 0; r < force_nrow; ++r) {
+            //TODO: 0 should be start_time
+            force_times[r] = 0 + (force_frames.first + r) * time_step;
         }
 
         auto&  force_table =
@@ -324,31 +393,38 @@ C3DFileAdapter::extendRead(const std::string& fileName) const {
     }
 
     // Try to extract analog data and place in a new TimeSeriesTable_<double> 
-    std::vector<std::string> analog_labels{};
+    std::vector<std::string> all_analog_labels{};
     for (auto label : c3d.parameters().group("ANALOG")
         .parameter("LABELS").valuesAsString()) {
-        analog_labels.push_back(SimTK::Value<std::string>(label));
+        all_analog_labels.push_back(SimTK::Value<std::string>(label));
+    }
+    const std::vector<int> analog_indices = getSelectedIndices(
+            all_analog_labels, _analogChannelNames, "analog channel");
+    std::vector<std::string> analog_labels{};
+    for (int index : analog_indices) {
+        analog_labels.push_back(all_analog_labels[index]);
     }
 
     int numAnalogSignals = (int)analog_labels.size();
-    int totalAnalogFrames = (int) (c3d.data().nbFrames() * c3d.header().nbAnalogByFrame());
-    SimTK::Matrix analog_data_matrix(totalAnalogFrames, numAnalogSignals);
-    std::vector<double> analog_times(totalAnalogFrames);
+    const int nbAnalogByFrame = (int)c3d.header().nbAnalogByFrame();
+    int totalAnalogFrames = (int) (c3d.data().nbFrames() * nbAnalogByFrame);
     double analog_time_step{ 1.0 / analogFrequency };
-
-    // Exrtact matrix of analog data one (sub)frame at a time
-    int rowNumber = 0;
-    for (const auto& frame : c3d.data().frames()) {
-        for (size_t i = 0; i < frame.analogs().nbSubframes(); ++i) {
-            const auto& subframe(frame.analogs().subframe(i));
-            SimTK::RowVector_<double> row{ numAnalogSignals, SimTK::NaN };
-            for (int col = 0; col < numAnalogSignals; ++col) {
-                row[col] = subframe.channel(col).data();
-            }
-            analog_data_matrix.updRow(rowNumber) = row;
-            analog_times[rowNumber] = rowNumber * analog_time_step; //TODO: 0 should be start_time
-            rowNumber++;
+    const auto analog_frames = getFrameRange(totalAnalogFrames,
+            analog_time_step, _initialTime, _finalTime);
+    const int analog_nrow = analog_frames.second - analog_frames.first;
+    SimTK::Matrix analog_data_matrix(analog_nrow, numAnalogSignals);
+    std::vector<double> analog_times(analog_nrow);
+
+    // Extract matrix of analog data one (sub)frame at a time
+    for (int r = 0; r < analog_nrow; ++r) {
+        const int rowNumber = analog_frames.first + r;
+        const auto& subframe(c3d.data().frame(rowNumber / nbAnalogByFrame)
+                .analogs().subframe(rowNumber % nbAnalogByFrame));
+        for (int col = 0; col < numAnalogSignals; ++col) {
+            analog_data_matrix(r, col) =
+                    subframe.channel(analog_indices[col]).data();
         }
+        analog_times[r] = rowNumber * analog_time_step; //TODO: 0 should be start_time
     }
     auto& analog_table =
         *(new TimeSeriesTable(analog_times, analog_data_matrix, analog_labels));
@@ -116,6 +116,50 @@ public:
         return _location;
     }
 
+    /** Read only the frames whose times lie within [initialTime, finalTime]
+        (in seconds, with the first frame of the file at time 0). The
+        window is applied to the markers, forces and analog tables; frames
+        outside of it are not copied into the tables. The times in the
+        resulting tables are those of the frames in the file. By default, all
+        frames are read. */
+    void setTimeRange(double initialTime, double finalTime) {
+        OPENSIM_THROW_IF(initialTime > finalTime, Exception,
+            "Expected initialTime <= finalTime, but initialTime = " +
+            std::to_string(initialTime) + " and finalTime = " +
+            std::to_string(finalTime) + ".");
+        _initialTime = initialTime;
+        _finalTime = finalTime;
+    }
+    /** Retrieve the start of the time range to read (-Infinity by default). */
+    double getInitialTime() const { return _initialTime; }
+    /** Retrieve the end of the time range to read (Infinity by default). */
+    double getFinalTime() const { return _finalTime; }
+
+    /** Read only the markers with the given labels into the markers table;
+        the columns of the table are in the order given here. An exception
+        is thrown by read() if one of the labels is not in the file. If the
+        list is empty (the default), all markers are read. */
+    void setMarkerNames(const std::vector<std::string>& markerNames) {
+        _markerNames = markerNames;
+    }
+    /** Retrieve the labels of the markers to read. */
+    const std::vector<std::string>& getMarkerNames() const {
+        return _markerNames;
+    }
+
+    /** Read only the analog channels with the given labels into the analog
+        table; the columns of the table are in the order given here. An
+        exception is thrown by read() if one of the labels is not in the file.
+        If the list is empty (the default), all channels are read. Forces
+        are always computed from the channels of the force plates. */
+    void setAnalogChannelNames(const std::vector<std::string>& channelNames) {
+        _analogChannelNames = channelNames;
+    }
+    /** Retrieve the labels of the analog channels to read. */
+    const std::vector<std::string>& getAnalogChannelNames() const {
+        return _analogChannelNames;
+    }
+
 #ifndef SWIG
     static
     void write(const Tables& markerTable, const std::string& fileName);
@@ -153,6 +197,10 @@ private:
     static const std::unordered_map<std::string, std::size_t> _unit_index;
 
     ForceLocation _location{ ForceLocation::OriginOfForcePlate };
+    double _initialTime{ -SimTK::Infinity };
+    double _finalTime{ SimTK::Infinity };
+    std::vector<std::string> _markerNames;
+    std::vector<std::string> _analogChannelNames;
 
 };
 
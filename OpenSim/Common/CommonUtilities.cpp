@@ -23,13 +23,17 @@
 
 #include "CommonUtilities.h"
 
+#include "IO.h"
 #include "PiecewiseLinearFunction.h"
 #include "STOFileAdapter.h"
 #include "TimeSeriesTable.h"
 #include <chrono>
+#include <cstdio>
 #include <ctime>
+#include <fstream>
 #include <iomanip>
 #include <memory>
+#include <random>
 #include <sstream>
 
 #include <SimTKcommon/internal/Pathname.h>
@@ -183,3 +187,69 @@ SimTK::Real OpenSim::solveBisection(
     }
     return midpoint;
 }
+
+OpenSim::ContentHash& OpenSim::ContentHash::update(
+        const void* data, size_t size) {
+    const auto* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        m_hash ^= bytes[i];
+        m_hash *= 1099511628211ull;
+    }
+    return *this;
+}
+
+OpenSim::ContentHash& OpenSim::ContentHash::update(const std::string& string) {
+    const std::uint64_t size = string.size();
+    update(&size, sizeof(size));
+    return update(string.data(), string.size());
+}
+
+OpenSim::ContentHash& OpenSim::ContentHash::update(double value) {
+    return update(&value, sizeof(value));
+}
+
+OpenSim::ContentHash& OpenSim::ContentHash::updateWithFile(
+        const std::string& filepath) {
+    std::ifstream file(filepath, std::ios::binary);
+    OPENSIM_THROW_IF(!file.good(), FileDoesNotExist, filepath);
+    char buffer[65536];
+    while (file) {
+        file.read(buffer, sizeof(buffer));
+        update(buffer, (size_t)file.gcount());
+    }
+    return *this;
+}
+
+void OpenSim::writeFileAtomically(const std::string& path,
+        const std::function<void(const std::string&)>& write) {
+    // Insert a random suffix before the extension, so that concurrent writers
+    // do not share a temporary file and the extension is kept.
+    std::random_device random;
+    std::ostringstream suffix;
+    suffix << ".tmp" << std::hex << random() << random();
+    const auto slash = path.find_last_of("/\\");
+    auto dot = path.rfind('.');
+    if (dot == std::string::npos ||
+            (slash != std::string::npos && dot < slash)) {
+        dot = path.size();
+    }
+    std::string temporaryPath = path;
+    temporaryPath.insert(dot, suffix.str());
+    try {
+        write(temporaryPath);
+    } catch (...) {
+        std::remove(temporaryPath.c_str());
+        throw;
+    }
+    if (std::rename(temporaryPath.c_str(), path.c_str()) != 0) {
+        std::remove(temporaryPath.c_str());
+        OPENSIM_THROW_IF(!IO::FileExists(path), Exception,
+                "Could not rename '{}' to '{}'.", temporaryPath, path);
+    }
+}
+
+std::string OpenSim::ContentHash::toString() const {
+    std::ostringstream ss;
+    ss << std::hex << std::setw(16) << std::setfill('0') << m_hash;
+    return ss.str();
+}
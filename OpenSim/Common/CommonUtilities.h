@@ -24,11 +24,14 @@
  * -------------------------------------------------------------------------- */
 
 #include "osimCommonDLL.h"
+#include <cstdint>
 #include <functional>
 #include <iostream>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <stack>
+#include <string>
 #include <condition_variable>
 
 #include <SimTKcommon/internal/BigMatrix.h>
@@ -165,6 +168,97 @@ private:
     std::condition_variable m_inventoryMonitor;
 };
 
+/// This class computes a hash of a sequence of bytes, strings, numbers and
+/// files (the 64-bit FNV-1a hash), for identifying the inputs of a
+/// computation whose result can be reused (see MemoizationCache). Unlike
+/// std::hash, the hash is the same on every platform and in every run, so it
+/// can be used to name files. This is not a cryptographic hash.
+/// @ingroup commonutil
+class OSIMCOMMON_API ContentHash {
+public:
+    ContentHash& update(const void* data, size_t size);
+    /// The length of the string is also hashed, so that consecutive strings
+    /// are delimited (e.g., "ab", "c" and "a", "bc" have different hashes).
+    ContentHash& update(const std::string& string);
+    ContentHash& update(double value);
+    /// Hash the contents of a file.
+    /// @throws FileDoesNotExist if the file cannot be opened.
+    ContentHash& updateWithFile(const std::string& filepath);
+    /// The hash of everything provided so far, as 16 hexadecimal digits.
+    std::string toString() const;
+
+private:
+    std::uint64_t m_hash = 14695981039346656037ull;
+};
+
+/// Write a file by calling write() with the path of a temporary file in the
+/// same directory, and then renaming the temporary file to `path`. Other
+/// processes that read `path` (e.g., a cache file) therefore see either no
+/// file or the complete file. If `path` already exists and cannot be replaced
+/// (on Windows), the existing file is kept. The temporary file is removed if
+/// write() throws.
+/// @ingroup commonutil
+OSIMCOMMON_API
+void writeFileAtomically(const std::string& path,
+        const std::function<void(const std::string& temporaryPath)>& write);
+
+/// This class stores the results of a computation, keyed by a hash of the
+/// inputs to the computation (see ContentHash), so that the computation can be
+/// skipped when it is repeated with the same inputs. Access is threadsafe.
+/// Results are stored as shared pointers to const objects so that lookups do
+/// not copy; callers that need a mutable result must copy it. The cache also
+/// holds whether memoization is enabled and the directory (if any) in which
+/// results are also stored as files; the owner of the cache decides how to use
+/// these settings.
+/// @ingroup commonutil
+template <typename T> class MemoizationCache {
+public:
+    void setEnabled(bool enabled) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_enabled = enabled;
+    }
+    bool getEnabled() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_enabled;
+    }
+    void setDirectory(std::string directory) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_directory = std::move(directory);
+    }
+    std::string getDirectory() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_directory;
+    }
+    /// Obtain the result stored for the given hash, or nullptr if there is
+    /// none.
+    std::shared_ptr<const T> find(const std::string& hash) const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_entries.find(hash);
+        return it == m_entries.end() ? nullptr : it->second;
+    }
+    /// Store a result, replacing any result stored for the same hash.
+    void insert(const std::string& hash, std::shared_ptr<const T> result) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_entries[hash] = std::move(result);
+    }
+    /// Remove all results from memory.
+    void clear() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_entries.clear();
+    }
+    /// The number of results in memory.
+    int size() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return (int)m_entries.size();
+    }
+
+private:
+    std::map<std::string, std::shared_ptr<const T>> m_entries;
+    bool m_enabled = false;
+    std::string m_directory;
+    mutable std::mutex m_mutex;
+};
+
 } // namespace OpenSim
 
 #endif // OPENSIM_COMMONUTILITIES_H_
@@ -25,7 +25,9 @@
 // INCLUDES
 #include "Component.h"
 #include "OpenSim/Common/IO.h"
+#include "Profiler.h"
 #include "XMLDocument.h"
+#include <atomic>
 #include <unordered_map>
 #include <set>
 #include <regex>
@@ -79,29 +81,38 @@ public:
     {   return this->getValueZero(); }
 
     void realizeMeasureTopologyVirtual(SimTK::State& s) const override final
-    {   _Component.extendRealizeTopology(s); }
+    {   Profiler::Scope scope(_Component, "realizeTopology");
+        _Component.extendRealizeTopology(s); }
     void realizeMeasureModelVirtual(SimTK::State& s) const override final
-    {   _Component.extendRealizeModel(s); }
+    {   Profiler::Scope scope(_Component, "realizeModel");
+        _Component.extendRealizeModel(s); }
     void realizeMeasureInstanceVirtual(const SimTK::State& s)
         const override final
-    {   _Component.extendRealizeInstance(s); }
+    {   Profiler::Scope scope(_Component, "realizeInstance");
+        _Component.extendRealizeInstance(s); }
     void realizeMeasureTimeVirtual(const SimTK::State& s) const override final
-    {   _Component.extendRealizeTime(s); }
+    {   Profiler::Scope scope(_Component, "realizeTime");
+        _Component.extendRealizeTime(s); }
     void realizeMeasurePositionVirtual(const SimTK::State& s)
         const override final
-    {   _Component.extendRealizePosition(s); }
+    {   Profiler::Scope scope(_Component, "realizePosition");
+        _Component.extendRealizePosition(s); }
     void realizeMeasureVelocityVirtual(const SimTK::State& s)
         const override final
-    {   _Component.extendRealizeVelocity(s); }
+    {   Profiler::Scope scope(_Component, "realizeVelocity");
+        _Component.extendRealizeVelocity(s); }
     void realizeMeasureDynamicsVirtual(const SimTK::State& s)
         const override final
-    {   _Component.extendRealizeDynamics(s); }
+    {   Profiler::Scope scope(_Component, "realizeDynamics");
+        _Component.extendRealizeDynamics(s); }
     void realizeMeasureAccelerationVirtual(const SimTK::State& s)
         const override final
-    {   _Component.extendRealizeAcceleration(s); }
+    {   Profiler::Scope scope(_Component, "realizeAcceleration");
+        _Component.extendRealizeAcceleration(s); }
     void realizeMeasureReportVirtual(const SimTK::State& s)
         const override final
-    {   _Component.extendRealizeReport(s); }
+    {   Profiler::Scope scope(_Component, "realizeReport");
+        _Component.extendRealizeReport(s); }
 
 private:
     const Component& _Component;
@@ -334,6 +345,10 @@ void Component::finalizeConnections(Component& root)
     // Allow subcomponents to form their connections
     componentsFinalizeConnections(root);
 
+    if (this == &root) {
+        updateTopologyGeneration();
+    }
+
     // Forming connections changes the Socket which is a property
     // Remark as upToDate.
     setObjectIsUpToDateWithProperties();
@@ -392,6 +407,39 @@ void Component::addToSystem(SimTK::MultibodySystem& system) const
     extendAddToSystem(system);
     componentsAddToSystem(system);
     extendAddToSystemAfterSubcomponents(system);
+
+    if (!hasOwner()) {
+        const_cast<Component*>(this)->updateTopologyGeneration();
+    }
+}
+
+void Component::updateTopologyGeneration()
+{
+    // Generations are unique across all trees, so a handle cannot match a
+    // tree that was connected after the handle was obtained, even if the new
+    // System has the same address as the old one.
+    static std::atomic<long long> latestGeneration{0};
+    assignTopologyGeneration(++latestGeneration, 0);
+}
+
+int Component::assignTopologyGeneration(long long generation, int index)
+{
+    _topologyGeneration = generation;
+    _treeIndex = index++;
+    for (unsigned int i = 0; i<_memberSubcomponents.size(); ++i) {
+        index = _memberSubcomponents[i].upd()->assignTopologyGeneration(
+                generation, index);
+    }
+    for (unsigned int i = 0; i<_propertySubcomponents.size(); ++i) {
+        index = _propertySubcomponents[i].get()->assignTopologyGeneration(
+                generation, index);
+    }
+    for (unsigned int i = 0; i<_adoptedSubcomponents.size(); ++i) {
+        index = _adoptedSubcomponents[i].upd()->assignTopologyGeneration(
+                generation, index);
+    }
+    _treeIndexEnd = index;
+    return index;
 }
 
 // Base class implementation of virtual method.
@@ -845,6 +893,69 @@ double Component::
     return SimTK::NaN;
 }
 
+// Resolve a state variable name (or path) to a handle.
+Component::StateVariableHandle Component::
+    getStateVariableHandle(const std::string& name) const
+{
+    // Must have already called initSystem.
+    OPENSIM_THROW_IF_FRMOBJ(!hasSystem(), ComponentHasNoSystem);
+
+    const StateVariable* rsv = traverseToStateVariable(name);
+    if (rsv) {
+        return StateVariableHandle(rsv);
+    }
+
+    std::stringstream msg;
+    msg << "Component::getStateVariableHandle: ERR- state named '" << name
+        << "' not found in " << getName() << " of type "
+        << getConcreteClassName();
+    throw Exception(msg.str(),__FILE__,__LINE__);
+}
+
+void Component::
+    checkStateVariableHandle(const StateVariableHandle& handle) const
+{
+    // The generation is shared by the whole tree, so comparing it with this
+    // Component's generation and the handle's preorder index with this
+    // Component's subtree takes constant time.
+    OPENSIM_THROW_IF_FRMOBJ(!handle.sv || !hasSystem() ||
+                            handle.generation != _topologyGeneration,
+        Exception,
+        "The state variable handle is invalid for the current System; "
+        "obtain one with getStateVariableHandle() after calling "
+        "initSystem().");
+    OPENSIM_THROW_IF_FRMOBJ(handle.treeIndex < _treeIndex ||
+                            handle.treeIndex >= _treeIndexEnd, Exception,
+        "The state variable handle refers to a state variable of '{}', "
+        "which is not a subcomponent of this Component.",
+        handle.owner->getAbsolutePathString());
+}
+
+double Component::
+    getStateVariableValue(const SimTK::State& s,
+                          const StateVariableHandle& handle) const
+{
+    checkStateVariableHandle(handle);
+    return handle.sv->getValue(s);
+}
+
+void Component::
+    setStateVariableValue(SimTK::State& s, const StateVariableHandle& handle,
+                          double value) const
+{
+    checkStateVariableHandle(handle);
+    handle.sv->setValue(s, value);
+}
+
+double Component::
+    getStateVariableDerivativeValue(const SimTK::State& s,
+                                    const StateVariableHandle& handle) const
+{
+    checkStateVariableHandle(handle);
+    handle.sv->getOwner().computeStateVariableDerivatives(s);
+    return handle.sv->getDerivative(s);
+}
+
 // Get the value of a state variable derivative computed by this Component.
 double Component::
     getStateVariableDerivativeValue(const SimTK::State& state,
@@ -928,6 +1039,30 @@ bool Component::isAllStatesVariablesListValid() const
 }
 
 
+// Collect the state variables of this Component and its subcomponents
+// without forming (and then traversing) the path of each state variable.
+void Component::rebuildAllStateVariablesList() const
+{
+    _statesAssociatedSystem.reset(&getSystem());
+    _allStateVariables.clear();
+
+    auto append = [this](const Component& comp) {
+        const size_t offset = _allStateVariables.size();
+        _allStateVariables.resize(
+                (unsigned)(offset + comp._namedStateVariableInfo.size()));
+        for (const auto& entry : comp._namedStateVariableInfo) {
+            _allStateVariables[(unsigned)(offset + entry.second.order)].reset(
+                    entry.second.stateVariable.get());
+        }
+    };
+
+    // Same order as getStateVariableNames().
+    append(*this);
+    for (const auto& comp : getComponentList<Component>()) {
+        append(comp);
+    }
+}
+
 // Get all values of the state variables allocated by this Component. Includes
 // state variables allocated by its subcomponents.
 SimTK::Vector Component::
@@ -939,12 +1074,7 @@ SimTK::Vector Component::
     int nsv = getNumStateVariables();
     // if the StateVariables are invalid (see above) rebuild the list
     if (!isAllStatesVariablesListValid()) {
-        _statesAssociatedSystem.reset(&getSystem());
-        _allStateVariables.clear();
-        _allStateVariables.resize(nsv);
-        Array<std::string> names = getStateVariableNames();
-        for (int i = 0; i < nsv; ++i)
-            _allStateVariables[i].reset(traverseToStateVariable(names[i]));
+        rebuildAllStateVariablesList();
     }
 
     Vector stateVariableValues(nsv, SimTK::NaN);
@@ -972,12 +1102,7 @@ void Component::
 
     // if the StateVariables are invalid (see above) rebuild the list
     if (!isAllStatesVariablesListValid()) {
-        _statesAssociatedSystem.reset(&getSystem());
-        _allStateVariables.clear();
-        _allStateVariables.resize(nsv);
-        Array<std::string> names = getStateVariableNames();
-        for (int i = 0; i < nsv; ++i)
-            _allStateVariables[i].reset(traverseToStateVariable(names[i]));
+        rebuildAllStateVariablesList();
     }
 
     for(int i=0; i<nsv; ++i){
@@ -1277,6 +1277,103 @@ public:
         return (Output<T>::downcast(getOutput(name))).getValue(state);
     }
 
+protected:
+    class StateVariable;
+
+public:
+    /**
+     * A handle to a continuous state variable of this Component or one of
+     * its subcomponents.
+     *
+     * - A `StateVariableHandle` is obtained with
+     *   `Component::getStateVariableHandle`, which resolves the name (or
+     *   path) of the state variable once
+     *
+     * - Accessing a state variable's value through its handle
+     *   (`Component::getStateVariableValue(state, handle)`, etc.) does not
+     *   perform any name lookups, so prefer handles over names in code that
+     *   accesses state variables repeatedly (e.g., once per time step)
+     *
+     * - A handle is only valid until the components are connected or added
+     *   to a System again; obtain a new handle after calling
+     *   `Model::initSystem()` again or after modifying the model
+     */
+    class StateVariableHandle {
+    private:
+        const StateVariable* sv = nullptr;
+        const Component* owner = nullptr;
+        // The owner's topology generation and preorder index when the handle
+        // was obtained.
+        long long generation = 0;
+        int treeIndex = -1;
+
+        friend class Component;
+
+        explicit StateVariableHandle(const StateVariable* _sv) :
+            sv{_sv}, owner{&_sv->getOwner()},
+            generation{_sv->getOwner()._topologyGeneration},
+            treeIndex{_sv->getOwner()._treeIndex} {
+        }
+
+    public:
+        // A default-constructed handle is invalid; it allows derived classes
+        // and callers to hold handles as members and initialize them later.
+        StateVariableHandle() = default;
+
+        /** Whether the component tree that contains the state variable has
+        not been connected or added to a System since this handle was
+        obtained. A handle becomes invalid when the System is re-created
+        (e.g., by calling `Model::initSystem()` again). The component that
+        owns the state variable must still exist. */
+        bool isValid() const {
+            return sv != nullptr && owner->hasSystem() &&
+                   owner->_topologyGeneration == generation;
+        }
+    };
+
+    /**
+     * Resolve the name (or path, relative to this Component) of a state
+     * variable to a handle that provides fast access to its value.
+     *
+     * @param name    the name or path of the state variable of interest
+     * @throws ComponentHasNoSystem if this Component has not been added to a
+     *         System (i.e., if initSystem has not been called)
+     * @throws Exception if the state variable is not found
+     */
+    StateVariableHandle getStateVariableHandle(const std::string& name) const;
+
+    /**
+     * Get the value of a state variable through its handle.
+     *
+     * @param state   the State for which to get the value
+     * @param handle  a handle from getStateVariableHandle()
+     */
+    double getStateVariableValue(const SimTK::State& state,
+                                 const StateVariableHandle& handle) const;
+
+    /**
+     * %Set the value of a state variable through its handle.
+     *
+     * @param state   the State for which to set the value
+     * @param handle  a handle from getStateVariableHandle()
+     * @param value   the value to set
+     */
+    void setStateVariableValue(SimTK::State& state,
+                               const StateVariableHandle& handle,
+                               double value) const;
+
+    /**
+     * Get the value of a state variable derivative through its handle. The
+     * derivatives of the component that owns the state variable are computed
+     * if necessary.
+     *
+     * @param state   the State for which to get the derivative value
+     * @param handle  a handle from getStateVariableHandle()
+     */
+    double getStateVariableDerivativeValue(const SimTK::State& state,
+                                           const StateVariableHandle& handle)
+                                           const;
+
 
     /**
      * Get the value of a state variable allocated by this Component.
@@ -1556,6 +1653,36 @@ public:
      */
     SimTK::CacheEntryIndex getCacheVariableIndex(const std::string& name) const;
 
+    /**
+     * Get a handle to a cache variable that was previously allocated by this
+     * Component (with Component::addCacheVariable) under the given name.
+     * Accessing the cache variable through the handle avoids looking up the
+     * name on every access.
+     *
+     * @tparam T
+     *   Type of value held in the cache variable
+     * @param name
+     *   Name of the cache variable, as provided to Component::addCacheVariable
+     * @throws Exception
+     *   if there is no cache variable with this name, or if its value is not
+     *   of type T
+     */
+    template<class T>
+    CacheVariable<T> getCacheVariable(const std::string& name) const {
+        auto it = this->_namedCacheVariables.find(name);
+        if (it == this->_namedCacheVariables.end()) {
+            std::stringstream msg;
+            msg << "Cannot find cache variable with name '" << name << "'";
+            OPENSIM_THROW_FRMOBJ(Exception, msg.str());
+        }
+        if (!SimTK::Value<T>::isA(*it->second.value)) {
+            std::stringstream msg;
+            msg << "Cache variable '" << name << "' does not hold a value of the requested type";
+            OPENSIM_THROW_FRMOBJ(Exception, msg.str());
+        }
+        return CacheVariable<T>{name};
+    }
+
 private:
     template<class T, class K>
     const T& getCacheVariableValueGeneric(const SimTK::State& state, const K& key) const
@@ -1955,7 +2082,6 @@ public:
     /// @}
 
 protected:
-    class StateVariable;
     //template <class T> friend class ComponentSet;
     // Give the ComponentMeasure access to the realize() methods.
     template <class T> friend class ComponentMeasure;
@@ -3064,6 +3190,15 @@ private:
     // Reference pointer to the system that this component belongs to.
     SimTK::ReferencePtr<SimTK::MultibodySystem> _system;
 
+    // Changes whenever the tree of components that this Component belongs
+    // to is connected or added to a System, and is the same for all
+    // components of the tree; see StateVariableHandle.
+    long long _topologyGeneration{0};
+    // This Component and its subcomponents have the preorder indices
+    // [_treeIndex, _treeIndexEnd) in the tree.
+    int _treeIndex{-1};
+    int _treeIndexEnd{-1};
+
     // propertiesTable maintained by Object
 
     // Table of Component's structural Sockets indexed by name.
@@ -3241,6 +3376,20 @@ private:
 
     // Check that the list of _allStateVariables is valid
     bool isAllStatesVariablesListValid() const;
+    // Rebuild the list of _allStateVariables directly from the state
+    // variables allocated by this Component and its subcomponents, in the
+    // order given by getStateVariableNames().
+    void rebuildAllStateVariablesList() const;
+    // Throw if the handle is invalid, was obtained before the tree was last
+    // connected or added to a System, or refers to a state variable outside
+    // this Component's subtree.
+    void checkStateVariableHandle(const StateVariableHandle& handle) const;
+    // Give this Component and its subcomponents a new topology generation,
+    // which invalidates existing StateVariableHandles, and number them in
+    // preorder. Called on the root of the tree.
+    void updateTopologyGeneration();
+    // Returns the index after the last one used by this subtree.
+    int assignTopologyGeneration(long long generation, int index);
 
     // Array of all state variables for fast access during simulation
     mutable SimTK::Array_<SimTK::ReferencePtr<const StateVariable> >
@@ -36,6 +36,7 @@
 
 #include <functional>
 #include <map>
+#include <vector>
 
 #include <SimTKcommon/internal/Stage.h>
 #include <SimTKcommon/internal/State.h>
@@ -44,6 +45,7 @@ namespace OpenSim {
 
 class Component;
 class AbstractInput;
+template <typename T> class ChannelArray;
 
 /** One of the values of an Output. */
 class AbstractChannel {
@@ -327,6 +329,11 @@ private:
     // for names.
     std::map<std::string, Channel> _channels;
 
+#ifndef SWIG
+    // To evaluate channels without going through Output::getValue().
+    friend class ChannelArray<T>;
+#endif
+
 //=============================================================================
 };  // END class Output
 
@@ -366,8 +373,86 @@ private:
     // To allow Output<T> to set the _output pointer upon copy.
     friend Output<T>::Output(const Output&);
     friend Output<T>& Output<T>::operator=(const Output&);
+    friend class ChannelArray<T>;
 #endif
 };
+
+#ifndef SWIG
+/** A flat array of Channel%s of Output%s of type T, which are evaluated
+together, for reporting many outputs at a high rate (see Reporter). Each
+Channel is resolved when it is appended, so evaluating the array calls each
+output function directly, without looking up the output or checking the
+stage of each channel; the stage is checked once for all channels.
+
+The array refers to, but does not own, the Channel%s, so it must be rebuilt if
+the components that own the outputs are destroyed or copied (e.g., in
+Component::extendFinalizeConnections()). */
+template <typename T>
+class ChannelArray {
+public:
+    /** Remove all channels. */
+    void clear() {
+        _entries.clear();
+        _dependsOnStage = SimTK::Stage::Empty;
+    }
+    /** Append a channel; the value of this channel is element size() - 1 of
+    the values from evaluate(). */
+    void append(const typename Output<T>::Channel& channel) {
+        const Output<T>& output = channel.getOutput();
+        Entry entry;
+        entry.channel = &channel;
+        entry.function = &output._outputFcn;
+        entry.owner = &output.getOwner();
+        entry.channelName = &channel._channelName;
+        _entries.push_back(entry);
+        if (output.getDependsOnStage() > _dependsOnStage) {
+            _dependsOnStage = output.getDependsOnStage();
+        }
+    }
+    int size() const { return (int)_entries.size(); }
+    const typename Output<T>::Channel& getChannel(int index) const {
+        return *_entries[index].channel;
+    }
+    /** The highest stage on which the outputs of the channels depend. */
+    SimTK::Stage getDependsOnStage() const { return _dependsOnStage; }
+
+    /** Evaluate all channels, in order, into `values`, which is resized to
+    size(). The state must be realized to getDependsOnStage(), except that
+    outputs that depend on SimTK::Stage::Report can be evaluated while the
+    state is realized to Stage::Report (when the system stage is
+    Stage::Acceleration), as reporters do. */
+    template <typename ValueT>
+    void evaluate(const SimTK::State& state,
+            SimTK::RowVector_<ValueT>& values) const {
+        SimTK::Stage required = _dependsOnStage;
+        if (required > SimTK::Stage::Acceleration) {
+            required = SimTK::Stage::Acceleration;
+        }
+        if (state.getSystemStage() < required) {
+            throw SimTK::Exception::StageTooLow(__FILE__, __LINE__,
+                    state.getSystemStage(), required,
+                    "ChannelArray::evaluate(state)");
+        }
+        values.resize(size());
+        for (int i = 0; i < size(); ++i) {
+            const Entry& entry = _entries[i];
+            (*entry.function)(entry.owner, state, *entry.channelName, _value);
+            values[i] = _value;
+        }
+    }
+
+private:
+    struct Entry {
+        const typename Output<T>::Channel* channel;
+        const decltype(Output<T>::_outputFcn)* function;
+        const Component* owner;
+        const std::string* channelName;
+    };
+    std::vector<Entry> _entries;
+    SimTK::Stage _dependsOnStage = SimTK::Stage::Empty;
+    mutable T _value;
+};
+#endif
 } // end of namespace OpenSim
 
 // below: macro definitions (care: these must be defined such that they
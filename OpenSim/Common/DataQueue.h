@@ -22,9 +22,17 @@
  * See the License for the specific language governing permissions and        *
  * limitations under the License.                                             *
  * -------------------------------------------------------------------------- */
-#include <queue>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <vector>
 #include <SimTKcommon.h>
+#include <OpenSim/Common/Exception.h>
 #include <OpenSim/Common/osimCommonDLL.h>
 
 namespace OpenSim {
@@ -33,12 +41,12 @@ namespace OpenSim {
 //=============================================================================
 /**
  * This base class defines the interface for a DataQueue. A data structure
- * to maintain a queue of data to be passed between computations that are 
- * potentially different in processing speeds, decoupling the producers 
- * (e.g. File or live stream) from consumers. 
+ * to maintain a queue of data to be passed between computations that are
+ * potentially different in processing speeds, decoupling the producers
+ * (e.g. File or live stream) from consumers.
  *
- * Synchronization mechanism will be implmented later to allow handling of 
- * multiple threads or significant differences in speeds.
+ * The queue synchronizes one producer thread with one consumer thread
+ * without locks, except when a thread has to wait for the other.
  *
  * @author Ayman Habib
  */
@@ -60,16 +68,51 @@ private:
     double _timeStamp;
     SimTK::RowVectorView_<U> _data;
 };
+/** What DataQueue_::push_back() does when the queue is full. */
+enum class DataQueueOverflowPolicy {
+    /// Double the capacity of the queue. No data is lost and the producer
+    /// never waits for the consumer, so a single thread may push all of its
+    /// data before popping any of it. Growing allocates memory and briefly
+    /// pauses the consumer.
+    Grow,
+    /// Wait until the consumer has removed an entry. No data is lost, but a
+    /// slow consumer slows down the producer. The consumer must run on
+    /// another thread: a thread that fills the queue before popping from it
+    /// waits forever.
+    BackPressure,
+    /// Discard the oldest entry in the queue to make room for the new entry.
+    /// The producer never waits for the consumer, so the consumer receives
+    /// the most recent data (e.g., for live visualization).
+    DropOldest
+};
+
 /**
- * DataQueue is a wrapper around the std::queue customized to handle data 
- * processing and synchronization, and limiting the interface to only the 
- * subset of operations needed for this use case. 
- * Synchronization is experimental as of now. Client is responsible for 
- * making sure order is preserved.
+ * DataQueue is a queue of timestamped rows of data passed from one
+ * producer thread (e.g. File or live stream) to one consumer thread (e.g.
+ * the InverseKinematicsSolver). The element type is a template parameter, so
+ * the same queue can carry orientations, marker positions or coordinate
+ * values.
+ *
+ * The queue is a lock-free single-producer/single-consumer ring buffer. The
+ * slots are allocated when the queue is created, and the row of each slot is
+ * allocated the first time a row is pushed into it (or upfront, if a row size
+ * is provided), so pushing and popping rows of a fixed size (e.g. the number
+ * of sensors) does not allocate memory unless the queue grows. Give the queue
+ * enough capacity for the expected backlog to avoid growing while streaming.
+ * At most one thread may push and at most one thread may pop at a time.
+ *
+ * When the queue is full, push_back() grows the queue (the default), waits
+ * for the consumer, or discards the oldest entry (see
+ * DataQueueOverflowPolicy). When the queue is empty, pop_front() waits for
+ * the producer. A waiting thread first yields for a short while and then
+ * blocks on a condition variable until the other thread makes progress, so
+ * an idle consumer does not use the processor. The queue counts growths,
+ * dropped entries, pushes that had to wait and waits that blocked, and
+ * measures the time between pushing and popping each entry.
+ *
  * timestamp is required to pass in data so that clients can enforce order,
  * however timestamp is not used/order-enforced internally.
  */
-// @TODO Test support of multiple consumers. 
 template<class T> class DataQueue_ {
 //=============================================================================
 // METHODS
@@ -79,54 +122,301 @@ public:
     // CONSTRUCTION
     //--------------------------------------------------------------------------
     virtual ~DataQueue_() {}
-    
-    DataQueue_()                                = default;
-    // using compiler generated methods here is problematic due to mutex 
-    DataQueue_(const DataQueue_& other){ 
-        m_data_queue = other.m_data_queue;
-    };
-    DataQueue_(DataQueue_&& other){ 
-        m_data_queue = other.m_data_queue;
-    };
-    DataQueue_& operator=(const DataQueue_& other) { 
-        m_data_queue = other.m_data_queue;
+
+    /** Create a queue that holds `capacity` entries before the overflow
+     * policy applies. If `rowSize` is positive, the rows of all slots are
+     * allocated now. */
+    explicit DataQueue_(size_t capacity = 1024, int rowSize = 0,
+            DataQueueOverflowPolicy policy = DataQueueOverflowPolicy::Grow)
+            : m_policy(policy) {
+        allocate(capacity, rowSize);
+    }
+    // The atomics are not copyable. Copying a queue copies its settings and
+    // the entries it currently holds, and must not happen while another
+    // thread pushes or pops.
+    DataQueue_(const DataQueue_& other) { copyFrom(other); }
+    DataQueue_(DataQueue_&& other) { copyFrom(other); }
+    DataQueue_& operator=(const DataQueue_& other) {
+        if (this != &other) copyFrom(other);
         return (*this);
-    };
+    }
+
+    //--------------------------------------------------------------------------
+    // SETTINGS (not threadsafe; call these before streaming)
+    //--------------------------------------------------------------------------
+    /** Change the number of entries the queue holds before the overflow
+     * policy applies; this discards the current entries. If `rowSize` is
+     * positive, the rows of all slots are allocated now. */
+    void setCapacity(size_t capacity, int rowSize = 0) {
+        allocate(capacity, rowSize);
+    }
+    size_t getCapacity() const { return m_capacity; }
+    void setOverflowPolicy(DataQueueOverflowPolicy policy) {
+        m_policy = policy;
+    }
+    DataQueueOverflowPolicy getOverflowPolicy() const { return m_policy; }
 
     //--------------------------------------------------------------------------
     // DataQueue Interface
     //--------------------------------------------------------------------------
     // push data and associated timestamp to the end of the queue
-    void push_back(const double time, const SimTK::RowVectorView_<T>& data) { 
-        SimTK::RowVector_<T>* deepCopy = new SimTK::RowVector_<T>(data);
-        std::unique_lock<std::mutex> mlock(m_mutex);
-        m_data_queue.push(DataQueueEntry_<T>(time, *deepCopy));
-        mlock.unlock();     // unlock before notificiation to minimize mutex con
-        m_cond.notify_one(); 
-    }
-    // pop the front of the queue and return data and associated timestamp
-    void pop_front(double& time, SimTK::RowVector_<T>& data) { 
-        std::unique_lock<std::mutex> mlock(m_mutex);
-        while (m_data_queue.empty()) { m_cond.wait(mlock); }
-        DataQueueEntry_<SimTK::Rotation> frontEntry = m_data_queue.front();
-        m_data_queue.pop();
-        mlock.unlock(); 
-        time = frontEntry.getTimeStamp();
-        data = frontEntry.getData();
+    void push_back(const double time, const SimTK::RowVectorView_<T>& data) {
+        const uint64_t write = m_write.load(std::memory_order_relaxed);
+        uint64_t read = m_read.load();
+        bool waited = false;
+        while (write - read >= m_capacity) {
+            if (m_policy == DataQueueOverflowPolicy::Grow) {
+                grow(2 * m_capacity, data.size());
+                break;
+            }
+            if (m_policy == DataQueueOverflowPolicy::DropOldest) {
+                // If this fails, the consumer popped the oldest entry first,
+                // and read now holds the new front.
+                if (m_read.compare_exchange_strong(read, read + 1)) {
+                    ++m_numDropped;
+                    break;
+                }
+            } else {
+                waited = true;
+                waitUntil(m_producerWaiting, [this, write]() {
+                    return write - m_read.load() < m_capacity;
+                });
+                read = m_read.load();
+            }
+        }
+        if (waited) ++m_numWaited;
+        // After dropping entries, the consumer may still be copying an entry
+        // that occupied the slot we are about to write.
+        const size_t index = size_t(write % m_slots.size());
+        waitUntil(m_producerWaiting, [this, index]() {
+            const uint64_t reading = m_reading.load();
+            return reading == NotReading || reading % m_slots.size() != index;
+        });
+        Slot& slot = m_slots[index];
+        slot.time = time;
+        slot.pushTime = std::chrono::steady_clock::now();
+        const int n = data.size();
+        if (slot.data.size() != n) slot.data.resize(n);
+        for (int i = 0; i < n; ++i) slot.data[i] = data[i];
+        m_write.store(write + 1);
+        notify(m_consumerWaiting);
+    }
+    // pop the front of the queue and return data and associated timestamp,
+    // waiting for data if the queue is empty
+    void pop_front(double& time, SimTK::RowVector_<T>& data) {
+        while (!try_pop_front(time, data)) {
+            waitUntil(m_consumerWaiting, [this]() { return !isEmpty(); });
+        }
+    }
+    // pop the front of the queue if there is one and return true; otherwise,
+    // return false and leave the arguments unchanged. This waits only while
+    // the producer grows the queue.
+    bool try_pop_front(double& time, SimTK::RowVector_<T>& data) {
+        uint64_t read = m_read.load();
+        while (read != m_write.load(std::memory_order_acquire)) {
+            // Announce the entry before claiming it, so that the producer
+            // does not overwrite its slot after dropping entries or move the
+            // slots while growing.
+            m_reading.store(read);
+            if (m_growing.load()) {
+                m_reading.store(NotReading);
+                notify(m_producerWaiting);
+                waitUntil(m_consumerWaiting,
+                        [this]() { return !m_growing.load(); });
+                read = m_read.load();
+                continue;
+            }
+            if (m_read.compare_exchange_strong(read, read + 1)) {
+                const Slot& slot = m_slots[size_t(read % m_slots.size())];
+                time = slot.time;
+                const int n = slot.data.size();
+                if (data.size() != n) data.resize(n);
+                for (int i = 0; i < n; ++i) data[i] = slot.data[i];
+                const auto pushTime = slot.pushTime;
+                m_reading.store(NotReading);
+                notify(m_producerWaiting);
+                recordLatency(pushTime);
+                return true;
+            }
+            // The producer dropped the entry; read now holds the new front.
+            m_reading.store(NotReading);
+            notify(m_producerWaiting);
+        }
+        return false;
     }
     // check if the queue is empty
-    bool isEmpty() { 
-        bool status = false;
-        std::unique_lock<std::mutex> mlock(m_mutex);
-        status = m_data_queue.empty();
-        mlock.unlock(); 
-        return status;
+    bool isEmpty() const { return m_read.load() == m_write.load(); }
+    // the number of entries in the queue (a snapshot if other threads are
+    // pushing or popping)
+    size_t size() const {
+        const uint64_t read = m_read.load();
+        const uint64_t write = m_write.load();
+        return write > read ? size_t(write - read) : 0;
     }
+
+    //--------------------------------------------------------------------------
+    // STATISTICS
+    //--------------------------------------------------------------------------
+    /** The number of entries discarded by the DropOldest policy. */
+    uint64_t getNumDropped() const { return m_numDropped.load(); }
+    /** The number of times the queue grew under the Grow policy. */
+    uint64_t getNumGrown() const { return m_numGrown.load(); }
+    /** The number of calls to push_back() that waited for the consumer under
+     * the BackPressure policy. */
+    uint64_t getNumWaited() const { return m_numWaited.load(); }
+    /** The number of times push_back() or pop_front() blocked until the
+     * other thread made progress (after yielding did not suffice). */
+    uint64_t getNumBlocked() const { return m_numBlocked.load(); }
+    /** The number of entries popped. */
+    uint64_t getNumPopped() const { return m_numPopped.load(); }
+    /** The mean time (seconds) that popped entries spent in the queue. */
+    double getMeanLatency() const {
+        const uint64_t numPopped = m_numPopped.load();
+        return numPopped ? 1e-9 * m_totalLatencyNs.load() / numPopped : 0;
+    }
+    /** The longest time (seconds) that a popped entry spent in the queue. */
+    double getMaxLatency() const { return 1e-9 * m_maxLatencyNs.load(); }
+    void resetStatistics() {
+        m_numDropped = 0;
+        m_numGrown = 0;
+        m_numWaited = 0;
+        m_numBlocked = 0;
+        m_numPopped = 0;
+        m_totalLatencyNs = 0;
+        m_maxLatencyNs = 0;
+    }
+
 private:
-    // As of now we use std::queue but other data structures could be used as well
-    std::queue<DataQueueEntry_<T>> m_data_queue;
-    std::mutex m_mutex;
-    std::condition_variable m_cond;
+    struct Slot {
+        double time = 0;
+        std::chrono::steady_clock::time_point pushTime;
+        SimTK::RowVector_<T> data;
+    };
+    static constexpr uint64_t NotReading =
+            std::numeric_limits<uint64_t>::max();
+    // The number of times a waiting thread yields before it blocks.
+    static constexpr int NumYieldsBeforeBlocking = 100;
+
+    // Wait until ready() is true. `waiting` is this thread's flag, which the
+    // other thread checks (in notify()) after each change to the indices.
+    // The flag is set before ready() is checked under the mutex, and the
+    // indices are changed before the flag is checked (all sequentially
+    // consistent), so a notification cannot be missed.
+    template <class Ready>
+    void waitUntil(std::atomic<bool>& waiting, Ready ready) {
+        for (int i = 0; i < NumYieldsBeforeBlocking; ++i) {
+            if (ready()) return;
+            std::this_thread::yield();
+        }
+        std::unique_lock<std::mutex> lock(m_waitMutex);
+        waiting.store(true);
+        if (!ready()) {
+            ++m_numBlocked;
+            m_waitCondition.wait(lock, ready);
+        }
+        waiting.store(false);
+    }
+    // Wake the other thread if it is blocked in waitUntil().
+    void notify(const std::atomic<bool>& waiting) {
+        if (waiting.load()) {
+            std::lock_guard<std::mutex> lock(m_waitMutex);
+            m_waitCondition.notify_all();
+        }
+    }
+
+    // Move the entries to capacity + 1 new slots. Only the producer calls
+    // this. The consumer does not touch the slots while m_growing is set:
+    // both threads announce themselves before checking the other (all
+    // sequentially consistent), so either the consumer sees the flag and
+    // backs off, or the producer sees m_reading and waits for the copy.
+    void grow(size_t capacity, int rowSize) {
+        m_growing.store(true);
+        waitUntil(m_producerWaiting,
+                [this]() { return m_reading.load() == NotReading; });
+        std::vector<Slot> slots(capacity + 1);
+        const uint64_t read = m_read.load();
+        const uint64_t write = m_write.load(std::memory_order_relaxed);
+        for (uint64_t i = read; i < write; ++i) {
+            slots[size_t(i % slots.size())] =
+                    m_slots[size_t(i % m_slots.size())];
+        }
+        for (auto& slot : slots) {
+            if (slot.data.size() == 0) slot.data.resize(rowSize);
+        }
+        m_slots.swap(slots);
+        m_capacity = capacity;
+        ++m_numGrown;
+        m_growing.store(false);
+        notify(m_consumerWaiting);
+    }
+
+    void allocate(size_t capacity, int rowSize) {
+        OPENSIM_THROW_IF(capacity == 0, Exception,
+                "Expected the capacity of the DataQueue to be positive.");
+        m_capacity = capacity;
+        // With one extra slot, the producer never has to wait for the
+        // consumer to finish copying under the BackPressure policy.
+        m_slots.assign(capacity + 1, Slot());
+        if (rowSize > 0) {
+            for (auto& slot : m_slots) slot.data.resize(rowSize);
+        }
+        m_read = 0;
+        m_write = 0;
+        m_reading = NotReading;
+        resetStatistics();
+    }
+    void copyFrom(const DataQueue_& other) {
+        m_policy = other.m_policy;
+        allocate(other.m_capacity.load(), 0);
+        const uint64_t otherRead = other.m_read.load();
+        const uint64_t otherWrite = other.m_write.load();
+        for (uint64_t i = otherRead; i < otherWrite; ++i) {
+            m_slots[size_t(i - otherRead)] =
+                    other.m_slots[size_t(i % other.m_slots.size())];
+        }
+        m_write = otherWrite - otherRead;
+    }
+    // Only the consumer calls this.
+    void recordLatency(std::chrono::steady_clock::time_point pushTime) {
+        const auto elapsed = std::chrono::steady_clock::now() - pushTime;
+        const uint64_t latency = (uint64_t)std::max<int64_t>(0,
+                std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed)
+                        .count());
+        m_totalLatencyNs += latency;
+        if (latency > m_maxLatencyNs.load()) m_maxLatencyNs = latency;
+        ++m_numPopped;
+    }
+
+    // Atomic because the producer changes it when the queue grows.
+    std::atomic<size_t> m_capacity{0};
+    DataQueueOverflowPolicy m_policy = DataQueueOverflowPolicy::Grow;
+    std::vector<Slot> m_slots;
+    // Indices of the front entry and of the next entry to push. They only
+    // increase and map to slots modulo the number of slots. The padding keeps
+    // the index written by the producer and the index written by the
+    // consumer on separate cache lines.
+    std::atomic<uint64_t> m_read{0};
+    char m_readPadding[64];
+    std::atomic<uint64_t> m_write{0};
+    char m_writePadding[64];
+    // The index of the entry that the consumer is copying, or NotReading.
+    std::atomic<uint64_t> m_reading{NotReading};
+    // Set while the producer moves the entries to larger slots.
+    std::atomic<bool> m_growing{false};
+
+    // Used only when a thread has to block; see waitUntil().
+    std::mutex m_waitMutex;
+    std::condition_variable m_waitCondition;
+    std::atomic<bool> m_producerWaiting{false};
+    std::atomic<bool> m_consumerWaiting{false};
+
+    std::atomic<uint64_t> m_numDropped{0};
+    std::atomic<uint64_t> m_numGrown{0};
+    std::atomic<uint64_t> m_numWaited{0};
+    std::atomic<uint64_t> m_numBlocked{0};
+    std::atomic<uint64_t> m_numPopped{0};
+    std::atomic<uint64_t> m_totalLatencyNs{0};
+    std::atomic<uint64_t> m_maxLatencyNs{0};
 
     //=============================================================================
 };  // END of class templatized DataQueue_<T>
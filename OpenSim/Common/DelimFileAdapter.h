@@ -31,6 +31,7 @@
 
 #include <string>
 #include <fstream>
+#include <limits>
 #include <regex>
 
 namespace OpenSim {
@@ -116,6 +117,12 @@ public:
     /** Name of the data type T (template parameter).                         */
     static inline std::string dataTypeName();
 
+    /** Number of significant digits of the numbers written. The default is
+    16; std::numeric_limits<double>::max_digits10 (17) guarantees that the
+    numbers read back are identical to those written.                      */
+    void setWritePrecision(unsigned precision) { _writePrecision = precision; }
+    unsigned getWritePrecision() const { return _writePrecision; }
+
 protected:
     /** Implementation of the read functionality.                             */
     OutputTables extendRead(const std::string& filename) const override;
@@ -186,6 +193,8 @@ private:
     const std::string _compDelimRead;
     /** Delimiter used for writing. Separates components of an element.       */
     const std::string _compDelimWrite;
+    /** Number of significant digits of the numbers written.                  */
+    unsigned _writePrecision = std::numeric_limits<double>::digits10 + 1;
     /** String representing the end of header in the file.                    */
     static const std::string _endHeaderString;
     /** Column label of the time column.                                      */
@@ -625,7 +634,7 @@ DelimFileAdapter<T>::extendWrite(const InputTables& absTables,
 
     // Data rows.
     for(unsigned row = 0; row < table->getNumRows(); ++row) {
-        constexpr auto prec = std::numeric_limits<double>::digits10 + 1;
+        const auto prec = _writePrecision;
         out_stream << std::setprecision(prec)
                    << table->getIndependentColumn()[row];
         const auto& row_r = table->getRowAtIndex(row);
@@ -39,8 +39,12 @@
     #include <sys/types.h>
 #elif defined(_MSC_VER)
     #include <direct.h>
+    #include <sys/stat.h>
+    #include <sys/types.h>
 #else
     #include <unistd.h>
+    #include <sys/stat.h>
+    #include <sys/types.h>
 #endif
 
 // PATH stuff from Kenny
@@ -423,6 +427,17 @@ bool IO::FileExists(const std::string& filePath) {
     return std::ifstream(filePath).good();
 }
 
+long long IO::GetFileModificationTime(const std::string& filePath) {
+#ifdef _MSC_VER
+    struct _stat64 info;
+    if (_stat64(filePath.c_str(), &info) != 0) return -1;
+#else
+    struct stat info;
+    if (stat(filePath.c_str(), &info) != 0) return -1;
+#endif
+    return static_cast<long long>(info.st_mtime);
+}
+
 //_____________________________________________________________________________
 /**
  * Open a file.
@@ -486,6 +501,21 @@ makeDir(const string &aDirName)
 #endif
 }
 //_____________________________________________________________________________
+/**
+ * Remove an empty directory. Potentially platform dependent.
+  * @return int 0 on success, error condition otherwise
+*/
+int IO::
+removeDir(const string &aDirName)
+{
+
+#if defined __linux__ || defined __APPLE__
+    return rmdir(aDirName.c_str());
+#else
+    return _rmdir(aDirName.c_str());
+#endif
+}
+//_____________________________________________________________________________
 /**
  * Change working directory. Potentially platform dependent.
   * @return int 0 on success, error condition otherwise
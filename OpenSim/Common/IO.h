@@ -99,12 +99,16 @@ public:
     static int ComputeNumberOfSteps(double aTI,double aTF,double aDT);
     static std::string ReadCharacters(std::istream &aIS,int aNChar);
     static bool FileExists(const std::string& filePath);
+    /** Last modification time of a file, in seconds since the epoch, or -1
+    if the file cannot be accessed. */
+    static long long GetFileModificationTime(const std::string& filePath);
     static FILE* OpenFile(const std::string &aFileName,const std::string &aMode);
     static std::ifstream* OpenInputFile(const std::string &aFileName,std::ios_base::openmode mode=std::ios_base::in);
     static std::ofstream* OpenOutputFile(const std::string &aFileName,std::ios_base::openmode mode=std::ios_base::out);
 #endif
     // Directory management
     static int makeDir(const std::string &aDirName);
+    static int removeDir(const std::string &aDirName);
     static int chDir(const std::string &aDirName);
     static std::string getCwd();
     static std::string getParentDirectory(const std::string& fileName);
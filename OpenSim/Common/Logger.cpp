@@ -26,8 +26,15 @@
 #include "IO.h"
 #include "LogSink.h"
 
+#include "spdlog/async.h"
 #include "spdlog/sinks/stdout_color_sinks.h"
 
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <sstream>
+#include <thread>
+
 using namespace OpenSim;
 
 static void initializeLogger(spdlog::logger& l, const char* pattern) {
@@ -43,6 +50,24 @@ static std::shared_ptr<spdlog::logger> coutLogger =
 static std::shared_ptr<spdlog::logger> defaultLogger =
         spdlog::default_logger();
 
+// in asynchronous mode (see setAsynchronous()), messages are logged to copies
+// of the loggers above (and of the telemetry logger) that share their sinks
+// and queue the messages for the thread of the thread pool.
+//
+// the loggers above remain the ones that are registered with spdlog and hold
+// the sinks and levels, so the copies are recreated whenever those change.
+// other threads may be logging at that time, so the pointers to the copies
+// (and to the telemetry logger) are only accessed with std::atomic_load and
+// std::atomic_store, and each message holds its own reference to its logger
+static std::shared_ptr<spdlog::details::thread_pool> threadPool = nullptr;
+static std::shared_ptr<spdlog::logger> asyncCoutLogger = nullptr;
+static std::shared_ptr<spdlog::logger> asyncDefaultLogger = nullptr;
+
+// telemetry records (see addTelemetryFile()) have their own logger so that
+// they are not written to the other sinks
+static std::shared_ptr<spdlog::logger> telemetryLogger = nullptr;
+static std::shared_ptr<spdlog::logger> asyncTelemetryLogger = nullptr;
+
 // this function returns a dummy value so that it can be used in an assignment
 // expression (below) that *must* be executed in-order at static init time
 static bool initializeLogging() {
@@ -90,23 +115,50 @@ return true;
 #endif
 }
 
+// returns an asynchronous copy of the logger, or nullptr if logging is not
+// asynchronous
+static std::shared_ptr<spdlog::logger> makeAsyncLogger(
+        const std::shared_ptr<spdlog::logger>& logger) {
+    if (!threadPool || !logger) {
+        return nullptr;
+    }
+    auto asyncLogger = std::make_shared<spdlog::async_logger>(logger->name(),
+            logger->sinks().begin(), logger->sinks().end(), threadPool,
+            spdlog::async_overflow_policy::block);
+    asyncLogger->set_level(logger->level());
+    asyncLogger->flush_on(logger->flush_level());
+    return asyncLogger;
+}
+
+// messages that were already queued keep the previous copies alive until
+// they are written
+static void updateAsyncLoggers() {
+    std::atomic_store(&asyncCoutLogger, makeAsyncLogger(coutLogger));
+    std::atomic_store(&asyncDefaultLogger, makeAsyncLogger(defaultLogger));
+    std::atomic_store(&asyncTelemetryLogger,
+            makeAsyncLogger(std::atomic_load(&telemetryLogger)));
+}
+
 // this function is only called when the caller is about to log something, so
 // it should perform lazy initialization of the file sink
-spdlog::logger& Logger::getCoutLogger() {
+std::shared_ptr<spdlog::logger> Logger::getCoutLogger() {
     initFileLoggingAsNeeded();
-    return *coutLogger;
+    auto asyncLogger = std::atomic_load(&asyncCoutLogger);
+    return asyncLogger ? asyncLogger : coutLogger;
 }
 
 // this function is only called when the caller is about to log something, so
 // it should perform lazy initialization of the file sink
-spdlog::logger& Logger::getDefaultLogger() {
+std::shared_ptr<spdlog::logger> Logger::getDefaultLogger() {
     initFileLoggingAsNeeded();
-    return *defaultLogger;
+    auto asyncLogger = std::atomic_load(&asyncDefaultLogger);
+    return asyncLogger ? asyncLogger : defaultLogger;
 }
 
 static void addSinkInternal(std::shared_ptr<spdlog::sinks::sink> sink) {
     coutLogger->sinks().push_back(sink);
     defaultLogger->sinks().push_back(sink);
+    updateAsyncLoggers();
 }
 
 static void removeSinkInternal(const std::shared_ptr<spdlog::sinks::sink> sink)
@@ -121,6 +173,7 @@ static void removeSinkInternal(const std::shared_ptr<spdlog::sinks::sink> sink)
         auto new_end = std::remove(sinks.begin(), sinks.end(), sink);
         sinks.erase(new_end, sinks.end());
     }
+    updateAsyncLoggers();
 }
 
 void Logger::setLevel(Level level) {
@@ -149,6 +202,7 @@ void Logger::setLevel(Level level) {
     default:
         OPENSIM_THROW(Exception, "Internal error.");
     }
+    updateAsyncLoggers();
     Logger::info("Set log level to {}.", getLevelString());
 }
 
@@ -274,3 +328,112 @@ void Logger::removeSink(const std::shared_ptr<LogSink> sink) {
 }
 
 
+
+void Logger::setAsynchronous(bool asynchronous, int queueSize) {
+    if (asynchronous == isAsynchronous()) {
+        return;
+    }
+    if (asynchronous) {
+        OPENSIM_THROW_IF(queueSize < 1, Exception,
+                "Expected queueSize to be positive, but got {}.", queueSize);
+        // create the log file now, rather than with the first message
+        initFileLoggingAsNeeded();
+        threadPool = std::make_shared<spdlog::details::thread_pool>(
+                static_cast<size_t>(queueSize), 1);
+        updateAsyncLoggers();
+    } else {
+        auto pool = std::move(threadPool);
+        updateAsyncLoggers();
+        // the thread writes the queued messages before it is joined
+        pool.reset();
+    }
+}
+
+bool Logger::isAsynchronous() {
+    return threadPool != nullptr;
+}
+
+void Logger::addTelemetryFile(const std::string& filepath) {
+    removeTelemetryFile();
+    std::shared_ptr<spdlog::sinks::basic_file_sink_mt> sink;
+    try {
+        sink = std::make_shared<spdlog::sinks::basic_file_sink_mt>(
+                filepath, true);
+    } catch (const spdlog::spdlog_ex& ex) {
+        OPENSIM_THROW(Exception, "Can't open telemetry file '{}': {}",
+                filepath, ex.what());
+    }
+    auto logger = std::make_shared<spdlog::logger>("telemetry", sink);
+    logger->set_pattern("%v");
+    logger->set_level(spdlog::level::trace);
+    logger->flush_on(spdlog::level::info);
+    std::atomic_store(&telemetryLogger, logger);
+    updateAsyncLoggers();
+}
+
+void Logger::removeTelemetryFile() {
+    if (std::atomic_load(&telemetryLogger) == nullptr) {
+        return;
+    }
+    std::atomic_store(&telemetryLogger, std::shared_ptr<spdlog::logger>());
+    updateAsyncLoggers();
+}
+
+bool Logger::isTelemetryEnabled() {
+    return std::atomic_load(&telemetryLogger) != nullptr;
+}
+
+static void appendJSONString(std::string& out, const std::string& str) {
+    out += '"';
+    for (const char c : str) {
+        switch (c) {
+        case '"': out += "\\\""; break;
+        case '\\': out += "\\\\"; break;
+        case '\n': out += "\\n"; break;
+        case '\t': out += "\\t"; break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20) {
+                out += fmt::format("\\u{:04x}", static_cast<int>(c));
+            } else {
+                out += c;
+            }
+        }
+    }
+    out += '"';
+}
+
+void Logger::telemetry(const std::string& event,
+        std::initializer_list<std::pair<const char*, double>> fields) {
+    auto logger = std::atomic_load(&asyncTelemetryLogger);
+    if (logger == nullptr) {
+        logger = std::atomic_load(&telemetryLogger);
+    }
+    if (logger == nullptr) {
+        return;
+    }
+    static thread_local const std::string threadID = [] {
+        std::ostringstream ss;
+        ss << std::this_thread::get_id();
+        return ss.str();
+    }();
+    const double timestamp = std::chrono::duration<double>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+
+    std::string record = fmt::format("{{\"timestamp\":{:.6f},", timestamp);
+    record += "\"thread\":";
+    appendJSONString(record, threadID);
+    record += ",\"event\":";
+    appendJSONString(record, event);
+    for (const auto& field : fields) {
+        record += ',';
+        appendJSONString(record, field.first);
+        record += ':';
+        if (std::isfinite(field.second)) {
+            record += fmt::format("{}", field.second);
+        } else {
+            record += "null";
+        }
+    }
+    record += '}';
+    logger->log(spdlog::level::info, "{}", record);
+}
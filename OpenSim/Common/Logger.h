@@ -23,10 +23,13 @@
  * -------------------------------------------------------------------------- */
 
 #include "osimCommonDLL.h"
+#include <initializer_list>
+#include <memory>
 #include <set>
 #include <spdlog/spdlog.h>
 #include <spdlog/sinks/basic_file_sink.h>
 #include <string>
+#include <utility>
 #include <spdlog/fmt/ostr.h> 
 
 namespace OpenSim {
@@ -105,42 +108,42 @@ public:
     template <typename... Args>
     static void critical(spdlog::string_view_t fmt, const Args&... args) {
         if (shouldLog(Level::Critical)) {
-            getDefaultLogger().critical(fmt, args...);
+            getDefaultLogger()->critical(fmt, args...);
         }
     }
 
     template <typename... Args>
     static void error(spdlog::string_view_t fmt, const Args&... args) {
         if (shouldLog(Level::Error)) {
-            getDefaultLogger().error(fmt, args...);
+            getDefaultLogger()->error(fmt, args...);
         }
     }
 
     template <typename... Args>
     static void warn(spdlog::string_view_t fmt, const Args&... args) {
         if (shouldLog(Level::Warn)) {
-            getDefaultLogger().warn(fmt, args...);
+            getDefaultLogger()->warn(fmt, args...);
         }
     }
 
     template <typename... Args>
     static void info(spdlog::string_view_t fmt, const Args&... args) {
         if (shouldLog(Level::Info)) {
-            getDefaultLogger().info(fmt, args...);
+            getDefaultLogger()->info(fmt, args...);
         }
     }
 
     template <typename... Args>
     static void debug(spdlog::string_view_t fmt, const Args&... args) {
         if (shouldLog(Level::Debug)) {
-            getDefaultLogger().debug(fmt, args...);
+            getDefaultLogger()->debug(fmt, args...);
         }
     }
 
     template <typename... Args>
     static void trace(spdlog::string_view_t fmt, const Args&... args) {
         if (shouldLog(Level::Trace)) {
-            getDefaultLogger().trace(fmt, args...);
+            getDefaultLogger()->trace(fmt, args...);
         }
     }
 
@@ -153,7 +156,7 @@ public:
     /// give users control over what gets logged.
     template <typename... Args>
     static void cout(spdlog::string_view_t fmt, const Args&... args) {
-        getCoutLogger().log(spdlog::level::info, fmt, args...);
+        getCoutLogger()->log(spdlog::level::info, fmt, args...);
     }
 
     /// @}
@@ -182,9 +185,66 @@ public:
     /// @note This function is not thread-safe. Do not invoke this function
     /// concurrently, or concurrently with addLogFile() or addSink().
     static void removeSink(const std::shared_ptr<LogSink> sink);
+
+    /// @name Asynchronous logging
+    /// By default, messages are formatted and written to the sinks (and the
+    /// log file is flushed) by the thread that logs them. In asynchronous
+    /// mode, messages are instead placed in a queue of at most `queueSize`
+    /// messages and written by a background thread, so that logging does not
+    /// stall the logging thread on I/O (e.g., when many processes write to
+    /// log files on a shared file system). A thread that logs while the queue
+    /// is full waits until there is room in the queue.
+    /// @note These functions are not thread-safe. Do not invoke them
+    /// concurrently with logging or with the functions that add or remove
+    /// sinks.
+    /// @{
+    /// Switch to (or from) asynchronous mode. Switching from asynchronous
+    /// mode waits until all queued messages have been written. Invoking this
+    /// function with the current mode does nothing.
+    static void setAsynchronous(bool asynchronous, int queueSize = 8192);
+    static bool isAsynchronous();
+    /// @}
+
+    /// @name Telemetry
+    /// Telemetry records are machine-readable records of the progress of long
+    /// computations (e.g., the objective at each iteration of
+    /// MocoCasADiSolver, or the time to solve each frame in
+    /// InverseKinematicsTool and AnalyzeTool), for monitoring tools. Each
+    /// record is written to the telemetry file as a single line containing a
+    /// JSON object with the fields "timestamp" (seconds since the epoch),
+    /// "thread" (the ID of the thread that wrote the record), "event", and the
+    /// fields of the record, for example:
+    /// @code{.json}
+    /// {"timestamp":1700000000.123456,"thread":"140232","event":"InverseKinematicsTool.frame","frame":12,"time":0.12,"duration":0.0021}
+    /// @endcode
+    /// Fields whose value is not finite are written as null. Records are not
+    /// written to the other sinks, do not depend on getLevel(), and are
+    /// written asynchronously in asynchronous mode.
+    /// @note These functions, except telemetry(), are not thread-safe, as for
+    /// addFileSink().
+    /// @{
+    /// Write telemetry records to the given file, replacing the file if it
+    /// exists.
+    static void addTelemetryFile(const std::string& filepath);
+    /// Stop writing telemetry records. If there is no telemetry file, this
+    /// does nothing.
+    static void removeTelemetryFile();
+    /// Whether telemetry records are written (i.e., there is a telemetry
+    /// file). Check this before computing the fields of a record.
+    static bool isTelemetryEnabled();
+#ifndef SWIG
+    /// Write a telemetry record. This does nothing if there is no telemetry
+    /// file.
+    static void telemetry(const std::string& event,
+            std::initializer_list<std::pair<const char*, double>> fields);
+#endif
+    /// @}
 private:
-    static spdlog::logger& getCoutLogger();
-    static spdlog::logger& getDefaultLogger();
+    // The loggers are returned by value so that they stay alive while a
+    // message is logged, even if another thread replaces them (see
+    // setAsynchronous()).
+    static std::shared_ptr<spdlog::logger> getCoutLogger();
+    static std::shared_ptr<spdlog::logger> getDefaultLogger();
 };
 
 /// @name Logging functions
@@ -0,0 +1,345 @@
+/* -------------------------------------------------------------------------- *
+ *                           OpenSim: Profiler.cpp                            *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "Profiler.h"
+
+#include "Component.h"
+
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+
+using namespace OpenSim;
+
+std::atomic<bool> Profiler::m_enabled(false);
+
+namespace {
+// A call site in the tree of calls of one thread: a label of a component,
+// called from the parent node (-1 for calls made outside of any timed call).
+struct Node {
+    int parent = -1;
+    const Component* component = nullptr;
+    const char* label = nullptr;
+    std::string type;
+    std::string path;
+    long long numCalls = 0;
+    long long inclusiveTime = 0;
+    long long exclusiveTime = 0;
+};
+
+struct TraceEvent {
+    int node;
+    long long start;
+    long long duration;
+};
+
+// A call in progress.
+struct Frame {
+    int node;
+    long long start;
+    long long childTime;
+};
+
+// Labels are compared by address here; they are string literals, so each
+// call site has one address. Entries with equal label strings are merged when
+// the results are requested.
+using NodeKey = std::tuple<int, const Component*, const char*>;
+
+// The calls recorded on one thread. Only that thread adds to the table, so its
+// mutex is contended only while the results are requested or reset.
+struct ThreadTable {
+    int index = 0;
+    std::mutex mutex;
+    std::vector<Node> nodes;
+    std::map<NodeKey, int> nodeIndices;
+    std::vector<TraceEvent> traceEvents;
+    std::vector<Frame> callStack;
+};
+
+// The tables of all threads that have recorded calls. A table is kept after
+// its thread exits so that its calls are still reported.
+std::mutex tablesMutex;
+std::vector<std::shared_ptr<ThreadTable>> tables;
+long long origin = SimTK::realTimeInNs();
+std::atomic<int> maxTraceEvents(1000000);
+std::atomic<int> numTraceEvents(0);
+
+ThreadTable& getThreadTable() {
+    static thread_local const std::shared_ptr<ThreadTable> table = [] {
+        auto newTable = std::make_shared<ThreadTable>();
+        std::lock_guard<std::mutex> lock(tablesMutex);
+        newTable->index = (int)tables.size();
+        tables.push_back(newTable);
+        return newTable;
+    }();
+    return *table;
+}
+
+// Call visit(table) for the table of each thread while holding its mutex.
+template <typename Visitor>
+void visitTables(Visitor visit) {
+    std::lock_guard<std::mutex> lock(tablesMutex);
+    for (const auto& table : tables) {
+        std::lock_guard<std::mutex> tableLock(table->mutex);
+        visit(*table);
+    }
+}
+
+// Sum the nodes of all threads with the same key. The inclusive time of a
+// node is skipped if an enclosing call has the same key, so that it is not
+// counted twice.
+template <typename Key, typename KeyFunction>
+std::vector<Profiler::Entry> createEntries(
+        bool perInstance, KeyFunction getKey) {
+    std::map<Key, Profiler::Entry> entries;
+    visitTables([&](const ThreadTable& table) {
+        const auto& nodes = table.nodes;
+        for (int i = 0; i < (int)nodes.size(); ++i) {
+            const Node& node = nodes[i];
+            const Key key = getKey(node);
+            auto& entry = entries[key];
+            if (entry.label.empty()) {
+                entry.type = node.type;
+                if (perInstance) entry.path = node.path;
+                entry.label = node.label;
+            }
+            entry.numCalls += node.numCalls;
+            entry.exclusiveTime += SimTK::nsToSec(node.exclusiveTime);
+            bool isRecursive = false;
+            for (int parent = node.parent; parent != -1;
+                    parent = nodes[parent].parent) {
+                if (getKey(nodes[parent]) == key) {
+                    isRecursive = true;
+                    break;
+                }
+            }
+            if (!isRecursive) {
+                entry.inclusiveTime += SimTK::nsToSec(node.inclusiveTime);
+            }
+        }
+    });
+    std::vector<Profiler::Entry> sorted;
+    sorted.reserve(entries.size());
+    for (auto& entry : entries) sorted.push_back(std::move(entry.second));
+    std::stable_sort(sorted.begin(), sorted.end(),
+            [](const Profiler::Entry& a, const Profiler::Entry& b) {
+                return a.exclusiveTime > b.exclusiveTime;
+            });
+    return sorted;
+}
+
+void printEntries(std::ostream& stream,
+        const std::vector<Profiler::Entry>& entries, bool perInstance) {
+    stream << "  exclusive (s)  inclusive (s)       calls  ";
+    stream << (perInstance ? "component" : "type") << std::endl;
+    char buffer[64];
+    for (const auto& entry : entries) {
+        snprintf(buffer, sizeof(buffer), "  %13.6f  %13.6f  %10lld  ",
+                entry.exclusiveTime, entry.inclusiveTime, entry.numCalls);
+        stream << buffer << (perInstance ? entry.path : entry.type) << " "
+               << entry.label << std::endl;
+    }
+}
+
+void appendJSONString(std::string& out, const std::string& value) {
+    out += '"';
+    for (const char c : value) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if ((unsigned char)c < 0x20) {
+            char buffer[8];
+            snprintf(buffer, sizeof(buffer), "\\u%04x", (unsigned char)c);
+            out += buffer;
+        } else {
+            out += c;
+        }
+    }
+    out += '"';
+}
+} // anonymous namespace
+
+void Profiler::setEnabled(bool enabled) {
+    m_enabled = enabled;
+}
+
+void Profiler::reset() {
+    std::lock_guard<std::mutex> lock(tablesMutex);
+    for (const auto& table : tables) {
+        std::lock_guard<std::mutex> tableLock(table->mutex);
+        table->nodes.clear();
+        table->nodeIndices.clear();
+        table->traceEvents.clear();
+        // Calls in progress would refer to deleted nodes.
+        table->callStack.clear();
+    }
+    numTraceEvents = 0;
+    origin = SimTK::realTimeInNs();
+}
+
+void Profiler::setMaxTraceEvents(int maxTraceEvents) {
+    OPENSIM_THROW_IF(maxTraceEvents < 0, Exception,
+            "Expected the maximum number of trace events to be non-negative, "
+            "but got {}.", maxTraceEvents);
+    ::maxTraceEvents = maxTraceEvents;
+}
+
+int Profiler::getMaxTraceEvents() {
+    return maxTraceEvents;
+}
+
+void Profiler::begin(const Component& component, const char* label) {
+    ThreadTable& table = getThreadTable();
+    std::lock_guard<std::mutex> lock(table.mutex);
+    auto& callStack = table.callStack;
+    const int parent = callStack.empty() ? -1 : callStack.back().node;
+    int index;
+    NodeKey key(parent, &component, label);
+    auto it = table.nodeIndices.find(key);
+    if (it == table.nodeIndices.end()) {
+        index = (int)table.nodes.size();
+        table.nodes.emplace_back();
+        Node& node = table.nodes.back();
+        node.parent = parent;
+        node.component = &component;
+        node.label = label;
+        node.type = component.getConcreteClassName();
+        node.path = component.getAbsolutePathString();
+        table.nodeIndices.emplace(key, index);
+    } else {
+        index = it->second;
+    }
+    Frame frame;
+    frame.node = index;
+    frame.childTime = 0;
+    frame.start = SimTK::realTimeInNs();
+    callStack.push_back(frame);
+}
+
+void Profiler::end() {
+    const long long stop = SimTK::realTimeInNs();
+    ThreadTable& table = getThreadTable();
+    std::lock_guard<std::mutex> lock(table.mutex);
+    auto& callStack = table.callStack;
+    // The call stack is empty if reset() was called during this call.
+    if (callStack.empty()) return;
+    const Frame frame = callStack.back();
+    callStack.pop_back();
+    const long long duration = stop - frame.start;
+    Node& node = table.nodes[frame.node];
+    ++node.numCalls;
+    node.inclusiveTime += duration;
+    node.exclusiveTime += duration - frame.childTime;
+    // Only count the events while there is room, so that the counter is not
+    // written by every call once the trace is full.
+    if (numTraceEvents.load(std::memory_order_relaxed) < maxTraceEvents.load(
+                std::memory_order_relaxed) &&
+            numTraceEvents.fetch_add(1, std::memory_order_relaxed) <
+                    maxTraceEvents.load(std::memory_order_relaxed)) {
+        TraceEvent event;
+        event.node = frame.node;
+        event.start = frame.start;
+        event.duration = duration;
+        table.traceEvents.push_back(event);
+    }
+    if (!callStack.empty()) callStack.back().childTime += duration;
+}
+
+std::vector<Profiler::Entry> Profiler::getInstanceEntries() {
+    using Key = std::pair<const Component*, std::string>;
+    return createEntries<Key>(true, [](const Node& node) {
+        return Key(node.component, node.label);
+    });
+}
+
+std::vector<Profiler::Entry> Profiler::getTypeEntries() {
+    using Key = std::pair<std::string, std::string>;
+    return createEntries<Key>(false, [](const Node& node) {
+        return Key(node.type, node.label);
+    });
+}
+
+void Profiler::printSummary(std::ostream& stream) {
+    stream << "Time per component type:" << std::endl;
+    printEntries(stream, getTypeEntries(), false);
+    stream << "Time per component:" << std::endl;
+    printEntries(stream, getInstanceEntries(), true);
+}
+
+void Profiler::printFlameGraph(const std::string& fileName) {
+    std::ofstream stream(fileName);
+    OPENSIM_THROW_IF(!stream.good(), Exception,
+            "Could not open file '{}'.", fileName);
+    // The same call stack may have been recorded on several threads.
+    std::map<std::string, long long> exclusiveTimes;
+    visitTables([&](const ThreadTable& table) {
+        const auto& nodes = table.nodes;
+        std::vector<std::string> stacks(nodes.size());
+        for (int i = 0; i < (int)nodes.size(); ++i) {
+            const Node& node = nodes[i];
+            // Parents are created before their children.
+            if (node.parent != -1) stacks[i] = stacks[node.parent] + ";";
+            stacks[i] += node.path + " " + node.label + " (" + node.type + ")";
+            exclusiveTimes[stacks[i]] += node.exclusiveTime;
+        }
+    });
+    for (const auto& stack : exclusiveTimes) {
+        const long long microseconds = stack.second / 1000;
+        if (microseconds > 0) {
+            stream << stack.first << " " << microseconds << "\n";
+        }
+    }
+}
+
+void Profiler::printChromeTrace(const std::string& fileName) {
+    std::ofstream stream(fileName);
+    OPENSIM_THROW_IF(!stream.good(), Exception,
+            "Could not open file '{}'.", fileName);
+    stream << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    std::string record;
+    char buffer[128];
+    bool first = true;
+    visitTables([&](const ThreadTable& table) {
+        for (const TraceEvent& event : table.traceEvents) {
+            const Node& node = table.nodes[event.node];
+            record = first ? "\n{\"name\":" : ",\n{\"name\":";
+            first = false;
+            appendJSONString(record, node.label);
+            record += ",\"cat\":";
+            appendJSONString(record, node.type);
+            snprintf(buffer, sizeof(buffer),
+                    ",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":0,"
+                    "\"tid\":%d",
+                    1e-3 * (event.start - origin), 1e-3 * event.duration,
+                    table.index);
+            record += buffer;
+            record += ",\"args\":{\"path\":";
+            appendJSONString(record, node.path);
+            record += "}}";
+            stream << record;
+        }
+    });
+    stream << "\n]}\n";
+}
@@ -0,0 +1,161 @@
+#ifndef OPENSIM_PROFILER_H_
+#define OPENSIM_PROFILER_H_
+/* -------------------------------------------------------------------------- *
+ *                            OpenSim: Profiler.h                             *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "osimCommonDLL.h"
+
+#include <atomic>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace OpenSim {
+
+class Component;
+
+/** Record where the time of a simulation is spent, per component. When the
+profiler is enabled, each realization stage of each component
+(extendRealizeTopology(), ..., extendRealizeReport()), each call to
+Force::computeForce(), Controller::computeControls() and
+GeometryPath::computePath(), and each calculation of the cached muscle
+quantities (e.g., Muscle::calcMuscleLengthInfo()) is timed, along with the
+timed calls it makes (e.g., the GeometryPath of a muscle computing its path
+while the muscle computes its force). The profiler is disabled by default, in
+which case timing a call costs only a check of a flag.
+
+For each call, the profiler accumulates the number of calls, the inclusive time
+(all time spent in the call) and the exclusive time (the inclusive time minus
+the time spent in the timed calls it makes). The results are available per
+component instance (getInstanceEntries()), per component type
+(getTypeEntries()), as a printed summary (printSummary()), as folded stacks for
+flame graph tools (printFlameGraph()), and as a trace that can be opened in
+Chrome's about:tracing page or in Perfetto (printChromeTrace()).
+
+@code
+Profiler::setEnabled(true);
+Manager manager(model);
+manager.initialize(state);
+manager.integrate(1.0);
+Profiler::setEnabled(false);
+Profiler::printSummary(std::cout);
+Profiler::printChromeTrace("simulation_trace.json");
+@endcode
+
+The profiler is shared by all models and threads, and calls are identified by
+the address of the component, so call reset() before profiling a model that is
+created after an earlier model has been deleted. Times are wall-clock times.
+Each thread records its calls in its own tables, which are merged only when
+the results are requested, and its calls appear as a separate thread in the
+trace. reset() also discards the calls in progress on all threads.
+
+opensim-cmd run-tool profiles a tool with the --profile option. */
+class OSIMCOMMON_API Profiler {
+public:
+    /// The calls of one kind (e.g., "computeForce") made by a component or by
+    /// all components of a type.
+    struct Entry {
+        /// The concrete class name of the component.
+        std::string type;
+        /// The absolute path of the component; empty for the entries of
+        /// getTypeEntries().
+        std::string path;
+        /// The kind of call, e.g., "realizePosition" or "computeForce".
+        std::string label;
+        long long numCalls = 0;
+        /// Time in seconds.
+        double inclusiveTime = 0;
+        /// Time in seconds.
+        double exclusiveTime = 0;
+    };
+
+    /// Time a call made by a component while this object exists, if the
+    /// profiler is enabled. The label must outlive the Scope (e.g., a string
+    /// literal).
+    /// @code
+    /// void MyForce::computeForce(...) const {
+    ///     // computeForce() is timed already; time part of it.
+    ///     Profiler::Scope scope(*this, "computeContactForces");
+    ///     ...
+    /// }
+    /// @endcode
+    class Scope {
+    public:
+        Scope(const Component& component, const char* label) {
+            if (isEnabled()) {
+                Profiler::begin(component, label);
+                m_active = true;
+            }
+        }
+        ~Scope() {
+            if (m_active) Profiler::end();
+        }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    private:
+        bool m_active = false;
+    };
+
+    /// Start or stop recording calls. Recorded calls are kept when the
+    /// profiler is disabled.
+    static void setEnabled(bool enabled);
+    static bool isEnabled() {
+        return m_enabled.load(std::memory_order_relaxed);
+    }
+    /// Discard all recorded calls.
+    static void reset();
+
+    /// The maximum number of calls kept for printChromeTrace() (default:
+    /// 1000000); later calls are still included in the entries. Set to 0 to
+    /// record no trace.
+    static void setMaxTraceEvents(int maxTraceEvents);
+    static int getMaxTraceEvents();
+
+    /// One entry per component and label, sorted by decreasing exclusive
+    /// time.
+    static std::vector<Entry> getInstanceEntries();
+    /// One entry per component type and label, sorted by decreasing
+    /// exclusive time.
+    static std::vector<Entry> getTypeEntries();
+
+    /// Print a table of the entries per type followed by the entries per
+    /// component.
+    static void printSummary(std::ostream& stream);
+    /// Print the recorded calls in the "folded stacks" format read by flame
+    /// graph tools (e.g., flamegraph.pl and speedscope): one line per call
+    /// stack, with frames "<path> <label> (<type>)" separated by semicolons,
+    /// followed by the exclusive time in microseconds.
+    static void printFlameGraph(const std::string& fileName);
+    /// Print the recorded calls in the Trace Event Format (JSON) read by
+    /// about:tracing in Chrome and by Perfetto.
+    static void printChromeTrace(const std::string& fileName);
+
+private:
+    static void begin(const Component& component, const char* label);
+    static void end();
+
+    static std::atomic<bool> m_enabled;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_PROFILER_H_
@@ -25,13 +25,95 @@
 //============================================================================
 #include "Property.h"
 #include "Object.h"
+#include <cctype>
+#include <clocale>
+#include <cstdlib>
 #include <string>
 
+#ifdef __APPLE__
+    #include <xlocale.h>
+#endif
+
 
 using namespace OpenSim;
 using namespace SimTK;
 using namespace std;
 
+//=============================================================================
+// READING HELPERS
+//=============================================================================
+namespace {
+// std::strtod() uses the decimal point of the global C locale (e.g., ',' in
+// de_DE), but property values are always written with '.', so parse with the
+// "C" locale.
+#ifdef _WIN32
+double strtodC(const char* str, char** end) {
+    static const _locale_t cLocale = _create_locale(LC_NUMERIC, "C");
+    return _strtod_l(str, end, cLocale);
+}
+#else
+double strtodC(const char* str, char** end) {
+    static const locale_t cLocale =
+            newlocale(LC_NUMERIC_MASK, "C", static_cast<locale_t>(0));
+    return strtod_l(str, end, cLocale);
+}
+#endif
+
+// Compare a token to a lowercase word, ignoring case.
+bool equalsIgnoringCase(const char* begin, const char* end, const char* word) {
+    for (; begin != end; ++begin, ++word) {
+        if (*word == '\0' ||
+                std::tolower(static_cast<unsigned char>(*begin)) != *word)
+            return false;
+    }
+    return *word == '\0';
+}
+
+// Parse a token the way SimTK::readUnformatted() does: a decimal number, or
+// NaN or (optionally signed) Inf or Infinity in any case. Hexadecimal numbers
+// and "nan(...)", which std::strtod() would accept, are rejected.
+bool parseDouble(const char* begin, const char* end, double& value) {
+    const char* word = begin;
+    if (*word == '+' || *word == '-') ++word;
+    if (equalsIgnoringCase(word, end, "inf") ||
+            equalsIgnoringCase(word, end, "infinity")) {
+        value = *begin == '-' ? -SimTK::Infinity : SimTK::Infinity;
+        return true;
+    }
+    if (equalsIgnoringCase(begin, end, "nan")) {
+        value = SimTK::NaN;
+        return true;
+    }
+    for (const char* c = begin; c != end; ++c) {
+        if (!std::isdigit(static_cast<unsigned char>(*c)) && *c != '.' &&
+                *c != 'e' && *c != 'E' && *c != '+' && *c != '-')
+            return false;
+    }
+    char* next = nullptr;
+    value = strtodC(begin, &next);
+    // The token must be a number in its entirety.
+    return next == end;
+}
+} // anonymous namespace
+
+bool OpenSim::readDoublesFromString(const std::string& str,
+                                    SimTK::Array_<double, int>& values) {
+    const char* p = str.c_str();
+    const char* const end = p + str.size();
+    while (true) {
+        while (p != end && std::isspace(static_cast<unsigned char>(*p))) ++p;
+        if (p == end) return true;
+        const char* tokenEnd = p;
+        while (tokenEnd != end &&
+                !std::isspace(static_cast<unsigned char>(*tokenEnd)))
+            ++tokenEnd;
+        double value;
+        if (!parseDouble(p, tokenEnd, value)) return false;
+        values.push_back(value);
+        p = tokenEnd;
+    }
+}
+
 //=============================================================================
 // TYPE HELPER SPECIALIZATIONS
 //=============================================================================
@@ -702,6 +702,39 @@ Property<T>::getTypeName() const {
 // to know about these.
 /** @cond **/
 
+//==============================================================================
+//                  HELPERS FOR READING PROPERTY VALUES
+//==============================================================================
+#ifndef SWIG
+
+/** Parse the blank-separated numbers in `str` and append them to `values`.
+The numbers are parsed as SimTK::readUnformatted() parses them, independent
+of the locale: '.' is the decimal point, and NaN and infinity are
+recognized in any case (e.g., "NaN", "-Inf", "infinity").
+Returns false if `str` contains a token that is not a number; `values` may
+then contain the numbers preceding that token. **/
+OSIMCOMMON_API bool readDoublesFromString(const std::string& str,
+                                          SimTK::Array_<double, int>& values);
+
+/** Parse the blank-separated numbers in `str` into `values`, M numbers per
+element. Returns false if a token is not a number or if the number of
+tokens is not a multiple of M. **/
+template <int M> inline bool
+readVecsFromString(const std::string& str,
+                   SimTK::Array_<SimTK::Vec<M>, int>& values)
+{
+    SimTK::Array_<double, int> flat;
+    values.clear();
+    if (!readDoublesFromString(str, flat) || flat.size() % M != 0)
+        return false;
+    values.reserve(flat.size() / M);
+    for (int i = 0; i < flat.size(); i += M)
+        values.push_back(SimTK::Vec<M>::getAs(&flat[i]));
+    return true;
+}
+
+#endif
+
 //==============================================================================
 //                  HELPERS FOR WRITING PROPERTY VALUES 
 //==============================================================================
@@ -881,18 +914,18 @@ public:
     void readFromXMLElement
        (SimTK::Xml::Element& propertyElement,
         int                  versionNumber) override final {
-        std::istringstream valstream(propertyElement.getValue());
+        const std::string& valstring = propertyElement.getValue();
 
         // read the values _transactionally_: if a read failure occurs then
         // `values` should return to their original state (#3409)
         SimTK::Array_<T, int> valuesBackup = values;
         bool shouldRollback = false;
 
-        if (!readSimplePropertyFromStream(valstream)) {
+        if (!readSimplePropertyFromString(valstring)) {
             log_warn("Failed to read '{}': property '{}' with input '{}': the data has been ignored",
                 SimTK::NiceTypeName<T>::name(),
                 this->getName(),
-                valstream.str().substr(0, 50)  // limit displayed length
+                valstring.substr(0, 50)  // limit displayed length
             );
             shouldRollback = true;
         }
@@ -900,7 +933,7 @@ public:
             log_warn("Failed to read '{}': property '{}' with input '{}': does not contain enough values (minimum: {}, got: {}): the data (all fields) have been ignored",
                 SimTK::NiceTypeName<T>::name(),
                 this->getName(),
-                valstream.str().substr(0,50),  // limit displayed length
+                valstring.substr(0,50),  // limit displayed length
                 this->getMinListSize(),
                 values.size()
             );
@@ -910,7 +943,7 @@ public:
             log_warn("Truncated '{}': property '{}' with input '{}': contains too many values (maximum: {}, got: {}): the data has been truncated",
                 SimTK::NiceTypeName<T>::name(),
                 this->getName(),
-                valstream.str().substr(0,50),  // limit displayed length
+                valstring.substr(0,50),  // limit displayed length
                 this->getMaxListSize(),
                 values.size()
             );
@@ -998,6 +1031,15 @@ private:
         delete valuep; // throw out the old one
         return values.size()-1; }
 
+    // This is the default implementation, which parses the string with
+    // readSimplePropertyFromStream(); specializations for numeric types
+    // parse the string directly since stream-based parsing dominates the
+    // cost of reading large models.
+    bool readSimplePropertyFromString(const std::string& str) {
+        std::istringstream in(str);
+        return readSimplePropertyFromStream(in);
+    }
+
     // This is the default implementation; specialization is required if
     // the Simbody default behavior is different than OpenSim's; e.g. for
     // Transform serialization.
@@ -1054,6 +1096,29 @@ writeSimplePropertyToStream(std::ostream& o) const
     SimTK::writeUnformatted(o, rotTrans);
 }
 
+// Numeric properties are read without going through a stream. Vec3 and Vec6
+// values are read as a flat list of blank-separated numbers, as
+// SimTK::readUnformatted() does.
+
+template <> inline bool SimpleProperty<double>::
+readSimplePropertyFromString(const std::string& str)
+{
+    values.clear();
+    return readDoublesFromString(str, values);
+}
+
+template <> inline bool SimpleProperty<SimTK::Vec3>::
+readSimplePropertyFromString(const std::string& str)
+{
+    return readVecsFromString(str, values);
+}
+
+template <> inline bool SimpleProperty<SimTK::Vec6>::
+readSimplePropertyFromString(const std::string& str)
+{
+    return readVecsFromString(str, values);
+}
+
 // We have to provide specializations for string because we want to ignore white space
 // if the property allows only one value
 template<> inline bool SimpleProperty<std::string>::
@@ -156,6 +156,27 @@ protected:
     called from a derived class constructor. **/
     Reporter() = default;
     virtual ~Reporter() = default;
+
+    /** The channels connected to the "inputs" Input, in order, for
+    evaluating all of them at once in implementReport(). This is rebuilt
+    whenever the connections are finalized. */
+    const ChannelArray<InputT>& getInputChannels() const {
+        return _inputChannels;
+    }
+
+    void extendFinalizeConnections(Component& root) override {
+        Super::extendFinalizeConnections(root);
+        const auto& input = this->template getInput<InputT>("inputs");
+        _inputChannels.clear();
+        for (auto idx = 0u; idx < input.getNumConnectees(); ++idx) {
+            _inputChannels.append(input.getChannel(idx));
+        }
+    }
+
+private:
+    // The channels refer to outputs of the components of this reporter's
+    // model, so a copy must connect to the outputs of its own model.
+    SimTK::ResetOnCopy<ChannelArray<InputT>> _inputChannels;
     //=============================================================================
 };  // END of class Reporter<InputT>
     //=============================================================================
@@ -204,18 +225,10 @@ public:
 
 protected:
     void implementReport(const SimTK::State& state) const override {
-        const auto& input = this->template getInput<InputT>("inputs");
-        SimTK::RowVector_<ValueT> result;
-        result.resize(int(input.getNumConnectees()));
-
-        for (auto idx = 0u; idx < input.getNumConnectees(); ++idx) {
-              const auto& chan = input.getChannel(idx);
-              const auto& value = chan.getValue(state);
-              result[idx] = value;
-        }
+        this->getInputChannels().evaluate(state, _row);
         try {
             const_cast<Self*>(this)->_outputTable.appendRow(state.getTime(),
-                                                            result);
+                                                            _row);
         } catch(const InvalidTimestamp& exception) {
             OPENSIM_THROW(Exception,
                           "Attempting to update reporter with rows having "
@@ -251,6 +264,9 @@ private:
     // We write to this table in const methods, but only because we ensure
     // those const methods are never called with trial integrator states.
     TimeSeriesTable_<ValueT> _outputTable;
+    // The values of the channels at the current report, reused across
+    // reports.
+    mutable SimTK::RowVector_<ValueT> _row;
 };
 
 /** A reporter that simply prints quantities to the console
@@ -277,18 +293,18 @@ private:
             const_cast<ConsoleReporter_<T>*>(this)->_printCount = 0;
         }
 
-        // Find the length of the longest label.
-        int lengthOfLongestLabel = 0;
-        for (auto idx = 0u; idx < input.getNumConnectees(); ++idx) {
-            lengthOfLongestLabel = std::max(
-                    lengthOfLongestLabel,
-                                    (int)input.getLabel(idx).size());
-        }
-
         // Periodically display column headers.
         if (_printCount % 40 == 0) {
             log_cout("[{}]", this->getName());
 
+            // Find the length of the longest label.
+            int lengthOfLongestLabel = 0;
+            for (auto idx = 0u; idx < input.getNumConnectees(); ++idx) {
+                lengthOfLongestLabel = std::max(
+                        lengthOfLongestLabel,
+                                        (int)input.getLabel(idx).size());
+            }
+
             // Split labels over multiple lines.
             // Round up to the nearest multiple of _width to determine the
             // number of header rows.
@@ -326,12 +342,14 @@ private:
         // TODO set width based on number of significant digits.
         std::string msg;
         msg += fmt::format("{:>{}}| ", state.getTime(), _width);
-        for (const auto& chan : input.getChannels()) {
-            const auto& value = chan->getValue(state);
-            const auto& nSigFigs = chan->getOutput().getNumberOfSignificantDigits();
+        const auto& channels = this->getInputChannels();
+        channels.evaluate(state, _values);
+        for (int idx = 0; idx < channels.size(); ++idx) {
+            const auto& nSigFigs = channels.getChannel(idx).getOutput()
+                                           .getNumberOfSignificantDigits();
             // Print `value` right-justified in a column with width `_width`,
             // using `nSigFigs`: {:>{_width}.{nSigFigs}g}
-            msg += fmt::format("{:>{}.{}g}| ", value, _width, nSigFigs);
+            msg += fmt::format("{:>{}.{}g}| ", _values[idx], _width, nSigFigs);
         }
         log_cout(msg);
 
@@ -340,6 +358,8 @@ private:
 
     unsigned int _printCount = 0;
     int _width = 14;
+    // The values of the channels at the current report.
+    mutable SimTK::RowVector_<T> _values;
 };
 
 // specialization where InputT is Vector_<T> and ValueT is Real
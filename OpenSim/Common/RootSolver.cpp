@@ -86,6 +86,24 @@ setNull()
 Array<double> RootSolver::
 solve(const SimTK::State& s, const Array<double> &ax,const Array<double> &bx,
         const Array<double> &tol)
+{
+    int N = _function->getNX();
+    Array<double> fa(0.0,N),fb(0.0,N);
+    _function->evaluate(s,ax,fa);
+    _function->evaluate(s,bx,fb);
+    return solve(s,ax,bx,fa,fb,tol);
+}
+//_____________________________________________________________________________
+/**
+ * Solve for the roots given the function values at the bracket end points,
+ * fax = f(ax) and fbx = f(bx).  The function is not evaluated at ax or bx,
+ * so the result is the same as that of solve(s,ax,bx,tol) but with two
+ * fewer function evaluations.
+ */
+Array<double> RootSolver::
+solve(const SimTK::State& s, const Array<double> &ax,const Array<double> &bx,
+        const Array<double> &fax,const Array<double> &fbx,
+        const Array<double> &tol)
 {
     int i;
     int N = _function->getNX();
@@ -105,8 +123,8 @@ solve(const SimTK::State& s, const Array<double> &ax,const Array<double> &bx,
     // INITIALIZATIONS
     a = ax;
     b = bx;
-    _function->evaluate(s,a,fa);
-    _function->evaluate(s,b,fb);
+    fa = fax;
+    fb = fbx;
     c = a;
     fc = fa;
 
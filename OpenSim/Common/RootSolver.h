@@ -89,6 +89,13 @@ private:
 public:
     Array<double> solve(const SimTK::State& s, const Array<double> &ax,const Array<double> &bx,
         const Array<double> &tol);
+    /** Same as the solve() above, but the caller supplies the function
+    values at the bracket end points, fax = f(ax) and fbx = f(bx). This
+    avoids two evaluations of the function when the caller has already
+    computed them (e.g., while determining the bracket). */
+    Array<double> solve(const SimTK::State& s, const Array<double> &ax,const Array<double> &bx,
+        const Array<double> &fax,const Array<double> &fbx,
+        const Array<double> &tol);
 
 //=============================================================================
 };  // END class RootSolver
@@ -0,0 +1,265 @@
+/* -------------------------------------------------------------------------- *
+ *                       OpenSim:  RotationKernels.cpp                        *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "RotationKernels.h"
+
+#include <cmath>
+#include <limits>
+
+using namespace OpenSim;
+
+// Each kernel is a loop over arrays passed as separate pointers. The
+// pointers are declared __restrict (supported by GCC, Clang and MSVC) to
+// promise the compiler that the arrays do not overlap, so that it vectorizes
+// the loops without checking for overlap at run time.
+#define OSIM_RESTRICT __restrict
+
+namespace {
+
+void normalizeKernel(size_t n, double* OSIM_RESTRICT w,
+        double* OSIM_RESTRICT x, double* OSIM_RESTRICT y,
+        double* OSIM_RESTRICT z) {
+    const double epsilon = std::numeric_limits<double>::epsilon();
+    for (size_t i = 0; i < n; ++i) {
+        const double norm =
+                std::sqrt(w[i] * w[i] + x[i] * x[i] + y[i] * y[i] + z[i] * z[i]);
+        // As in SimTK::Quaternion::normalizeThis(); the comparisons are false
+        // for NaN, so NaN propagates. The division is done unconditionally so
+        // that the branches only select values.
+        const double inverse = 1 / norm;
+        const bool isZero = norm == 0;
+        const double scale = isZero ? 0
+                           : norm < epsilon ? SimTK::NaN : inverse;
+        w[i] = isZero ? 1 : w[i] * scale;
+        x[i] *= scale;
+        y[i] *= scale;
+        z[i] *= scale;
+    }
+}
+
+void rotateKernel(size_t n, const double rw, const double rx, const double ry,
+        const double rz, double* OSIM_RESTRICT w, double* OSIM_RESTRICT x,
+        double* OSIM_RESTRICT y, double* OSIM_RESTRICT z) {
+    for (size_t i = 0; i < n; ++i) {
+        // The quaternion product qR * q is the quaternion of R * Rotation(q).
+        const double pw = rw * w[i] - rx * x[i] - ry * y[i] - rz * z[i];
+        const double px = rw * x[i] + rx * w[i] + ry * z[i] - rz * y[i];
+        const double py = rw * y[i] - rx * z[i] + ry * w[i] + rz * x[i];
+        const double pz = rw * z[i] + rx * y[i] - ry * x[i] + rz * w[i];
+        // q and -q are the same rotation; keep the scalar part non-negative.
+        // The product of unit quaternions is a unit quaternion, but
+        // renormalize to avoid accumulating roundoff.
+        const double norm = std::sqrt(pw * pw + px * px + py * py + pz * pz);
+        const double scale = (pw < 0 ? -1 : 1) / norm;
+        w[i] = pw * scale;
+        x[i] = px * scale;
+        y[i] = py * scale;
+        z[i] = pz * scale;
+    }
+}
+
+void quaternionsToRotationsKernel(size_t n, const double* OSIM_RESTRICT w,
+        const double* OSIM_RESTRICT x, const double* OSIM_RESTRICT y,
+        const double* OSIM_RESTRICT z, double* OSIM_RESTRICT R00,
+        double* OSIM_RESTRICT R01, double* OSIM_RESTRICT R02,
+        double* OSIM_RESTRICT R10, double* OSIM_RESTRICT R11,
+        double* OSIM_RESTRICT R12, double* OSIM_RESTRICT R20,
+        double* OSIM_RESTRICT R21, double* OSIM_RESTRICT R22) {
+    for (size_t i = 0; i < n; ++i) {
+        // As in SimTK::Rotation::setRotationFromQuaternion().
+        const double ww = w[i] * w[i], xx = x[i] * x[i];
+        const double yy = y[i] * y[i], zz = z[i] * z[i];
+        const double wx = w[i] * x[i], wy = w[i] * y[i], wz = w[i] * z[i];
+        const double xy = x[i] * y[i], xz = x[i] * z[i], yz = y[i] * z[i];
+        R00[i] = ww + xx - yy - zz;
+        R01[i] = 2 * (xy - wz);
+        R02[i] = 2 * (xz + wy);
+        R10[i] = 2 * (xy + wz);
+        R11[i] = ww - xx + yy - zz;
+        R12[i] = 2 * (yz - wx);
+        R20[i] = 2 * (xz - wy);
+        R21[i] = 2 * (yz + wx);
+        R22[i] = ww - xx - yy + zz;
+    }
+}
+
+void rotationsToQuaternionsKernel(size_t n, const double* OSIM_RESTRICT R00,
+        const double* OSIM_RESTRICT R01, const double* OSIM_RESTRICT R02,
+        const double* OSIM_RESTRICT R10, const double* OSIM_RESTRICT R11,
+        const double* OSIM_RESTRICT R12, const double* OSIM_RESTRICT R20,
+        const double* OSIM_RESTRICT R21, const double* OSIM_RESTRICT R22,
+        double* OSIM_RESTRICT w, double* OSIM_RESTRICT x,
+        double* OSIM_RESTRICT y, double* OSIM_RESTRICT z) {
+    for (size_t i = 0; i < n; ++i) {
+        // As in SimTK::Rotation::convertRotationToQuaternion(), which uses
+        // the largest of the trace and the diagonal elements for accuracy.
+        // The branches only select values, and the conditions use & rather
+        // than && to avoid short-circuit branches, so the loop vectorizes.
+        const double tr = R00[i] + R11[i] + R22[i];
+        const bool useTrace = (tr >= R00[i]) & (tr >= R11[i]) & (tr >= R22[i]);
+        const bool use0 =
+                !useTrace & (R00[i] >= R11[i]) & (R00[i] >= R22[i]);
+        const bool use1 = !useTrace & !use0 & (R11[i] >= R22[i]);
+        const double d21 = R21[i] - R12[i], s21 = R21[i] + R12[i];
+        const double d02 = R02[i] - R20[i], s02 = R02[i] + R20[i];
+        const double d10 = R10[i] - R01[i], s10 = R10[i] + R01[i];
+        const double diag0 = 1 - (tr - 2 * R00[i]);
+        const double diag1 = 1 - (tr - 2 * R11[i]);
+        const double diag2 = 1 - (tr - 2 * R22[i]);
+        const double qw = useTrace ? 1 + tr : use0 ? d21 : use1 ? d02 : d10;
+        const double qx = useTrace ? d21 : use0 ? diag0 : use1 ? s10 : s02;
+        const double qy = useTrace ? d02 : use0 ? s10 : use1 ? diag1 : s21;
+        const double qz = useTrace ? d10 : use0 ? s02 : use1 ? s21 : diag2;
+        const double norm = std::sqrt(qw * qw + qx * qx + qy * qy + qz * qz);
+        const double scale = (qw < 0 ? -1 : 1) / norm;
+        w[i] = qw * scale;
+        x[i] = qx * scale;
+        y[i] = qy * scale;
+        z[i] = qz * scale;
+    }
+}
+
+void rotationsToBodyFixedXYZKernel(size_t n, const double* OSIM_RESTRICT R00,
+        const double* OSIM_RESTRICT R01, const double* OSIM_RESTRICT R02,
+        const double* OSIM_RESTRICT R10, const double* OSIM_RESTRICT R11,
+        const double* OSIM_RESTRICT R12, const double* OSIM_RESTRICT R20,
+        const double* OSIM_RESTRICT R21, const double* OSIM_RESTRICT R22,
+        double* OSIM_RESTRICT ax, double* OSIM_RESTRICT ay,
+        double* OSIM_RESTRICT az) {
+    const double tol = 4 * SimTK::Eps;
+    // This loop vectorizes only with a vector math library that provides
+    // atan2(), but still avoids constructing a SimTK::Rotation per element.
+    for (size_t i = 0; i < n; ++i) {
+        // As in SimTK::Rotation::convertThreeAxesRotationToThreeAngles().
+        // cosY = |cos(y)| is computed from four elements for accuracy.
+        const double cosY = std::sqrt((R00[i] * R00[i] + R01[i] * R01[i] +
+                                       R12[i] * R12[i] + R22[i] * R22[i]) / 2);
+        ay[i] = std::atan2(R02[i], cosY);
+        if (cosY > tol) {
+            ax[i] = std::atan2(-R12[i], R22[i]);
+            az[i] = std::atan2(-R01[i], R00[i]);
+        } else if (R02[i] > 0) {
+            // Gimbal lock at y = pi/2: only x + z is defined.
+            ax[i] = std::atan2(R10[i] + R21[i], R11[i] - R20[i]);
+            az[i] = 0;
+        } else {
+            // Gimbal lock at y = -pi/2: only x - z is defined.
+            ax[i] = std::atan2(R21[i] - R10[i], R11[i] + R20[i]);
+            az[i] = 0;
+        }
+    }
+}
+
+}
+
+void RotationKernels::normalize(QuaternionArrays& q) {
+    normalizeKernel(q.size(), q.w.data(), q.x.data(), q.y.data(), q.z.data());
+}
+
+void RotationKernels::rotate(const SimTK::Rotation& R, QuaternionArrays& q) {
+    normalize(q);
+    const SimTK::Quaternion qR = R.convertRotationToQuaternion();
+    rotateKernel(q.size(), qR[0], qR[1], qR[2], qR[3], q.w.data(), q.x.data(),
+            q.y.data(), q.z.data());
+}
+
+void RotationKernels::convertQuaternionsToRotations(
+        const QuaternionArrays& q, RotationMatrixArrays& R) {
+    R.resize(q.size());
+    quaternionsToRotationsKernel(q.size(), q.w.data(), q.x.data(), q.y.data(),
+            q.z.data(), R.m[0].data(), R.m[1].data(), R.m[2].data(),
+            R.m[3].data(), R.m[4].data(), R.m[5].data(), R.m[6].data(),
+            R.m[7].data(), R.m[8].data());
+}
+
+void RotationKernels::convertRotationsToQuaternions(
+        const RotationMatrixArrays& R, QuaternionArrays& q) {
+    q.resize(R.size());
+    rotationsToQuaternionsKernel(R.size(), R.m[0].data(), R.m[1].data(),
+            R.m[2].data(), R.m[3].data(), R.m[4].data(), R.m[5].data(),
+            R.m[6].data(), R.m[7].data(), R.m[8].data(), q.w.data(),
+            q.x.data(), q.y.data(), q.z.data());
+}
+
+void RotationKernels::convertRotationsToBodyFixedXYZ(
+        const RotationMatrixArrays& R, AngleArrays& angles) {
+    angles.resize(R.size());
+    rotationsToBodyFixedXYZKernel(R.size(), R.m[0].data(), R.m[1].data(),
+            R.m[2].data(), R.m[3].data(), R.m[4].data(), R.m[5].data(),
+            R.m[6].data(), R.m[7].data(), R.m[8].data(), angles.x.data(),
+            angles.y.data(), angles.z.data());
+}
+
+void RotationKernels::loadColumn(
+        const SimTK::MatrixBase<SimTK::Quaternion>& matrix, int column,
+        QuaternionArrays& q) {
+    const int n = matrix.nrow();
+    q.resize(n);
+    for (int i = 0; i < n; ++i) {
+        const SimTK::Quaternion& elt = matrix(i, column);
+        q.w[i] = elt[0];
+        q.x[i] = elt[1];
+        q.y[i] = elt[2];
+        q.z[i] = elt[3];
+    }
+}
+
+void RotationKernels::loadColumn(
+        const SimTK::MatrixBase<SimTK::Rotation>& matrix, int column,
+        RotationMatrixArrays& R) {
+    const int n = matrix.nrow();
+    R.resize(n);
+    for (int i = 0; i < n; ++i) {
+        const SimTK::Mat33& elt = matrix(i, column).asMat33();
+        for (int k = 0; k < 9; ++k) R.m[k][i] = elt(k / 3, k % 3);
+    }
+}
+
+void RotationKernels::storeColumn(const QuaternionArrays& q, int column,
+        SimTK::MatrixBase<SimTK::Quaternion>& matrix) {
+    const int n = (int)q.size();
+    for (int i = 0; i < n; ++i) {
+        // The quaternions are already normalized.
+        matrix.updElt(i, column) = SimTK::Quaternion(
+                SimTK::Vec4(q.w[i], q.x[i], q.y[i], q.z[i]), true);
+    }
+}
+
+void RotationKernels::storeColumn(const RotationMatrixArrays& R, int column,
+        SimTK::MatrixBase<SimTK::Rotation>& matrix) {
+    const int n = (int)R.size();
+    SimTK::Mat33 elt;
+    for (int i = 0; i < n; ++i) {
+        for (int k = 0; k < 9; ++k) elt(k / 3, k % 3) = R.m[k][i];
+        // The matrices are already orthonormal.
+        matrix.updElt(i, column).setRotationFromMat33TrustMe(elt);
+    }
+}
+
+void RotationKernels::storeColumn(const AngleArrays& angles, int column,
+        SimTK::MatrixBase<SimTK::Vec3>& matrix) {
+    const int n = (int)angles.size();
+    for (int i = 0; i < n; ++i) {
+        matrix.updElt(i, column) =
+                SimTK::Vec3(angles.x[i], angles.y[i], angles.z[i]);
+    }
+}
@@ -0,0 +1,121 @@
+#ifndef OPENSIM_ROTATION_KERNELS_H_
+#define OPENSIM_ROTATION_KERNELS_H_
+/* -------------------------------------------------------------------------- *
+ *                        OpenSim:  RotationKernels.h                         *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "osimCommonDLL.h"
+#include <SimTKcommon.h>
+#include <vector>
+
+namespace OpenSim {
+
+/** Quaternions stored as a structure of arrays: quaternion i is
+(w[i], x[i], y[i], z[i]), where w is the scalar part, as in
+SimTK::Quaternion. */
+struct QuaternionArrays {
+    std::vector<double> w, x, y, z;
+    void resize(size_t n) {
+        w.resize(n);
+        x.resize(n);
+        y.resize(n);
+        z.resize(n);
+    }
+    size_t size() const { return w.size(); }
+};
+
+/** Rotation matrices stored as a structure of arrays: element (r, c) of
+matrix i is m[3 * r + c][i]. */
+struct RotationMatrixArrays {
+    std::vector<double> m[9];
+    void resize(size_t n) {
+        for (auto& elt : m) elt.resize(n);
+    }
+    size_t size() const { return m[0].size(); }
+};
+
+/** Three angles (e.g., Euler angles) stored as a structure of arrays. */
+struct AngleArrays {
+    std::vector<double> x, y, z;
+    void resize(size_t n) {
+        x.resize(n);
+        y.resize(n);
+        z.resize(n);
+    }
+    size_t size() const { return x.size(); }
+};
+
+/** Operations on whole columns of orientations at once, for converting tables
+of sensor orientations. Each kernel applies the same operation to every
+element of its input arrays, which are stored as a structure of arrays (one
+array per component) so that the compiler can vectorize the loops. The results
+agree with the corresponding SimTK::Rotation and SimTK::Quaternion operations
+on each element to within roundoff.
+
+Use the load and store functions to move a column of a SimTK::Matrix_ (e.g.,
+the matrix of a TimeSeriesTable_) into and out of the arrays. */
+class OSIMCOMMON_API RotationKernels {
+public:
+    /// @name Kernels
+    /// @{
+    /** Normalize each quaternion, as SimTK::Quaternion does on construction:
+    quaternions with zero norm become the identity, and quaternions with a
+    norm smaller than machine epsilon become NaN. */
+    static void normalize(QuaternionArrays& q);
+    /** Replace each quaternion q with the quaternion of the rotation
+    R * Rotation(q). The quaternions need not be normalized. The results are
+    normalized and have a non-negative scalar part, as returned by
+    SimTK::Rotation::convertRotationToQuaternion(). */
+    static void rotate(const SimTK::Rotation& R, QuaternionArrays& q);
+    /** The rotation matrix of each normalized quaternion. */
+    static void convertQuaternionsToRotations(
+            const QuaternionArrays& q, RotationMatrixArrays& R);
+    /** The quaternion of each rotation matrix, as returned by
+    SimTK::Rotation::convertRotationToQuaternion(). The matrices need only be
+    approximately orthogonal (e.g., values read from a file), in which case
+    the quaternions are normalized, as SimTK::Rotation(Mat33) does. */
+    static void convertRotationsToQuaternions(
+            const RotationMatrixArrays& R, QuaternionArrays& q);
+    /** The body-fixed X-Y-Z Euler angles of each rotation matrix, as returned
+    by SimTK::Rotation::convertRotationToBodyFixedXYZ(). */
+    static void convertRotationsToBodyFixedXYZ(
+            const RotationMatrixArrays& R, AngleArrays& angles);
+    /// @}
+
+    /// @name Loading and storing columns
+    /// @{
+    static void loadColumn(const SimTK::MatrixBase<SimTK::Quaternion>& matrix,
+            int column, QuaternionArrays& q);
+    static void loadColumn(const SimTK::MatrixBase<SimTK::Rotation>& matrix,
+            int column, RotationMatrixArrays& R);
+    /// The matrix must have as many rows as there are elements in the arrays.
+    static void storeColumn(const QuaternionArrays& q, int column,
+            SimTK::MatrixBase<SimTK::Quaternion>& matrix);
+    static void storeColumn(const RotationMatrixArrays& R, int column,
+            SimTK::MatrixBase<SimTK::Rotation>& matrix);
+    static void storeColumn(const AngleArrays& angles, int column,
+            SimTK::MatrixBase<SimTK::Vec3>& matrix);
+    /// @}
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_ROTATION_KERNELS_H_
@@ -118,6 +118,12 @@ public:
     /** Write a STO file.                                                     */
     static
     void write(const TimeSeriesTable_<T>& table, const std::string& fileName);
+
+    /** Write a STO file with numbers that have the given number of
+    significant digits (see DelimFileAdapter::setWritePrecision()).           */
+    static
+    void write(const TimeSeriesTable_<T>& table, const std::string& fileName,
+               unsigned precision);
 };
 
 template<typename T>
@@ -143,6 +149,18 @@ STOFileAdapter_<T>::write(const TimeSeriesTable_<T>& table,
     STOFileAdapter_{}.extendWrite(tables, fileName);
 }
 
+template<typename T>
+void 
+STOFileAdapter_<T>::write(const TimeSeriesTable_<T>& table, 
+                          const std::string& fileName,
+                          unsigned precision) {
+    DataAdapter::InputTables tables{};
+    tables.emplace(DelimFileAdapter<T>::tableString(), &table);
+    STOFileAdapter_ adapter{};
+    adapter.setWritePrecision(precision);
+    adapter.extendWrite(tables, fileName);
+}
+
 std::shared_ptr<DataAdapter> 
 createSTOFileAdapterForReading(const std::string& fileName);
 
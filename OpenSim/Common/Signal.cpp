@@ -28,6 +28,8 @@
 
 // INCLUDES
 #include <math.h>
+#include <algorithm>
+#include <vector>
 #include "Signal.h"
 #include "Array.h"
 #include "SimTKcommon/Constants.h"
@@ -157,19 +159,13 @@ SmoothSpline(int degree,double T,double fc,int N,double *times,double *sig,doubl
  *
  * @return 0 on success, and -1 on failure.
  */
-int Signal::
-LowpassIIR(double T,double fc,int N,const double *sig,double *sigf)
+namespace {
+// Coefficients of the 3rd order lowpass Butterworth filter used by
+// Signal::LowpassIIR().
+void computeLowpassIIRCoefficients(double T,double fc,double a[4],double b[4])
 {
-int i,j;
 double fs/*,ws*/,wc,wa,wa2,wa3;
-double a[4],b[4],denom;
-double *sigr;
-
-    // ERROR CHECK
-    if(T==0) return(-1);
-    if(N==0) return(-1);
-    if(sig==NULL) return(-1);
-    if(sigf==NULL) return(-1);
+double denom;
 
     // CHECK THAT THE CUTOFF FREQUENCY IS LESS THAN HALF THE SAMPLE FREQUENCY
     fs = 1 / T;
@@ -199,6 +195,23 @@ double *sigr;
     b[1] = (3*wa3 + 2*wa2 - 2*wa - 3) / denom; 
     b[2] = (3*wa3 - 2*wa2 - 2*wa + 3) / denom; 
     b[3] = (wa - 1) * (wa2 - wa + 1) / denom;
+}
+} // anonymous namespace
+
+int Signal::
+LowpassIIR(double T,double fc,int N,const double *sig,double *sigf)
+{
+int i,j;
+double a[4],b[4];
+double *sigr;
+
+    // ERROR CHECK
+    if(T==0) return(-1);
+    if(N==0) return(-1);
+    if(sig==NULL) return(-1);
+    if(sigf==NULL) return(-1);
+
+    computeLowpassIIRCoefficients(T,fc,a,b);
 
     // ALLOCATE MEMORY FOR sigr[]
     sigr = new double[N];
@@ -240,6 +253,82 @@ double *sigr;
 
   return(0);
 }
+//_____________________________________________________________________________
+/**
+ * 3rd ORDER LOWPASS IIR BUTTERWORTH DIGITAL FILTER OF SEVERAL SIGNALS
+ *
+ * The signals are filtered in place, forward and then backward, exactly as
+ * by LowpassIIR(T,fc,N,sig,sigf). Only the last three (unfiltered) samples
+ * of each pass are kept in addition to the signals.
+ *
+ *  @param T Sample interval in seconds.
+ *  @param fc Cutoff frequency in Hz.
+ *  @param N Number of data points in each signal.
+ *  @param M Number of signals.
+ *  @param sig The sampled signals; sample i of signal j is sig[i*M + j].
+ *
+ * @return 0 on success, and -1 on failure.
+ */
+int Signal::
+LowpassIIR(double T,double fc,int N,int M,double *sig)
+{
+    // ERROR CHECK
+    if(T==0) return(-1);
+    if(N<4) return(-1);
+    if(M<=0) return(-1);
+    if(sig==NULL) return(-1);
+
+    double a[4],b[4];
+    computeLowpassIIRCoefficients(T,fc,a,b);
+
+    // The unfiltered values of the previous three samples.
+    std::vector<double> history(3*M);
+    double *x1 = &history[0];
+    double *x2 = &history[M];
+    double *x3 = &history[2*M];
+
+    // FORWARD PASS
+    // The first three samples are not filtered.
+    std::copy(sig+2*M, sig+3*M, x1);
+    std::copy(sig+M, sig+2*M, x2);
+    std::copy(sig, sig+M, x3);
+    for(int i=3;i<N;i++) {
+        double *y = sig + i*M;
+        const double *y1 = y - M;
+        const double *y2 = y - 2*M;
+        const double *y3 = y - 3*M;
+        for(int j=0;j<M;j++) {
+            const double x = y[j];
+            y[j] = a[0]*x + a[1]*x1[j] + a[2]*x2[j] + a[3]*x3[j]
+                    - b[1]*y1[j] - b[2]*y2[j] - b[3]*y3[j];
+            x3[j] = x2[j];
+            x2[j] = x1[j];
+            x1[j] = x;
+        }
+    }
+
+    // BACKWARD PASS
+    // The last three samples are not filtered.
+    std::copy(sig+(N-3)*M, sig+(N-2)*M, x1);
+    std::copy(sig+(N-2)*M, sig+(N-1)*M, x2);
+    std::copy(sig+(N-1)*M, sig+N*M, x3);
+    for(int i=N-4;i>=0;i--) {
+        double *y = sig + i*M;
+        const double *y1 = y + M;
+        const double *y2 = y + 2*M;
+        const double *y3 = y + 3*M;
+        for(int j=0;j<M;j++) {
+            const double x = y[j];
+            y[j] = a[0]*x + a[1]*x1[j] + a[2]*x2[j] + a[3]*x3[j]
+                    - b[1]*y1[j] - b[2]*y2[j] - b[3]*y3[j];
+            x3[j] = x2[j];
+            x2[j] = x1[j];
+            x1[j] = x;
+        }
+    }
+
+  return(0);
+}
 
 //-----------------------------------------------------------------------------
 // FIR
@@ -64,6 +64,14 @@ public:
     static int
         LowpassIIR(double aDeltaT,double aCutOffFrequency,
         int aN,const double *aSignal,double *rFilteredSignal);
+    /** Apply the filter of LowpassIIR() to aM signals at once, in place.
+    Sample i of signal j is aSignals[i*aM + j], so that each step of the
+    filter processes the same sample of all signals together (and can be
+    vectorized across the signals). The results are the same as filtering each
+    signal separately with LowpassIIR(). */
+    static int
+        LowpassIIR(double aDeltaT,double aCutOffFrequency,
+        int aN,int aM,double *aSignals);
     static int
         LowpassFIR(int aOrder,double aDeltaT,double aCutoffFrequency,
         int aN,double *aSignal,double *rFilteredSignal);
@@ -173,6 +173,9 @@ getTime() const
 void StateVector::
 setStates(double aT, const SimTK::Vector_<double>& data) {
     _t = aT;
+    // Allocate exactly what is needed, since many state vectors are kept
+    // (e.g., one per row of a Storage).
+    _data.ensureCapacity(data.size() + 1);
     _data.setSize(data.size());
     int size = _data.getSize();
     for(int i = 0; i < size; ++i) {
@@ -41,7 +41,9 @@
 #include "StateVector.h"
 #include "TableUtilities.h"
 #include "TimeSeriesTable.h"
+#include <algorithm>
 #include <iostream>
+#include <vector>
 
 using namespace OpenSim;
 using namespace std;
@@ -1454,6 +1456,28 @@ append(const StateVector &aStateVector,bool aCheckForDuplicateTime)
     return(_storage.getSize());
 }
 //_____________________________________________________________________________
+/**
+ * Append a state vector, moving its data into this storage.
+ *
+ * @param aStateVector State vector to be appended; its data is taken over.
+ * @return Size of the storage after the append.
+ */
+int Storage::
+append(StateVector&& aStateVector,bool aCheckForDuplicateTime)
+{
+    if (_fp!=0){
+        aStateVector.print(_fp);
+        fflush(_fp);
+    }
+
+    if(aCheckForDuplicateTime && _storage.getSize() && _storage.getLast().getTime()==aStateVector.getTime())
+        _storage.updLast() = std::move(aStateVector);
+    else
+        _storage.append(std::move(aStateVector));
+
+    return(_storage.getSize());
+}
+//_____________________________________________________________________________
 /**
  * Append copies of all state vectors in an Storage object.
  *
@@ -1486,8 +1510,14 @@ append(double aT,int aN,const double *aY,bool aCheckForDuplicateTime)
     if(aN<0) return(_storage.getSize());
 
     // APPEND
-    StateVector vec(aT, SimTK::Vector_<double>(aN, aY));
-    append(vec,aCheckForDuplicateTime);
+    // Fill the state vector directly and move it into the storage, to avoid
+    // copying the data more than once.
+    StateVector vec(aT);
+    Array<double>& data = vec.getData();
+    data.ensureCapacity(aN+1);
+    data.setSize(aN);
+    for(int i=0;i<aN;i++) data[i] = aY[i];
+    append(std::move(vec),aCheckForDuplicateTime);
     // TODO: use some tolerance when checking for duplicate time?
     /*
     if(aCheckForDuplicateTime && _storage.getSize() && _storage.getLast().getTime()==vec.getTime())
@@ -2415,18 +2445,21 @@ lowpassIIR(double aCutoffFrequency)
         return;
     }
 
-    // LOOP OVER COLUMNS
+    // FILTER ALL COLUMNS AT ONCE
+    // The rows of the storage are already laid out as Signal::LowpassIIR()
+    // expects for several signals.
     int nc = getSmallestNumberOfStates();
-    double *signal=NULL;
-    Array<double> filt(0.0,size);
-    for(int i=0;i<nc;i++) {
-        getDataColumn(i,signal);
-        Signal::LowpassIIR(dtmin,aCutoffFrequency,size,signal,&filt[0]);
-        setDataColumn(i,filt);
+    if(nc<=0) return;
+    std::vector<double> signals((size_t)size*nc);
+    for(int i=0;i<size;i++) {
+        const Array<double>& data = _storage[i].getData();
+        std::copy(&data[0], &data[0]+nc, &signals[(size_t)i*nc]);
+    }
+    Signal::LowpassIIR(dtmin,aCutoffFrequency,size,nc,signals.data());
+    for(int i=0;i<size;i++) {
+        Array<double>& data = _storage[i].getData();
+        std::copy(&signals[(size_t)i*nc], &signals[(size_t)i*nc]+nc, &data[0]);
     }
-
-    // CLEANUP
-    delete[] signal;
 }
 
 void Storage::
@@ -233,6 +233,10 @@ public:
     // CAPACITY INCREMENT
     void setCapacityIncrement(int aIncrement);
     int getCapacityIncrement() const;
+    /** Ensure that at least aNumRows state vectors can be appended without
+    reallocating the storage (e.g., when the number of time steps is known
+    in advance). */
+    void ensureCapacity(int aNumRows) { _storage.ensureCapacity(aNumRows+1); }
     // IO
     void setWriteSIMMHeader(bool aTrueFalse);
     bool getWriteSIMMHeader() const;
@@ -263,6 +267,10 @@ public:
     // STORAGE
     //--------------------------------------------------------------------------
     int append(const StateVector &aVec, bool aCheckForDuplicateTime=true) override;
+#ifndef SWIG
+    /** Append a state vector, moving rather than copying its data. */
+    int append(StateVector&& aVec, bool aCheckForDuplicateTime=true);
+#endif
     int append(const Array<StateVector> &aArray) override;
     int append(double aT,int aN,const double *aY, bool aCheckForDuplicateTime=true) override;
     int append(double aT,const SimTK::Vector& aY, bool aCheckForDuplicateTime=true) override;
@@ -27,9 +27,14 @@
 #include "FunctionSet.h"
 #include "GCVSplineSet.h"
 #include "PiecewiseLinearFunction.h"
+#include "RotationKernels.h"
 #include "Signal.h"
 #include "Storage.h"
 
+#include <SimTKcommon/internal/ParallelExecutor.h>
+
+#include <functional>
+
 using namespace OpenSim;
 
 void TableUtilities::checkNonUniqueLabels(std::vector<std::string> labels) {
@@ -119,19 +124,81 @@ int TableUtilities::findStateLabelIndexInternal(const std::string* begin,
     return -1;
 }
 
-void TableUtilities::filterLowpass(
-        TimeSeriesTable& table, double cutoffFreq, bool padData) {
-    OPENSIM_THROW_IF(cutoffFreq < 0, Exception,
-            "Cutoff frequency must be non-negative; got {}.", cutoffFreq);
+namespace {
+// The number of columns that are filtered together. The rows of a block are
+// contiguous, so that the filter can be vectorized across the columns.
+const int filterBlockSize = 16;
+
+// Copy rows [0, numRows) of columns [begin, begin + width) of the matrix into
+// rows [numPad, numPad + numRows) of the row-major block, and fill the first
+// and last numPad rows of the block as Signal::Pad() does.
+void loadPaddedBlock(const SimTK::Matrix& matrix, int begin, int width,
+        int numPad, std::vector<double>& block) {
+    const int numRows = matrix.nrow();
+    block.resize((size_t)(numRows + 2 * numPad) * width);
+    for (int k = 0; k < width; ++k) {
+        const double* column =
+                matrix.col(begin + k).getContiguousScalarData();
+        double* out = block.data() + (size_t)numPad * width + k;
+        for (int i = 0; i < numRows; ++i) out[(size_t)i * width] = column[i];
+    }
+    if (numPad == 0) return;
+    // Reflect and negate the signal about its first and last values.
+    const double* first = block.data() + (size_t)numPad * width;
+    const double* last = first + (size_t)(numRows - 1) * width;
+    for (int i = 0; i < numPad; ++i) {
+        double* prepend = block.data() + (size_t)i * width;
+        const double* mirror = first + (size_t)(numPad - i) * width;
+        for (int k = 0; k < width; ++k) {
+            prepend[k] = 2.0 * first[k] - mirror[k];
+        }
+        double* append = block.data() + (size_t)(numPad + numRows + i) * width;
+        const double* mirror2 = last - (size_t)(i + 1) * width;
+        for (int k = 0; k < width; ++k) {
+            append[k] = 2.0 * last[k] - mirror2[k];
+        }
+    }
+}
 
-    if (padData) { pad(table, (int)table.getNumRows() / 2); }
+void storeBlock(const std::vector<double>& block, int begin, int width,
+        SimTK::Matrix& matrix) {
+    const int numRows = matrix.nrow();
+    for (int k = 0; k < width; ++k) {
+        double* column = matrix.updCol(begin + k).updContiguousScalarData();
+        const double* in = block.data() + k;
+        for (int i = 0; i < numRows; ++i) column[i] = in[(size_t)i * width];
+    }
+}
 
-    const int numRows = (int)table.getNumRows();
+class FunctionTask : public SimTK::ParallelExecutor::Task {
+public:
+    explicit FunctionTask(const std::function<void(int)>& function)
+            : m_function(function) {}
+    void execute(int index) override { m_function(index); }
+
+private:
+    const std::function<void(int)>& m_function;
+};
+} // anonymous namespace
+
+void TableUtilities::filterLowpass(TimeSeriesTable& table, double cutoffFreq,
+        bool padData, int numThreads) {
+    OPENSIM_THROW_IF(cutoffFreq < 0, Exception,
+            "Cutoff frequency must be non-negative; got {}.", cutoffFreq);
+    OPENSIM_THROW_IF(numThreads < 0, Exception,
+            "Expected numThreads to be non-negative, but got {}.",
+            numThreads);
+
+    // The padding is added while filtering, unless the table must be
+    // resampled.
+    int numPad = padData ? (int)table.getNumRows() / 2 : 0;
+    const std::vector<double> time =
+            Signal::Pad(numPad, (int)table.getNumRows(),
+                    table.getIndependentColumn().data());
+    int numRows = (int)time.size();
     OPENSIM_THROW_IF(numRows < 4, Exception,
             "Expected at least 4 rows to filter, but got {} rows.", numRows);
 
-    const auto& time = table.getIndependentColumn();
-
     double dtMin = SimTK::Infinity;
     for (int irow = 1; irow < numRows; ++irow) {
         double dt = time[irow] - time[irow - 1];
@@ -144,17 +211,36 @@ void TableUtilities::filterLowpass(
 
     // Resample if the sampling interval is not uniform.
     if (dtAvg - dtMin > SimTK::Eps) {
+        pad(table, numPad);
+        numPad = 0;
         table = resampleWithInterval(table, dtMin);
+        numRows = (int)table.getNumRows();
     }
 
-    SimTK::Vector filtered(numRows);
-    for (int icol = 0; icol < (int)table.getNumColumns(); ++icol) {
-        SimTK::VectorView column = table.getDependentColumnAtIndex(icol);
-        Signal::LowpassIIR(dtMin, cutoffFreq, numRows,
-                column.getContiguousScalarData(),
-                filtered.updContiguousScalarData());
-        table.updDependentColumnAtIndex(icol) = filtered;
+    const int numColumns = (int)table.getNumColumns();
+    SimTK::Matrix filtered(numRows, numColumns);
+    const int numBlocks = (numColumns + filterBlockSize - 1) / filterBlockSize;
+    const std::function<void(int)> filterBlock = [&](int iblock) {
+        const int begin = iblock * filterBlockSize;
+        const int width = std::min(filterBlockSize, numColumns - begin);
+        std::vector<double> block;
+        loadPaddedBlock(table.getMatrix(), begin, width, numPad, block);
+        Signal::LowpassIIR(dtMin, cutoffFreq, numRows, width, block.data());
+        storeBlock(block, begin, width, filtered);
+    };
+    if (numThreads == 1 || numBlocks <= 1) {
+        for (int iblock = 0; iblock < numBlocks; ++iblock) {
+            filterBlock(iblock);
+        }
+    } else {
+        SimTK::ParallelExecutor executor(numThreads ? numThreads
+                : SimTK::ParallelExecutor::getNumProcessors());
+        FunctionTask task(filterBlock);
+        executor.execute(task, numBlocks);
     }
+
+    if (numPad) table._indData = time;
+    table.updMatrix() = filtered;
 }
 
 void TableUtilities::pad(
@@ -169,17 +255,16 @@ void TableUtilities::pad(
     table._indData = Signal::Pad(numRowsToPrependAndAppend,
             (int)table._indData.size(), table._indData.data());
 
-    size_t numColumns = table.getNumColumns();
-
     // _indData.size() is now the number of rows after padding.
-    SimTK::Matrix newMatrix((int)table._indData.size(), (int)numColumns);
-    for (size_t icol = 0; icol < numColumns; ++icol) {
-        SimTK::Vector column = table.getDependentColumnAtIndex(icol);
-        const std::vector<double> newColumn =
-                Signal::Pad(numRowsToPrependAndAppend, column.size(),
-                        column.getContiguousScalarData());
-        newMatrix.updCol((int)icol) =
-                SimTK::Vector((int)newColumn.size(), newColumn.data(), true);
+    const int numRows = (int)table._indData.size();
+    const int numColumns = (int)table.getNumColumns();
+    SimTK::Matrix newMatrix(numRows, numColumns);
+    std::vector<double> block;
+    for (int begin = 0; begin < numColumns; begin += filterBlockSize) {
+        const int width = std::min(filterBlockSize, numColumns - begin);
+        loadPaddedBlock(table.getMatrix(), begin, width,
+                numRowsToPrependAndAppend, block);
+        storeBlock(block, begin, width, newMatrix);
     }
     table.updMatrix() = newMatrix;
 }
@@ -297,13 +382,15 @@ TimeSeriesTable_<SimTK::Vec3> TableUtilities::convertRotationsToEulerAngles(
     int nc = int(labels.size());
     int nt = int(times.size());
 
-    SimTK::Matrix_<SimTK::Vec3> eulerMatrix(nt, nc, SimTK::Vec3(SimTK::NaN));
+    SimTK::Matrix_<SimTK::Vec3> eulerMatrix(nt, nc);
 
-    for (int i = 0; i < nt; ++i) {
-        for (int j = 0; j < nc; ++j) {
-            eulerMatrix.updElt(i, j) =
-                    rotations(i, j).convertRotationToBodyFixedXYZ();
-        }
+    // Convert a column at a time with the batched kernels.
+    RotationMatrixArrays rotColumn;
+    AngleArrays eulerColumn;
+    for (int j = 0; j < nc; ++j) {
+        RotationKernels::loadColumn(rotations, j, rotColumn);
+        RotationKernels::convertRotationsToBodyFixedXYZ(rotColumn, eulerColumn);
+        RotationKernels::storeColumn(eulerColumn, j, eulerMatrix);
     }
     TimeSeriesTable_<SimTK::Vec3> eulerData{times, eulerMatrix, labels};
     eulerData.updTableMetaData().setValueForKey(
@@ -63,9 +63,11 @@ public:
     /// Lowpass filter the data in a TimeSeriesTable at a provided cutoff
     /// frequency. If padData is true, then the data is first padded with pad()
     /// using numRowsToPrependAndAppend = table.getNumRows() / 2.
-    /// The filtering is performed with Signal::LowpassIIR()
+    /// The filtering is performed with Signal::LowpassIIR(), on blocks of
+    /// columns at a time; the blocks are divided among numThreads threads
+    /// (0 uses all available cores).
     static void filterLowpass(TimeSeriesTable& table,
-            double cutoffFreq, bool padData = false);
+            double cutoffFreq, bool padData = false, int numThreads = 1);
 
     /// Pad each column by the number of rows specified. The padded data is
     /// obtained by reflecting and negating the data in the table.
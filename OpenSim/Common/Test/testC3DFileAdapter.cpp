@@ -24,6 +24,7 @@
 #include "OpenSim/Common/STOFileAdapter.h"
 #include "OpenSim/Common/TRCFileAdapter.h"
 #include <chrono>
+#include <algorithm>
 #include <cmath>
 #include <cstdlib>
 #include <thread>
@@ -220,9 +221,80 @@ void test(const std::string filename) {
 
 }
 
+void testTimeRangeAndSelection(const std::string filename) {
+    using namespace OpenSim;
+
+    C3DFileAdapter fullAdapter{};
+    auto fullTables = fullAdapter.read(filename);
+    auto fullMarkers = fullAdapter.getMarkersTable(fullTables);
+    auto fullForces = fullAdapter.getForcesTable(fullTables);
+    auto fullAnalog = fullAdapter.getAnalogDataTable(fullTables);
+
+    const auto& allMarkerNames = fullMarkers->getColumnLabels();
+    const auto& allChannelNames = fullAnalog->getColumnLabels();
+    const std::vector<std::string> markerNames{
+            allMarkerNames[2], allMarkerNames[0]};
+    const std::vector<std::string> channelNames{allChannelNames[1]};
+    // Chosen to fall between samples of the marker and analog data.
+    const double initialTime = 0.25037;
+    const double finalTime = 0.50041;
+
+    C3DFileAdapter adapter{};
+    adapter.setTimeRange(initialTime, finalTime);
+    adapter.setMarkerNames(markerNames);
+    adapter.setAnalogChannelNames(channelNames);
+    auto tables = adapter.read(filename);
+    auto markers = adapter.getMarkersTable(tables);
+    auto forces = adapter.getForcesTable(tables);
+    auto analog = adapter.getAnalogDataTable(tables);
+
+    // Build the expected tables by trimming and selecting from the full ones.
+    auto expectedMarkers = *fullMarkers;
+    expectedMarkers.trim(initialTime, finalTime);
+    for (const auto& label : allMarkerNames) {
+        if (std::find(markerNames.begin(), markerNames.end(), label) ==
+                markerNames.end()) {
+            expectedMarkers.removeColumn(label);
+        }
+    }
+    auto expectedForces = *fullForces;
+    expectedForces.trim(initialTime, finalTime);
+    auto expectedAnalog = *fullAnalog;
+    expectedAnalog.trim(initialTime, finalTime);
+    for (const auto& label : allChannelNames) {
+        if (label != channelNames[0]) expectedAnalog.removeColumn(label);
+    }
+
+    SimTK_TEST(markers->getColumnLabels() == markerNames);
+    SimTK_TEST(markers->getNumRows() == expectedMarkers.getNumRows());
+    SimTK_TEST(forces->getNumRows() == expectedForces.getNumRows());
+    SimTK_TEST(analog->getNumRows() == expectedAnalog.getNumRows());
+    SimTK_TEST(markers->getIndependentColumn().front() >= initialTime);
+    SimTK_TEST(markers->getIndependentColumn().back() <= finalTime);
+
+    // Markers are in the selected order, which differs from the file order.
+    for (size_t r = 0; r < markers->getNumRows(); ++r) {
+        for (size_t c = 0; c < markerNames.size(); ++c) {
+            const auto& actual = markers->getDependentColumn(markerNames[c])[r];
+            const auto& expected =
+                    expectedMarkers.getDependentColumn(markerNames[c])[r];
+            SimTK_TEST(actual.isNaN() == expected.isNaN());
+            if (!expected.isNaN()) SimTK_TEST_EQ(actual, expected);
+        }
+    }
+    compare_tables<SimTK::Vec3>(*forces, expectedForces);
+    compare_tables<double>(*analog, expectedAnalog);
+
+    SimTK_TEST_MUST_THROW_EXC(adapter.setTimeRange(1.0, 0.5),
+            OpenSim::Exception);
+    adapter.setMarkerNames({"not_a_marker"});
+    SimTK_TEST_MUST_THROW_EXC(adapter.read(filename), OpenSim::Exception);
+}
+
 int main() {
     SimTK_START_TEST("testC3DFileAdapter");
         SimTK_SUBTEST1(test, "walking2.c3d");
         SimTK_SUBTEST1(test, "walking5.c3d");
+        SimTK_SUBTEST1(testTimeRangeAndSelection, "walking2.c3d");
     SimTK_END_TEST();
 }
@@ -1342,6 +1342,93 @@ void testGetStateVariableValueComponentPath() {
             OpenSim::Exception);
 }
 
+void testStateVariableHandles() {
+    TheWorld top;
+    top.setName("top");
+    Sub* a = new Sub();
+    a->setName("a");
+    Sub* b = new Sub();
+    b->setName("b");
+
+    top.add(a);
+    a->addComponent(b);
+
+    MultibodySystem system;
+    top.buildUpSystem(system);
+    State s = system.realizeTopology();
+
+    SimTK_TEST(s.getNY() == 3);
+    s.updY()[0] = 10; // "top/internalSub/subState"
+    s.updY()[1] = 20; // "top/a/subState"
+    s.updY()[2] = 30; // "top/a/b/subState"
+
+    const auto hInternal = top.getStateVariableHandle("internalSub/subState");
+    const auto hA = top.getStateVariableHandle("a/subState");
+    const auto hB = top.getStateVariableHandle("a/b/subState");
+    SimTK_TEST(hInternal.isValid() && hA.isValid() && hB.isValid());
+    SimTK_TEST(top.getStateVariableValue(s, hInternal) == 10);
+    SimTK_TEST(top.getStateVariableValue(s, hA) == 20);
+    SimTK_TEST(top.getStateVariableValue(s, hB) == 30);
+
+    // Relative paths resolve to the same state variable.
+    const auto hAFromB = b->getStateVariableHandle("../subState");
+    SimTK_TEST(a->getStateVariableValue(s, hAFromB) == 20);
+    // A handle can only be used with a component that owns the state
+    // variable, directly or through a subcomponent.
+    SimTK_TEST_MUST_THROW_EXC(b->getStateVariableValue(s, hAFromB),
+            OpenSim::Exception);
+    SimTK_TEST_MUST_THROW_EXC(b->setStateVariableValue(s, hA, 0),
+            OpenSim::Exception);
+
+    // Setting through a handle updates the underlying state.
+    top.setStateVariableValue(s, hB, 35);
+    SimTK_TEST(s.getY()[2] == 35);
+    SimTK_TEST(top.getStateVariableValue(s, "a/b/subState") == 35);
+
+    // The bulk accessors agree with the handles, in the order of the names.
+    const Array<std::string> names = top.getStateVariableNames();
+    const SimTK::Vector values = top.getStateVariableValues(s);
+    SimTK_TEST(values.size() == names.size());
+    for (int i = 0; i < names.size(); ++i) {
+        SimTK_TEST(values[i] == top.getStateVariableValue(s,
+                top.getStateVariableHandle(names[i])));
+    }
+
+    SimTK_TEST(!Component::StateVariableHandle().isValid());
+    SimTK_TEST_MUST_THROW_EXC(
+            top.getStateVariableValue(s, Component::StateVariableHandle()),
+            OpenSim::Exception);
+    SimTK_TEST_MUST_THROW_EXC(
+            top.getStateVariableHandle("typo/b/subState"),
+            OpenSim::Exception);
+
+    // Handles are invalidated by re-creating the System; they must not be
+    // used to access the state variables of the new System.
+    top.finalizeFromProperties();
+    MultibodySystem system2;
+    top.buildUpSystem(system2);
+    State s2 = system2.realizeTopology();
+    SimTK_TEST(!hA.isValid() && !hB.isValid());
+    SimTK_TEST_MUST_THROW_EXC(top.getStateVariableValue(s2, hB),
+            OpenSim::Exception);
+    SimTK_TEST_MUST_THROW_EXC(top.setStateVariableValue(s2, hB, 0),
+            OpenSim::Exception);
+    SimTK_TEST_MUST_THROW_EXC(top.getStateVariableDerivativeValue(s2, hB),
+            OpenSim::Exception);
+    s2.updY()[2] = 40; // "top/a/b/subState"
+    const auto hB2 = top.getStateVariableHandle("a/b/subState");
+    SimTK_TEST(hB2.isValid());
+    SimTK_TEST(top.getStateVariableValue(s2, hB2) == 40);
+
+    // Connecting the components again invalidates handles even though the
+    // System (and its address) stays the same.
+    top.buildUpSystem(system2);
+    SimTK_TEST(&top.getSystem() == &system2);
+    SimTK_TEST(!hB2.isValid());
+    SimTK_TEST_MUST_THROW_EXC(top.getStateVariableValue(s2, hB2),
+            OpenSim::Exception);
+}
+
 void testInputOutputConnections()
 {
     {
@@ -2423,6 +2510,16 @@ void testCacheVariableInterface() {
         CacheVariable<double> cv2 = cv;
     }
 
+    // can be retrieved by name via Component::getCacheVariable, which throws
+    // for unknown names or mismatched types
+    {
+        ComponentWithCacheVariable c{};
+        c.addCacheVariable("name", 0.0, SimTK::Stage::Velocity);
+        CacheVariable<double> cv = c.getCacheVariable<double>("name");
+        ASSERT_THROW(std::exception, c.getCacheVariable<double>("typo"));
+        ASSERT_THROW(std::exception, c.getCacheVariable<int>("name"));
+    }
+
     // the Component's cache variable value methods (e.g. Component::getCacheVariableValue)
     // should throw if `Component::realizeTopology` has not yet been called
     {
@@ -2624,6 +2721,7 @@ int main() {
         SimTK_SUBTEST(testTraversePathToComponent);
         SimTK_SUBTEST(testGetStateVariableValue);
         SimTK_SUBTEST(testGetStateVariableValueComponentPath);
+        SimTK_SUBTEST(testStateVariableHandles);
         SimTK_SUBTEST(testInputOutputConnections);
         SimTK_SUBTEST(testInputConnecteePaths);
         SimTK_SUBTEST(testExceptionsForConnecteeTypeMismatch);
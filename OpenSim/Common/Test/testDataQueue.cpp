@@ -0,0 +1,195 @@
+/* -------------------------------------------------------------------------- *
+ *                       OpenSim:  testDataQueue.cpp                          *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include <OpenSim/Common/DataQueue.h>
+
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+using namespace OpenSim;
+
+namespace {
+// Every element of the row holds the time so that torn rows are detected.
+SimTK::RowVector_<double> createRow(double time, int size = 3) {
+    return SimTK::RowVector_<double>(size, time);
+}
+bool rowHolds(const SimTK::RowVector_<double>& row, double time) {
+    for (int i = 0; i < row.size(); ++i) {
+        if (row[i] != time) return false;
+    }
+    return row.size() == 3;
+}
+}
+
+void testSingleThread() {
+    DataQueue_<double> queue(3, 3, DataQueueOverflowPolicy::BackPressure);
+    double time;
+    SimTK::RowVector_<double> row;
+    SimTK_TEST(queue.isEmpty());
+    SimTK_TEST(!queue.try_pop_front(time, row));
+
+    for (int i = 0; i < 3; ++i) queue.push_back(i, createRow(i));
+    SimTK_TEST(queue.size() == 3);
+    for (int i = 0; i < 3; ++i) {
+        queue.pop_front(time, row);
+        SimTK_TEST(time == i);
+        SimTK_TEST(rowHolds(row, i));
+    }
+    SimTK_TEST(queue.isEmpty());
+    SimTK_TEST(queue.getNumPopped() == 3);
+    SimTK_TEST(queue.getNumDropped() == 0);
+    SimTK_TEST(queue.getMeanLatency() >= 0);
+    SimTK_TEST(queue.getMaxLatency() >= queue.getMeanLatency());
+
+    // Rows may change size.
+    queue.push_back(5, createRow(5, 7));
+    queue.pop_front(time, row);
+    SimTK_TEST(row.size() == 7);
+
+    // The oldest entries are dropped.
+    queue.setOverflowPolicy(DataQueueOverflowPolicy::DropOldest);
+    for (int i = 0; i < 5; ++i) queue.push_back(i, createRow(i));
+    SimTK_TEST(queue.size() == 3);
+    SimTK_TEST(queue.getNumDropped() == 2);
+    for (int i = 2; i < 5; ++i) {
+        queue.pop_front(time, row);
+        SimTK_TEST(time == i);
+    }
+
+    // Copies contain the queued entries.
+    queue.push_back(10, createRow(10));
+    queue.push_back(11, createRow(11));
+    DataQueue_<double> copy(queue);
+    SimTK_TEST(copy.getCapacity() == 3);
+    SimTK_TEST(copy.getOverflowPolicy() ==
+               DataQueueOverflowPolicy::DropOldest);
+    SimTK_TEST(copy.size() == 2);
+    copy.pop_front(time, row);
+    SimTK_TEST(time == 10);
+    SimTK_TEST(queue.size() == 2);
+
+    SimTK_TEST_MUST_THROW_EXC(queue.setCapacity(0), Exception);
+}
+
+// By default, a full queue grows, so one thread can push many entries before
+// popping them.
+void testGrow() {
+    DataQueue_<double> queue(2, 3);
+    SimTK_TEST(queue.getOverflowPolicy() == DataQueueOverflowPolicy::Grow);
+    double time;
+    SimTK::RowVector_<double> row;
+    queue.push_back(0, createRow(0));
+    queue.pop_front(time, row);
+    // The entries wrap around the end of the slots before the queue grows.
+    for (int i = 1; i <= 10; ++i) queue.push_back(i, createRow(i));
+    SimTK_TEST(queue.size() == 10);
+    SimTK_TEST(queue.getCapacity() == 16);
+    SimTK_TEST(queue.getNumGrown() == 3);
+    SimTK_TEST(queue.getNumWaited() == 0);
+    SimTK_TEST(queue.getNumDropped() == 0);
+    for (int i = 1; i <= 10; ++i) {
+        queue.pop_front(time, row);
+        SimTK_TEST(time == i);
+        SimTK_TEST(rowHolds(row, i));
+    }
+    SimTK_TEST(queue.isEmpty());
+}
+
+void testProducerConsumer(DataQueueOverflowPolicy policy) {
+    const int numRows = 20000;
+    DataQueue_<double> queue(8, 3, policy);
+    std::thread producer([&queue, numRows]() {
+        for (int i = 0; i < numRows; ++i) queue.push_back(i, createRow(i));
+    });
+
+    double time = -1;
+    double prevTime = -1;
+    SimTK::RowVector_<double> row;
+    int numReceived = 0;
+    while (time != numRows - 1) {
+        queue.pop_front(time, row);
+        SimTK_TEST(time > prevTime);
+        SimTK_TEST(rowHolds(row, time));
+        prevTime = time;
+        ++numReceived;
+    }
+    producer.join();
+
+    SimTK_TEST(queue.isEmpty());
+    SimTK_TEST((int)queue.getNumPopped() == numReceived);
+    if (policy == DataQueueOverflowPolicy::Grow) {
+        SimTK_TEST(numReceived == numRows);
+        SimTK_TEST(queue.getNumDropped() == 0);
+        SimTK_TEST(queue.getNumWaited() == 0);
+    } else if (policy == DataQueueOverflowPolicy::BackPressure) {
+        SimTK_TEST(numReceived == numRows);
+        SimTK_TEST(queue.getNumDropped() == 0);
+    } else {
+        SimTK_TEST(numReceived + (int)queue.getNumDropped() == numRows);
+        SimTK_TEST(queue.getNumWaited() == 0);
+    }
+}
+
+// A consumer waiting on an empty queue blocks instead of spinning, and is
+// woken by the next push.
+void testIdleConsumerBlocks() {
+    DataQueue_<double> queue(4, 3, DataQueueOverflowPolicy::BackPressure);
+    double time = -1;
+    SimTK::RowVector_<double> row;
+    std::thread consumer([&]() { queue.pop_front(time, row); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    // The consumer gave up yielding and blocked exactly once; a spinning
+    // consumer would not have blocked at all.
+    SimTK_TEST(queue.getNumBlocked() == 1);
+    queue.push_back(7, createRow(7));
+    consumer.join();
+    SimTK_TEST(time == 7);
+    SimTK_TEST(rowHolds(row, 7));
+    SimTK_TEST(queue.getNumBlocked() == 1);
+
+    // Likewise, a producer waiting on a full queue blocks until the consumer
+    // pops an entry.
+    for (int i = 0; i < 4; ++i) queue.push_back(i, createRow(i));
+    std::thread producer([&]() { queue.push_back(4, createRow(4)); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    SimTK_TEST(queue.getNumBlocked() == 2);
+    for (int i = 0; i < 5; ++i) {
+        queue.pop_front(time, row);
+        SimTK_TEST(time == i);
+    }
+    producer.join();
+    SimTK_TEST(queue.getNumWaited() == 1);
+}
+
+int main() {
+    SimTK_START_TEST("testDataQueue");
+        SimTK_SUBTEST(testSingleThread);
+        SimTK_SUBTEST(testGrow);
+        SimTK_SUBTEST(testIdleConsumerBlocks);
+        SimTK_SUBTEST1(testProducerConsumer, DataQueueOverflowPolicy::Grow);
+        SimTK_SUBTEST1(testProducerConsumer,
+                DataQueueOverflowPolicy::BackPressure);
+        SimTK_SUBTEST1(testProducerConsumer,
+                DataQueueOverflowPolicy::DropOldest);
+    SimTK_END_TEST();
+}
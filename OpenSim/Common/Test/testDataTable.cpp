@@ -27,6 +27,7 @@
 #include <OpenSim/Auxiliary/catch.hpp>
 #include <OpenSim/Common/CommonUtilities.h>
 #include <OpenSim/Common/PiecewiseLinearFunction.h>
+#include <OpenSim/Common/Signal.h>
 #include <OpenSim/Common/TableUtilities.h>
 #include <OpenSim/Common/STOFileAdapter.h>
 #include <OpenSim/Common/TimeSeriesTable.h>
@@ -861,6 +862,50 @@ TEST_CASE("TableUtilities::filterLowpass") {
     }
 }
 
+TEST_CASE("TableUtilities::filterLowpass multiple columns") {
+    // Enough columns for several blocks of columns, the last one partial.
+    const int numRows = 200;
+    const int numColumns = 37;
+    std::vector<double> time(numRows);
+    for (int i = 0; i < numRows; ++i) time[i] = 0.01 * i;
+    TimeSeriesTable table(time);
+    for (int j = 0; j < numColumns; ++j) {
+        table.appendColumn(std::to_string(j), SimTK::Test::randVector(numRows));
+    }
+
+    TimeSeriesTable filtered = table;
+    TableUtilities::filterLowpass(filtered, 6.0, true);
+    const int numPad = numRows / 2;
+    REQUIRE(filtered.getNumRows() == numRows + 2 * numPad);
+    REQUIRE(filtered.getNumColumns() == numColumns);
+    const auto paddedTime = Signal::Pad(numPad, numRows, time.data());
+    CHECK(filtered.getIndependentColumn() == paddedTime);
+
+    // Each column matches padding and filtering the column by itself.
+    std::vector<double> expected(paddedTime.size());
+    for (int j = 0; j < numColumns; ++j) {
+        const auto padded = Signal::Pad(numPad, numRows,
+                table.getDependentColumnAtIndex(j).getContiguousScalarData());
+        Signal::LowpassIIR(0.01, 6.0, (int)padded.size(), padded.data(),
+                expected.data());
+        const auto& column = filtered.getDependentColumnAtIndex(j);
+        for (int i = 0; i < (int)expected.size(); ++i) {
+            CHECK(column[i] == Approx(expected[i]).margin(1e-12));
+        }
+    }
+
+    // Filtering blocks of columns in parallel gives the same results.
+    TimeSeriesTable filteredInParallel = table;
+    TableUtilities::filterLowpass(filteredInParallel, 6.0, true, 3);
+    for (int i = 0; i < (int)filtered.getNumRows(); ++i) {
+        for (int j = 0; j < numColumns; ++j) {
+            CHECK(filteredInParallel.getMatrix().getElt(i, j) ==
+                    filtered.getMatrix().getElt(i, j));
+        }
+    }
+    CHECK_THROWS(TableUtilities::filterLowpass(table, 6.0, false, -1));
+}
+
 TEST_CASE("TableUtilities::pad") {
     Storage sto("test.sto");
     TimeSeriesTable paddedTable = sto.exportToTable();
@@ -0,0 +1,156 @@
+/* -------------------------------------------------------------------------- *
+ *                          OpenSim: testLogger.cpp                           *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include <OpenSim/Common/LogSink.h>
+#include <OpenSim/Common/Logger.h>
+
+#include <atomic>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+#include <SimTKcommon/Testing.h>
+
+using namespace OpenSim;
+
+namespace {
+std::vector<std::string> readLines(const std::string& filepath) {
+    std::ifstream file(filepath);
+    std::vector<std::string> lines;
+    std::string line;
+    while (std::getline(file, line)) lines.push_back(line);
+    return lines;
+}
+}
+
+void testAsynchronous() {
+    auto sink = std::make_shared<StringLogSink>();
+    Logger::addSink(sink);
+
+    // A small queue, so that the logging thread must wait for the queue.
+    Logger::setAsynchronous(true, 4);
+    SimTK_TEST(Logger::isAsynchronous());
+    for (int i = 0; i < 100; ++i) log_info("message {}", i);
+    // Switching from asynchronous mode writes the queued messages.
+    Logger::setAsynchronous(false);
+    SimTK_TEST(!Logger::isAsynchronous());
+    Logger::removeSink(sink);
+
+    const std::string& messages = sink->getString();
+    size_t previous = 0;
+    for (int i = 0; i < 100; ++i) {
+        const size_t pos = messages.find("message " + std::to_string(i) + "\n");
+        SimTK_TEST(pos != std::string::npos);
+        SimTK_TEST(pos >= previous);
+        previous = pos;
+    }
+
+    SimTK_TEST_MUST_THROW(Logger::setAsynchronous(true, 0));
+}
+
+// In asynchronous mode, changing the level or the sinks replaces the loggers
+// while other threads may be logging with them.
+void testAsynchronousReconfiguration() {
+    auto sink = std::make_shared<StringLogSink>();
+    Logger::addSink(sink);
+    Logger::setAsynchronous(true);
+    std::atomic<bool> done{false};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&done] {
+            while (!done) log_warn("reconfigured");
+        });
+    }
+    for (int i = 0; i < 100; ++i) {
+        Logger::setLevel(i % 2 ? Logger::Level::Info : Logger::Level::Warn);
+        auto other = std::make_shared<StringLogSink>();
+        Logger::addSink(other);
+        Logger::removeSink(other);
+    }
+    done = true;
+    for (auto& thread : threads) thread.join();
+    Logger::setLevel(Logger::Level::Info);
+    Logger::setAsynchronous(false);
+    Logger::removeSink(sink);
+    SimTK_TEST(sink->getString().find("reconfigured") != std::string::npos);
+}
+
+void testTelemetry() {
+    const std::string filepath = "testLogger_telemetry.jsonl";
+    auto sink = std::make_shared<StringLogSink>();
+    Logger::addSink(sink);
+    SimTK_TEST(!Logger::isTelemetryEnabled());
+    Logger::addTelemetryFile(filepath);
+    SimTK_TEST(Logger::isTelemetryEnabled());
+    Logger::telemetry("test.\"event\"",
+            {{"a", 1.5}, {"b", SimTK::NaN}, {"c", -3}});
+    Logger::removeTelemetryFile();
+    SimTK_TEST(!Logger::isTelemetryEnabled());
+    // This record is not written.
+    Logger::telemetry("test.removed", {});
+    Logger::removeSink(sink);
+
+    // Records are not written to the other sinks.
+    SimTK_TEST(sink->getString().find("test.") == std::string::npos);
+
+    auto lines = readLines(filepath);
+    SimTK_TEST(lines.size() == 1);
+    const std::string& record = lines[0];
+    SimTK_TEST(record.find("{\"timestamp\":") == 0);
+    SimTK_TEST(record.find(",\"thread\":\"") != std::string::npos);
+    SimTK_TEST(record.find(",\"event\":\"test.\\\"event\\\"\"") !=
+               std::string::npos);
+    SimTK_TEST(record.find(",\"a\":1.5") != std::string::npos);
+    SimTK_TEST(record.find(",\"b\":null") != std::string::npos);
+    SimTK_TEST(record.find(",\"c\":-3") != std::string::npos);
+    SimTK_TEST(record.back() == '}');
+
+    // Records from several threads, written asynchronously.
+    Logger::addTelemetryFile(filepath);
+    Logger::setAsynchronous(true);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([t] {
+            for (int i = 0; i < 50; ++i) {
+                Logger::telemetry("test.thread", {{"thread_index", t},
+                                                         {"record", i}});
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    Logger::setAsynchronous(false);
+    Logger::removeTelemetryFile();
+    lines = readLines(filepath);
+    SimTK_TEST(lines.size() == 200);
+    for (const auto& line : lines) {
+        SimTK_TEST(line.find("\"event\":\"test.thread\"") != std::string::npos);
+    }
+    std::remove(filepath.c_str());
+}
+
+int main() {
+    SimTK_START_TEST("testLogger");
+        SimTK_SUBTEST(testAsynchronous);
+        SimTK_SUBTEST(testAsynchronousReconfiguration);
+        SimTK_SUBTEST(testTelemetry);
+    SimTK_END_TEST();
+}
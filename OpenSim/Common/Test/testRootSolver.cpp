@@ -44,6 +44,46 @@
 using namespace OpenSim;
 using namespace std;
 
+// The example function, evaluable through the State-based interface used by
+// RootSolver, counting the number of evaluations.
+class CountingVectorFunction : public ExampleVectorFunctionUncoupledNxN {
+public:
+    CountingVectorFunction(int aN) : ExampleVectorFunctionUncoupledNxN(aN) {}
+    void evaluate(const SimTK::State& s, const Array<double> &aX,
+            Array<double> &rF) override {
+        ++numEvaluations;
+        calcValue(aX, rF);
+    }
+    int numEvaluations = 0;
+};
+
+// Solving with the function values at the bracket end points supplied must
+// give the same roots as solving without them, with two fewer evaluations.
+void testSolveWithEndPointValues()
+{
+    int N = 101;
+    SimTK::State s;
+    Array<double> a(-1.0,N), b(1.0,N), tol(1.0e-6,N);
+
+    CountingVectorFunction function(N);
+    RootSolver solver(&function);
+    Array<double> roots = solver.solve(s, a, b, tol);
+    int numEvaluations = function.numEvaluations;
+    for (int i=0; i < N; i++){
+        ASSERT_EQUAL(i*0.01, roots[i], 1e-5);
+    }
+
+    Array<double> fa(0.0,N), fb(0.0,N);
+    function.calcValue(a, fa);
+    function.calcValue(b, fb);
+    function.numEvaluations = 0;
+    Array<double> rootsGivenEndPoints = solver.solve(s, a, b, fa, fb, tol);
+    ASSERT_EQUAL(numEvaluations - 2, function.numEvaluations);
+    for (int i=0; i < N; i++){
+        ASSERT_EQUAL(roots[i], rootsGivenEndPoints[i], 0.0);
+    }
+}
+
 int main()
 {
     try {
@@ -69,6 +109,8 @@ int main()
         for (int i=0; i <= 100; i++){
             //ASSERT_EQUAL(i*0.01, roots[i], 1e-6);
         }
+
+        testSolveWithEndPointValues();
     }
     catch (const Exception& e) {
         e.print(cerr);
@@ -0,0 +1,187 @@
+/* -------------------------------------------------------------------------- *
+ *                     OpenSim:  testRotationKernels.cpp                      *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+// The batched kernels must agree with the SimTK::Rotation and
+// SimTK::Quaternion operations they replace.
+
+#include <OpenSim/Common/RotationKernels.h>
+#include <OpenSim/Common/TableUtilities.h>
+
+using namespace OpenSim;
+
+namespace {
+const double tol = 1e-12;
+
+// Random, unnormalized quaternions, including the identity and a zero
+// quaternion.
+SimTK::Matrix_<SimTK::Vec4> createQuaternionValues(int nrow, int ncol) {
+    SimTK::Random::Gaussian random;
+    random.setSeed(0);
+    SimTK::Matrix_<SimTK::Vec4> values(nrow, ncol);
+    for (int i = 0; i < nrow; ++i) {
+        for (int j = 0; j < ncol; ++j) {
+            for (int k = 0; k < 4; ++k) values(i, j)[k] = random.getValue();
+        }
+    }
+    values(0, 0) = SimTK::Vec4(1, 0, 0, 0);
+    values(1, 0) = SimTK::Vec4(0);
+    return values;
+}
+
+SimTK::Vec4 getQuaternion(const QuaternionArrays& q, int i) {
+    return SimTK::Vec4(q.w[i], q.x[i], q.y[i], q.z[i]);
+}
+
+SimTK::Mat33 getRotation(const RotationMatrixArrays& R, int i) {
+    SimTK::Mat33 m;
+    for (int k = 0; k < 9; ++k) m(k / 3, k % 3) = R.m[k][i];
+    return m;
+}
+}
+
+void testQuaternionKernels() {
+    const int n = 200;
+    const auto values = createQuaternionValues(n, 1);
+    QuaternionArrays q;
+    q.resize(n);
+    for (int i = 0; i < n; ++i) {
+        q.w[i] = values(i, 0)[0];
+        q.x[i] = values(i, 0)[1];
+        q.y[i] = values(i, 0)[2];
+        q.z[i] = values(i, 0)[3];
+    }
+
+    RotationKernels::normalize(q);
+    for (int i = 0; i < n; ++i) {
+        const SimTK::Quaternion expected(values(i, 0));
+        SimTK_TEST_EQ_TOL(getQuaternion(q, i), expected.asVec4(), tol);
+    }
+
+    RotationMatrixArrays R;
+    RotationKernels::convertQuaternionsToRotations(q, R);
+    SimTK_TEST(R.size() == (size_t)n);
+    for (int i = 0; i < n; ++i) {
+        const SimTK::Rotation expected(SimTK::Quaternion(values(i, 0)));
+        SimTK_TEST_EQ_TOL(getRotation(R, i), expected.asMat33(), tol);
+    }
+
+    QuaternionArrays roundTrip;
+    RotationKernels::convertRotationsToQuaternions(R, roundTrip);
+    for (int i = 0; i < n; ++i) {
+        const SimTK::Rotation rotation(SimTK::Quaternion(values(i, 0)));
+        SimTK_TEST_EQ_TOL(getQuaternion(roundTrip, i),
+                rotation.convertRotationToQuaternion().asVec4(), tol);
+    }
+
+    // Rotate.
+    const SimTK::Rotation R_XG(SimTK::BodyOrSpaceType::SpaceRotationSequence,
+            -SimTK::Pi / 2, SimTK::XAxis, 0.3, SimTK::YAxis, 1.1,
+            SimTK::ZAxis);
+    QuaternionArrays rotated = q;
+    RotationKernels::rotate(R_XG, rotated);
+    for (int i = 0; i < n; ++i) {
+        const SimTK::Rotation rotation(SimTK::Quaternion(values(i, 0)));
+        const SimTK::Quaternion expected =
+                (R_XG * rotation).convertRotationToQuaternion();
+        SimTK_TEST(rotated.w[i] >= 0);
+        SimTK_TEST_EQ_TOL(getQuaternion(rotated, i), expected.asVec4(), tol);
+    }
+}
+
+void testEulerAngles() {
+    const int n = 200;
+    const auto values = createQuaternionValues(n, 1);
+    RotationMatrixArrays R;
+    R.resize(n + 2);
+    for (int i = 0; i < n; ++i) {
+        const SimTK::Rotation rotation(SimTK::Quaternion(values(i, 0)));
+        for (int k = 0; k < 9; ++k) R.m[k][i] = rotation(k / 3, k % 3);
+    }
+    // Gimbal lock, where only the sum or difference of the x and z angles is
+    // defined.
+    const SimTK::Rotation up(SimTK::BodyRotationSequence, 0.4, SimTK::XAxis,
+            SimTK::Pi / 2, SimTK::YAxis, 0.2, SimTK::ZAxis);
+    const SimTK::Rotation down(SimTK::BodyRotationSequence, 0.4, SimTK::XAxis,
+            -SimTK::Pi / 2, SimTK::YAxis, 0.2, SimTK::ZAxis);
+    for (int k = 0; k < 9; ++k) {
+        R.m[k][n] = up(k / 3, k % 3);
+        R.m[k][n + 1] = down(k / 3, k % 3);
+    }
+
+    AngleArrays angles;
+    RotationKernels::convertRotationsToBodyFixedXYZ(R, angles);
+    for (int i = 0; i < n; ++i) {
+        const SimTK::Rotation rotation(SimTK::Quaternion(values(i, 0)));
+        SimTK_TEST_EQ_TOL(SimTK::Vec3(angles.x[i], angles.y[i], angles.z[i]),
+                rotation.convertRotationToBodyFixedXYZ(), tol);
+    }
+    for (int i = n; i < n + 2; ++i) {
+        const SimTK::Rotation rotation(SimTK::BodyRotationSequence,
+                angles.x[i], SimTK::XAxis, angles.y[i], SimTK::YAxis,
+                angles.z[i], SimTK::ZAxis);
+        SimTK_TEST_EQ_TOL(rotation.asMat33(), getRotation(R, i), 1e-10);
+    }
+}
+
+void testTableColumns() {
+    const int nrow = 50;
+    const int ncol = 3;
+    const auto values = createQuaternionValues(nrow, ncol);
+    SimTK::Matrix_<SimTK::Rotation> rotations(nrow, ncol);
+    for (int i = 0; i < nrow; ++i) {
+        for (int j = 0; j < ncol; ++j) {
+            rotations(i, j) = SimTK::Rotation(SimTK::Quaternion(values(i, j)));
+        }
+    }
+    std::vector<double> times(nrow);
+    for (int i = 0; i < nrow; ++i) times[i] = 0.01 * i;
+    TimeSeriesTable_<SimTK::Rotation> table(
+            times, rotations, {"a_imu", "b_imu", "c_imu"});
+
+    const auto euler = TableUtilities::convertRotationsToEulerAngles(table);
+    SimTK_TEST(euler.getNumRows() == (size_t)nrow);
+    SimTK_TEST(euler.getNumColumns() == (size_t)ncol);
+    for (int i = 0; i < nrow; ++i) {
+        for (int j = 0; j < ncol; ++j) {
+            SimTK_TEST_EQ_TOL(euler.getMatrix()(i, j),
+                    rotations(i, j).convertRotationToBodyFixedXYZ(), tol);
+        }
+    }
+
+    // Loading and storing a column leaves the other columns unchanged.
+    RotationMatrixArrays column;
+    RotationKernels::loadColumn(rotations, 1, column);
+    SimTK::Matrix_<SimTK::Rotation> copy(rotations);
+    RotationKernels::storeColumn(column, 2, copy);
+    for (int i = 0; i < nrow; ++i) {
+        SimTK_TEST_EQ(copy(i, 0).asMat33(), rotations(i, 0).asMat33());
+        SimTK_TEST_EQ(copy(i, 2).asMat33(), rotations(i, 1).asMat33());
+    }
+}
+
+int main() {
+    SimTK_START_TEST("testRotationKernels");
+        SimTK_SUBTEST(testQuaternionKernels);
+        SimTK_SUBTEST(testEulerAngles);
+        SimTK_SUBTEST(testTableColumns);
+    SimTK_END_TEST();
+}
@@ -36,7 +36,9 @@
 #include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
 #include "SimTKcommon.h"
 
+#include <clocale>
 #include <iostream>
+#include <memory>
 #include <string>
 
 #include "SerializableObject.h"
@@ -199,6 +201,66 @@ int main()
         cout << res << "\n";
     }
    
+    // Test the parsing of numeric property values, which does not go through
+    // SimTK::readUnformatted.
+    {
+        SimTK::Array_<double, int> values;
+        SimTK_TEST(readDoublesFromString(
+                "  1 -2.5e3\t0.125\n NaN -Inf infinity ", values));
+        SimTK_TEST(values.size() == 6);
+        SimTK_TEST(values[0] == 1 && values[1] == -2500 && values[2] == 0.125);
+        SimTK_TEST(SimTK::isNaN(values[3]));
+        SimTK_TEST(values[4] == -SimTK::Infinity);
+        SimTK_TEST(values[5] == SimTK::Infinity);
+        values.clear();
+        SimTK_TEST(readDoublesFromString("", values) && values.empty());
+        SimTK_TEST(!readDoublesFromString("1 2x 3", values));
+        SimTK_TEST(!readDoublesFromString("one", values));
+        // Hexadecimal numbers and "nan(...)" are not numbers in OpenSim files.
+        SimTK_TEST(!readDoublesFromString("0x10", values));
+        SimTK_TEST(!readDoublesFromString("nan(1)", values));
+
+        // The decimal point is '.' even if the locale uses ','.
+        const std::string previousLocale = std::setlocale(LC_NUMERIC, nullptr);
+        bool foundCommaLocale = false;
+        for (const char* name : {"de_DE.UTF-8", "de_DE.utf8", "de_DE",
+                     "German_Germany.1252", "fr_FR.UTF-8", "fr_FR"}) {
+            if (std::setlocale(LC_NUMERIC, name) &&
+                    std::localeconv()->decimal_point[0] == ',') {
+                foundCommaLocale = true;
+                break;
+            }
+        }
+        if (foundCommaLocale) {
+            values.clear();
+            SimTK_TEST(readDoublesFromString("0.5 1e-3", values));
+            SimTK_TEST(values.size() == 2);
+            SimTK_TEST(values[0] == 0.5 && values[1] == 1e-3);
+        } else {
+            cout << "No locale with a comma decimal point is installed; "
+                    "skipping the locale test." << endl;
+        }
+        std::setlocale(LC_NUMERIC, previousLocale.c_str());
+
+        SimTK::Array_<Vec3, int> vecs;
+        SimTK_TEST(readVecsFromString("1 2 3 4 5 6", vecs));
+        SimTK_TEST(vecs.size() == 2 && vecs[1] == Vec3(4, 5, 6));
+        SimTK_TEST(!readVecsFromString("1 2 3 4", vecs));
+
+        // Malformed values are rejected and the previous value is kept.
+        std::unique_ptr<Property<Vec3>> propertyVec3(
+                Property<Vec3>::TypeHelper::create("vec3", true));
+        propertyVec3->setValue(Vec3(7, 8, 9));
+        SimTK::Xml::Element good("Object");
+        good.appendNode(SimTK::Xml::Element("vec3", "0.5 -1 2e-3"));
+        propertyVec3->readFromXMLParentElement(good, 40000);
+        SimTK_TEST(propertyVec3->getValue() == Vec3(0.5, -1, 2e-3));
+        SimTK::Xml::Element bad("Object");
+        bad.appendNode(SimTK::Xml::Element("vec3", "0.5 oops 1"));
+        propertyVec3->readFromXMLParentElement(bad, 40000);
+        SimTK_TEST(propertyVec3->getValue() == Vec3(0.5, -1, 2e-3));
+    }
+
     // Test Property's toString() and toStringForDisplay() functionality
     cout << "Testing toString() and toStringForDisplay()" << endl;
     cout << "Input:  std::to_string() SimTK::writeUnformatted() Property::toString()" << endl;
@@ -170,6 +170,47 @@ void testStorageGetStateIndexBackwardsCompatibility() {
     // TODO: Put XML document version in Storage header.
 }
 
+void testStorageAppend() {
+    // Moving an Array takes over its elements and leaves it empty.
+    Array<double> values(0.0, 3);
+    values[0] = 1; values[1] = 2; values[2] = 3;
+    Array<double> moved(std::move(values));
+    SimTK_TEST(moved.getSize() == 3);
+    SimTK_TEST(moved[2] == 3);
+    SimTK_TEST(values.getSize() == 0);
+    values.append(4);
+    SimTK_TEST(values.getSize() == 1 && values[0] == 4);
+
+    Storage sto;
+    const int numRows = 1000;
+    sto.ensureCapacity(numRows);
+    double row[3];
+    for (int i = 0; i < numRows; ++i) {
+        for (int j = 0; j < 3; ++j) row[j] = 10 * i + j;
+        sto.append(0.01 * i, 3, row);
+    }
+    // Rows at the same time replace the last row.
+    row[0] = -1;
+    sto.append(0.01 * (numRows - 1), 3, row);
+    StateVector vec(0.01 * numRows, SimTK::Vector(3, 7.0));
+    sto.append(vec);
+    sto.append(StateVector(0.01 * (numRows + 1), SimTK::Vector(2, 8.0)));
+    SimTK_TEST(vec.getSize() == 3);
+
+    SimTK_TEST(sto.getSize() == numRows + 2);
+    for (int i = 0; i < numRows - 1; ++i) {
+        const StateVector& stored = *sto.getStateVector(i);
+        SimTK_TEST(stored.getTime() == 0.01 * i);
+        SimTK_TEST(stored.getSize() == 3);
+        for (int j = 0; j < 3; ++j) {
+            SimTK_TEST(stored.getData()[j] == 10 * i + j);
+        }
+    }
+    SimTK_TEST(sto.getStateVector(numRows - 1)->getData()[0] == -1);
+    SimTK_TEST(sto.getStateVector(numRows)->getData()[2] == 7);
+    SimTK_TEST(sto.getStateVector(numRows + 1)->getSize() == 2);
+}
+
 int main() {
     SimTK_START_TEST("testStorage");
 
@@ -188,6 +229,8 @@ int main() {
         SimTK_SUBTEST(testStorageLegacy);
 
         SimTK_SUBTEST(testStorageGetStateIndexBackwardsCompatibility);
+
+        SimTK_SUBTEST(testStorageAppend);
     SimTK_END_TEST();
 }
 
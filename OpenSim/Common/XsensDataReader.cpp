@@ -2,6 +2,7 @@
 #include "Simbody.h"
 #include "Exception.h"
 #include "FileAdapter.h"
+#include "RotationKernels.h"
 #include "TimeSeriesTable.h"
 #include "XsensDataReader.h"
 
@@ -28,7 +29,9 @@ XsensDataReader::extendRead(const std::string& folderName) const {
     int last_size = 1024;
     // Will read data into pre-allocated Matrices in-memory rather than appendRow
     // on the fly to avoid the overhead of 
-    SimTK::Matrix_<SimTK::Quaternion> rotationsData{ last_size, n_imus };
+    // Orientation matrices are collected per imu and converted to
+    // quaternions in batch once all rows are read.
+    std::vector<RotationMatrixArrays> imuMatrices(n_imus);
     SimTK::Matrix_<SimTK::Vec3> linearAccelerationData{ last_size, n_imus };
     SimTK::Matrix_<SimTK::Vec3> magneticHeadingData{ last_size, n_imus };
     SimTK::Matrix_<SimTK::Vec3> angularVelocityData{ last_size, n_imus };
@@ -101,8 +104,6 @@ XsensDataReader::extendRead(const std::string& folderName) const {
     int rowNumber = 0;
     while (!done){
         // Make vectors one per table
-        TimeSeriesTableQuaternion::RowVector
-            orientation_row_vector{ n_imus, SimTK::Quaternion() };
         TimeSeriesTableVec3::RowVector
             accel_row_vector{ n_imus, SimTK::Vec3(SimTK::NaN) };
         TimeSeriesTableVec3::RowVector
@@ -130,18 +131,16 @@ XsensDataReader::extendRead(const std::string& folderName) const {
             if (foundAngularVelocityData)
                 gyro_row_vector[imu_index] = SimTK::Vec3(std::stod(nextRow[gyroIndex]),
                     std::stod(nextRow[gyroIndex + 1]), std::stod(nextRow[gyroIndex + 2]));
-            // Create Mat33 then convert into Quaternion
-            SimTK::Mat33 imu_matrix{ SimTK::NaN };
+            // Matrix entries are stored in the file column by column
+            RotationMatrixArrays& imu_matrices = imuMatrices[imu_index];
             int matrix_entry_index = 0;
             for (int mcol = 0; mcol < 3; mcol++) {
                 for (int mrow = 0; mrow < 3; mrow++) {
-                    imu_matrix[mrow][mcol] = std::stod(nextRow[rotationsIndex + matrix_entry_index]);
+                    imu_matrices.m[3 * mrow + mcol].push_back(std::stod(
+                            nextRow[rotationsIndex + matrix_entry_index]));
                     matrix_entry_index++;
                 }
             }
-            // Convert imu_matrix to Quaternion
-            SimTK::Rotation imu_rotation{ imu_matrix };
-            orientation_row_vector[imu_index] = imu_rotation.convertRotationToQuaternion();
         }
         if (done) 
             break;
@@ -153,7 +152,6 @@ XsensDataReader::extendRead(const std::string& folderName) const {
             magneticHeadingData[rowNumber] = magneto_row_vector;
         if (foundAngularVelocityData) 
             angularVelocityData[rowNumber] = gyro_row_vector;
-        rotationsData[rowNumber] = orientation_row_vector;
         time += timeIncrement;
         rowNumber++;
         if (std::remainder(rowNumber, last_size) == 0) {
@@ -164,7 +162,6 @@ XsensDataReader::extendRead(const std::string& folderName) const {
             if (foundLinearAccelerationData) linearAccelerationData.resizeKeep(newSize, n_imus);
             if (foundMagneticHeadingData) magneticHeadingData.resizeKeep(newSize, n_imus);
             if (foundAngularVelocityData) angularVelocityData.resizeKeep(newSize, n_imus);
-            rotationsData.resizeKeep(newSize, n_imus);
             last_size = newSize;
         }
     }
@@ -177,7 +174,16 @@ XsensDataReader::extendRead(const std::string& folderName) const {
             n_imus);
     angularVelocityData.resizeKeep(foundAngularVelocityData? rowNumber :0,
         n_imus);
-    rotationsData.resizeKeep(rowNumber, n_imus);
+    // Convert the orientation matrices to quaternions, an imu at a time.
+    // Imus read before another imu's file ended have an extra, partial row.
+    SimTK::Matrix_<SimTK::Quaternion> rotationsData{ rowNumber, n_imus };
+    QuaternionArrays imu_quaternions;
+    for (int imu_index = 0; imu_index < n_imus; ++imu_index) {
+        imuMatrices[imu_index].resize(rowNumber);
+        RotationKernels::convertRotationsToQuaternions(
+                imuMatrices[imu_index], imu_quaternions);
+        RotationKernels::storeColumn(imu_quaternions, imu_index, rotationsData);
+    }
 
     // Now create the tables from matrices
     // Create 4 tables for Rotations, LinearAccelerations, AngularVelocity, MagneticHeading
@@ -43,6 +43,7 @@
 #include "PiecewiseConstantFunction.h"
 #include "PiecewiseLinearFunction.h"
 #include "PolynomialFunction.h"
+#include "Profiler.h"
 #include "RegisterTypes_osimCommon.h" // to expose RegisterTypes_osimCommon
 #include "Reporter.h"
 #include "Scale.h"
@@ -20,6 +20,11 @@
 
 #include "CasOCProblem.h"
 
+#include <OpenSim/Common/CommonUtilities.h>
+#include <OpenSim/Common/Stopwatch.h>
+
+#include <fstream>
+
 using namespace CasOC;
 
 casadi::Sparsity calcJacobianSparsityWithPerturbation(const VectorDM& x0s,
@@ -73,7 +78,265 @@ casadi::Sparsity calcJacobianSparsityWithPerturbation(const VectorDM& x0s,
     return combinedSparsity;
 }
 
+/// Create a sparsity pattern with numRows rows in which every row has a
+/// nonzero in each column for which columnMask is true.
+casadi::Sparsity createSparsityFromColumnMask(
+        casadi_int numRows, const std::vector<bool>& columnMask) {
+    std::vector<casadi_int> rows;
+    std::vector<casadi_int> cols;
+    for (casadi_int icol = 0; icol < (casadi_int)columnMask.size(); ++icol) {
+        if (!columnMask[icol]) continue;
+        for (casadi_int irow = 0; irow < numRows; ++irow) {
+            rows.push_back(irow);
+            cols.push_back(icol);
+        }
+    }
+    return casadi::Sparsity::triplet(
+            numRows, (casadi_int)columnMask.size(), rows, cols);
+}
+
+/// The Jacobian sparsity for the outputs of the multibody system functions
+/// (multibody derivatives or residuals, auxiliary derivatives, auxiliary
+/// residuals, and kinematic constraint errors) with respect to the continuous
+/// inputs. The multibody equations and kinematic constraint errors depend on
+/// all inputs except the controls that the problem excludes. The auxiliary
+/// equations depend on all of time, the multibody states, the multipliers,
+/// the accelerations, and the parameters, but only on the auxiliary states,
+/// controls, and auxiliary derivatives given by the problem's auxiliary
+/// dynamics sparsity.
+casadi::Sparsity createMultibodySystemJacobianSparsity(
+        const Problem& problem, int numKinematicConstraintErrors) {
+    const casadi_int NMB = problem.getNumMultibodyDynamicsEquations();
+    const casadi_int NS = problem.getNumStates();
+    const casadi_int NZ = problem.getNumAuxiliaryStates();
+    const casadi_int NC = problem.getNumControls();
+    const casadi_int NM = problem.getNumMultipliers();
+    const casadi_int NA = problem.getNumAccelerations();
+    const casadi_int NR = problem.getNumAuxiliaryResidualEquations();
+    const casadi_int NP = problem.getNumParameters();
+    const casadi_int NKC = numKinematicConstraintErrors;
+
+    // Column offsets of the blocks of the stacked inputs.
+    const casadi_int auxStatesOffset = 1 + NS - NZ;
+    const casadi_int controlsOffset = 1 + NS;
+    const casadi_int multipliersOffset = controlsOffset + NC;
+    const casadi_int auxDerivsOffset = multipliersOffset + NM + NA;
+    const casadi_int numCols = auxDerivsOffset + NR + NP;
+
+    std::vector<casadi_int> rows;
+    std::vector<casadi_int> cols;
+    auto addEntireRow = [&](casadi_int irow,
+                                const std::vector<bool>& controlMask) {
+        for (casadi_int icol = 0; icol < numCols; ++icol) {
+            if (icol >= controlsOffset && icol < multipliersOffset &&
+                    !controlMask[icol - controlsOffset]) {
+                continue;
+            }
+            rows.push_back(irow);
+            cols.push_back(icol);
+        }
+    };
+
+    // Multibody equations and kinematic constraint errors.
+    std::vector<bool> multibodyControlMask(NC, false);
+    {
+        std::vector<casadi_int> mbRows;
+        std::vector<casadi_int> mbCols;
+        problem.getMultibodyControlSparsity().get_triplet(mbRows, mbCols);
+        for (const auto& icontrol : mbCols) {
+            multibodyControlMask[icontrol] = true;
+        }
+    }
+    for (casadi_int irow = 0; irow < NMB; ++irow) {
+        addEntireRow(irow, multibodyControlMask);
+    }
+    const casadi_int kcOffset = NMB + NZ + NR;
+    for (casadi_int irow = 0; irow < NKC; ++irow) {
+        addEntireRow(kcOffset + irow, multibodyControlMask);
+    }
+
+    // Auxiliary derivatives and residuals.
+    for (casadi_int irow = 0; irow < NZ + NR; ++irow) {
+        // Time, the multibody states, multipliers, accelerations and
+        // parameters. The auxiliary states, controls, and auxiliary
+        // derivatives are added below.
+        for (casadi_int icol = 0; icol < numCols; ++icol) {
+            if ((icol >= auxStatesOffset && icol < multipliersOffset) ||
+                    (icol >= auxDerivsOffset && icol < auxDerivsOffset + NR)) {
+                continue;
+            }
+            rows.push_back(NMB + irow);
+            cols.push_back(icol);
+        }
+    }
+    {
+        // The columns of the auxiliary dynamics sparsity are the auxiliary
+        // states, controls, and auxiliary derivatives.
+        std::vector<casadi_int> auxRows;
+        std::vector<casadi_int> auxCols;
+        problem.getAuxiliaryDynamicsSparsity().get_triplet(auxRows, auxCols);
+        for (int i = 0; i < (int)auxRows.size(); ++i) {
+            const casadi_int icol = auxCols[i];
+            rows.push_back(NMB + auxRows[i]);
+            if (icol < NZ) {
+                cols.push_back(auxStatesOffset + icol);
+            } else if (icol < NZ + NC) {
+                cols.push_back(controlsOffset + icol - NZ);
+            } else {
+                cols.push_back(auxDerivsOffset + icol - NZ - NC);
+            }
+        }
+    }
+
+    return casadi::Sparsity::triplet(
+            NMB + NZ + NR + NKC, numCols, rows, cols);
+}
+
+bool Function::has_jacobian_sparsity() const {
+    return m_casProblem->getStructuralSparsity() ||
+           !m_fullPointsForSparsityDetection->empty();
+}
+
+casadi::Sparsity Function::getStructuralJacobianSparsity() const {
+    return casadi::Sparsity::dense(this->nnz_out(), this->nnz_in());
+}
+
+std::vector<bool> Function::createContinuousInputMask(
+        const InputDependencies& deps) const {
+    std::vector<bool> mask;
+    auto append = [&mask](int size, bool value) {
+        mask.insert(mask.end(), size, value);
+    };
+    append(1, true);
+    append(m_casProblem->getNumStates(), deps.states);
+    append(m_casProblem->getNumControls(), deps.controls);
+    append(m_casProblem->getNumMultipliers(), deps.multipliers);
+    append(m_casProblem->getNumAccelerations(), deps.accelerations);
+    append(m_casProblem->getNumAuxiliaryResidualEquations(),
+            deps.auxiliary_derivatives);
+    append(m_casProblem->getNumParameters(), deps.parameters);
+    return mask;
+}
+
+namespace {
+
+const std::string sparsityCacheHeader = "CasOC Jacobian sparsity cache 3";
+
+/// Read a sparsity pattern written by writeSparsityCacheFile(). Returns false
+/// if the file does not exist or does not match the key, function name, or
+/// dimensions.
+bool readSparsityCacheFile(const std::string& fileName, const std::string& key,
+        const std::string& functionName, casadi_int numRows,
+        casadi_int numCols, casadi::Sparsity& sparsity,
+        double& detectionTime) {
+    std::ifstream file(fileName);
+    if (!file) return false;
+    std::string header, fileFunctionName, fileKey;
+    std::getline(file, header);
+    std::getline(file, fileFunctionName);
+    std::getline(file, fileKey);
+    if (header != sparsityCacheHeader || fileFunctionName != functionName ||
+            fileKey != key) {
+        return false;
+    }
+    casadi_int fileNumRows, fileNumCols, numNonzeros;
+    if (!(file >> detectionTime >> fileNumRows >> fileNumCols >> numNonzeros))
+        return false;
+    if (fileNumRows != numRows || fileNumCols != numCols) return false;
+    std::vector<casadi_int> rows(numNonzeros);
+    std::vector<casadi_int> cols(numNonzeros);
+    for (casadi_int i = 0; i < numNonzeros; ++i) {
+        if (!(file >> rows[i] >> cols[i])) return false;
+        if (rows[i] < 0 || rows[i] >= numRows || cols[i] < 0 ||
+                cols[i] >= numCols) {
+            return false;
+        }
+    }
+    sparsity = casadi::Sparsity::triplet(numRows, numCols, rows, cols);
+    return true;
+}
+
+/// Write the file atomically, so that solves running concurrently never read
+/// a partially-written file. Failing to write the cache is not an error.
+void writeSparsityCacheFile(const std::string& fileName,
+        const std::string& key, const std::string& functionName,
+        const casadi::Sparsity& sparsity, double detectionTime) {
+    try {
+        OpenSim::writeFileAtomically(
+                fileName, [&](const std::string& temporaryPath) {
+                    std::ofstream file(temporaryPath);
+                    OPENSIM_THROW_IF(!file, OpenSim::Exception,
+                            "Could not open '{}'.", temporaryPath);
+                    std::vector<casadi_int> rows;
+                    std::vector<casadi_int> cols;
+                    sparsity.get_triplet(rows, cols);
+                    file << sparsityCacheHeader << "\n"
+                         << functionName << "\n"
+                         << key << "\n"
+                         << detectionTime << "\n"
+                         << sparsity.size1() << " " << sparsity.size2() << " "
+                         << rows.size() << "\n";
+                    for (int i = 0; i < (int)rows.size(); ++i) {
+                        file << rows[i] << " " << cols[i] << "\n";
+                    }
+                    OPENSIM_THROW_IF(!file, OpenSim::Exception,
+                            "Could not write '{}'.", temporaryPath);
+                });
+    } catch (const std::exception& e) {
+        OpenSim::log_warn("[CasOC] Could not write sparsity cache file '{}': "
+                          "{}",
+                fileName, e.what());
+    }
+}
+
+} // anonymous namespace
+
 casadi::Sparsity Function::get_jacobian_sparsity() const {
+    if (m_casProblem->getStructuralSparsity()) {
+        const auto sparsity = getStructuralJacobianSparsity();
+        OPENSIM_THROW_IF(sparsity.size1() != this->nnz_out() ||
+                                 sparsity.size2() != this->nnz_in(),
+                OpenSim::Exception, "Internal error.");
+        return sparsity;
+    }
+
+    const std::string& cacheDir = m_casProblem->getSparsityCacheDirectory();
+    if (cacheDir.empty()) return detectJacobianSparsity();
+
+    // The key is a hash of everything that affects the sparsity of the
+    // problem's functions; the file name is a hash of the key and the
+    // function name, and the file also contains the key and the function
+    // name.
+    const std::string& key = m_casProblem->getSparsityCacheKey();
+    const std::string functionName = name();
+    OpenSim::ContentHash hash;
+    hash.update(key);
+    hash.update(functionName);
+    const std::string fileName =
+            fmt::format("{}/{}.sparsity", cacheDir, hash.toString());
+
+    casadi::Sparsity sparsity;
+    double detectionTime = 0;
+    if (readSparsityCacheFile(fileName, key, functionName, this->nnz_out(),
+                this->nnz_in(), sparsity, detectionTime)) {
+        OpenSim::log_info("[CasOC] Sparsity cache hit for function '{}' "
+                          "(saved {:.3f} s); read file '{}'.",
+                functionName, detectionTime, fileName);
+        return sparsity;
+    }
+
+    OpenSim::Stopwatch stopwatch;
+    sparsity = detectJacobianSparsity();
+    detectionTime = stopwatch.getElapsedTime();
+    OpenSim::log_info("[CasOC] Sparsity cache miss for function '{}' "
+                      "(detection took {:.3f} s); writing file '{}'.",
+            functionName, detectionTime, fileName);
+    writeSparsityCacheFile(
+            fileName, key, functionName, sparsity, detectionTime);
+    return sparsity;
+}
+
+casadi::Sparsity Function::detectJacobianSparsity() const {
     using casadi::DM;
     using casadi::Slice;
 
@@ -142,6 +405,11 @@ VectorDM PathConstraint::eval(const VectorDM& args) const {
     return out;
 }
 
+casadi::Sparsity Integrand::getStructuralJacobianSparsity() const {
+    return createSparsityFromColumnMask(
+            1, createContinuousInputMask(m_dependencies));
+}
+
 VectorDM CostIntegrand::eval(const VectorDM& args) const {
     Problem::ContinuousInput input{args.at(0).scalar(), args.at(1), args.at(2),
             args.at(3), args.at(4), args.at(5)};
@@ -188,6 +456,20 @@ casadi::Sparsity Endpoint::get_sparsity_in(casadi_int i) {
         return casadi::Sparsity(0, 0);
     }
 }
+casadi::Sparsity Endpoint::getStructuralJacobianSparsity() const {
+    // The inputs are the continuous inputs (without parameters) at the
+    // initial time, then at the final time, then the parameters and the
+    // integral.
+    const int NP = m_casProblem->getNumParameters();
+    std::vector<bool> endpointMask = createContinuousInputMask(m_dependencies);
+    endpointMask.resize(endpointMask.size() - NP);
+    std::vector<bool> mask(endpointMask);
+    mask.insert(mask.end(), endpointMask.begin(), endpointMask.end());
+    mask.insert(mask.end(), NP, m_dependencies.parameters);
+    mask.push_back(true);
+    return createSparsityFromColumnMask(m_numEquations, mask);
+}
+
 VectorDM Cost::eval(const VectorDM& args) const {
     Problem::CostInput input{args.at(0).scalar(), args.at(1), args.at(2),
             args.at(3), args.at(4), args.at(5).scalar(), args.at(6), args.at(7),
@@ -244,6 +526,14 @@ VectorDM MultibodySystemExplicit<CalcKCErrors>::eval(
     return out;
 }
 
+template <bool CalcKCErrors>
+casadi::Sparsity
+MultibodySystemExplicit<CalcKCErrors>::getStructuralJacobianSparsity() const {
+    return createMultibodySystemJacobianSparsity(*m_casProblem,
+            CalcKCErrors ? m_casProblem->getNumKinematicConstraintEquations()
+                         : 0);
+}
+
 template class CasOC::MultibodySystemExplicit<false>;
 template class CasOC::MultibodySystemExplicit<true>;
 
@@ -330,5 +620,13 @@ VectorDM MultibodySystemImplicit<CalcKCErrors>::eval(
     return out;
 }
 
+template <bool CalcKCErrors>
+casadi::Sparsity
+MultibodySystemImplicit<CalcKCErrors>::getStructuralJacobianSparsity() const {
+    return createMultibodySystemJacobianSparsity(*m_casProblem,
+            CalcKCErrors ? m_casProblem->getNumKinematicConstraintEquations()
+                         : 0);
+}
+
 template class CasOC::MultibodySystemImplicit<false>;
 template class CasOC::MultibodySystemImplicit<true>;
@@ -28,6 +28,20 @@ class Problem;
 
 using VectorDM = std::vector<casadi::DM>;
 
+/// The categories of variables on which a cost or endpoint constraint may
+/// depend. This is used to create the sparsity pattern of the Jacobian of the
+/// functions for these terms when using "structural" sparsity detection (see
+/// Solver::setSparsityDetection()). Time is always assumed to be a dependency.
+/// By default, a function depends on all variables.
+struct InputDependencies {
+    bool states = true;
+    bool controls = true;
+    bool multipliers = true;
+    bool accelerations = true;
+    bool auxiliary_derivatives = true;
+    bool parameters = true;
+};
+
 class Function : public casadi::Callback {
 public:
     virtual ~Function() = default;
@@ -58,12 +72,25 @@ public:
         }
     }
     casadi::Sparsity get_sparsity_in(casadi_int i) override;
-    bool has_jacobian_sparsity() const override {
-        return !m_fullPointsForSparsityDetection->empty();
-    }
+    bool has_jacobian_sparsity() const override;
     casadi::Sparsity get_jacobian_sparsity() const override;
 
 protected:
+    /// The sparsity pattern of the Jacobian of the outputs (stacked) with
+    /// respect to the inputs (stacked), created from the dependencies
+    /// described in the Problem rather than by perturbing the function. This
+    /// is used when the Problem's sparsity is structural. The default
+    /// implementation is dense.
+    virtual casadi::Sparsity getStructuralJacobianSparsity() const;
+    /// Flags for each entry of the stacked inputs time, states, controls,
+    /// multipliers, derivatives, and parameters; an entry is true if the
+    /// corresponding dependency is true.
+    std::vector<bool> createContinuousInputMask(
+            const InputDependencies& deps) const;
+    /// Detect the sparsity pattern by perturbing the function about the
+    /// points for sparsity detection.
+    casadi::Sparsity detectJacobianSparsity() const;
+
     const Problem* m_casProblem;
 
 private:
@@ -147,9 +174,14 @@ public:
         else
             return casadi::Sparsity(0, 0);
     }
+    void setInputDependencies(InputDependencies deps) {
+        m_dependencies = std::move(deps);
+    }
 
 protected:
+    casadi::Sparsity getStructuralJacobianSparsity() const override;
     int m_index = -1;
+    InputDependencies m_dependencies;
 };
 
 class CostIntegrand : public Integrand {
@@ -233,9 +265,14 @@ public:
                 // variable.
                 casadi::DM::zeros(1, 1)});
     }
+    void setInputDependencies(InputDependencies deps) {
+        m_dependencies = std::move(deps);
+    }
 protected:
+    casadi::Sparsity getStructuralJacobianSparsity() const override;
     int m_index = -1;
     int m_numEquations = -1;
+    InputDependencies m_dependencies;
 };
 
 /// This invokes CasOC::Problem::calcCost().
@@ -268,6 +305,9 @@ public:
     }
     casadi::Sparsity get_sparsity_out(casadi_int i) override final;
     VectorDM eval(const VectorDM& args) const override;
+
+protected:
+    casadi::Sparsity getStructuralJacobianSparsity() const override;
 };
 
 /// This function should compute a velocity correction term to make feasible
@@ -311,6 +351,7 @@ class MultibodySystemImplicit : public Function {
     }
     casadi::Sparsity get_sparsity_out(casadi_int i) override final;
     VectorDM eval(const VectorDM& args) const override;
+    casadi::Sparsity getStructuralJacobianSparsity() const override;
 };
 
 } // namespace CasOC
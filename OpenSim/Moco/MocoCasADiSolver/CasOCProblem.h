@@ -90,6 +90,7 @@ struct EndpointInfo {
     int num_outputs;
     std::unique_ptr<Integrand> integrand_function;
     std::unique_ptr<Endpoint> endpoint_function;
+    InputDependencies dependencies;
 };
 
 struct CostInfo : EndpointInfo {
@@ -244,8 +245,10 @@ protected:
     void addParameter(std::string name, Bounds bounds) {
         m_paramInfos.push_back({std::move(name), std::move(bounds)});
     }
-    /// Add a cost term to the problem.
-    void addCost(std::string name, int numIntegrals, int numOutputs) {
+    /// Add a cost term to the problem. The dependencies are used only with
+    /// "structural" sparsity detection.
+    void addCost(std::string name, int numIntegrals, int numOutputs,
+            InputDependencies dependencies = InputDependencies()) {
         OPENSIM_THROW_IF(numIntegrals < 0 || numIntegrals > 1,
                 OpenSim::Exception, "numIntegrals must be 0 or 1.");
         std::unique_ptr<CostIntegrand> integrand_function;
@@ -255,10 +258,13 @@ protected:
         m_costInfos.emplace_back(std::move(name), numOutputs,
                 std::move(integrand_function),
                 OpenSim::make_unique<Cost>());
+        m_costInfos.back().dependencies = dependencies;
     }
-    /// Add an endpoint constraint to the problem.
-    void addEndpointConstraint(
-            std::string name, int numIntegrals, std::vector<Bounds> bounds) {
+    /// Add an endpoint constraint to the problem. The dependencies are used
+    /// only with "structural" sparsity detection.
+    void addEndpointConstraint(std::string name, int numIntegrals,
+            std::vector<Bounds> bounds,
+            InputDependencies dependencies = InputDependencies()) {
         OPENSIM_THROW_IF(numIntegrals < 0 || numIntegrals > 1,
                 OpenSim::Exception, "numIntegrals must be 0 or 1.");
         std::unique_ptr<EndpointConstraintIntegrand> integrand_function;
@@ -276,6 +282,7 @@ protected:
                 (int)bounds.size(), std::move(integrand_function),
                 OpenSim::make_unique<EndpointConstraint>(), std::move(lower),
                 std::move(upper));
+        m_endpointConstraintInfos.back().dependencies = dependencies;
     }
     /// The size of bounds must match the number of outputs in the function.
     void addPathConstraint(std::string name, std::vector<Bounds> bounds) {
@@ -299,6 +306,25 @@ protected:
         m_auxiliaryDerivativeNames = names;
         m_numAuxiliaryResiduals = (int)names.size();
     }
+    /// Describe which variables the auxiliary dynamics depend on, for
+    /// "structural" sparsity detection. The rows of the pattern are the
+    /// auxiliary state derivatives followed by the auxiliary residuals; the
+    /// columns are the auxiliary states, the controls, and the auxiliary
+    /// derivatives, in that order. A nonzero indicates that the row may depend
+    /// on the column. The auxiliary dynamics are always assumed to depend on
+    /// time, the generalized coordinates and speeds, the multipliers, the
+    /// accelerations, and the parameters. If this is not set, the auxiliary
+    /// dynamics are assumed to depend on all variables.
+    void setAuxiliaryDynamicsSparsity(casadi::Sparsity sparsity) {
+        m_auxiliaryDynamicsSparsity = std::move(sparsity);
+    }
+    /// Describe which controls may affect the multibody dynamics and the
+    /// kinematic constraint errors, for "structural" sparsity detection. The
+    /// pattern is a row vector with a column for each control. If this is not
+    /// set, all controls are assumed to affect the multibody dynamics.
+    void setMultibodyControlSparsity(casadi::Sparsity sparsity) {
+        m_multibodyControlSparsity = std::move(sparsity);
+    }
 
 public:
     /// Kinematic constraint errors should be ordered as so:
@@ -379,19 +405,56 @@ public:
         return it;
     }
 
+    /// If structuralSparsity is true, the Jacobian sparsity of the functions
+    /// is created from the dependencies provided while building the problem
+    /// instead of from pointsForSparsityDetection. If sparsityCacheDirectory
+    /// is not empty, the sparsity detected from pointsForSparsityDetection is
+    /// saved to and loaded from files in this directory, under
+    /// sparsityCacheKey, a hash of everything that affects the sparsity (see
+    /// Solver::setSparsityCache()).
     void initialize(const std::string& finiteDiffScheme,
             std::shared_ptr<const std::vector<VariablesDM>>
-                    pointsForSparsityDetection) const {
+                    pointsForSparsityDetection,
+            bool structuralSparsity = false,
+            std::string sparsityCacheDirectory = "",
+            std::string sparsityCacheKey = "") const {
         auto* mutThis = const_cast<Problem*>(this);
+        mutThis->m_structuralSparsity = structuralSparsity;
+        mutThis->m_sparsityCacheDirectory = std::move(sparsityCacheDirectory);
+        mutThis->m_sparsityCacheKey = std::move(sparsityCacheKey);
+        if (structuralSparsity) {
+            const int numAuxRows = getNumAuxiliaryStates() +
+                                   getNumAuxiliaryResidualEquations();
+            const int numAuxCols = getNumAuxiliaryStates() + getNumControls() +
+                                   getNumAuxiliaryResidualEquations();
+            const auto aux = getAuxiliaryDynamicsSparsity();
+            OPENSIM_THROW_IF(aux.size1() != numAuxRows ||
+                                     aux.size2() != numAuxCols,
+                    OpenSim::Exception,
+                    "Expected the auxiliary dynamics sparsity to have "
+                    "dimensions {} x {}, but it has dimensions {} x {}.",
+                    numAuxRows, numAuxCols, aux.size1(), aux.size2());
+            const auto mbControls = getMultibodyControlSparsity();
+            OPENSIM_THROW_IF(mbControls.size1() != 1 ||
+                                     mbControls.size2() != getNumControls(),
+                    OpenSim::Exception,
+                    "Expected the multibody control sparsity to have "
+                    "dimensions 1 x {}, but it has dimensions {} x {}.",
+                    getNumControls(), mbControls.size1(), mbControls.size2());
+        }
 
         {
             int index = 0;
             for (const auto& costInfo : mutThis->m_costInfos) {
+                costInfo.endpoint_function->setInputDependencies(
+                        costInfo.dependencies);
                 costInfo.endpoint_function->constructFunction(this,
                         "cost_" + costInfo.name + "_endpoint", index,
                         costInfo.num_outputs, finiteDiffScheme,
                         pointsForSparsityDetection);
                 if (costInfo.integrand_function) {
+                    costInfo.integrand_function->setInputDependencies(
+                            costInfo.dependencies);
                     costInfo.integrand_function->constructFunction(this,
                             "cost_" + costInfo.name + "_integrand", index,
                             finiteDiffScheme, pointsForSparsityDetection);
@@ -402,11 +465,15 @@ public:
         {
             int index = 0;
             for (const auto& info : mutThis->m_endpointConstraintInfos) {
+                info.endpoint_function->setInputDependencies(
+                        info.dependencies);
                 info.endpoint_function->constructFunction(this,
                         "endpoint_constraint_" + info.name + "_endpoint", index,
                         info.num_outputs, finiteDiffScheme,
                         pointsForSparsityDetection);
                 if (info.integrand_function) {
+                    info.integrand_function->setInputDependencies(
+                            info.dependencies);
                     info.integrand_function->constructFunction(this,
                             "endpoint_constraint_" + info.name + "_integrand", index,
                             finiteDiffScheme, pointsForSparsityDetection);
@@ -567,6 +634,33 @@ public:
     const std::vector<PathConstraintInfo>& getPathConstraintInfos() const {
         return m_pathInfos;
     }
+    /// Whether the Jacobian sparsity of the functions should be created from
+    /// the dependencies provided while building the problem.
+    bool getStructuralSparsity() const { return m_structuralSparsity; }
+    /// If empty, detected sparsity patterns are not cached.
+    const std::string& getSparsityCacheDirectory() const {
+        return m_sparsityCacheDirectory;
+    }
+    const std::string& getSparsityCacheKey() const {
+        return m_sparsityCacheKey;
+    }
+    /// If setAuxiliaryDynamicsSparsity() was not called, this is dense.
+    casadi::Sparsity getAuxiliaryDynamicsSparsity() const {
+        if (m_auxiliaryDynamicsSparsity.is_empty(true)) {
+            return casadi::Sparsity::dense(
+                    getNumAuxiliaryStates() + getNumAuxiliaryResidualEquations(),
+                    getNumAuxiliaryStates() + getNumControls() +
+                            getNumAuxiliaryResidualEquations());
+        }
+        return m_auxiliaryDynamicsSparsity;
+    }
+    /// If setMultibodyControlSparsity() was not called, this is dense.
+    casadi::Sparsity getMultibodyControlSparsity() const {
+        if (m_multibodyControlSparsity.is_empty(true)) {
+            return casadi::Sparsity::dense(1, getNumControls());
+        }
+        return m_multibodyControlSparsity;
+    }
     /// Get a function to the full multibody system (i.e. including kinematic
     /// constraints errors).
     const casadi::Function& getMultibodySystem() const {
@@ -626,6 +720,11 @@ private:
     std::vector<CostInfo> m_costInfos;
     std::vector<EndpointConstraintInfo> m_endpointConstraintInfos;
     std::vector<PathConstraintInfo> m_pathInfos;
+    casadi::Sparsity m_auxiliaryDynamicsSparsity;
+    casadi::Sparsity m_multibodyControlSparsity;
+    bool m_structuralSparsity = false;
+    std::string m_sparsityCacheDirectory;
+    std::string m_sparsityCacheKey;
     std::unique_ptr<MultibodySystemExplicit<true>> m_multibodyFunc;
     std::unique_ptr<MultibodySystemExplicit<false>>
             m_multibodyFuncIgnoringConstraints;
@@ -22,10 +22,14 @@
 
 #include <OpenSim/Moco/MocoUtilities.h>
 
+#include <algorithm>
+
 using OpenSim::Exception;
 
 namespace CasOC {
 
+Solver::~Solver() = default;
+
 std::unique_ptr<Transcription> Solver::createTranscription() const {
     std::unique_ptr<Transcription> transcription;
     if (m_transcriptionScheme == "trapezoidal") {
@@ -39,19 +43,45 @@ std::unique_ptr<Transcription> Solver::createTranscription() const {
     return transcription;
 }
 
+Transcription& Solver::getTranscription() const {
+    if (!m_transcription) m_transcription = createTranscription();
+    return *m_transcription;
+}
+
 Iterate Solver::createInitialGuessFromBounds() const {
-    auto transcription = createTranscription();
-    return transcription->createInitialGuessFromBounds();
+    return getTranscription().createInitialGuessFromBounds();
 }
 
 Iterate Solver::createRandomIterateWithinBounds() const {
-    auto transcription = createTranscription();
-    return transcription->createRandomIterateWithinBounds();
+    return getTranscription().createRandomIterateWithinBounds();
+}
+
+void Solver::setCostWeight(const std::string& name, double weight) {
+    const auto& infos = m_problem.getCostInfos();
+    for (int i = 0; i < (int)infos.size(); ++i) {
+        if (infos[i].name == name) {
+            getTranscription().setCostWeight(i, weight);
+            return;
+        }
+    }
+    OPENSIM_THROW(Exception, "No cost named '{}'.", name);
+}
+
+void Solver::setParameterBounds(const std::string& name, const Bounds& bounds) {
+    const auto& infos = m_problem.getParameterInfos();
+    for (int i = 0; i < (int)infos.size(); ++i) {
+        if (infos[i].name == name) {
+            getTranscription().setParameterBounds(i, bounds);
+            return;
+        }
+    }
+    OPENSIM_THROW(Exception, "No parameter named '{}'.", name);
 }
 
 void Solver::setSparsityDetection(const std::string& setting) {
     OPENSIM_THROW_IF(setting != "none" && setting != "random" &&
-                             setting != "initial-guess",
+                             setting != "initial-guess" &&
+                             setting != "structural",
             Exception);
     m_sparsity_detection = setting;
 }
@@ -69,14 +99,16 @@ void Solver::setParallelism(std::string parallelism, int numThreads) {
 }
 
 Solution Solver::solve(const Iterate& guess) const {
-    auto transcription = createTranscription();
+    auto& transcription = getTranscription();
+    if (m_problemInitialized) return transcription.solve(guess);
+
     auto pointsForSparsityDetection =
             std::make_shared<std::vector<VariablesDM>>();
     if (m_sparsity_detection == "initial-guess") {
         // Interpolate the guess.
         Iterate guessCopy(guess);
         const auto guessTimes =
-                transcription->createTimes(guessCopy.variables.at(initial_time),
+                transcription.createTimes(guessCopy.variables.at(initial_time),
                         guessCopy.variables.at(final_time));
         guessCopy = guessCopy.resample(guessTimes);
         pointsForSparsityDetection->push_back(guessCopy.variables);
@@ -86,15 +118,44 @@ Solution Solver::solve(const Iterate& guess) const {
         randGen->setSeed(0);
         for (int i = 0; i < m_sparsity_detection_random_count; ++i) {
             pointsForSparsityDetection->push_back(
-                    transcription->createRandomIterateWithinBounds(
+                    transcription.createRandomIterateWithinBounds(
                                          randGen.get())
                             .variables);
         }
     }
+    // The cache key is a hash of the structure of the problem and of the
+    // points for sparsity detection; the points depend on the mesh, the
+    // bounds, and (for "initial-guess") the guess.
+    std::string sparsityCacheDirectory;
+    std::string sparsityCacheKey;
+    if (!m_sparsityCacheDirectory.empty() &&
+            !pointsForSparsityDetection->empty()) {
+        sparsityCacheDirectory = m_sparsityCacheDirectory;
+        OpenSim::ContentHash hash;
+        hash.update(m_sparsity_detection);
+        hash.update(m_sparsityCacheStructureHash);
+        for (const auto& point : *pointsForSparsityDetection) {
+            // Visit the variables in a fixed order.
+            std::vector<int> vars;
+            for (const auto& kv : point) vars.push_back(kv.first);
+            std::sort(vars.begin(), vars.end());
+            for (const auto& var : vars) {
+                const auto& values = point.at((Var)var).nonzeros();
+                const int numValues = (int)values.size();
+                hash.update(&var, sizeof(var));
+                hash.update(&numValues, sizeof(numValues));
+                hash.update(values.data(), values.size() * sizeof(double));
+            }
+        }
+        sparsityCacheKey = hash.toString();
+    }
     m_problem.initialize(m_finite_difference_scheme,
             std::const_pointer_cast<const std::vector<VariablesDM>>(
-                    pointsForSparsityDetection));
-    return transcription->solve(guess);
+                    pointsForSparsityDetection),
+            m_sparsity_detection == "structural",
+            std::move(sparsityCacheDirectory), std::move(sparsityCacheKey));
+    m_problemInitialized = true;
+    return transcription.solve(guess);
 }
 
 } // namespace CasOC
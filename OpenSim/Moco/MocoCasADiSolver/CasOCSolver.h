@@ -35,6 +35,7 @@ class Transcription;
 class Solver {
 public:
     Solver(const Problem& problem) : m_problem(problem) {}
+    ~Solver();
     void setNumMeshIntervals(int numMeshIntervals) {
         for (int i = 0; i < (numMeshIntervals + 1); ++i) {
             m_mesh.push_back(i / (double)(numMeshIntervals));
@@ -147,12 +148,28 @@ public:
 
     int getCallbackInterval() const { return m_callbackInterval; }
     /// "none" to use block sparsity (treat all CasOC::Function%s as dense;
-    /// default), "initial-guess", or "random".
+    /// default), "initial-guess", "random", or "structural". With
+    /// "structural", the sparsity is created from the dependencies that the
+    /// Problem describes (see Problem::setAuxiliaryDynamicsSparsity()),
+    /// without evaluating the functions.
     void setSparsityDetection(const std::string& setting);
     /// If sparsity detection is "random", use this number of random iterates
     /// to determine sparsity.
     void setSparsityDetectionRandomCount(int count);
 
+    /// If `directory` is not empty, the Jacobian sparsity patterns of the
+    /// CasOC::Function%s detected with "initial-guess" or "random" sparsity
+    /// detection are written to files in this directory, and later solves
+    /// load these files instead of detecting the sparsity again. The files
+    /// are keyed by a hash of `structureHash` and of the points used for
+    /// sparsity detection, so `structureHash` must be a hash of everything
+    /// else that affects the sparsity of the functions (e.g., the model and
+    /// the goals). The directory must exist.
+    void setSparsityCache(std::string directory, std::string structureHash) {
+        m_sparsityCacheDirectory = std::move(directory);
+        m_sparsityCacheStructureHash = std::move(structureHash);
+    }
+
     /// If this is set to a non-empty string, the sparsity patterns of the
     /// optimization problem derivatives are written to files whose names use
     /// `setting` as a prefix.
@@ -186,10 +203,22 @@ public:
     /// The contents of this iterate depends on the transcription scheme.
     Iterate createRandomIterateWithinBounds() const;
 
+    /// Multiply the cost with the given name by `weight` in the objective
+    /// (default: 1), without creating the NLP again.
+    void setCostWeight(const std::string& name, double weight);
+    /// Change the bounds of the parameter with the given name, without
+    /// creating the NLP again.
+    void setParameterBounds(const std::string& name, const Bounds& bounds);
+
+    /// The transcription (and the NLP) is created by the first call to this
+    /// function, createInitialGuessFromBounds(), etc., and is reused by later
+    /// solves, so set all options beforehand. The problem is initialized
+    /// (e.g., the sparsity patterns are detected) only by the first solve.
     Solution solve(const Iterate& guess) const;
 
 private:
     std::unique_ptr<Transcription> createTranscription() const;
+    Transcription& getTranscription() const;
 
     const Problem& m_problem;
     std::vector<double> m_mesh;
@@ -208,6 +237,8 @@ private:
     std::string m_finite_difference_scheme = "central";
     std::string m_sparsity_detection = "none";
     std::string m_write_sparsity;
+    std::string m_sparsityCacheDirectory;
+    std::string m_sparsityCacheStructureHash;
     int m_callbackInterval = 0;
     int m_sparsity_detection_random_count = 3;
     std::string m_parallelism = "serial";
@@ -215,6 +246,9 @@ private:
     casadi::Dict m_pluginOptions;
     casadi::Dict m_solverOptions;
     std::string m_optimSolver;
+
+    mutable std::unique_ptr<Transcription> m_transcription;
+    mutable bool m_problemInitialized = false;
 };
 
 } // namespace CasOC
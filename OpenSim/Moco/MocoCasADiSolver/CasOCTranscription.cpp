@@ -17,6 +17,8 @@
  * -------------------------------------------------------------------------- */
 #include "CasOCTranscription.h"
 
+#include <OpenSim/Common/Stopwatch.h>
+
 using casadi::DM;
 using casadi::MX;
 using casadi::MXVector;
@@ -32,9 +34,10 @@ class NlpsolCallback : public casadi::Callback {
 public:
     NlpsolCallback(const Transcription& transcription, const Problem& problem,
             casadi_int numVariables, casadi_int numConstraints,
-            casadi_int outputInterval)
+            casadi_int numParameters, casadi_int outputInterval)
             : m_transcription(transcription), m_problem(problem),
               m_numVariables(numVariables), m_numConstraints(numConstraints),
+              m_numParameters(numParameters),
               m_callbackInterval(outputInterval) {
         construct("NlpsolCallback", {});
     }
@@ -52,6 +55,8 @@ public:
             return casadi::Sparsity::dense(m_numVariables, 1);
         } else if (n == "g" || n == "lam_g") {
             return casadi::Sparsity::dense(m_numConstraints, 1);
+        } else if (n == "lam_p") {
+            return casadi::Sparsity::dense(m_numParameters, 1);
         } else {
             return casadi::Sparsity(0, 0);
         }
@@ -67,19 +72,35 @@ public:
             m_problem.intermediateCallbackWithIterate(iterate);
         }
         m_problem.intermediateCallback();
+        if (OpenSim::Logger::isTelemetryEnabled()) {
+            // The inputs are the outputs of nlpsol: x, f, g, lam_x, ....
+            OpenSim::Logger::telemetry("MocoCasADiSolver.iteration",
+                    {{"iteration", evalCount},
+                            {"objective", static_cast<double>(args.at(1))},
+                            {"elapsed_time", m_stopwatch.getElapsedTime()}});
+        }
         ++evalCount;
         return {0};
     }
+    /// Count iterations from zero for the next solve.
+    void restart() {
+        evalCount = 0;
+        m_stopwatch.reset();
+    }
 
 private:
     const Transcription& m_transcription;
     const Problem& m_problem;
     casadi_int m_numVariables;
     casadi_int m_numConstraints;
+    casadi_int m_numParameters;
     casadi_int m_callbackInterval;
     mutable int evalCount = 0;
+    OpenSim::Stopwatch m_stopwatch;
 };
 
+Transcription::~Transcription() = default;
+
 void Transcription::createVariablesAndSetBounds(const casadi::DM& grid,
         int numDefectsPerMeshInterval,
         const casadi::DM& pointsForInterpControls) {
@@ -272,6 +293,8 @@ void Transcription::createVariablesAndSetBounds(const casadi::DM& grid,
             ++ip;
         }
     }
+    m_costWeights = MX::sym("cost_weights", m_problem.getNumCosts(), 1);
+    m_costWeightValues = DM::ones(m_problem.getNumCosts(), 1);
     m_unscaledVars = unscaleVariables(m_scaledVars);
 
     m_duration = m_unscaledVars[final_time] - m_unscaledVars[initial_time];
@@ -550,7 +573,8 @@ void Transcription::setObjectiveAndEndpointConstraints() {
                         m_unscaledVars[parameters], 
                         integral},
                 costOut);
-        m_objectiveTerms(iterm++) = casadi::MX::sum1(costOut.at(0));
+        m_objectiveTerms(iterm++) =
+                m_costWeights(ic) * casadi::MX::sum1(costOut.at(0));
     }
 
     // Minimize Lagrange multipliers if specified by the solver.
@@ -630,49 +654,27 @@ void Transcription::setObjectiveAndEndpointConstraints() {
     }
 }
 
-Solution Transcription::solve(const Iterate& guessOrig) {
+void Transcription::setCostWeight(int index, double weight) {
+    OPENSIM_THROW_IF(index < 0 || index >= m_problem.getNumCosts(),
+            OpenSim::Exception, "Expected a cost index in [0, {}), but got {}.",
+            m_problem.getNumCosts(), index);
+    m_costWeightValues(index) = weight;
+}
+
+void Transcription::setParameterBounds(int index, const Bounds& bounds) {
+    OPENSIM_THROW_IF(index < 0 || index >= m_problem.getNumParameters(),
+            OpenSim::Exception,
+            "Expected a parameter index in [0, {}), but got {}.",
+            m_problem.getNumParameters(), index);
+    setVariableBounds(parameters, index, 0, bounds);
+}
+
+void Transcription::createNlpFunction() {
 
     // Define the NLP.
     // ---------------
     transcribe();
 
-    // Resample the guess.
-    // -------------------
-    const auto guessTimes = createTimes(guessOrig.variables.at(initial_time),
-            guessOrig.variables.at(final_time));
-    auto guess = guessOrig.resample(guessTimes);
-
-    // Adjust guesses for the slack variables to ensure they are the correct
-    // length (i.e. slacks.size2() == m_numPointsIgnoringConstraints).
-    if (guess.variables.find(Var::slacks) != guess.variables.end()) {
-        auto& slacks = guess.variables.at(Var::slacks);
-
-        // If slack variables provided in the guess are equal to the grid
-        // length, remove the elements on the mesh points where the slack
-        // variables are not defined.
-        if (slacks.size2() == m_numGridPoints) {
-            casadi::DM meshIndices = createMeshIndices();
-            std::vector<casadi_int> slackColumnsToRemove;
-            for (int itime = 0; itime < m_numGridPoints; ++itime) {
-                if (meshIndices(itime).__nonzero__()) {
-                    slackColumnsToRemove.push_back(itime);
-                }
-            }
-            // The first argument is an empty vector since we don't want to
-            // remove an entire row.
-            slacks.remove(std::vector<casadi_int>(), slackColumnsToRemove);
-        }
-
-        // Check that either that the slack variables provided in the guess
-        // are the correct length, or that the correct number of columns
-        // were removed.
-        OPENSIM_THROW_IF(slacks.size2() != m_numMeshInteriorPoints,
-                OpenSim::Exception,
-                "Expected slack variables to be length {}, but they are length "
-                "{}.",
-                m_numMeshInteriorPoints, slacks.size2());
-    }
-
     // Create the CasADi NLP function.
     // -------------------------------
     // Option handling is copied from casadi::OptiNode::solver().
@@ -681,21 +683,22 @@ Solution Transcription::solve(const Iterate& guessOrig) {
         options[m_solver.getOptimSolver()] = m_solver.getSolverOptions();
     }
 
-    auto x = flattenVariables(m_scaledVars);
-    casadi_int numVariables = x.numel();
+    m_nlpVariables = flattenVariables(m_scaledVars);
+    casadi_int numVariables = m_nlpVariables.numel();
 
     // The m_constraints symbolic vector holds all of the expressions for
     // the constraint functions.
-    auto g = flattenConstraints(m_constraints);
-    casadi_int numConstraints = g.numel();
+    m_nlpConstraints = flattenConstraints(m_constraints);
+    casadi_int numConstraints = m_nlpConstraints.numel();
 
-    NlpsolCallback callback(*this, m_problem, numVariables, numConstraints,
+    m_nlpCallback = OpenSim::make_unique<NlpsolCallback>(*this, m_problem,
+            numVariables, numConstraints, m_costWeights.numel(),
             m_solver.getCallbackInterval());
-    options["iteration_callback"] = callback;
+    options["iteration_callback"] = *m_nlpCallback;
 
     // The inputs to nlpsol() are symbolic (casadi::MX).
     casadi::MXDict nlp;
-    nlp.emplace(std::make_pair("x", x));
+    nlp.emplace(std::make_pair("x", m_nlpVariables));
     // The objective symbolic variable holds an expression graph including
     // all the calculations performed on the variables x.
     casadi::MX objective = MX::sum1(m_objectiveTerms);
@@ -703,7 +706,8 @@ Solution Transcription::solve(const Iterate& guessOrig) {
         objective = 0;
     }
     nlp.emplace(std::make_pair("f", objective));
-    nlp.emplace(std::make_pair("g", g));
+    nlp.emplace(std::make_pair("g", m_nlpConstraints));
+    nlp.emplace(std::make_pair("p", m_costWeights));
     if (!m_solver.getWriteSparsity().empty()) {
         const auto prefix = m_solver.getWriteSparsity();
         auto gradient = casadi::MX::gradient(nlp["f"], nlp["x"]);
@@ -721,14 +725,60 @@ Solution Transcription::solve(const Iterate& guessOrig) {
         jacobian.sparsity().to_file(
                 prefix + "constraint_Jacobian_sparsity.mtx");
     }
-    const casadi::Function nlpFunc =
-            casadi::nlpsol("nlp", m_solver.getOptimSolver(), nlp, options);
+    m_nlpFunc = casadi::nlpsol("nlp", m_solver.getOptimSolver(), nlp, options);
+}
+
+Solution Transcription::solve(const Iterate& guessOrig) {
+
+    if (m_nlpFunc.is_null()) {
+        createNlpFunction();
+    } else {
+        m_nlpCallback->restart();
+    }
+
+    // Resample the guess.
+    // -------------------
+    const auto guessTimes = createTimes(guessOrig.variables.at(initial_time),
+            guessOrig.variables.at(final_time));
+    auto guess = guessOrig.resample(guessTimes);
+
+    // Adjust guesses for the slack variables to ensure they are the correct
+    // length (i.e. slacks.size2() == m_numPointsIgnoringConstraints).
+    if (guess.variables.find(Var::slacks) != guess.variables.end()) {
+        auto& slacks = guess.variables.at(Var::slacks);
+
+        // If slack variables provided in the guess are equal to the grid
+        // length, remove the elements on the mesh points where the slack
+        // variables are not defined.
+        if (slacks.size2() == m_numGridPoints) {
+            casadi::DM meshIndices = createMeshIndices();
+            std::vector<casadi_int> slackColumnsToRemove;
+            for (int itime = 0; itime < m_numGridPoints; ++itime) {
+                if (meshIndices(itime).__nonzero__()) {
+                    slackColumnsToRemove.push_back(itime);
+                }
+            }
+            // The first argument is an empty vector since we don't want to
+            // remove an entire row.
+            slacks.remove(std::vector<casadi_int>(), slackColumnsToRemove);
+        }
+
+        // Check that either that the slack variables provided in the guess
+        // are the correct length, or that the correct number of columns
+        // were removed.
+        OPENSIM_THROW_IF(slacks.size2() != m_numMeshInteriorPoints,
+                OpenSim::Exception,
+                "Expected slack variables to be length {}, but they are length "
+                "{}.",
+                m_numMeshInteriorPoints, slacks.size2());
+    }
 
     // Run the optimization (evaluate the CasADi NLP function).
     // --------------------------------------------------------
-    // The inputs and outputs of nlpFunc are numeric (casadi::DM).
-    const casadi::DMDict nlpResult = nlpFunc(casadi::DMDict{
+    // The inputs and outputs of m_nlpFunc are numeric (casadi::DM).
+    const casadi::DMDict nlpResult = m_nlpFunc(casadi::DMDict{
                     {"x0", flattenVariables(scaleVariables(guess.variables))},
+                    {"p", m_costWeightValues},
                     {"lbx", flattenVariables(scaleVariables(m_lowerBounds))},
                     {"ubx", flattenVariables(scaleVariables(m_upperBounds))},
                     {"lbg", flattenConstraints(m_constraintsLowerBounds)},
@@ -742,14 +792,16 @@ Solution Transcription::solve(const Iterate& guessOrig) {
     solution.objective = nlpResult.at("f").scalar();
 
     casadi::DMVector finalVarsDMV{finalVariables};
-    casadi::Function objectiveFunc("objective", {x}, {m_objectiveTerms});
+    casadi::Function objectiveFunc("objective",
+            {m_nlpVariables, m_costWeights}, {m_objectiveTerms});
     casadi::DMVector objectiveOut;
-    objectiveFunc.call(finalVarsDMV, objectiveOut);
+    objectiveFunc.call(
+            casadi::DMVector{finalVariables, m_costWeightValues}, objectiveOut);
     solution.objective_breakdown = expandObjectiveTerms(objectiveOut[0]);
 
     solution.times = createTimes(
             solution.variables[initial_time], solution.variables[final_time]);
-    solution.stats = nlpFunc.stats();
+    solution.stats = m_nlpFunc.stats();
 
     // Print breakdown of objective.
     printObjectiveBreakdown(solution, objectiveOut[0]);
@@ -758,7 +810,8 @@ Solution Transcription::solve(const Iterate& guessOrig) {
 
         // For some reason, nlpResult.at("g") is all 0. So we calculate the
         // constraints ourselves.
-        casadi::Function constraintFunc("constraints", {x}, {g});
+        casadi::Function constraintFunc(
+                "constraints", {m_nlpVariables}, {m_nlpConstraints});
         casadi::DMVector constraintsOut;
         constraintFunc.call(finalVarsDMV, constraintsOut);
         printConstraintValues(solution, expandConstraints(constraintsOut[0]));
@@ -22,6 +22,8 @@
 
 namespace CasOC {
 
+class NlpsolCallback;
+
 /// This is the base class for transcription schemes that convert a
 /// CasOC::Problem into a general nonlinear programming problem. If you are
 /// creating a new derived class, make sure to override all virtual functions
@@ -30,7 +32,7 @@ class Transcription {
 public:
     Transcription(const Solver& solver, const Problem& problem)
             : m_solver(solver), m_problem(problem) {}
-    virtual ~Transcription() = default;
+    virtual ~Transcription();
     Iterate createInitialGuessFromBounds() const;
     /// Use the provided random number generator to generate an iterate.
     /// Random::Uniform is used if a generator is not provided. The generator
@@ -62,6 +64,19 @@ public:
         return meshIndices;
     }
 
+    /// Multiply the cost with the given index (in the order of
+    /// Problem::getCostInfos()) by `weight` in the objective (default: 1).
+    /// The weights are parameters of the NLP, so changing them does not
+    /// require creating the NLP again.
+    void setCostWeight(int index, double weight);
+    /// Change the bounds of the parameter variable with the given index (in
+    /// the order of Problem::getParameterInfos()). If scaling variables
+    /// using bounds, the scaling from the original bounds is kept.
+    void setParameterBounds(int index, const Bounds& bounds);
+
+    /// The NLP and the nlpsol function are created by the first call and
+    /// reused by later calls, which only pass the new guess, bounds, and
+    /// cost weights.
     Solution solve(const Iterate& guessOrig);
 
 protected:
@@ -176,11 +191,21 @@ private:
 
     casadi::MX m_objectiveTerms;
     std::vector<std::string> m_objectiveTermNames;
+    // The weights of the costs are the "p" input of nlpsol().
+    casadi::MX m_costWeights;
+    casadi::DM m_costWeightValues;
 
     Constraints<casadi::MX> m_constraints;
     Constraints<casadi::DM> m_constraintsLowerBounds;
     Constraints<casadi::DM> m_constraintsUpperBounds;
 
+    // The NLP, created by the first call to solve(). The callback must
+    // outlive m_nlpFunc.
+    casadi::MX m_nlpVariables;
+    casadi::MX m_nlpConstraints;
+    std::unique_ptr<NlpsolCallback> m_nlpCallback;
+    casadi::Function m_nlpFunc;
+
 private:
     /// Override this function in your derived class to compute a vector of
     /// quadrature coeffecients (of length m_numGridPoints) required to set the
@@ -202,6 +227,7 @@ private:
     }
 
     void transcribe();
+    void createNlpFunction();
     void setObjectiveAndEndpointConstraints();
     void calcDefects() {
         calcDefectsImpl(
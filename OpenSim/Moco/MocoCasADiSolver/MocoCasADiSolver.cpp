@@ -20,6 +20,8 @@
 
 #include <OpenSim/Moco/MocoUtilities.h>
 
+#include <algorithm>
+
 #ifdef OPENSIM_WITH_CASADI
     #include "CasOCSolver.h"
     #include "MocoCasOCProblem.h"
@@ -37,6 +39,37 @@
 
 using namespace OpenSim;
 
+#ifdef OPENSIM_WITH_CASADI
+namespace {
+/// Hash everything about the problem, other than the variable bounds and the
+/// mesh, that affects the sparsity of the CasOC functions. The weights of the
+/// goals do not affect sparsity, so that parameter sweeps over the weights
+/// can reuse cached sparsity patterns.
+std::string createSparsityCacheStructureHash(const MocoProblemRep& rep) {
+    ContentHash hash;
+    hash.update(rep.getModelBase().dump());
+    auto updateWithGoal = [&hash](const MocoGoal& goal) {
+        std::unique_ptr<MocoGoal> copy(goal.clone());
+        copy->setWeight(1.0);
+        hash.update(copy->dump());
+    };
+    for (int i = 0; i < rep.getNumCosts(); ++i) {
+        updateWithGoal(rep.getCostByIndex(i));
+    }
+    for (int i = 0; i < rep.getNumEndpointConstraints(); ++i) {
+        updateWithGoal(rep.getEndpointConstraintByIndex(i));
+    }
+    for (const auto& name : rep.createPathConstraintNames()) {
+        hash.update(rep.getPathConstraint(name).dump());
+    }
+    for (const auto& name : rep.createParameterNames()) {
+        hash.update(rep.getParameter(name).dump());
+    }
+    return hash.toString();
+}
+} // anonymous namespace
+#endif
+
 MocoCasADiSolver::MocoCasADiSolver() { constructProperties(); }
 
 void MocoCasADiSolver::constructProperties() {
@@ -44,6 +77,7 @@ void MocoCasADiSolver::constructProperties() {
     constructProperty_parameters_require_initsystem(true);
     constructProperty_optim_sparsity_detection("none");
     constructProperty_optim_write_sparsity("");
+    constructProperty_optim_sparsity_cache_directory("");
     constructProperty_optim_finite_difference_scheme("central");
     constructProperty_parallel();
     constructProperty_output_interval(0);
@@ -271,12 +305,18 @@ std::unique_ptr<CasOC::Solver> MocoCasADiSolver::createCasOCSolver(
     }
 
     checkPropertyValueIsInSet(getProperty_optim_sparsity_detection(),
-            {"none", "random", "initial-guess"});
+            {"none", "random", "initial-guess", "structural"});
     casSolver->setSparsityDetection(get_optim_sparsity_detection());
     casSolver->setSparsityDetectionRandomCount(3);
 
     casSolver->setWriteSparsity(get_optim_write_sparsity());
 
+    if (!get_optim_sparsity_cache_directory().empty()) {
+        IO::makeDir(get_optim_sparsity_cache_directory());
+        casSolver->setSparsityCache(get_optim_sparsity_cache_directory(),
+                createSparsityCacheStructureHash(getProblemRep()));
+    }
+
     checkPropertyValueIsInSet(getProperty_optim_finite_difference_scheme(),
             {"central", "forward", "backward"});
     casSolver->setFiniteDifferenceScheme(get_optim_finite_difference_scheme());
@@ -356,11 +396,18 @@ MocoSolution MocoCasADiSolver::solveImpl() const {
     if (get_verbosity()) {
         log_info("Number of threads: {}", casProblem->getJarSize());
     }
+    return solveCasOC(*casSolver, getGuess(), stopwatch);
+#else
+    OPENSIM_THROW(MocoCasADiSolverNotAvailable);
+#endif
+}
 
-    MocoTrajectory guess = getGuess();
+MocoSolution MocoCasADiSolver::solveCasOC(const CasOC::Solver& casSolver,
+        const MocoTrajectory& guess, const Stopwatch& stopwatch) const {
+#ifdef OPENSIM_WITH_CASADI
     CasOC::Iterate casGuess;
     if (guess.empty()) {
-        casGuess = casSolver->createInitialGuessFromBounds();
+        casGuess = casSolver.createInitialGuessFromBounds();
     } else {
         casGuess = convertToCasOCIterate(guess);
     }
@@ -371,7 +418,7 @@ MocoSolution MocoCasADiSolver::solveImpl() const {
     Logger::setLevel(Logger::Level::Warn);
     CasOC::Solution casSolution;
     try {
-        casSolution = casSolver->solve(casGuess);
+        casSolution = casSolver.solve(casGuess);
     } catch (...) {
         OpenSim::Logger::setLevel(origLoggerLevel);
     }
@@ -448,3 +495,63 @@ MocoSolution MocoCasADiSolver::solveImpl() const {
     OPENSIM_THROW(MocoCasADiSolverNotAvailable);
 #endif
 }
+
+MocoCasADiSolver::ReusableNLP::ReusableNLP(const MocoCasADiSolver& solver)
+        : m_solver(solver) {
+#ifdef OPENSIM_WITH_CASADI
+    m_casProblem = m_solver.createCasOCProblem();
+    m_casSolver = m_solver.createCasOCSolver(*m_casProblem);
+#else
+    OPENSIM_THROW(MocoCasADiSolverNotAvailable);
+#endif
+}
+
+MocoCasADiSolver::ReusableNLP::~ReusableNLP() = default;
+
+void MocoCasADiSolver::ReusableNLP::setGoalWeight(
+        const std::string& name, double weight) {
+#ifdef OPENSIM_WITH_CASADI
+    const auto& rep = m_solver.getProblemRep();
+    const auto endpointConstraintNames = rep.createEndpointConstraintNames();
+    if (std::find(endpointConstraintNames.begin(),
+                endpointConstraintNames.end(),
+                name) != endpointConstraintNames.end()) {
+        return;
+    }
+    // The cost functions already include the weight from the problem.
+    const double problemWeight = rep.getCost(name).getWeight();
+    OPENSIM_THROW_IF(problemWeight == 0, Exception,
+            "Cannot change the weight of goal '{}', since its weight in the "
+            "problem is 0.",
+            name);
+    m_casSolver->setCostWeight(name, weight / problemWeight);
+#else
+    OPENSIM_THROW(MocoCasADiSolverNotAvailable);
+#endif
+}
+
+void MocoCasADiSolver::ReusableNLP::setParameterBounds(
+        const std::string& name, const MocoBounds& bounds) {
+#ifdef OPENSIM_WITH_CASADI
+    // Throws if the parameter does not exist.
+    m_solver.getProblemRep().getParameter(name);
+    m_casSolver->setParameterBounds(name, convertBounds(bounds));
+#else
+    OPENSIM_THROW(MocoCasADiSolverNotAvailable);
+#endif
+}
+
+MocoSolution MocoCasADiSolver::ReusableNLP::solve(
+        const MocoTrajectory& guess) const {
+#ifdef OPENSIM_WITH_CASADI
+    const Stopwatch stopwatch;
+    if (guess.empty()) {
+        return m_solver.solveCasOC(
+                *m_casSolver, m_solver.getGuess(), stopwatch);
+    }
+    m_solver.checkGuess(guess);
+    return m_solver.solveCasOC(*m_casSolver, guess, stopwatch);
+#else
+    OPENSIM_THROW(MocoCasADiSolverNotAvailable);
+#endif
+}
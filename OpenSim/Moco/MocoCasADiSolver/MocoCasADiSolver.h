@@ -27,6 +27,7 @@ class Solver;
 namespace OpenSim {
 
 class MocoCasOCProblem;
+class Stopwatch;
 
 class MocoCasADiSolverNotAvailable : public Exception {
 public:
@@ -62,6 +63,39 @@ of "random", we use 3 random trajectories and combine the resulting sparsity
 patterns. The seed used for these 3 random trajectories is always exactly
 the same, ensuring that the sparsity pattern is deterministic.
 
+The "structural" setting does not evaluate the model at all. Instead, the
+sparsity pattern is created from the structure of the problem:
+- Each goal depends only on the variables available at its stage dependency
+  (e.g., a goal with a stage dependency of SimTK::Stage::Model does not depend
+  on the Lagrange multipliers).
+- The auxiliary dynamics (e.g., muscle activation dynamics) of a component
+  depend only on the auxiliary states, controls, and auxiliary derivatives of
+  the component itself, its subcomponents, and the components it is connected
+  to through Sockets and Inputs (recursively).
+- The control of a Muscle with activation dynamics affects only that
+  muscle's auxiliary dynamics, unless another component is connected to the
+  muscle.
+- All other dependencies (e.g., of the multibody dynamics and path
+  constraints) are treated as dense.
+These assumptions hold for the components distributed with OpenSim, but a
+custom component that accesses other components without connecting to them
+(e.g., through getParent() or getModel()) violates them; use "random" in that
+case.
+
+Detecting the sparsity with "random" or "initial-guess" requires evaluating
+the model many times. If you solve problems with the same structure many
+times (e.g., in a parameter sweep over goal weights), set
+optim_sparsity_cache_directory so that the detected patterns are saved to
+files and reused. The files are keyed by the model, the goals (excluding
+their weights), the path constraints, the parameters, each function's name,
+and the points used for detection (which depend on the mesh, the variable
+bounds, and the initial guess). Files are named by a hash of this key, and
+only contain the hash (not the model), which must match for a file to be
+used; as with any hash, distinct keys match with a tiny probability. Files
+are written to a temporary file and then renamed.
+Cache hits and misses are logged along with the time spent (or saved)
+detecting sparsity.
+
 To explore the sparsity pattern for your problem, set optim_write_sparsity
 and run the resulting files with the plot_casadi_sparsity.py Python script.
 
@@ -132,12 +166,17 @@ public:
             "(default: true).");
     OpenSim_DECLARE_PROPERTY(optim_sparsity_detection, std::string,
             "Detect the sparsity pattern of derivatives; 'none' "
-            "(for safe block sparsity; default), 'random', or "
-            "'initial-guess'.");
+            "(for safe block sparsity; default), 'random', "
+            "'initial-guess', or 'structural'.");
     OpenSim_DECLARE_PROPERTY(optim_write_sparsity, std::string,
             "Write files for the sparsity pattern of the gradient, Jacobian, "
             "and Hessian to the working directory using this as a prefix; "
             "empty (default) to not write such files.");
+    OpenSim_DECLARE_PROPERTY(optim_sparsity_cache_directory, std::string,
+            "Save the sparsity patterns detected with 'random' or "
+            "'initial-guess' optim_sparsity_detection to this directory, and "
+            "reuse them in later solves of a problem with the same structure; "
+            "empty (default) to not cache sparsity patterns.");
     OpenSim_DECLARE_PROPERTY(optim_finite_difference_scheme, std::string,
             "The finite difference scheme CasADi will use to calculate problem "
             "derivatives (default: 'central').");
@@ -225,6 +264,41 @@ public:
 
     /// @}
 
+#ifndef SWIG
+    /// (Experimental) The problem transcribed into a nonlinear program (NLP)
+    /// that can be solved several times with different goal weights and
+    /// MocoParameter bounds, as in MocoSweep. The CasOC problem (with its
+    /// MocoProblemRep%s), the CasADi expression graph, the Jacobian sparsity
+    /// patterns, and the nlpsol function are created once; each solve() only
+    /// passes new numbers to the NLP. Other changes to the problem (e.g.,
+    /// model property values) require a new ReusableNLP.
+    /// Changes to the problem or to the solver's properties after creating
+    /// this object have no effect on it. The solver must outlive this object.
+    class OSIMMOCO_API ReusableNLP {
+    public:
+        /// @precondition You must have called resetProblem() on the solver.
+        explicit ReusableNLP(const MocoCasADiSolver& solver);
+        ~ReusableNLP();
+        /// Set the weight of the cost goal with the given name. The goal's
+        /// weight in the problem must be nonzero, since the new weight is
+        /// applied as a factor on the goal's weighted value. Goals in
+        /// endpoint constraint mode are ignored.
+        void setGoalWeight(const std::string& name, double weight);
+        /// Set the bounds of the MocoParameter with the given name.
+        void setParameterBounds(
+                const std::string& name, const MocoBounds& bounds);
+        /// Solve from `guess`, or from the solver's guess (or the bounds) if
+        /// `guess` is empty.
+        MocoSolution solve(
+                const MocoTrajectory& guess = MocoTrajectory()) const;
+
+    private:
+        const MocoCasADiSolver& m_solver;
+        std::unique_ptr<MocoCasOCProblem> m_casProblem;
+        std::unique_ptr<CasOC::Solver> m_casSolver;
+    };
+#endif
+
 protected:
     MocoSolution solveImpl() const override;
 
@@ -239,6 +313,12 @@ protected:
 private:
     void constructProperties();
 
+    /// Solve with the given CasOC solver, starting from `guess` (or from the
+    /// bounds, if `guess` is empty). The solver duration is measured by
+    /// `stopwatch`.
+    MocoSolution solveCasOC(const CasOC::Solver& casSolver,
+            const MocoTrajectory& guess, const Stopwatch& stopwatch) const;
+
     // When a copy of the solver is made, we want to keep any guess specified
     // by the API, but want to discard anything we've cached by loading a file.
     MocoTrajectory m_guessFromAPI;
@@ -20,10 +20,146 @@
 
 #include "MocoCasADiSolver.h"
 
+#include <OpenSim/Simulation/Model/Muscle.h>
 #include <OpenSim/Simulation/SimulationUtilities.h>
 
+#include <unordered_set>
+
 using namespace OpenSim;
 
+namespace {
+
+/// The variables that a MocoGoal can depend on, given its stage dependency.
+/// This must be consistent with MocoCasOCProblem::applyInput().
+CasOC::InputDependencies createInputDependencies(SimTK::Stage stageDep) {
+    CasOC::InputDependencies deps;
+    deps.states = stageDep >= SimTK::Stage::Time;
+    deps.controls = stageDep >= SimTK::Stage::Model;
+    deps.auxiliary_derivatives = stageDep >= SimTK::Stage::Model;
+    deps.parameters = stageDep >= SimTK::Stage::Instance;
+    deps.multipliers = stageDep >= SimTK::Stage::Dynamics;
+    deps.accelerations = stageDep >= SimTK::Stage::Acceleration;
+    return deps;
+}
+
+/// A directed graph of the components in a model. A component has an edge to
+/// each of its subcomponents and to each component it connects to through a
+/// Socket or an Input. A connectee that cannot be resolved is represented by
+/// the model itself, from which every component is reachable.
+///
+/// Components may access their owners without connecting to them (e.g., a
+/// muscle's subcomponent may use the muscle's excitation), so the graph groups
+/// each component of the model's sets (e.g., a muscle in the ForceSet) with
+/// all of its subcomponents into a single "unit". Dependencies are expressed
+/// in terms of these units.
+class ComponentGraph {
+public:
+    explicit ComponentGraph(const Model& model) : m_model(model) {
+        const std::unordered_set<const Component*> sets{&model.getBodySet(),
+                &model.getJointSet(), &model.getForceSet(),
+                &model.getConstraintSet(), &model.getContactGeometrySet(),
+                &model.getMarkerSet(), &model.getControllerSet(),
+                &model.getProbeSet(), &model.getMiscModelComponentSet()};
+        m_components[model.getAbsolutePathString()] = &model;
+        m_units[&model] = &model;
+        for (const auto& comp : model.getComponentList()) {
+            m_components[comp.getAbsolutePathString()] = &comp;
+            const Component* unit = &comp;
+            while (unit->hasOwner() && &unit->getOwner() != &model &&
+                    !sets.count(&unit->getOwner())) {
+                unit = &unit->getOwner();
+            }
+            m_units[&comp] = unit;
+        }
+        for (const auto& comp : model.getComponentList()) {
+            if (comp.hasOwner()) {
+                m_edges[&comp.getOwner()].push_back(&comp);
+            }
+            for (const auto& name : comp.getSocketNames()) {
+                const auto& socket = comp.getSocket(name);
+                for (unsigned i = 0; i < socket.getNumConnectees(); ++i) {
+                    addConnection(comp, socket.getConnecteePath(i));
+                }
+            }
+            for (const auto& name : comp.getInputNames()) {
+                const auto& input = comp.getInput(name);
+                for (unsigned i = 0; i < input.getNumConnectees(); ++i) {
+                    std::string componentPath, outputName, channelName, alias;
+                    AbstractInput::parseConnecteePath(input.getConnecteePath(i),
+                            componentPath, outputName, channelName, alias);
+                    addConnection(comp, componentPath);
+                }
+            }
+        }
+    }
+
+    /// Get the unit containing the component with the given absolute path,
+    /// or nullptr if no such component exists.
+    const Component* findUnit(const std::string& absolutePath) const {
+        const auto it = m_components.find(absolutePath);
+        if (it == m_components.end()) return nullptr;
+        return m_units.at(it->second);
+    }
+
+    /// The units reachable from `unit`, including `unit`.
+    std::unordered_set<const Component*> findReachableUnits(
+            const Component* unit) const {
+        std::unordered_set<const Component*> visited{unit};
+        std::vector<const Component*> toVisit{unit};
+        std::unordered_set<const Component*> units;
+        while (!toVisit.empty()) {
+            const Component* comp = toVisit.back();
+            toVisit.pop_back();
+            // Reaching any component of a unit reaches the entire unit.
+            const Component* compUnit = m_units.at(comp);
+            units.insert(compUnit);
+            if (visited.insert(compUnit).second) toVisit.push_back(compUnit);
+            const auto it = m_edges.find(comp);
+            if (it == m_edges.end()) continue;
+            for (const auto* next : it->second) {
+                if (visited.insert(next).second) toVisit.push_back(next);
+            }
+        }
+        return units;
+    }
+
+    /// Does a component outside of `unit` connect to `unit`?
+    bool hasExternalConnections(const Component* unit) const {
+        for (const auto& connection : m_connections) {
+            if (m_units.at(connection.second) == unit &&
+                    m_units.at(connection.first) != unit) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    void addConnection(const Component& comp, const std::string& path) {
+        if (path.empty()) return;
+        ComponentPath connecteePath(path);
+        if (!connecteePath.isAbsolute()) {
+            connecteePath =
+                    connecteePath.formAbsolutePath(comp.getAbsolutePath());
+        }
+        const Component* connectee = &m_model;
+        const auto it = m_components.find(connecteePath.toString());
+        if (it != m_components.end()) connectee = it->second;
+        m_edges[&comp].push_back(connectee);
+        m_connections.emplace_back(&comp, connectee);
+    }
+
+    const Model& m_model;
+    std::unordered_map<std::string, const Component*> m_components;
+    std::unordered_map<const Component*, const Component*> m_units;
+    std::unordered_map<const Component*, std::vector<const Component*>>
+            m_edges;
+    // Pairs of (component, connectee) for all Sockets and Inputs.
+    std::vector<std::pair<const Component*, const Component*>> m_connections;
+};
+
+} // anonymous namespace
+
 thread_local SimTK::Vector_<SimTK::SpatialVec>
         MocoCasOCProblem::m_constraintBodyForces;
 thread_local SimTK::Vector MocoCasOCProblem::m_constraintMobilityForces;
@@ -95,6 +231,10 @@ MocoCasOCProblem::MocoCasOCProblem(const MocoCasADiSolver& mocoCasADiSolver,
 
     setAuxiliaryDerivativeNames(derivativeNames);
 
+    if (mocoCasADiSolver.get_optim_sparsity_detection() == "structural") {
+        setStructuralSparsity(problemRep, stateNames);
+    }
+
     // Add any scalar constraints associated with kinematic constraints in
     // the model as path constraints in the problem.
     // Whether or not enabled kinematic constraints exist in the model,
@@ -225,7 +365,8 @@ MocoCasOCProblem::MocoCasOCProblem(const MocoCasADiSolver& mocoCasADiSolver,
     const auto costNames = problemRep.createCostNames();
     for (const auto& name : costNames) {
         const auto& cost = problemRep.getCost(name);
-        addCost(name, cost.getNumIntegrals(), cost.getNumOutputs());
+        addCost(name, cost.getNumIntegrals(), cost.getNumOutputs(),
+                createInputDependencies(cost.getStageDependency()));
     }
 
     const auto endpointConNames =
@@ -236,7 +377,8 @@ MocoCasOCProblem::MocoCasOCProblem(const MocoCasADiSolver& mocoCasADiSolver,
         for (const auto& bounds : ec.getConstraintInfo().getBounds()) {
             casBounds.push_back(convertBounds(bounds));
         }
-        addEndpointConstraint(name, ec.getNumIntegrals(), casBounds);
+        addEndpointConstraint(name, ec.getNumIntegrals(), casBounds,
+                createInputDependencies(ec.getStageDependency()));
     }
 
     const auto pathConstraintNames = problemRep.createPathConstraintNames();
@@ -253,3 +395,99 @@ MocoCasOCProblem::MocoCasOCProblem(const MocoCasADiSolver& mocoCasADiSolver,
             fmt::format("delete_this_to_stop_optimization_{}_{}.txt",
                     problemRep.getName(), m_formattedTimeString));
 }
+
+void MocoCasOCProblem::setStructuralSparsity(const MocoProblemRep& problemRep,
+        const std::vector<std::string>& stateNames) {
+    const auto& model = problemRep.getModelBase();
+    const ComponentGraph graph(model);
+
+    // The unit (see ComponentGraph) that owns each auxiliary state, control,
+    // and auxiliary derivative, in the order of the columns of the auxiliary
+    // dynamics sparsity. A nullptr indicates that the owner is unknown; such
+    // a variable is assumed to affect, and be affected by, all the others.
+    std::vector<const Component*> owners;
+    for (const auto& stateName : stateNames) {
+        if (IO::EndsWith(stateName, "/value") ||
+                IO::EndsWith(stateName, "/speed")) {
+            continue;
+        }
+        owners.push_back(graph.findUnit(
+                ComponentPath(stateName).getParentPathString()));
+    }
+    const int numAuxStates = (int)owners.size();
+    OPENSIM_THROW_IF(numAuxStates != getNumAuxiliaryStates(), Exception,
+            "Internal error.");
+
+    // The controls of muscles with activation dynamics only affect the
+    // muscle's own auxiliary dynamics, unless other components are connected
+    // to the muscle.
+    casadi::Sparsity multibodyControls(1, getNumControls());
+    for (const auto& actu : model.getComponentList<Actuator>()) {
+        if (!actu.get_appliesForce()) continue;
+        const Component* unit = graph.findUnit(actu.getAbsolutePathString());
+        bool affectsMultibody = true;
+        if (const auto* muscle = dynamic_cast<const Muscle*>(&actu)) {
+            affectsMultibody = muscle->get_ignore_activation_dynamics() ||
+                               muscle->getNumStateVariables() == 0 ||
+                               unit != muscle ||
+                               graph.hasExternalConnections(unit);
+        }
+        for (int i = 0; i < actu.numControls(); ++i) {
+            if (affectsMultibody) {
+                multibodyControls.add_nz(
+                        0, (casadi_int)owners.size() - numAuxStates);
+            }
+            owners.push_back(unit);
+        }
+    }
+    OPENSIM_THROW_IF((int)owners.size() != numAuxStates + getNumControls(),
+            Exception, "Internal error.");
+
+    for (const auto& implicitRef :
+            problemRep.getImplicitComponentReferencePtrs()) {
+        owners.push_back(
+                graph.findUnit(implicitRef.second->getAbsolutePathString()));
+    }
+
+    // Rows of the auxiliary dynamics sparsity: the auxiliary state derivatives
+    // are owned by the same units as the auxiliary states, and the auxiliary
+    // residuals are owned by the same units as the auxiliary derivatives.
+    std::vector<const Component*> rowOwners(
+            owners.begin(), owners.begin() + numAuxStates);
+    rowOwners.insert(rowOwners.end(),
+            owners.begin() + numAuxStates + getNumControls(), owners.end());
+
+    // Many rows share an owner (e.g., a muscle with activation and fiber
+    // length states), so we cache the reachable units.
+    std::unordered_map<const Component*, std::unordered_set<const Component*>>
+            reachableCache;
+    std::vector<casadi_int> rows;
+    std::vector<casadi_int> cols;
+    for (int irow = 0; irow < (int)rowOwners.size(); ++irow) {
+        const Component* rowOwner = rowOwners[irow];
+        const std::unordered_set<const Component*>* reachable = nullptr;
+        if (rowOwner) {
+            auto it = reachableCache.find(rowOwner);
+            if (it == reachableCache.end()) {
+                it = reachableCache
+                             .emplace(rowOwner,
+                                     graph.findReachableUnits(rowOwner))
+                             .first;
+            }
+            reachable = &it->second;
+            // The model is reachable if a connectee could not be resolved.
+            if (reachable->count(&model)) reachable = nullptr;
+        }
+        for (int icol = 0; icol < (int)owners.size(); ++icol) {
+            const Component* colOwner = owners[icol];
+            if (!reachable || !colOwner || reachable->count(colOwner)) {
+                rows.push_back(irow);
+                cols.push_back(icol);
+            }
+        }
+    }
+    setAuxiliaryDynamicsSparsity(casadi::Sparsity::triplet(
+            (casadi_int)rowOwners.size(), (casadi_int)owners.size(), rows,
+            cols));
+    setMultibodyControlSparsity(multibodyControls);
+}
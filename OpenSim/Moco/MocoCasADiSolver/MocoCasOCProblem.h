@@ -503,6 +503,12 @@ private:
     }
 
 private:
+    /// Describe the structure of the auxiliary dynamics and the effect of the
+    /// controls on the multibody dynamics, for "structural" sparsity
+    /// detection. See the "Sparsity" section of MocoCasADiSolver for the
+    /// assumptions this makes.
+    void setStructuralSparsity(const MocoProblemRep& problemRep,
+            const std::vector<std::string>& stateNames);
     /// Apply parameters to properties in the models returned by
     /// `mocoProblemRep.getModelBase()` and
     /// `mocoProblemRep.getModelDisabledConstraints()`.
@@ -0,0 +1,307 @@
+/* -------------------------------------------------------------------------- *
+ * OpenSim: MocoSweep.cpp                                                     *
+ * -------------------------------------------------------------------------- *
+ * Copyright (c) 2023 Stanford University and the Authors                     *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0          *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "MocoSweep.h"
+
+#include "MocoCasADiSolver/MocoCasADiSolver.h"
+#include "MocoGoal/MocoGoal.h"
+#include "MocoParameter.h"
+#include "MocoProblem.h"
+
+#include <OpenSim/Common/Logger.h>
+
+#include <algorithm>
+#include <map>
+
+using namespace OpenSim;
+
+MocoSweepPoint& MocoSweepPoint::setGoalWeight(
+        const std::string& goalName, double weight) {
+    m_goalWeights.push_back({goalName, weight});
+    return *this;
+}
+
+MocoSweepPoint& MocoSweepPoint::setParameterBounds(
+        const std::string& parameterName, const MocoBounds& bounds) {
+    m_parameterBounds.push_back({parameterName, bounds});
+    return *this;
+}
+
+MocoSweepPoint& MocoSweepPoint::setModelPropertyValue(
+        const std::string& componentPath, const std::string& propertyName,
+        double value) {
+    m_modelPropertyValues.push_back({componentPath, propertyName, value});
+    return *this;
+}
+
+MocoSweep::MocoSweep(MocoStudy study) : m_study(std::move(study)) {
+    const MocoSolver& solver = m_study.updSolver();
+    OPENSIM_THROW_IF(!dynamic_cast<const MocoCasADiSolver*>(&solver),
+            Exception,
+            "Expected the study's solver to be a MocoCasADiSolver, but got a "
+            "{}.",
+            solver.getConcreteClassName());
+}
+
+void MocoSweep::addPoint(MocoSweepPoint point) {
+    m_points.push_back(std::move(point));
+}
+
+void MocoSweep::setNumGridThreads(int numThreads) {
+    OPENSIM_THROW_IF(numThreads < 0, Exception,
+            "Expected the number of grid threads to be non-negative, but got "
+            "{}.",
+            numThreads);
+    m_numGridThreads = numThreads;
+}
+
+void MocoSweep::applyModelPropertyValues(
+        const MocoSweepPoint& point, MocoStudy& study) {
+    if (point.m_modelPropertyValues.empty()) return;
+    Model& model = study.updProblem().updModel();
+    model.finalizeFromProperties();
+    for (const auto& prop : point.m_modelPropertyValues) {
+        auto& abstractProp = model.updComponent(prop.componentPath)
+                                     .updPropertyByName(prop.propertyName);
+        auto* doubleProp = dynamic_cast<Property<double>*>(&abstractProp);
+        OPENSIM_THROW_IF(!doubleProp || doubleProp->isListProperty(),
+                Exception,
+                "Expected property '{}' of component '{}' to hold a single "
+                "double, but it has type '{}'.",
+                prop.propertyName, prop.componentPath,
+                abstractProp.getTypeName());
+        doubleProp->setValue(prop.value);
+    }
+}
+
+std::vector<std::vector<double>> MocoSweep::createFeatures(
+        std::vector<bool>& isModelProperty) const {
+    // Map from a key for each override to the value in the base study.
+    std::map<std::string, double> baseValues;
+    const MocoPhase& phase = m_study.getProblem().getPhase(0);
+    std::unique_ptr<Model> model;
+    for (const auto& point : m_points) {
+        for (const auto& goal : point.m_goalWeights) {
+            baseValues["goal:" + goal.name] =
+                    phase.getGoal(goal.name).getWeight();
+        }
+        for (const auto& param : point.m_parameterBounds) {
+            const MocoBounds bounds =
+                    phase.getParameter(param.name).getBounds();
+            baseValues["parameter_lower:" + param.name] = bounds.getLower();
+            baseValues["parameter_upper:" + param.name] = bounds.getUpper();
+        }
+        for (const auto& prop : point.m_modelPropertyValues) {
+            if (!model) {
+                model.reset(phase.getModel().clone());
+                model->finalizeFromProperties();
+            }
+            const auto& abstractProp =
+                    model->getComponent(prop.componentPath)
+                            .getPropertyByName(prop.propertyName);
+            baseValues["property:" + prop.componentPath + "|" +
+                       prop.propertyName] = abstractProp.getValue<double>();
+        }
+    }
+    isModelProperty.clear();
+    for (const auto& entry : baseValues) {
+        isModelProperty.push_back(entry.first.compare(0, 9, "property:") == 0);
+    }
+
+    std::vector<std::vector<double>> features;
+    for (const auto& point : m_points) {
+        std::map<std::string, double> values = baseValues;
+        for (const auto& goal : point.m_goalWeights) {
+            values["goal:" + goal.name] = goal.weight;
+        }
+        for (const auto& param : point.m_parameterBounds) {
+            values["parameter_lower:" + param.name] = param.bounds.getLower();
+            values["parameter_upper:" + param.name] = param.bounds.getUpper();
+        }
+        for (const auto& prop : point.m_modelPropertyValues) {
+            values["property:" + prop.componentPath + "|" +
+                   prop.propertyName] = prop.value;
+        }
+        std::vector<double> feature;
+        feature.reserve(values.size());
+        for (const auto& entry : values) feature.push_back(entry.second);
+        features.push_back(std::move(feature));
+    }
+    return features;
+}
+
+std::vector<MocoSolution> MocoSweep::solve() const {
+    const int numPoints = getNumPoints();
+    std::vector<MocoSolution> solutions(numPoints);
+    if (!numPoints) return solutions;
+
+    // Normalize each override by its range across the points so that
+    // overrides with large magnitudes do not dominate the distance.
+    std::vector<bool> isModelProperty;
+    const auto features = createFeatures(isModelProperty);
+    const int numFeatures = (int)features[0].size();
+    std::vector<double> scales(numFeatures, 1.0);
+    for (int ifeat = 0; ifeat < numFeatures; ++ifeat) {
+        double min = SimTK::Infinity;
+        double max = -SimTK::Infinity;
+        for (const auto& feature : features) {
+            if (!SimTK::isFinite(feature[ifeat])) continue;
+            min = std::min(min, feature[ifeat]);
+            max = std::max(max, feature[ifeat]);
+        }
+        if (max > min) scales[ifeat] = max - min;
+    }
+    auto calcDistance = [&](int a, int b) {
+        double distance = 0;
+        for (int ifeat = 0; ifeat < numFeatures; ++ifeat) {
+            const double va = features[a][ifeat];
+            const double vb = features[b][ifeat];
+            if (va == vb) continue;
+            // Infinite bounds differ maximally from finite bounds.
+            if (!SimTK::isFinite(va) || !SimTK::isFinite(vb)) {
+                distance += 1;
+            } else {
+                distance += SimTK::square((va - vb) / scales[ifeat]);
+            }
+        }
+        return distance;
+    };
+    // Points with different model property values cannot share an NLP.
+    auto haveSameModel = [&](int a, int b) {
+        for (int ifeat = 0; ifeat < numFeatures; ++ifeat) {
+            if (isModelProperty[ifeat] &&
+                    features[a][ifeat] != features[b][ifeat]) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    // Solve in a nearest-neighbor order starting from the first point, so
+    // that each point's warm start is likely to be close. Points with the
+    // same model as the previous point come first, so that we create the NLP
+    // for each model only once.
+    std::vector<int> order = {0};
+    std::vector<bool> ordered(numPoints, false);
+    ordered[0] = true;
+    while ((int)order.size() < numPoints) {
+        int nearest = -1;
+        bool nearestHasSameModel = false;
+        double nearestDistance = SimTK::Infinity;
+        for (int ipoint = 0; ipoint < numPoints; ++ipoint) {
+            if (ordered[ipoint]) continue;
+            const bool hasSameModel = haveSameModel(order.back(), ipoint);
+            const double distance = calcDistance(order.back(), ipoint);
+            if (nearest == -1 || (hasSameModel && !nearestHasSameModel) ||
+                    (hasSameModel == nearestHasSameModel &&
+                            distance < nearestDistance)) {
+                nearest = ipoint;
+                nearestHasSameModel = hasSameModel;
+                nearestDistance = distance;
+            }
+        }
+        order.push_back(nearest);
+        ordered[nearest] = true;
+    }
+
+    // The goal weights and parameter bounds that any point overrides, with
+    // their values in the base study.
+    const MocoPhase& basePhase = m_study.getProblem().getPhase(0);
+    std::map<std::string, double> baseGoalWeights;
+    std::map<std::string, MocoBounds> baseParameterBounds;
+    for (const auto& point : m_points) {
+        for (const auto& goal : point.m_goalWeights) {
+            baseGoalWeights[goal.name] =
+                    basePhase.getGoal(goal.name).getWeight();
+        }
+        for (const auto& param : point.m_parameterBounds) {
+            baseParameterBounds[param.name] =
+                    basePhase.getParameter(param.name).getBounds();
+        }
+    }
+
+    // The NLP refers to the study's solver, so it must be destroyed first.
+    std::unique_ptr<MocoStudy> study;
+    std::unique_ptr<MocoCasADiSolver::ReusableNLP> nlp;
+    int nlpPoint = -1;
+    std::vector<bool> solved(numPoints, false);
+    for (const int ipoint : order) {
+        const MocoSweepPoint& point = m_points[ipoint];
+        if (!nlp || !haveSameModel(nlpPoint, ipoint)) {
+            log_info("MocoSweep: creating the NLP for the model of point {}.",
+                    ipoint + 1);
+            nlp.reset();
+            study.reset(m_study.clone());
+            applyModelPropertyValues(point, *study);
+            // The NLP multiplies each cost by the weight we give it, so the
+            // weights in the problem must be 1.
+            for (const auto& goal : baseGoalWeights) {
+                study->updProblem().updGoal(goal.first).setWeight(1.0);
+            }
+            auto& solver = study->updSolver<MocoCasADiSolver>();
+            if (m_numGridThreads) {
+                // For the parallel property, 1 means "all cores".
+                solver.set_parallel(
+                        m_numGridThreads == 1 ? 0 : m_numGridThreads);
+            }
+            solver.resetProblem(study->getProblem());
+            nlp = OpenSim::make_unique<MocoCasADiSolver::ReusableNLP>(solver);
+            nlpPoint = ipoint;
+        }
+
+        // Overrides that the point does not specify take the base value.
+        std::map<std::string, double> goalWeights = baseGoalWeights;
+        for (const auto& goal : point.m_goalWeights) {
+            goalWeights[goal.name] = goal.weight;
+        }
+        for (const auto& goal : goalWeights) {
+            nlp->setGoalWeight(goal.first, goal.second);
+        }
+        std::map<std::string, MocoBounds> parameterBounds =
+                baseParameterBounds;
+        for (const auto& param : point.m_parameterBounds) {
+            parameterBounds[param.name] = param.bounds;
+        }
+        for (const auto& param : parameterBounds) {
+            nlp->setParameterBounds(param.first, param.second);
+        }
+
+        int iguess = -1;
+        if (m_warmStart) {
+            double nearestDistance = SimTK::Infinity;
+            for (int jpoint = 0; jpoint < numPoints; ++jpoint) {
+                if (!solved[jpoint] || !solutions[jpoint].success()) continue;
+                const double distance = calcDistance(ipoint, jpoint);
+                if (iguess == -1 || distance < nearestDistance) {
+                    iguess = jpoint;
+                    nearestDistance = distance;
+                }
+            }
+        }
+        if (iguess == -1) {
+            log_info("MocoSweep: solving point {} of {}.", ipoint + 1,
+                    numPoints);
+            solutions[ipoint] = nlp->solve();
+        } else {
+            log_info("MocoSweep: solving point {} of {} (warm start from "
+                     "point {}).",
+                    ipoint + 1, numPoints, iguess + 1);
+            solutions[ipoint] = nlp->solve(solutions[iguess]);
+        }
+        solved[ipoint] = true;
+    }
+    return solutions;
+}
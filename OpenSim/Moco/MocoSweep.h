@@ -0,0 +1,156 @@
+#ifndef OPENSIM_MOCOSWEEP_H
+#define OPENSIM_MOCOSWEEP_H
+/* -------------------------------------------------------------------------- *
+ * OpenSim: MocoSweep.h                                                       *
+ * -------------------------------------------------------------------------- *
+ * Copyright (c) 2023 Stanford University and the Authors                     *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0          *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "MocoBounds.h"
+#include "MocoStudy.h"
+#include "MocoTrajectory.h"
+
+#include <string>
+#include <vector>
+
+namespace OpenSim {
+
+/** A point in a MocoSweep: a set of numeric overrides that are applied to a
+copy of the sweep's base MocoStudy before solving it. Overrides that are not
+specified retain the value from the base study. The setters return this point
+so that calls can be chained:
+@code
+MocoSweepPoint point;
+point.setGoalWeight("effort", 0.1)
+     .setModelPropertyValue("/bodyset/body", "mass", 2.0);
+@endcode */
+class OSIMMOCO_API MocoSweepPoint {
+public:
+    /// Set the weight of the goal with the given name.
+    MocoSweepPoint& setGoalWeight(const std::string& goalName, double weight);
+    /// Set the bounds of the MocoParameter with the given name. Use
+    /// MocoBounds(value) to fix the parameter to a single value.
+    MocoSweepPoint& setParameterBounds(
+            const std::string& parameterName, const MocoBounds& bounds);
+    /// Set the value of a double-valued property of a component in the
+    /// problem's model. The problem's model must have been set with
+    /// MocoProblem::setModel() or MocoProblem::setModelAsCopy() (not from a
+    /// file).
+    MocoSweepPoint& setModelPropertyValue(const std::string& componentPath,
+            const std::string& propertyName, double value);
+
+private:
+    struct GoalWeight {
+        std::string name;
+        double weight;
+    };
+    struct ParameterBounds {
+        std::string name;
+        MocoBounds bounds;
+    };
+    struct ModelPropertyValue {
+        std::string componentPath;
+        std::string propertyName;
+        double value;
+    };
+    std::vector<GoalWeight> m_goalWeights;
+    std::vector<ParameterBounds> m_parameterBounds;
+    std::vector<ModelPropertyValue> m_modelPropertyValues;
+
+    friend class MocoSweep;
+};
+
+/** Solve a MocoStudy for many values of its numeric settings (goal weights,
+MocoParameter bounds, model property values), as in a sensitivity study.
+The study's solver must be a MocoCasADiSolver. solve() returns the solutions
+in the order the points were added.
+
+Reusing work across points
+==========================
+Goal weights and MocoParameter bounds are numeric inputs of the nonlinear
+program (NLP), so points that differ only in these values share one
+MocoCasADiSolver::ReusableNLP: the MocoProblemRep%s, the CasADi expression
+graph, the Jacobian sparsity patterns, and the nlpsol function are created
+once, and each point only passes its values to the NLP. Model property values
+are baked into the problem, so a new NLP is created for each distinct set of
+model property values. To avoid detecting the same Jacobian sparsity patterns
+for each of these NLPs, set the `optim_sparsity_cache_directory` property of
+the base study's MocoCasADiSolver, or use "structural" sparsity detection.
+If scaling variables using bounds, MocoParameter%s are scaled using their
+bounds in the base study.
+
+Warm starts
+===========
+By default, each point is solved with the solution of the nearest point
+that was already solved successfully as the initial guess. The distance
+between points is the Euclidean distance between their override values, with
+each override normalized by its range across all points. Points are solved in
+a nearest-neighbor order, starting with the first point, so that consecutive
+solves differ as little as possible; points with the same model property
+values as the previous point are solved first, so that each NLP is created
+once. A point is solved with the base study's guess if no point has been
+solved yet or if warm starts are disabled with setWarmStart(false).
+
+Parallelization
+===============
+Points are solved one at a time. Ipopt (with its MUMPS linear solver) is not
+thread-safe, so points cannot be solved concurrently within one process.
+Instead, each solve can use setNumGridThreads() threads to evaluate the
+problem's functions across the mesh (the `parallel` property of
+MocoCasADiSolver). To solve points concurrently, split the points across
+separate processes. */
+class OSIMMOCO_API MocoSweep {
+public:
+    /// The study is copied; changes to it after this call have no effect on
+    /// the sweep. The study's solver must be a MocoCasADiSolver.
+    explicit MocoSweep(MocoStudy study);
+
+    /// Add a point to the sweep. The index of the point's solution in the
+    /// vector returned by solve() is the order in which it was added.
+    void addPoint(MocoSweepPoint point);
+    int getNumPoints() const { return (int)m_points.size(); }
+
+    /// The number of threads used within each solve, which sets the
+    /// `parallel` property of MocoCasADiSolver. The default, 0, means that
+    /// each solve uses the base study's setting.
+    void setNumGridThreads(int numThreads);
+    int getNumGridThreads() const { return m_numGridThreads; }
+
+    /// Should each point be solved using the solution of the nearest solved
+    /// point as the initial guess? Default: true.
+    void setWarmStart(bool tf) { m_warmStart = tf; }
+    bool getWarmStart() const { return m_warmStart; }
+
+    /// Solve all points. If solving a point throws an exception, the
+    /// remaining points are not solved and the exception is propagated.
+    std::vector<MocoSolution> solve() const;
+
+private:
+    /// Apply the point's model property values to the study's problem.
+    static void applyModelPropertyValues(
+            const MocoSweepPoint& point, MocoStudy& study);
+    /// Each point's override values, in the same order for all points.
+    /// Overrides that a point does not specify take the base study's value.
+    /// `isModelProperty` marks the values that are model property values.
+    std::vector<std::vector<double>> createFeatures(
+            std::vector<bool>& isModelProperty) const;
+
+    MocoStudy m_study;
+    std::vector<MocoSweepPoint> m_points;
+    int m_numGridThreads = 0;
+    bool m_warmStart = true;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_MOCOSWEEP_H
@@ -23,6 +23,7 @@
 #include <OpenSim/Actuators/BodyActuator.h>
 #include <OpenSim/Actuators/CoordinateActuator.h>
 #include <OpenSim/Actuators/ModelFactory.h>
+#include <OpenSim/Common/LogSink.h>
 #include <OpenSim/Common/STOFileAdapter.h>
 #include <OpenSim/Moco/osimMoco.h>
 #include <OpenSim/Simulation/Manager/Manager.h>
@@ -2011,6 +2012,154 @@ TEST_CASE("MocoPhase::bound_activation_from_excitation") {
     }
 }
 
+TEST_CASE("Structural sparsity detection", "[casadi]") {
+    // Two muscles with activation dynamics pull a mass in opposite
+    // directions. The excitation of each muscle affects only its own
+    // activation, so the structural sparsity pattern is sparser than the
+    // dense blocks used by default, and it must lead to the same solution as
+    // the pattern detected from random iterates.
+    auto createModel = []() {
+        auto model = make_unique<Model>();
+        model->setName("muscles");
+        auto* body = new Body("body", 0.5, SimTK::Vec3(0), SimTK::Inertia(0));
+        model->addComponent(body);
+        auto* joint = new SliderJoint("joint", model->getGround(), *body);
+        auto& coord = joint->updCoordinate(SliderJoint::Coord::TranslationX);
+        coord.setName("x");
+        model->addComponent(joint);
+        for (const auto& side : {-1, 1}) {
+            auto* muscle = new DeGrooteFregly2016Muscle();
+            muscle->setName(side < 0 ? "left" : "right");
+            muscle->set_ignore_tendon_compliance(true);
+            muscle->set_fiber_damping(0);
+            muscle->set_max_isometric_force(30);
+            muscle->set_optimal_fiber_length(0.2);
+            muscle->set_tendon_slack_length(0.05);
+            muscle->addNewPathPoint("origin", model->updGround(),
+                    SimTK::Vec3(0.25 * side, 0, 0));
+            muscle->addNewPathPoint("insertion", *body, SimTK::Vec3(0));
+            model->addComponent(muscle);
+        }
+        model->finalizeConnections();
+        return model;
+    };
+    auto solve = [&](const std::string& sparsityDetection) {
+        MocoStudy study;
+        auto& problem = study.updProblem();
+        problem.setModel(createModel());
+        problem.setTimeBounds(0, 0.5);
+        problem.setStateInfo("/joint/x/value", {-0.1, 0.1}, 0, 0.05);
+        problem.setStateInfo("/joint/x/speed", {-5, 5}, 0, 0);
+        problem.addGoal<MocoControlGoal>();
+        auto& solver = study.initCasADiSolver();
+        solver.set_num_mesh_intervals(20);
+        solver.set_optim_sparsity_detection(sparsityDetection);
+        return study.solve();
+    };
+    const MocoSolution random = solve("random");
+    const MocoSolution structural = solve("structural");
+    REQUIRE(random.success());
+    REQUIRE(structural.success());
+    CHECK(structural.getObjective() == Approx(random.getObjective()));
+    CHECK(structural.compareContinuousVariablesRMS(random) < 1e-4);
+}
+
+TEST_CASE("Sparsity cache", "[casadi]") {
+    // Solving the problem again with a different goal weight loads the
+    // sparsity patterns detected in the first solve.
+    const std::string cacheDir =
+            "testMocoInterface_sparsity_cache_" + getFormattedDateTime();
+    auto solve = [&](double weight, std::string& log) {
+        MocoStudy study = createSlidingMassMocoStudy<MocoCasADiSolver>();
+        study.updProblem().updGoal("goal").setWeight(weight);
+        auto& solver = study.updSolver<MocoCasADiSolver>();
+        solver.set_optim_sparsity_detection("random");
+        solver.set_optim_sparsity_cache_directory(cacheDir);
+        auto sink = std::make_shared<StringLogSink>();
+        Logger::addSink(sink);
+        MocoSolution solution = study.solve();
+        Logger::removeSink(sink);
+        log = sink->getString();
+        return solution;
+    };
+    std::string firstLog;
+    std::string secondLog;
+    const MocoSolution first = solve(1.0, firstLog);
+    const MocoSolution second = solve(2.0, secondLog);
+    CHECK(firstLog.find("Sparsity cache miss") != std::string::npos);
+    CHECK(firstLog.find("Sparsity cache hit") == std::string::npos);
+    CHECK(secondLog.find("Sparsity cache hit") != std::string::npos);
+    CHECK(secondLog.find("Sparsity cache miss") == std::string::npos);
+    CHECK(second.getFinalTime() == Approx(first.getFinalTime()));
+
+    // Remove the cache files (named in the log) and the cache directory.
+    const std::string fileToken = "writing file '";
+    for (auto pos = firstLog.find(fileToken); pos != std::string::npos;
+            pos = firstLog.find(fileToken, pos)) {
+        pos += fileToken.size();
+        const auto end = firstLog.find('\'', pos);
+        const std::string fileName = firstLog.substr(pos, end - pos);
+        {
+            // The files hold a hash of the problem, not the model itself.
+            std::ifstream file(fileName);
+            const std::string contents((std::istreambuf_iterator<char>(file)),
+                    std::istreambuf_iterator<char>());
+            CHECK(!contents.empty());
+            CHECK(contents.find("<Model") == std::string::npos);
+        }
+        std::remove(fileName.c_str());
+    }
+    CHECK(IO::removeDir(cacheDir) == 0);
+}
+
+TEST_CASE("MocoSweep", "[casadi]") {
+    MocoStudy study = createSlidingMassMocoStudy<MocoCasADiSolver>();
+    study.updProblem().addGoal<MocoControlGoal>("effort", 0.1);
+    const MocoSolution baseline = study.solve();
+
+    MocoSweep sweep(study);
+    sweep.setNumGridThreads(1);
+    for (double mass : {10.0, 20.0, 10.0}) {
+        sweep.addPoint(MocoSweepPoint().setModelPropertyValue(
+                "/body", "mass", mass));
+    }
+    sweep.addPoint(MocoSweepPoint().setGoalWeight("effort", 0.2));
+    CHECK(sweep.getNumPoints() == 4);
+    const std::vector<MocoSolution> solutions = sweep.solve();
+    REQUIRE(solutions.size() == 4);
+    for (const auto& solution : solutions) REQUIRE(solution.success());
+
+    CHECK(solutions[0].getFinalTime() ==
+            Approx(baseline.getFinalTime()).epsilon(1e-4));
+    CHECK(solutions[2].getFinalTime() ==
+            Approx(baseline.getFinalTime()).epsilon(1e-4));
+    // A heavier mass takes longer to move.
+    CHECK(solutions[1].getFinalTime() > baseline.getFinalTime());
+    // Penalizing effort more slows down the motion.
+    CHECK(solutions[3].getFinalTime() > baseline.getFinalTime());
+    // The third point is identical to the first, so it is solved next and
+    // starts from the first point's solution.
+    CHECK(solutions[2].getNumIterations() < solutions[0].getNumIterations());
+
+    // The fourth point only changes a goal weight, so it reuses the NLP of
+    // the first point; the result matches solving with the weight directly.
+    {
+        MocoStudy heavierEffort = study;
+        heavierEffort.updProblem().updGoal("effort").setWeight(0.2);
+        const MocoSolution expected = heavierEffort.solve();
+        CHECK(solutions[3].getObjective() ==
+                Approx(expected.getObjective()).epsilon(1e-4));
+        CHECK(solutions[3].getFinalTime() ==
+                Approx(expected.getFinalTime()).epsilon(1e-4));
+    }
+
+    MocoSweepPoint invalid;
+    invalid.setGoalWeight("nonexistent", 1.0);
+    MocoSweep invalidSweep(study);
+    invalidSweep.addPoint(invalid);
+    CHECK_THROWS_AS(invalidSweep.solve(), Exception);
+}
+
 TEST_CASE("updateStateLabels40") {
     auto model = ModelFactory::createPendulum();
     model.initSystem();
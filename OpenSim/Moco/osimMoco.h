@@ -52,6 +52,7 @@
 #include "MocoSolver.h"
 #include "MocoStudy.h"
 #include "MocoStudyFactory.h"
+#include "MocoSweep.h"
 #include "MocoTrack.h"
 #include "MocoTrajectory.h"
 #include "MocoTropterSolver.h"
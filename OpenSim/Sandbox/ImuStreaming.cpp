@@ -18,9 +18,11 @@ tracking of pose.*/
 #include <string>
 #include <array>
 #include <regex>
+#include <thread>
 #include <cmath>
 
 #include <OpenSim/OpenSim.h>
+#include <OpenSim/Common/DataQueue.h>
 
 class Kalman {
 public:
@@ -243,6 +245,40 @@ int main() {
 
     auto sock = openUdpSocket();
 
+    // ------------------------- Receiving.
+    // A separate thread receives the packets so that a slow frame does not
+    // delay reading the socket. Each row holds gravity (3) and omega (3). The
+    // visualization only needs the latest samples, so when the queue is full
+    // the oldest sample is dropped.
+    OpenSim::DataQueue_<double> imuQueue{
+            16, 6, OpenSim::DataQueueOverflowPolicy::DropOldest};
+    std::thread receiver{[&imuQueue, sock]() {
+        SimTK::RowVector_<double> row(6);
+        while(true) {
+            char buffer[BUFFSIZE];
+            auto bytes = recvfrom(sock, buffer, BUFFSIZE, 0, 0, 0);
+
+            if(bytes > 0) {
+                auto data = parseImuData(buffer, BUFFSIZE);
+
+                auto& gravity   = std::get<1>(data);
+                auto& omega     = std::get<2>(data);
+
+                // If omega is (0, 0, 0), skip over because there was no data.
+                // All three components are never equal except when they are 0.
+                if(omega[0] == omega[1] && omega[1] == omega[2])
+                    continue;
+
+                for(int i = 0; i < 3; ++i) {
+                    row[i] = gravity[i];
+                    row[3 + i] = omega[i];
+                }
+                imuQueue.push_back(std::get<0>(data), row);
+            } else
+                std::cout << "skipping....." << std::endl;
+        }
+    }};
+
     // ------------------------- Kalman filter.
     Kalman kalman_roll{};
     Kalman kalman_pitch{};
@@ -250,54 +286,49 @@ int main() {
     bool firstrow{true};
 
     // ------------------------ Streaming.
+    SimTK::RowVector_<double> row(6);
     while(true) {
-        char buffer[BUFFSIZE];
-        auto bytes = recvfrom(sock, buffer, BUFFSIZE, 0, 0, 0);
-
-        if(bytes > 0) {
-            auto data = parseImuData(buffer, BUFFSIZE);
-
-            auto& timestamp = std::get<0>(data);
-            auto& gravity   = std::get<1>(data);
-            auto& omega     = std::get<2>(data);
-
-            // If omega is (0, 0, 0), skip over because there was no data.
-            // All three components are never equal except when they are 0.
-            if(omega[0] == omega[1] && omega[1] == omega[2])
-                continue;
-
-            // Compute change in time and record the timestamp.
-            auto deltat = timestamp - oldtimestamp;
-            oldtimestamp = timestamp;
-            if(firstrow) {
-                firstrow = false;
-                continue;
-            }
-
-            auto tilt = computeRollPitch(gravity);
-            auto roll  = radToDeg(tilt.first);
-            auto pitch = radToDeg(tilt.second);
-
-            omega[0] = radToDeg(omega[0]);
-            omega[1] = radToDeg(omega[1]);
-            omega[2] = radToDeg(omega[2]);
-
-            // Angular velocity about axis y is roll.
-            // Angular velocity about axis x is pitch.
-            auto roll_hat  =  kalman_roll.getAngle( roll, omega[1], deltat);
-            auto pitch_hat = kalman_pitch.getAngle(pitch, omega[0], deltat);
-
-            // Multiplying -1 to roll just for display. This way visualizaiton moves
-            // like the physical phone.
-            model.getCoordinateSet()[0].setValue(state, -1 * degToRad( roll_hat));
-            model.getCoordinateSet()[2].setValue(state, degToRad(pitch_hat));
-            
-            viz.drawFrameNow(state);
-            
-            //std::cout << buffer << std::endl;
-        } else
-            std::cout << "skipping....." << std::endl;
+        double timestamp{};
+        imuQueue.pop_front(timestamp, row);
+        std::array<double, 3> gravity{{row[0], row[1], row[2]}};
+        std::array<double, 3> omega{{row[3], row[4], row[5]}};
+
+        // Compute change in time and record the timestamp.
+        auto deltat = timestamp - oldtimestamp;
+        oldtimestamp = timestamp;
+        if(firstrow) {
+            firstrow = false;
+            continue;
+        }
+
+        auto tilt = computeRollPitch(gravity);
+        auto roll  = radToDeg(tilt.first);
+        auto pitch = radToDeg(tilt.second);
+
+        omega[0] = radToDeg(omega[0]);
+        omega[1] = radToDeg(omega[1]);
+        omega[2] = radToDeg(omega[2]);
+
+        // Angular velocity about axis y is roll.
+        // Angular velocity about axis x is pitch.
+        auto roll_hat  =  kalman_roll.getAngle( roll, omega[1], deltat);
+        auto pitch_hat = kalman_pitch.getAngle(pitch, omega[0], deltat);
+
+        // Multiplying -1 to roll just for display. This way visualizaiton moves
+        // like the physical phone.
+        model.getCoordinateSet()[0].setValue(state, -1 * degToRad( roll_hat));
+        model.getCoordinateSet()[2].setValue(state, degToRad(pitch_hat));
+
+        viz.drawFrameNow(state);
+
+        if(imuQueue.getNumPopped() % 1000 == 0) {
+            std::cout << "dropped samples: " << imuQueue.getNumDropped()
+                      << ", mean latency: "
+                      << 1000 * imuQueue.getMeanLatency() << " ms, max latency: "
+                      << 1000 * imuQueue.getMaxLatency() << " ms" << std::endl;
+        }
     }
 
+    receiver.join();
     return 0;
 }
@@ -0,0 +1,139 @@
+/* -------------------------------------------------------------------------- *
+ *                   OpenSim:  benchmarkMeshContact.cpp                       *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+// Compares the time to compute the contact force between two overlapping
+// mesh spheres with ElasticFoundationForce and with MeshContactForce, for
+// several numbers of threads.
+//
+// The meshes are synthetic: uniformly subdivided spheres generated by
+// SimTK::PolygonalMesh::createSphereMesh(), not scanned articular surfaces.
+// Their triangles all have about the same size and the contact patch is
+// symmetric, so the timings show how the forces scale with the number of
+// triangles but need not match those for meshes from medical images.
+//
+// Usage: benchmarkMeshContact [resolution] [numEvaluations]
+// Each sphere has 8 * 4^resolution triangles; by default, the resolution is 6
+// (32768 triangles) and the force is evaluated 100 times.
+
+#include <OpenSim/Common/Stopwatch.h>
+#include <OpenSim/Simulation/Model/ContactMesh.h>
+#include <OpenSim/Simulation/Model/ElasticFoundationForce.h>
+#include <OpenSim/Simulation/Model/MeshContactForce.h>
+#include <OpenSim/Simulation/Model/Model.h>
+#include <OpenSim/Simulation/SimbodyEngine/FreeJoint.h>
+
+#include <fstream>
+#include <memory>
+#include <iostream>
+#include <string>
+
+using namespace OpenSim;
+using SimTK::Vec3;
+
+namespace {
+const double radius = 0.1;
+const std::string meshFile = "benchmarkMeshContact_synthetic_sphere.obj";
+
+void writeObj(const SimTK::PolygonalMesh& mesh, const std::string& filename) {
+    std::ofstream file(filename);
+    for (int v = 0; v < mesh.getNumVertices(); ++v) {
+        const Vec3& vertex = mesh.getVertexPosition(v);
+        file << "v " << vertex[0] << " " << vertex[1] << " " << vertex[2]
+             << "\n";
+    }
+    for (int f = 0; f < mesh.getNumFaces(); ++f) {
+        file << "f";
+        for (int k = 0; k < mesh.getNumVerticesForFace(f); ++k) {
+            file << " " << mesh.getFaceVertex(f, k) + 1;
+        }
+        file << "\n";
+    }
+}
+
+// The upper sphere is free and overlaps the fixed lower sphere by 5 mm.
+std::unique_ptr<Model> createModel(Force* force) {
+    auto model = std::unique_ptr<Model>(new Model());
+    model->setGravity(Vec3(0));
+    auto* ball = new OpenSim::Body("ball", 1.0, Vec3(0), SimTK::Inertia(1.0));
+    model->addBody(ball);
+    model->addJoint(new FreeJoint("free", model->getGround(), Vec3(0),
+            Vec3(0), *ball, Vec3(0), Vec3(0)));
+    auto* lower = new ContactMesh(
+            meshFile, Vec3(0), Vec3(0), model->getGround(), "lower");
+    auto* upper = new ContactMesh(meshFile, Vec3(0), Vec3(0), *ball, "upper");
+    model->addContactGeometry(lower);
+    model->addContactGeometry(upper);
+    if (auto* meshContact = dynamic_cast<MeshContactForce*>(force)) {
+        meshContact->connectSocket_target_mesh(*upper);
+        meshContact->connectSocket_base_mesh(*lower);
+    }
+    model->addForce(force);
+    return model;
+}
+
+double time(Model& model, int numEvaluations) {
+    SimTK::State& state = model.initSystem();
+    Stopwatch watch;
+    for (int i = 0; i < numEvaluations; ++i) {
+        // Change the positions so that the contacts are recomputed.
+        state.updQ()[4] = 2 * radius - 0.005 + 1e-6 * (i % 2);
+        model.realizeDynamics(state);
+    }
+    return watch.getElapsedTime() / numEvaluations;
+}
+} // anonymous namespace
+
+int main(int argc, char* argv[]) {
+    int resolution = 6;
+    int numEvaluations = 100;
+    if (argc > 1) resolution = std::stoi(argv[1]);
+    if (argc > 2) numEvaluations = std::stoi(argv[2]);
+
+    SimTK::PolygonalMesh sphere =
+            SimTK::PolygonalMesh::createSphereMesh(radius, resolution);
+    writeObj(sphere, meshFile);
+
+    std::cout << "Synthetic sphere meshes (createSphereMesh, resolution "
+              << resolution << ")" << std::endl;
+    std::cout << "force, triangles, threads, per evaluation [ms]" << std::endl;
+    auto report = [&](const std::string& force, int numThreads,
+                          double duration) {
+        std::cout << force << ", " << sphere.getNumFaces() << ", "
+                  << numThreads << ", " << 1000 * duration << std::endl;
+    };
+
+    {
+        auto* params = new ElasticFoundationForce::ContactParameters(
+                1e6, 0.0, 0.0, 0.0, 0.0);
+        params->addGeometry("upper");
+        params->addGeometry("lower");
+        auto model = createModel(new ElasticFoundationForce(params));
+        report("ElasticFoundationForce", 1, time(*model, numEvaluations));
+    }
+
+    for (int numThreads : {1, 2, 4, 8}) {
+        auto* force = new MeshContactForce();
+        force->setName("contact");
+        force->set_num_threads(numThreads);
+        auto model = createModel(force);
+        report("MeshContactForce", numThreads, time(*model, numEvaluations));
+    }
+    return 0;
+}
@@ -0,0 +1,79 @@
+/* -------------------------------------------------------------------------- *
+ *                  OpenSim:  benchmarkModelLoading.cpp                       *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+// Measures the time to load .osim files, either by deserializing them with
+// Model(const std::string&) or with Model::loadFromFileCached(), and the time
+// to call initSystem() on the loaded model.
+//
+// Usage: benchmarkModelLoading [numRepetitions] [model.osim ...]
+// By default, the models bundled with the tests are loaded 10 times each.
+
+#include <OpenSim/Common/Logger.h>
+#include <OpenSim/Common/Stopwatch.h>
+#include <OpenSim/Simulation/Model/Model.h>
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace OpenSim;
+
+int main(int argc, char* argv[]) {
+    int numRepetitions = 10;
+    std::vector<std::string> fileNames;
+    if (argc > 1) numRepetitions = std::stoi(argv[1]);
+    for (int i = 2; i < argc; ++i) fileNames.push_back(argv[i]);
+    if (fileNames.empty()) {
+        fileNames = {"arm26.osim", "gait10dof18musc_subject01.osim",
+                     "ThoracoscapularShoulderModel.osim"};
+    }
+
+    // Keep the log from dominating the timings.
+    Logger::setLevel(Logger::Level::Warn);
+
+    std::cout << "file, repetitions, Model() [ms], loadFromFileCached() [ms], "
+                 "initSystem() [ms]" << std::endl;
+    for (const auto& fileName : fileNames) {
+        Stopwatch watch;
+        for (int i = 0; i < numRepetitions; ++i) {
+            Model model(fileName);
+        }
+        const double uncached = watch.getElapsedTime() / numRepetitions;
+
+        Model::clearModelFileCache();
+        watch.reset();
+        for (int i = 0; i < numRepetitions; ++i) {
+            std::unique_ptr<Model> model(Model::loadFromFileCached(fileName));
+        }
+        const double cached = watch.getElapsedTime() / numRepetitions;
+
+        std::unique_ptr<Model> model(Model::loadFromFileCached(fileName));
+        watch.reset();
+        model->initSystem();
+        const double initSystem = watch.getElapsedTime();
+
+        std::cout << fileName << ", " << numRepetitions << ", "
+                  << 1000 * uncached << ", " << 1000 * cached << ", "
+                  << 1000 * initSystem << std::endl;
+    }
+    Model::clearModelFileCache();
+    return 0;
+}
@@ -0,0 +1,121 @@
+/* -------------------------------------------------------------------------- *
+ *                  OpenSim:  benchmarkRotationKernels.cpp                    *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+// Compares the time to transform a table of sensor orientations element by
+// element with SimTK::Rotation and SimTK::Quaternion against the batched
+// RotationKernels used by OpenSenseUtilities and TableUtilities.
+//
+// Usage: benchmarkRotationKernels [numRows] [numColumns]
+// By default, the table has 100000 rows and 10 columns.
+
+#include <OpenSim/Common/RotationKernels.h>
+#include <OpenSim/Common/Stopwatch.h>
+
+#include <iostream>
+#include <string>
+
+using namespace OpenSim;
+
+int main(int argc, char* argv[]) {
+    int numRows = 100000;
+    int numColumns = 10;
+    if (argc > 1) numRows = std::stoi(argv[1]);
+    if (argc > 2) numColumns = std::stoi(argv[2]);
+
+    SimTK::Random::Gaussian random;
+    random.setSeed(0);
+    SimTK::Matrix_<SimTK::Quaternion> quaternions(numRows, numColumns);
+    for (int i = 0; i < numRows; ++i) {
+        for (int j = 0; j < numColumns; ++j) {
+            quaternions(i, j) = SimTK::Quaternion(
+                    SimTK::Vec4(random.getValue(), random.getValue(),
+                            random.getValue(), random.getValue()));
+        }
+    }
+    const SimTK::Rotation R_XG(SimTK::BodyOrSpaceType::SpaceRotationSequence,
+            -SimTK::Pi / 2, SimTK::XAxis, 0, SimTK::YAxis, 0, SimTK::ZAxis);
+
+    SimTK::Matrix_<SimTK::Quaternion> rotated(numRows, numColumns);
+    SimTK::Matrix_<SimTK::Rotation> rotations(numRows, numColumns);
+    SimTK::Matrix_<SimTK::Vec3> angles(numRows, numColumns);
+
+    std::cout << "operation, rows, columns, per element [ms], kernels [ms]"
+              << std::endl;
+    auto report = [&](const std::string& operation, double perElement,
+                          double kernels) {
+        std::cout << operation << ", " << numRows << ", " << numColumns << ", "
+                  << 1000 * perElement << ", " << 1000 * kernels << std::endl;
+    };
+
+    // Rotate the quaternions, as OpenSenseUtilities::rotateOrientationTable()
+    // does.
+    Stopwatch watch;
+    for (int i = 0; i < numRows; ++i) {
+        for (int j = 0; j < numColumns; ++j) {
+            rotated(i, j) = (R_XG * SimTK::Rotation(quaternions(i, j)))
+                                    .convertRotationToQuaternion();
+        }
+    }
+    double perElement = watch.getElapsedTime();
+    watch.reset();
+    QuaternionArrays q;
+    for (int j = 0; j < numColumns; ++j) {
+        RotationKernels::loadColumn(quaternions, j, q);
+        RotationKernels::rotate(R_XG, q);
+        RotationKernels::storeColumn(q, j, rotated);
+    }
+    report("rotate", perElement, watch.getElapsedTime());
+
+    // Convert the quaternions to rotation matrices.
+    watch.reset();
+    for (int i = 0; i < numRows; ++i) {
+        for (int j = 0; j < numColumns; ++j) {
+            rotations(i, j) = SimTK::Rotation(quaternions(i, j));
+        }
+    }
+    perElement = watch.getElapsedTime();
+    watch.reset();
+    RotationMatrixArrays R;
+    for (int j = 0; j < numColumns; ++j) {
+        RotationKernels::loadColumn(quaternions, j, q);
+        RotationKernels::convertQuaternionsToRotations(q, R);
+        RotationKernels::storeColumn(R, j, rotations);
+    }
+    report("quaternion to rotation", perElement, watch.getElapsedTime());
+
+    // Convert the rotation matrices to body-fixed XYZ Euler angles.
+    watch.reset();
+    for (int i = 0; i < numRows; ++i) {
+        for (int j = 0; j < numColumns; ++j) {
+            angles(i, j) = rotations(i, j).convertRotationToBodyFixedXYZ();
+        }
+    }
+    perElement = watch.getElapsedTime();
+    watch.reset();
+    AngleArrays xyz;
+    for (int j = 0; j < numColumns; ++j) {
+        RotationKernels::loadColumn(rotations, j, R);
+        RotationKernels::convertRotationsToBodyFixedXYZ(R, xyz);
+        RotationKernels::storeColumn(xyz, j, angles);
+    }
+    report("rotation to Euler angles", perElement, watch.getElapsedTime());
+
+    return 0;
+}
@@ -24,8 +24,12 @@
 #include "AssemblySolver.h"
 #include "OpenSim/Simulation/Model/Model.h"
 #include <OpenSim/Common/Constant.h>
+#include <OpenSim/Common/Stopwatch.h>
 #include "simbody/internal/AssemblyCondition_QValue.h"
 
+#include <algorithm>
+#include <cmath>
+
 using namespace std;
 using namespace SimTK;
 
@@ -87,6 +91,9 @@ void AssemblySolver::setupGoals(SimTK::State &s)
     // wipe-out the previous SimTK::Assembler
     _assembler.reset(new SimTK::Assembler(getModel().getMultibodySystem()));
     _assembler->setAccuracy(_accuracy);
+    _trackingAccuracy = _accuracy;
+    _numFastFrames = 0;
+    _numPreviousFrames = 0;
 
     // Define weights on constraints. Note can be specified SimTK::Infinity to strictly enforce constraint
     // otherwise the weighted constraint error becomes a goal.
@@ -257,13 +264,19 @@ void AssemblySolver::track(SimTK::State &s)
             "AssemblySolver::track() failed: assemble() must be called first.");
     }
 
-    // TODO: Useful to include through debug message/log in the future
-    log_debug("UNASSEMBLED(track) CONFIGURATION (normerr={}, maxerr={}, cost={})",
-        _assembler->calcCurrentErrorNorm(), 
-        max(abs(_assembler->getInternalState().getQErr())), 
-        _assembler->calcCurrentGoal() );
-    log_debug("Model numQs: {}  Assembler num freeQs: {}",
-        _assembler->getInternalState().getNQ(), _assembler->getNumFreeQs());
+    // The arguments are expensive to evaluate, so only compute them when the
+    // message will be logged.
+    const bool logDebug = Logger::shouldLog(Logger::Level::Debug);
+    if (logDebug) {
+        log_debug("UNASSEMBLED(track) CONFIGURATION (normerr={}, maxerr={}, "
+                  "cost={})",
+            _assembler->calcCurrentErrorNorm(),
+            max(abs(_assembler->getInternalState().getQErr())),
+            _assembler->calcCurrentGoal() );
+        log_debug("Model numQs: {}  Assembler num freeQs: {}",
+            _assembler->getInternalState().getNQ(),
+            _assembler->getNumFreeQs());
+    }
 
     try{
         // Now do the assembly and return the updated state.
@@ -272,12 +285,16 @@ void AssemblySolver::track(SimTK::State &s)
         // update the state from the result of the assembler 
         _assembler->updateFromInternalState(s);
         
-        // TODO: Useful to include through debug message/log in the future
-        log_debug("Tracking: t= {} (acc={} tol={} normerr={}, maxerr={}, cost={})", 
-            s.getTime(),
-            _assembler->getAccuracyInUse(), _assembler->getErrorToleranceInUse(), 
-            _assembler->calcCurrentErrorNorm(), max(abs(_assembler->getInternalState().getQErr())),
-            _assembler->calcCurrentGoal()); 
+        if (logDebug) {
+            log_debug("Tracking: t= {} (acc={} tol={} normerr={}, maxerr={}, "
+                      "cost={})",
+                s.getTime(),
+                _assembler->getAccuracyInUse(),
+                _assembler->getErrorToleranceInUse(),
+                _assembler->calcCurrentErrorNorm(),
+                max(abs(_assembler->getInternalState().getQErr())),
+                _assembler->calcCurrentGoal());
+        }
     }
     catch (const std::exception& ex)
     {
@@ -286,6 +303,114 @@ void AssemblySolver::track(SimTK::State &s)
     }
 }
 
+TrackingFrameReport AssemblySolver::trackWithinBudget(SimTK::State &s)
+{
+    if (!_assembler || !_assembler->isInitialized()) {
+        throw Exception("AssemblySolver::trackWithinBudget() failed: "
+                        "assemble() must be called first.");
+    }
+    Stopwatch watch;
+    updateGoals(s);
+    const double time = s.getTime();
+
+    // Start from the previous solution, extrapolated to the new time.
+    if (_extrapolateFromPreviousFrames && _numPreviousFrames == 2) {
+        const double dtPrevious = _previousTimes[1] - _previousTimes[0];
+        const double dt = time - _previousTimes[1];
+        if (dtPrevious > 0 && dt > 0) {
+            _assembler->setInternalStateFromFreeQs(_previousFreeQs[1] +
+                    (dt / dtPrevious) *
+                            (_previousFreeQs[1] - _previousFreeQs[0]));
+        }
+    }
+
+    TrackingFrameReport report;
+    report.time = time;
+    report.accuracy = _trackingAccuracy;
+    try {
+        _assembler->track(time);
+        _assembler->updateFromInternalState(s);
+    }
+    catch (const std::exception& ex)
+    {
+        log_info("AssemblySolver::trackWithinBudget() attempt Failed: {}",
+                ex.what());
+        throw Exception("AssemblySolver::trackWithinBudget() attempt failed.");
+    }
+    report.errorNorm = _assembler->calcCurrentErrorNorm();
+    report.goal = _assembler->calcCurrentGoal();
+
+    if (_numPreviousFrames == 2) {
+        std::swap(_previousFreeQs[0], _previousFreeQs[1]);
+        _previousTimes[0] = _previousTimes[1];
+    } else {
+        ++_numPreviousFrames;
+    }
+    _previousFreeQs[_numPreviousFrames - 1] =
+            _assembler->getFreeQsFromInternalState();
+    _previousTimes[_numPreviousFrames - 1] = time;
+
+    report.duration = watch.getElapsedTime();
+    const int maxNumFrameDurations = 10000;
+    if ((int)_frameDurations.size() < maxNumFrameDurations) {
+        _frameDurations.push_back(report.duration);
+    } else {
+        _frameDurations[_nextFrameDurationIndex] = report.duration;
+        _nextFrameDurationIndex =
+                (_nextFrameDurationIndex + 1) % maxNumFrameDurations;
+    }
+
+    // Adapt the accuracy for the next frame. Changing the accuracy causes the
+    // assembler to reinitialize, so only change it in steps of 10.
+    if (_timeBudget > 0) {
+        double accuracy = _trackingAccuracy;
+        if (report.duration > _timeBudget) {
+            report.withinBudget = false;
+            ++_numFramesOverBudget;
+            _numFastFrames = 0;
+            accuracy = std::min(10 * accuracy, _loosestAccuracy);
+        } else if (report.duration < 0.5 * _timeBudget) {
+            if (++_numFastFrames >= 10) {
+                _numFastFrames = 0;
+                accuracy = std::max(0.1 * accuracy, _accuracy);
+            }
+        } else {
+            _numFastFrames = 0;
+        }
+        if (accuracy != _trackingAccuracy) {
+            log_debug("AssemblySolver::trackWithinBudget(): changing accuracy "
+                      "from {} to {} at time {}.",
+                    _trackingAccuracy, accuracy, time);
+            _trackingAccuracy = accuracy;
+            _assembler->setAccuracy(accuracy);
+            if (!_assembler->isInitialized()) _assembler->initialize();
+        }
+    }
+    return report;
+}
+
+double AssemblySolver::getFrameDurationPercentile(double percentile) const
+{
+    OPENSIM_THROW_IF(percentile < 0 || percentile > 1, Exception,
+            "Expected percentile to be between 0 and 1, but got {}.",
+            percentile);
+    if (_frameDurations.empty()) return SimTK::NaN;
+    std::vector<double> durations = _frameDurations;
+    const auto index = (size_t)std::round(percentile * (durations.size() - 1));
+    std::nth_element(durations.begin(), durations.begin() + index,
+            durations.end());
+    return durations[index];
+}
+
+void AssemblySolver::resetFrameStatistics()
+{
+    _frameDurations.clear();
+    _nextFrameDurationIndex = 0;
+    _numFramesOverBudget = 0;
+    _numFastFrames = 0;
+    _numPreviousFrames = 0;
+}
+
 const SimTK::Assembler& AssemblySolver::getAssembler() const
 {
     OPENSIM_THROW_IF(!_assembler, Exception,
@@ -36,6 +36,23 @@ namespace OpenSim {
 
 class Model;
 
+/** Information about a frame solved by AssemblySolver::trackWithinBudget(). */
+struct TrackingFrameReport {
+    /// The time of the frame.
+    double time = SimTK::NaN;
+    /// The wall-clock time (seconds) spent on the frame, including updating
+    /// the goals from the references.
+    double duration = SimTK::NaN;
+    /// The accuracy requested from the underlying SimTK::Assembler.
+    double accuracy = SimTK::NaN;
+    /// The norm of the constraint errors at the solution.
+    double errorNorm = SimTK::NaN;
+    /// The value of the weighted assembly goals at the solution.
+    double goal = SimTK::NaN;
+    /// Whether the frame finished within the time budget.
+    bool withinBudget = true;
+};
+
 //=============================================================================
 //=============================================================================
 /**
@@ -115,6 +132,56 @@ public:
         find a nearby solution due to a small change in the desired value.*/
     virtual void track(SimTK::State &s);
 
+    /** @name Tracking with bounded latency
+    When tracking live data (e.g., wearable sensors driving a biofeedback
+    display), a guaranteed output rate matters more than the best possible
+    accuracy. trackWithinBudget() is a variant of track() that
+    - starts from the previous solution extrapolated to the new time with the
+      velocity of the two previous solutions, and
+    - adapts the accuracy requested from the assembler to a per-frame time
+      budget: after a frame exceeds the budget, the accuracy is loosened by a
+      factor of 10 (up to setLoosestAccuracy()); after 10 consecutive frames
+      that take less than half the budget, it is tightened by a factor of 10
+      (down to the accuracy from setAccuracy()).
+
+    The underlying SimTK::Assembler cannot be interrupted once it has started
+    a frame, so a frame can still exceed the budget; the returned
+    TrackingFrameReport contains the frame's duration and the error that was
+    achieved. The solver keeps the durations of the most recent 10000 frames
+    for latency statistics (e.g., getFrameDurationPercentile(0.99)). */
+    /// @{
+    /** %Set the wall-clock time (seconds) allowed per call to
+        trackWithinBudget(). A nonpositive value (the default) disables
+        adapting the accuracy. */
+    void setTimeBudget(double seconds) { _timeBudget = seconds; }
+    double getTimeBudget() const { return _timeBudget; }
+    /** %Set the loosest accuracy trackWithinBudget() may use (default: 0.1).
+     */
+    void setLoosestAccuracy(double accuracy) { _loosestAccuracy = accuracy; }
+    double getLoosestAccuracy() const { return _loosestAccuracy; }
+    /** %Set whether trackWithinBudget() extrapolates the previous solutions
+        to obtain the initial guess for each frame (default: true). */
+    void setExtrapolateFromPreviousFrames(bool extrapolate) {
+        _extrapolateFromPreviousFrames = extrapolate;
+    }
+    bool getExtrapolateFromPreviousFrames() const {
+        return _extrapolateFromPreviousFrames;
+    }
+    /** Like track(), but with a warm start and a per-frame time budget (see
+        above). assemble() must be called first. */
+    TrackingFrameReport trackWithinBudget(SimTK::State& s);
+    /** Return the given percentile (between 0 and 1; e.g., 0.5 for the
+        median) of the durations (seconds) of recent calls to
+        trackWithinBudget(), or NaN if there have been none. */
+    double getFrameDurationPercentile(double percentile) const;
+    /** The number of calls to trackWithinBudget() that exceeded the time
+        budget. */
+    int getNumFramesOverBudget() const { return _numFramesOverBudget; }
+    /** Forget the frame durations, the previous solutions used for
+        extrapolation, and the number of frames over budget. */
+    void resetFrameStatistics();
+    /// @}
+
     /** Read access to the underlying SimTK::Assembler. */
     const SimTK::Assembler& getAssembler() const;
 
@@ -147,6 +214,23 @@ private:
     SimTK::ResetOnCopy< std::unique_ptr<SimTK::Assembler>> _assembler;
 
     SimTK::Array_<SimTK::QValue*> _coordinateAssemblyConditions;
+
+    // Settings and statistics for trackWithinBudget().
+    double _timeBudget{0};
+    double _loosestAccuracy{0.1};
+    bool _extrapolateFromPreviousFrames{true};
+    // The accuracy the assembler is currently using for tracking.
+    double _trackingAccuracy{SimTK::NaN};
+    int _numFastFrames{0};
+    int _numFramesOverBudget{0};
+    // Free q's and times of the two most recent solutions; index 1 is the
+    // most recent.
+    int _numPreviousFrames{0};
+    SimTK::Vector _previousFreeQs[2];
+    double _previousTimes[2];
+    // Ring buffer of recent frame durations.
+    std::vector<double> _frameDurations;
+    int _nextFrameDurationIndex{0};
 //=============================================================================
 };  // END of class AssemblySolver
 //=============================================================================
@@ -78,7 +78,11 @@ public:
     void getValuesAtTime(double time,
             SimTK::Array_<SimTK::Rotation_<double>>& values) const override;
 
-    /** add passed in values to data procesing Queue */
+    /** add passed in values to data procesing Queue. By default, the queue
+     * grows as needed, so the values for many frames may be put before the
+     * solver takes any (e.g., from the same thread). If setBufferSettings()
+     * selects DataQueueOverflowPolicy::BackPressure, this waits while the
+     * queue is full, so the solver must then run on another thread. */
     void putValues(double time, const SimTK::RowVector_<SimTK::Rotation>& dataRow);
 
     double getNextValuesAndTime(
@@ -89,9 +93,30 @@ public:
     void setFinished(bool finished) { 
         _finished = finished;
     };
+
+    /** Set the number of rows held in the queue of values passed to
+     * putValues() and what putValues() does when the queue is full (grow the
+     * queue, wait for the solver, or drop the oldest row). The rows are
+     * preallocated with one element per orientation column. This discards
+     * queued values, so call it before streaming. By default, the queue
+     * starts with 1024 rows and grows when it is full; a bounded queue is
+     * opt-in. */
+    void setBufferSettings(size_t capacity, DataQueueOverflowPolicy policy) {
+        _orientationDataQueue.setCapacity(
+                capacity, (int)_orientationData.getNumColumns());
+        _orientationDataQueue.setOverflowPolicy(policy);
+    }
+
+    /** Access the queue of values passed to putValues(), e.g. to obtain its
+     * latency and overflow counters. */
+    const DataQueue_<SimTK::Rotation>& getDataQueue() const {
+        return _orientationDataQueue;
+    }
 private:
     // Use a specialized data structure for holding the orientation data
     mutable DataQueue_<SimTK::Rotation> _orientationDataQueue;
+    // Reused for rows popped from the queue to avoid allocating per frame.
+    mutable SimTK::RowVector_<SimTK::Rotation> _nextRow;
     bool _finished{false};
     //=============================================================================
 };  // END of class BufferedOrientationsReference
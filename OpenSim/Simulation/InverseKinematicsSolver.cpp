@@ -481,12 +481,11 @@ void InverseKinematicsSolver::updateGoals(SimTK::State &s)
         double nextTime = NaN;
         if (_orientationsReference &&
                 _orientationsReference->getNumRefs() > 0) {
-            SimTK::Array_<SimTK::Rotation> orientationValues;
             nextTime = _orientationsReference->getNextValuesAndTime(
-                    orientationValues);
+                    _orientationValues);
             s.setTime(nextTime);
             _orientationAssemblyCondition->moveAllObservations(
-                    orientationValues);
+                    _orientationValues);
         }
         // update coordinates if any based on new time
         AssemblySolver::updateGoals(s);
@@ -498,16 +497,14 @@ void InverseKinematicsSolver::updateGoals(SimTK::State &s)
     double nextTime = s.getTime();
     // specify the marker observations to be matched
     if (_markersReference && _markersReference->getNumRefs() > 0) {
-        SimTK::Array_<SimTK::Vec3> markerValues;
-        _markersReference->getValuesAtTime(nextTime, markerValues);
-        _markerAssemblyCondition->moveAllObservations(markerValues);
+        _markersReference->getValuesAtTime(nextTime, _markerValues);
+        _markerAssemblyCondition->moveAllObservations(_markerValues);
     }
 
     // specify the orientation observations to be matched
     if (_orientationsReference && _orientationsReference->getNumRefs() > 0) {
-        SimTK::Array_<SimTK::Rotation> orientationValues;
-        _orientationsReference->getValuesAtTime(nextTime, orientationValues);
-        _orientationAssemblyCondition->moveAllObservations(orientationValues);
+        _orientationsReference->getValuesAtTime(nextTime, _orientationValues);
+        _orientationAssemblyCondition->moveAllObservations(_orientationValues);
     }
 }
 
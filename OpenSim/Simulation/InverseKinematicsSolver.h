@@ -262,6 +262,10 @@ private:
     // the SimTK::Assembler and the memory is managed by the Assembler
     SimTK::ReferencePtr<SimTK::OrientationSensors> _orientationAssemblyCondition;
 
+    // Reused for the reference values of each frame to avoid allocating.
+    SimTK::Array_<SimTK::Vec3> _markerValues;
+    SimTK::Array_<SimTK::Rotation> _orientationValues;
+
     // internal flag indicating whether time is advanced based on live data or
     // controlled by the driver porgram (typically based on pre-recorded data).
     bool _advanceTimeFromReference{false};
@@ -0,0 +1,296 @@
+/* -------------------------------------------------------------------------- *
+ *                      OpenSim: EnsembleSimulation.cpp                       *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "EnsembleSimulation.h"
+
+#include <OpenSim/Common/Logger.h>
+#include <OpenSim/Simulation/Model/Actuator.h>
+#include <OpenSim/Simulation/SimulationUtilities.h>
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+using namespace OpenSim;
+
+EnsembleMember& EnsembleMember::setStateVariableValue(
+        const std::string& path, double value) {
+    m_stateVariableValues.push_back({path, value});
+    return *this;
+}
+
+EnsembleMember& EnsembleMember::setModelPropertyValue(
+        const std::string& componentPath, const std::string& propertyName,
+        double value) {
+    m_modelPropertyValues.push_back({componentPath, propertyName, value});
+    return *this;
+}
+
+EnsembleMember& EnsembleMember::setActuatorOverride(
+        const std::string& actuatorPath, double actuation) {
+    m_actuatorOverrides.push_back({actuatorPath, actuation});
+    return *this;
+}
+
+// The model and system that one thread uses to simulate members.
+struct EnsembleSimulation::Worker {
+    std::unique_ptr<Model> model;
+    SimTK::State defaultState;
+    // Whether the system was created with the properties of the base model.
+    bool hasBaseSystem = false;
+    std::vector<const Output<double>*> outputs;
+    SimTK::Stage outputStage = SimTK::Stage::Time;
+};
+
+namespace {
+Property<double>& updDoubleProperty(Model& model,
+        const std::string& componentPath, const std::string& propertyName) {
+    auto& abstractProp = model.updComponent(componentPath)
+                                 .updPropertyByName(propertyName);
+    auto* doubleProp = dynamic_cast<Property<double>*>(&abstractProp);
+    OPENSIM_THROW_IF(!doubleProp || doubleProp->isListProperty(), Exception,
+            "Expected property '{}' of component '{}' to hold a single "
+            "double, but it has type '{}'.",
+            propertyName, componentPath, abstractProp.getTypeName());
+    return *doubleProp;
+}
+}
+
+EnsembleSimulation::EnsembleSimulation(Model model)
+        : m_model(std::move(model)) {}
+
+void EnsembleSimulation::addMember(EnsembleMember member) {
+    m_members.push_back(std::move(member));
+}
+
+void EnsembleSimulation::setFinalTime(double finalTime) {
+    OPENSIM_THROW_IF(!SimTK::isFinite(finalTime), Exception,
+            "Expected the final time to be finite, but got {}.", finalTime);
+    m_finalTime = finalTime;
+}
+
+void EnsembleSimulation::setReportInterval(double interval) {
+    OPENSIM_THROW_IF(!(interval > 0), Exception,
+            "Expected the report interval to be positive, but got {}.",
+            interval);
+    m_reportInterval = interval;
+}
+
+void EnsembleSimulation::setIntegratorAccuracy(double accuracy) {
+    OPENSIM_THROW_IF(!(accuracy >= 0), Exception,
+            "Expected the integrator accuracy to be non-negative, but got "
+            "{}.",
+            accuracy);
+    m_integratorAccuracy = accuracy;
+}
+
+void EnsembleSimulation::addOutput(const std::string& outputPath) {
+    OPENSIM_THROW_IF(outputPath.find('|') == std::string::npos, Exception,
+            "Expected output path '{}' to have the form "
+            "'<component path>|<output name>'.",
+            outputPath);
+    m_outputs.push_back(outputPath);
+}
+
+void EnsembleSimulation::setNumThreads(int numThreads) {
+    OPENSIM_THROW_IF(numThreads < 0, Exception,
+            "Expected the number of threads to be non-negative, but got {}.",
+            numThreads);
+    m_numThreads = numThreads;
+}
+
+void EnsembleSimulation::initializeWorker(
+        const EnsembleMember& member, Worker& worker) const {
+    Model& model = *worker.model;
+    model.finalizeFromProperties();
+    for (const auto& prop : member.m_modelPropertyValues) {
+        updDoubleProperty(model, prop.componentPath, prop.propertyName)
+                .setValue(prop.value);
+    }
+    worker.defaultState = model.initSystem();
+    worker.hasBaseSystem = member.m_modelPropertyValues.empty();
+
+    // Components may be created again with the system, so the outputs are
+    // found again.
+    worker.outputs.clear();
+    worker.outputStage = SimTK::Stage::Time;
+    for (const auto& outputPath : m_outputs) {
+        const auto bar = outputPath.find('|');
+        const std::string componentPath = outputPath.substr(0, bar);
+        const Component& owner =
+                componentPath.empty() || componentPath == "/"
+                        ? model
+                        : model.getComponent(componentPath);
+        const auto& output = owner.getOutput(outputPath.substr(bar + 1));
+        const auto* doubleOutput = dynamic_cast<const Output<double>*>(&output);
+        OPENSIM_THROW_IF(!doubleOutput, Exception,
+                "Expected output '{}' to have type double, but it has type "
+                "'{}'.",
+                outputPath, output.getTypeName());
+        worker.outputs.push_back(doubleOutput);
+        if (output.getDependsOnStage() > worker.outputStage) {
+            worker.outputStage = output.getDependsOnStage();
+        }
+    }
+}
+
+EnsembleResult EnsembleSimulation::simulate(
+        int imember, const EnsembleMember& member, Worker& worker) const {
+    EnsembleResult result;
+    Model& model = *worker.model;
+    // The original values of the properties that the member changes.
+    std::vector<double> baseValues;
+    try {
+        if (!member.m_modelPropertyValues.empty()) {
+            // The system is created again for this member, and again with
+            // the base properties for the next member.
+            worker.hasBaseSystem = false;
+            model.finalizeFromProperties();
+            for (const auto& prop : member.m_modelPropertyValues) {
+                baseValues.push_back(updDoubleProperty(model,
+                        prop.componentPath, prop.propertyName).getValue());
+            }
+        }
+        if (!worker.hasBaseSystem) {
+            initializeWorker(member, worker);
+        }
+
+        SimTK::State state = worker.defaultState;
+        for (const auto& sv : member.m_stateVariableValues) {
+            model.setStateVariableValue(state, sv.path, sv.value);
+        }
+        for (const auto& actu : member.m_actuatorOverrides) {
+            const auto& actuator =
+                    model.getComponent<ScalarActuator>(actu.actuatorPath);
+            actuator.overrideActuation(state, true);
+            actuator.setOverrideActuation(state, actu.actuation);
+        }
+
+        Manager manager(model);
+        manager.setWriteToStorage(false);
+        manager.setPerformAnalyses(false);
+        manager.setIntegratorMethod(m_integratorMethod);
+        if (m_integratorAccuracy > 0) {
+            manager.setIntegratorAccuracy(m_integratorAccuracy);
+        }
+        manager.initialize(state);
+
+        if (m_recordStates) {
+            const auto names = model.getStateVariableNames();
+            std::vector<std::string> labels;
+            labels.reserve(names.size());
+            for (int i = 0; i < names.size(); ++i) labels.push_back(names[i]);
+            result.states.setColumnLabels(labels);
+            result.states.appendRow(state.getTime(),
+                    model.getStateVariableValues(state).transpose());
+        }
+
+        const double initialTime = state.getTime();
+        for (int ireport = 1; state.getTime() < m_finalTime; ++ireport) {
+            const double reportTime = std::min(
+                    initialTime + ireport * m_reportInterval, m_finalTime);
+            state = manager.integrate(reportTime);
+            OPENSIM_THROW_IF(state.getTime() < reportTime, Exception,
+                    "The integrator stopped at time {} before reaching time "
+                    "{}.",
+                    state.getTime(), reportTime);
+            if (m_recordStates) {
+                result.states.appendRow(state.getTime(),
+                        model.getStateVariableValues(state).transpose());
+            }
+            if (m_cancelCondition && state.getTime() < m_finalTime &&
+                    m_cancelCondition(imember, state)) {
+                result.cancelled = true;
+                break;
+            }
+        }
+        result.finalTime = state.getTime();
+
+        model.getSystem().realize(state, worker.outputStage);
+        result.outputValues.reserve(worker.outputs.size());
+        for (const auto* output : worker.outputs) {
+            result.outputValues.push_back(output->getValue(state));
+        }
+        result.success = true;
+    } catch (const std::exception& e) {
+        result.message = e.what();
+        log_warn("EnsembleSimulation: the simulation of member {} failed: {}",
+                imember, e.what());
+    }
+
+    // Restore the base model's properties for the next member.
+    if (!baseValues.empty()) {
+        for (int i = 0; i < (int)baseValues.size(); ++i) {
+            const auto& prop = member.m_modelPropertyValues[i];
+            updDoubleProperty(model, prop.componentPath, prop.propertyName)
+                    .setValue(baseValues[i]);
+        }
+    }
+    return result;
+}
+
+std::vector<EnsembleResult> EnsembleSimulation::run() const {
+    std::vector<EnsembleResult> results(m_members.size());
+    run([&](int imember, EnsembleResult& result) {
+        results[imember] = std::move(result);
+    });
+    return results;
+}
+
+void EnsembleSimulation::run(
+        const std::function<void(int, EnsembleResult&)>& handleResult) const {
+    const int numMembers = getNumMembers();
+    if (!numMembers) return;
+    int numThreads = m_numThreads;
+    if (numThreads == 0) {
+        numThreads = std::max(1, (int)std::thread::hardware_concurrency());
+    }
+    numThreads = std::min(numThreads, numMembers);
+
+    // The copies are made before the threads start, and each thread creates
+    // the system of its own copy.
+    std::vector<Worker> workers(numThreads);
+    for (auto& worker : workers) worker.model.reset(m_model.clone());
+
+    // Completed results that wait for the results of preceding members.
+    std::mutex mutex;
+    std::map<int, EnsembleResult> completed;
+    detail::processChunksInOrder(numMembers, numThreads,
+            [&](int ithread, int imember) {
+                EnsembleResult result =
+                        simulate(imember, m_members[imember], workers[ithread]);
+                std::lock_guard<std::mutex> lock(mutex);
+                completed[imember] = std::move(result);
+            },
+            [&](int imember) {
+                EnsembleResult result;
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    auto it = completed.find(imember);
+                    result = std::move(it->second);
+                    completed.erase(it);
+                }
+                handleResult(imember, result);
+            });
+}
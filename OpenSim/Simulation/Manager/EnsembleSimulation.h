@@ -0,0 +1,239 @@
+#ifndef OPENSIM_ENSEMBLE_SIMULATION_H_
+#define OPENSIM_ENSEMBLE_SIMULATION_H_
+/* -------------------------------------------------------------------------- *
+ *                       OpenSim: EnsembleSimulation.h                        *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "Manager.h"
+
+#include <OpenSim/Common/TimeSeriesTable.h>
+#include <OpenSim/Simulation/Model/Model.h>
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace OpenSim {
+
+/** A member of an EnsembleSimulation: the changes to the initial state, the
+model and the actuation that distinguish one simulation of the ensemble from
+the base model. The setters return this member so that calls can be chained:
+@code
+EnsembleMember member;
+member.setStateVariableValue("/jointset/knee/knee_angle/value", 0.5)
+      .setModelPropertyValue("/forceset/spring", "stiffness", 200.0);
+@endcode */
+class OSIMSIMULATION_API EnsembleMember {
+public:
+    /// Set the initial value of a state variable (e.g.,
+    /// "/jointset/knee/knee_angle/value"), replacing the value in the model's
+    /// default state. Coordinates are not assembled, so values of coupled
+    /// coordinates should be consistent with the constraints.
+    EnsembleMember& setStateVariableValue(
+            const std::string& path, double value);
+    /// Set the value of a double-valued property of a component of the
+    /// model. The system of the model is created again (initSystem()) for
+    /// members that set properties, which costs much more than setting
+    /// state variables.
+    EnsembleMember& setModelPropertyValue(const std::string& componentPath,
+            const std::string& propertyName, double value);
+    /// Replace the actuation of the ScalarActuator with the given path with a
+    /// constant value for the whole simulation (see
+    /// ScalarActuator::overrideActuation()).
+    EnsembleMember& setActuatorOverride(
+            const std::string& actuatorPath, double actuation);
+
+private:
+    struct StateVariableValue {
+        std::string path;
+        double value;
+    };
+    struct ModelPropertyValue {
+        std::string componentPath;
+        std::string propertyName;
+        double value;
+    };
+    struct ActuatorOverride {
+        std::string actuatorPath;
+        double actuation;
+    };
+    std::vector<StateVariableValue> m_stateVariableValues;
+    std::vector<ModelPropertyValue> m_modelPropertyValues;
+    std::vector<ActuatorOverride> m_actuatorOverrides;
+
+    friend class EnsembleSimulation;
+};
+
+/** The result of the simulation of one member of an EnsembleSimulation. */
+struct OSIMSIMULATION_API EnsembleResult {
+    /// False if the simulation threw an exception (e.g., the integrator
+    /// failed); the exception's message is in `message`.
+    bool success = false;
+    /// True if the cancel condition stopped the simulation before the final
+    /// time.
+    bool cancelled = false;
+    std::string message;
+    /// The time at which the simulation stopped.
+    double finalTime = SimTK::NaN;
+    /// The state variables at the initial time and at each report time, with
+    /// the same column labels as Manager::getStatesTable(); see
+    /// StatesTrajectory::createFromStatesTable(). Empty if states are not
+    /// recorded.
+    TimeSeriesTable states;
+    /// The values of the outputs added with EnsembleSimulation::addOutput()
+    /// in the final state, in the order that they were added.
+    std::vector<double> outputValues;
+};
+
+/** Simulate many variations (members) of a model, as in uncertainty
+quantification or controller tuning, concurrently. Each member is simulated
+from the default state of the base model, with the changes of its
+EnsembleMember applied, to the final time (setFinalTime()); run() returns one
+EnsembleResult per member, in the order the members were added.
+
+@code
+EnsembleSimulation ensemble(model);
+ensemble.setFinalTime(1.0);
+for (double angle : {0.1, 0.2, 0.3}) {
+    EnsembleMember member;
+    member.setStateVariableValue("/jointset/knee/knee_angle/value", angle);
+    ensemble.addMember(member);
+}
+ensemble.addOutput("/bodyset/tibia|position");
+const std::vector<EnsembleResult> results = ensemble.run();
+@endcode
+
+Threads
+=======
+Members are simulated on setNumThreads() threads (all processor cores by
+default). Each thread makes one copy of the base model and creates its system
+once; the system is reused for each member the thread simulates, unless the member sets model properties. Idle
+threads take the next member that has not been started, so members with
+short simulations do not wait for members with long simulations. The model's
+components must be threadsafe.
+
+Memory
+======
+States are recorded only at the report times (setReportInterval()), not at
+each integrator step, and are not recorded at all with
+setRecordStates(false). To keep at most a few results in memory at a time,
+pass a function to run() that handles each result as it is completed (e.g.,
+writes it to a file); with this function, at most 2 * N completed results
+wait for the results of preceding members, where N is the number of threads
+actually used: getNumThreads(), or the number of processor cores if
+getNumThreads() is 0, but no more than the number of members.
+
+Cancellation
+============
+The cancel condition (setCancelCondition()) is evaluated at each report time;
+if it returns true, the simulation of the member stops, and its result is
+marked as cancelled. Use it to stop members that diverge (e.g., a coordinate
+leaves its range), so that they do not delay the rest of the ensemble. */
+class OSIMSIMULATION_API EnsembleSimulation {
+public:
+    /// The model is copied; changes to it after this call have no effect on
+    /// the ensemble.
+    explicit EnsembleSimulation(Model model);
+
+    /// Add a member to the ensemble. The index of the member's result is the
+    /// order in which it was added.
+    void addMember(EnsembleMember member);
+    int getNumMembers() const { return (int)m_members.size(); }
+
+    /// The time at which the simulations end (default: 1). The simulations
+    /// start at the time of the model's default state.
+    void setFinalTime(double finalTime);
+    double getFinalTime() const { return m_finalTime; }
+    /// The interval at which states are recorded and the cancel condition is
+    /// evaluated (default: 0.01).
+    void setReportInterval(double interval);
+    double getReportInterval() const { return m_reportInterval; }
+    /// Should the state variables be recorded at each report time? Default:
+    /// true.
+    void setRecordStates(bool tf) { m_recordStates = tf; }
+    bool getRecordStates() const { return m_recordStates; }
+
+    /// The integrator for each simulation (default: RungeKuttaMerson).
+    void setIntegratorMethod(Manager::IntegratorMethod method) {
+        m_integratorMethod = method;
+    }
+    Manager::IntegratorMethod getIntegratorMethod() const {
+        return m_integratorMethod;
+    }
+    /// The accuracy of the integrator. The default, 0, keeps the Manager's
+    /// default accuracy.
+    void setIntegratorAccuracy(double accuracy);
+    double getIntegratorAccuracy() const { return m_integratorAccuracy; }
+
+    /// Record the value of a double-valued output in the final state of each
+    /// member, in EnsembleResult::outputValues. The path has the form
+    /// "<component path>|<output name>", as returned by
+    /// AbstractOutput::getPathName() (e.g., "/forceset/muscle|fiber_length").
+    void addOutput(const std::string& outputPath);
+    const std::vector<std::string>& getOutputs() const { return m_outputs; }
+
+    /// Stop the simulation of a member if the condition returns true for the
+    /// index of the member and its state at a report time. The condition is
+    /// called concurrently from several threads.
+    void setCancelCondition(
+            std::function<bool(int imember, const SimTK::State& state)>
+                    condition) {
+        m_cancelCondition = std::move(condition);
+    }
+
+    /// The number of threads that simulate members. The default, 0, uses
+    /// all processor cores.
+    void setNumThreads(int numThreads);
+    int getNumThreads() const { return m_numThreads; }
+
+    /// Simulate all members and return their results.
+    std::vector<EnsembleResult> run() const;
+    /// Simulate all members, and call handleResult() with the index and the
+    /// result of each member, in the order the members were added, as soon as
+    /// the member and all preceding members are simulated. handleResult() is
+    /// called by one thread at a time. If handleResult() throws, no further
+    /// members are started and the exception is rethrown once the members in
+    /// progress have finished.
+    void run(const std::function<void(int imember, EnsembleResult& result)>&
+                    handleResult) const;
+
+private:
+    struct Worker;
+    void initializeWorker(const EnsembleMember& member, Worker& worker) const;
+    EnsembleResult simulate(
+            int imember, const EnsembleMember& member, Worker& worker) const;
+
+    Model m_model;
+    std::vector<EnsembleMember> m_members;
+    double m_finalTime = 1;
+    double m_reportInterval = 0.01;
+    bool m_recordStates = true;
+    Manager::IntegratorMethod m_integratorMethod =
+            Manager::IntegratorMethod::RungeKuttaMerson;
+    double m_integratorAccuracy = 0;
+    std::vector<std::string> m_outputs;
+    std::function<bool(int, const SimTK::State&)> m_cancelCondition;
+    int m_numThreads = 0;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_ENSEMBLE_SIMULATION_H_
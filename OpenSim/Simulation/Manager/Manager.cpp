@@ -24,6 +24,7 @@
 /* Note: This code was originally developed by Realistic Dynamics Inc.
  * Author: Frank C. Anderson
  */
+#include <algorithm>
 #include <cstdio>
 #include "Manager.h"
 #include <OpenSim/Simulation/Model/Model.h>
@@ -40,6 +41,9 @@ using namespace std;
 // STATICS
 //=============================================================================
 std::string Manager::_displayName = "Simulator";
+// The accuracy to which step() satisfies constraints and normalizes
+// quaternions.
+static const double realTimeProjectionAccuracy = 1e-6;
 //=============================================================================
 // DESTRUCTOR
 //=============================================================================
@@ -99,6 +103,16 @@ setNull()
     _writeToStorage=true;
     _tArray.setSize(0);
     _dtArray.setSize(0);
+    _realTimeMethod = RealTimeMethod::SemiExplicitEuler;
+    _realTimeInitialTime = 0;
+    _realTimeStep = 0;
+    _realTimeStepSize = SimTK::NaN;
+    _realTimeDeadline = SimTK::NaN;
+    _realTimeProject = false;
+    _realTimeOverrun = false;
+    _numRealTimeSteps = 0;
+    _numRealTimeOverruns = 0;
+    _maxRealTimeStepDuration = 0;
 }
 
 //_____________________________________________________________________________
@@ -479,7 +493,7 @@ setModel(Model& model)
         // May need to issue a warning here that model was already set to avoid a leak.
     }
 
-    if (_timeStepper) {
+    if (_timeStepper || _realTimeState) {
         std::string msg = "Cannot set a new Model on this Manager";
         msg += "after Manager::integrate() has been called at least once.";
         OPENSIM_THROW(Exception, msg);
@@ -647,6 +661,11 @@ const SimTK::State& Manager::integrate(double finalTime)
 {
     int step = 1; // for AnalysisSet::step()
 
+    if (_realTimeState) {
+        throw Exception("Manager::integrate(): Manager was initialized "
+            "for real-time stepping. Call Manager::step() instead.");
+    }
+
     if (_timeStepper == nullptr) {
         throw Exception("Manager::integrate(): Manager has not been "
             "initialized. Call Manager::initialize() first.");
@@ -757,6 +776,7 @@ const SimTK::State& Manager::integrate(double finalTime)
 
 const SimTK::State& Manager::getState() const
 {
+    if (_realTimeState) return *_realTimeState;
     return _timeStepper->getState();
 }
 
@@ -810,7 +830,7 @@ void Manager::initialize(const SimTK::State& s)
             "with an integrator, or call Manager::setIntegrator().");
     }
 
-    if (_timeStepper) {
+    if (_timeStepper || _realTimeState) {
         throw Exception("Manager::initialize(): "
             "Cannot initialize a Manager multiple times.");
     }
@@ -831,6 +851,115 @@ void Manager::initialize(const SimTK::State& s)
         _controllerSet->constructStorage();
 }
 
+//-----------------------------------------------------------------------------
+// REAL-TIME STEPPING
+//-----------------------------------------------------------------------------
+void Manager::initializeRealTime(const SimTK::State& s, double stepSize,
+        RealTimeMethod method)
+{
+    if (_timeStepper || _realTimeState) {
+        throw Exception("Manager::initializeRealTime(): "
+            "Cannot initialize a Manager multiple times.");
+    }
+    OPENSIM_THROW_IF(!(stepSize > 0) || !SimTK::isFinite(stepSize), Exception,
+            "Expected the step size to be positive, but got {}.", stepSize);
+
+    _realTimeState.reset(new SimTK::State(s));
+    _realTimeMethod = method;
+    _realTimeInitialTime = s.getTime();
+    _realTimeStepSize = stepSize;
+
+    const auto& system = _model->getMultibodySystem();
+    system.realize(*_realTimeState, SimTK::Stage::Acceleration);
+    _realTimeProject = _realTimeState->getNQErr() > 0 ||
+                       _realTimeState->getNUErr() > 0;
+    _realTimeQDot.resize(_realTimeState->getNQ());
+    _realTimeUDot.resize(_realTimeState->getNU());
+    _realTimeZDot.resize(_realTimeState->getNZ());
+
+    setRealTimeDeadline(stepSize);
+}
+
+const SimTK::State& Manager::step()
+{
+    if (!_realTimeState) {
+        throw Exception("Manager::step(): Manager has not been initialized "
+            "for real-time stepping. Call Manager::initializeRealTime() "
+            "first.");
+    }
+    const long long start = SimTK::realTimeInNs();
+
+    SimTK::State& s = *_realTimeState;
+    const auto& system = _model->getMultibodySystem();
+    const double h = _realTimeStepSize;
+
+    // Save the derivatives before the state variables are changed, which
+    // invalidates them.
+    system.realize(s, SimTK::Stage::Acceleration);
+    _realTimeUDot = s.getUDot();
+    _realTimeZDot = s.getZDot();
+    if (_realTimeMethod == RealTimeMethod::ExplicitEuler) {
+        _realTimeQDot = s.getQDot();
+    }
+
+    SimTK::Vector& u = s.updU();
+    for (int i = 0; i < u.size(); ++i) u[i] += h * _realTimeUDot[i];
+    SimTK::Vector& z = s.updZ();
+    for (int i = 0; i < z.size(); ++i) z[i] += h * _realTimeZDot[i];
+    if (_realTimeMethod == RealTimeMethod::SemiExplicitEuler) {
+        // qdot = N(q) u for the new u.
+        _model->getMatterSubsystem().multiplyByN(
+                s, false, s.getU(), _realTimeQDot);
+    }
+    SimTK::Vector& q = s.updQ();
+    for (int i = 0; i < q.size(); ++i) q[i] += h * _realTimeQDot[i];
+
+    // Compute the time from the number of steps so that it does not drift.
+    ++_realTimeStep;
+    ++_numRealTimeSteps;
+    s.setTime(_realTimeInitialTime + _realTimeStep * h);
+    system.realize(s, SimTK::Stage::Time);
+    system.prescribe(s);
+    if (_realTimeProject) system.project(s, realTimeProjectionAccuracy);
+
+    const long long duration = SimTK::realTimeInNs() - start;
+    const double deadline = _realTimeDeadline;
+    if (duration > SimTK::secToNs(deadline)) {
+        _realTimeOverrun = true;
+        ++_numRealTimeOverruns;
+    }
+    if (duration > _maxRealTimeStepDuration) {
+        _maxRealTimeStepDuration = duration;
+    }
+    const int numBins = (int)_realTimeHistogram.size();
+    const int bin = (int)std::min<double>(numBins - 1,
+            SimTK::nsToSec(duration) / getRealTimeHistogramBinWidth());
+    ++_realTimeHistogram[bin];
+    return s;
+}
+
+void Manager::setRealTimeDeadline(double deadline)
+{
+    OPENSIM_THROW_IF(!(deadline > 0) || !SimTK::isFinite(deadline),
+            Exception, "Expected the deadline to be positive, but got {}.",
+            deadline);
+    _realTimeDeadline = deadline;
+    resetRealTimeStatistics();
+}
+
+double Manager::getMaxRealTimeStepDuration() const
+{
+    return SimTK::nsToSec(_maxRealTimeStepDuration);
+}
+
+void Manager::resetRealTimeStatistics()
+{
+    _numRealTimeSteps = 0;
+    _numRealTimeOverruns = 0;
+    _maxRealTimeStepDuration = 0;
+    _realTimeHistogram.assign(20, 0);
+}
+
 void Manager::record(const SimTK::State& s, const int& step)
 {
     // ANALYSES
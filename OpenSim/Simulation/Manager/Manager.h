@@ -331,7 +331,7 @@ public:
     const SimTK::State& integrate(double finalTime);
 
     /** Get the current State from the Integrator associated with this 
-      * Manager. */
+      * Manager, or the state advanced by step() in real-time mode. */
     const SimTK::State& getState() const;
     
     double getFixedStepSize(int tArrayStep) const;
@@ -344,6 +344,95 @@ public:
     Storage& getStateStorage() const;
     TimeSeriesTable getStatesTable() const;
 
+    //--------------------------------------------------------------------------
+    // REAL-TIME STEPPING
+    //--------------------------------------------------------------------------
+    /** The fixed-step methods of real-time mode. Each requires one
+    realization to SimTK::Stage::Acceleration per step. */
+    enum class RealTimeMethod {
+        /// q, u and z are advanced with the derivatives at the start of the
+        /// step.
+        ExplicitEuler,
+        /// u and z are advanced first, and q is advanced with the new u
+        /// (symplectic Euler), which is more stable for oscillating systems.
+        SemiExplicitEuler
+    };
+
+    /**
+    * Prepare the Manager to advance the state by exactly one step of the
+    * given size with each call to step(), as needed by a controller that
+    * must run at a fixed rate (e.g., every 1 ms in a hardware-in-the-loop
+    * setup). Real-time mode does not use the SimTK::Integrator and
+    * SimTK::TimeStepper of integrate(): there is no error control, event
+    * handlers (e.g., those of SimTK::EventReporter) are not called, and the
+    * states are not recorded in the state storage nor passed to analyses.
+    * Prescribed motion is applied, and constraints and quaternions are
+    * projected (to an accuracy of 1e-6) after each step if the model has
+    * any. The buffers used by step() are allocated here and reused by
+    * each step.
+    *
+    * The compute time of each step is measured and compared with a
+    * deadline, which is the step size by default (see
+    * setRealTimeDeadline()).
+    *
+    * A Manager is initialized either with initialize() (for integrate()) or
+    * with initializeRealTime() (for step()), once.
+    *
+    * @code
+    * SimTK::State state = model.initSystem();
+    * Manager manager(model);
+    * manager.initializeRealTime(state, 0.001);
+    * while (running) {
+    *     // e.g., update the data queue of a Controller.
+    *     const SimTK::State& s = manager.step();
+    *     if (manager.getRealTimeOverrun()) {
+    *         // handle the missed deadline.
+    *         manager.clearRealTimeOverrun();
+    *     }
+    * }
+    * @endcode
+    */
+    void initializeRealTime(const SimTK::State& s, double stepSize,
+            RealTimeMethod method = RealTimeMethod::SemiExplicitEuler);
+
+    /** Advance the state by one step of the size given to
+    initializeRealTime(), and return the new state. Controllers compute the
+    controls for the step from the state at the start of the step. */
+    const SimTK::State& step();
+
+    double getRealTimeStepSize() const { return _realTimeStepSize; }
+
+    /** Set the compute time (in seconds) that a call to step() may take
+    before it is counted as an overrun. The default is the step size. This
+    also resets the statistics (see resetRealTimeStatistics()). */
+    void setRealTimeDeadline(double deadline);
+    double getRealTimeDeadline() const { return _realTimeDeadline; }
+
+    /** Whether a call to step() has exceeded the deadline since
+    initializeRealTime() or the last call to clearRealTimeOverrun(). */
+    bool getRealTimeOverrun() const { return _realTimeOverrun; }
+    void clearRealTimeOverrun() { _realTimeOverrun = false; }
+
+    /** The number of calls to step() since initializeRealTime() or the last
+    call to resetRealTimeStatistics(). */
+    int getNumRealTimeSteps() const { return _numRealTimeSteps; }
+    /** The number of those steps that exceeded the deadline. */
+    int getNumRealTimeOverruns() const { return _numRealTimeOverruns; }
+    /** The longest compute time of those steps, in seconds. */
+    double getMaxRealTimeStepDuration() const;
+    /** A histogram of the compute times of those steps. Bin i counts the
+    steps that took between i and i + 1 times the bin width
+    (getRealTimeHistogramBinWidth(), one tenth of the deadline); the last of
+    the 20 bins also counts all longer steps. */
+    const std::vector<int>& getRealTimeHistogram() const {
+        return _realTimeHistogram;
+    }
+    double getRealTimeHistogramBinWidth() const {
+        return _realTimeDeadline / 10;
+    }
+    /** Reset the step counts, the longest step and the histogram. */
+    void resetRealTimeStatistics();
+
    //--------------------------------------------------------------------------
    //  INTERRUPT
    //--------------------------------------------------------------------------
@@ -363,6 +452,26 @@ private:
     // step = 0 is the beginning, step = -1 used to denote the end/final step
     void record(const SimTK::State& s, const int& step);
 
+    // Real-time stepping (see initializeRealTime()).
+    std::unique_ptr<SimTK::State> _realTimeState;
+    RealTimeMethod _realTimeMethod;
+    double _realTimeInitialTime;
+    // The number of steps taken since initializeRealTime().
+    long long _realTimeStep;
+    double _realTimeStepSize;
+    double _realTimeDeadline;
+    // Whether constraints or quaternions are projected after each step.
+    bool _realTimeProject;
+    bool _realTimeOverrun;
+    int _numRealTimeSteps;
+    int _numRealTimeOverruns;
+    long long _maxRealTimeStepDuration;
+    std::vector<int> _realTimeHistogram;
+    // The derivatives at the start of a step.
+    SimTK::Vector _realTimeQDot;
+    SimTK::Vector _realTimeUDot;
+    SimTK::Vector _realTimeZDot;
+
 //=============================================================================
 };  // END of class Manager
 
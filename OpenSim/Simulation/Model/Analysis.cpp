@@ -352,6 +352,14 @@ ArrayPtrs<Storage>& Analysis::getStorageList()
     return _storageList;
 }
 
+void Analysis::ensureStorageCapacity(int aNumRows)
+{
+    ArrayPtrs<Storage>& storageList = getStorageList();
+    for(int i=0;i<storageList.getSize();i++) {
+        if(storageList[i]) storageList[i]->ensureCapacity(aNumRows);
+    }
+}
+
 // GET AND SET
 //=============================================================================
 //_____________________________________________________________________________
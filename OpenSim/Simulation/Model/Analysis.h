@@ -147,6 +147,15 @@ public:
     virtual int step( const SimTK::State& s, int stepNumber);
     virtual int end( const SimTK::State& s);
 
+    /**
+     * The stage to which a state must be realized for this analysis to
+     * record it. Tools that run several analyses on the same states (e.g.,
+     * AnalyzeTool) realize each state once to the highest stage required by
+     * the analyses that are on. The default is SimTK::Stage::Velocity.
+     */
+    virtual SimTK::Stage getRequiredStage() const
+    {   return SimTK::Stage::Velocity; }
+
 
     //--------------------------------------------------------------------------
     // GET AND SET
@@ -209,6 +218,12 @@ public:
     int getStorageInterval() const;
 #endif
     virtual ArrayPtrs<Storage>& getStorageList();
+    /**
+     * Allocate room for aNumRows rows in each storage of getStorageList(),
+     * so that recording a known number of steps (e.g., in AnalyzeTool) does
+     * not repeatedly grow the storages.
+     */
+    void ensureStorageCapacity(int aNumRows);
     void setPrintResultFiles(bool aToWrite) { _printResultFiles = aToWrite; }
     bool getPrintResultFiles() const { return _printResultFiles; }
 
@@ -183,6 +183,34 @@ getOn() const
     for(int i=0; i<getSize(); i++) on[i] = get(i).getOn();
     return on;
 }
+//_____________________________________________________________________________
+/**
+ * Get the highest stage required by the analyses that are on.
+ */
+SimTK::Stage AnalysisSet::
+getRequiredStage() const
+{
+    SimTK::Stage stage = SimTK::Stage::Time;
+    for(int i=0; i<getSize(); i++) {
+        const Analysis& analysis = get(i);
+        if (analysis.getOn() && analysis.getRequiredStage() > stage)
+            stage = analysis.getRequiredStage();
+    }
+    return stage;
+}
+//_____________________________________________________________________________
+/**
+ * Allocate room for a number of rows in the storages of the analyses that
+ * are on.
+ */
+void AnalysisSet::
+ensureStorageCapacity(int aNumRows)
+{
+    for(int i=0; i<getSize(); i++) {
+        Analysis& analysis = get(i);
+        if (analysis.getOn()) analysis.ensureStorageCapacity(aNumRows);
+    }
+}
 
 
 //=============================================================================
@@ -92,6 +92,13 @@ public:
     void setOn(bool aTrueFalse);
     void setOn(const Array<bool> &aOn);
     Array<bool> getOn() const;
+    /** The highest stage required by the analyses that are on (see
+    Analysis::getRequiredStage()), or SimTK::Stage::Time if no analysis is
+    on. */
+    SimTK::Stage getRequiredStage() const;
+    /** Call Analysis::ensureStorageCapacity() for the analyses that are
+    on. */
+    void ensureStorageCapacity(int aNumRows);
 
     //--------------------------------------------------------------------------
     // CALLBACKS
@@ -31,6 +31,8 @@
 #include <OpenSim/Simulation/Wrap/PathWrap.h>
 #include "Model.h"
 
+#include <OpenSim/Common/Profiler.h>
+
 //=============================================================================
 // STATICS
 //=============================================================================
@@ -913,6 +915,8 @@ void GeometryPath::computePath(const SimTK::State& s) const
         return;
     }
 
+    Profiler::Scope scope(*this, "computePath");
+
     // Clear the current path.
     _currentPathPtrsCache.setSize(0);
 
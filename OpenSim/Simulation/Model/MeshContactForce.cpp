@@ -0,0 +1,678 @@
+/* -------------------------------------------------------------------------- *
+ *                        OpenSim: MeshContactForce.cpp                       *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "MeshContactForce.h"
+
+#include <OpenSim/Simulation/Model/Model.h>
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+using namespace OpenSim;
+using SimTK::Vec3;
+
+namespace {
+// The part of a triangle abc that contains a closest point. The vertices and
+// edges are numbered in the order of the face's vertices (edge k joins
+// vertices k and k + 1).
+enum TriangleFeature {
+    VertexA, VertexB, VertexC, EdgeAB, EdgeBC, EdgeCA, FaceABC
+};
+
+// The closest point to p on the triangle abc (Ericson, Real-Time Collision
+// Detection, 2005, Section 5.1.5), and the feature that contains it.
+Vec3 findClosestPointOnTriangle(const Vec3& p, const Vec3& a, const Vec3& b,
+        const Vec3& c, TriangleFeature& feature) {
+    const Vec3 ab = b - a;
+    const Vec3 ac = c - a;
+    const Vec3 ap = p - a;
+    const double d1 = SimTK::dot(ab, ap);
+    const double d2 = SimTK::dot(ac, ap);
+    if (d1 <= 0 && d2 <= 0) {
+        feature = VertexA;
+        return a;
+    }
+
+    const Vec3 bp = p - b;
+    const double d3 = SimTK::dot(ab, bp);
+    const double d4 = SimTK::dot(ac, bp);
+    if (d3 >= 0 && d4 <= d3) {
+        feature = VertexB;
+        return b;
+    }
+
+    const double vc = d1 * d4 - d3 * d2;
+    if (vc <= 0 && d1 >= 0 && d3 <= 0) {
+        feature = EdgeAB;
+        return a + (d1 / (d1 - d3)) * ab;
+    }
+
+    const Vec3 cp = p - c;
+    const double d5 = SimTK::dot(ab, cp);
+    const double d6 = SimTK::dot(ac, cp);
+    if (d6 >= 0 && d5 <= d6) {
+        feature = VertexC;
+        return c;
+    }
+
+    const double vb = d5 * d2 - d1 * d6;
+    if (vb <= 0 && d2 >= 0 && d6 <= 0) {
+        feature = EdgeCA;
+        return a + (d2 / (d2 - d6)) * ac;
+    }
+
+    const double va = d3 * d6 - d5 * d4;
+    if (va <= 0 && d4 - d3 >= 0 && d5 - d6 >= 0) {
+        feature = EdgeBC;
+        return b + ((d4 - d3) / ((d4 - d3) + (d5 - d6))) * (c - b);
+    }
+
+    feature = FaceABC;
+    const double denom = 1 / (va + vb + vc);
+    return a + (vb * denom) * ab + (vc * denom) * ac;
+}
+
+double calcDistanceSquaredToBox(
+        const Vec3& p, const Vec3& lower, const Vec3& upper) {
+    double distanceSquared = 0;
+    for (int k = 0; k < 3; ++k) {
+        if (p[k] < lower[k]) {
+            distanceSquared += SimTK::square(lower[k] - p[k]);
+        } else if (p[k] > upper[k]) {
+            distanceSquared += SimTK::square(p[k] - upper[k]);
+        }
+    }
+    return distanceSquared;
+}
+
+bool boxesOverlap(const Vec3& lower1, const Vec3& upper1, const Vec3& lower2,
+        const Vec3& upper2) {
+    for (int k = 0; k < 3; ++k) {
+        if (upper1[k] < lower2[k] || upper2[k] < lower1[k]) return false;
+    }
+    return true;
+}
+
+class FunctionTask : public SimTK::ParallelExecutor::Task {
+public:
+    explicit FunctionTask(const std::function<void(int)>& function)
+            : m_function(function) {}
+    void execute(int index) override { m_function(index); }
+
+private:
+    const std::function<void(int)>& m_function;
+};
+} // anonymous namespace
+
+//=============================================================================
+//  BOUNDING VOLUME HIERARCHY
+//=============================================================================
+// A tree of axis-aligned bounding boxes, in the frame of the mesh, built by
+// splitting the triangles at the median of their centroids along the longest
+// axis. Queries do not modify the tree, so threads may share it.
+//
+// The tree also stores the angle-weighted pseudo-normals of the vertices and
+// edges (Baerentzen and Aanaes, Signed distance computation using the angle
+// weighted pseudonormal, IEEE TVCG 11(3), 2005): a point is outside a closed
+// mesh if and only if the vector from the closest point to it has a positive
+// component along the pseudo-normal of the feature (face, edge or vertex) that
+// contains the closest point. Face normals alone misclassify points whose
+// closest point is on an edge or a vertex.
+class MeshContactForce::BVH {
+public:
+    explicit BVH(const SimTK::ContactGeometry::TriangleMesh& mesh) {
+        const int numFaces = mesh.getNumFaces();
+        m_vertices.resize(3 * numFaces);
+        m_centroids.resize(numFaces);
+        m_normals.resize(numFaces);
+        m_areas.resize(numFaces);
+        m_order.resize(numFaces);
+        m_faceVertices.resize(3 * numFaces);
+        m_faceEdges.resize(3 * numFaces);
+        m_vertexNormals.assign(mesh.getNumVertices(), Vec3(0));
+        m_edgeNormals.assign(mesh.getNumEdges(), Vec3(0));
+        for (int f = 0; f < numFaces; ++f) {
+            for (int v = 0; v < 3; ++v) {
+                m_faceVertices[3 * f + v] = mesh.getFaceVertex(f, v);
+                m_vertices[3 * f + v] =
+                        mesh.getVertexPosition(m_faceVertices[3 * f + v]);
+            }
+            m_centroids[f] = mesh.getFaceCentroid(f);
+            m_normals[f] = mesh.getFaceNormal(f).asVec3();
+            m_areas[f] = mesh.getFaceArea(f);
+            m_order[f] = f;
+
+            for (int v = 0; v < 3; ++v) {
+                // Each face contributes its normal, weighted by the angle of
+                // the face at the vertex.
+                const Vec3& vertex = m_vertices[3 * f + v];
+                const Vec3 edge1 = m_vertices[3 * f + (v + 1) % 3] - vertex;
+                const Vec3 edge2 = m_vertices[3 * f + (v + 2) % 3] - vertex;
+                const double cosAngle = SimTK::dot(edge1, edge2) /
+                                        (edge1.norm() * edge2.norm());
+                m_vertexNormals[m_faceVertices[3 * f + v]] +=
+                        std::acos(SimTK::clamp(-1.0, cosAngle, 1.0)) *
+                        m_normals[f];
+            }
+            for (int e = 0; e < 3; ++e) {
+                // Match the edges of the mesh to the numbering of
+                // TriangleFeature.
+                const int edge = mesh.getFaceEdge(f, e);
+                const int v0 = mesh.getEdgeVertex(edge, 0);
+                const int v1 = mesh.getEdgeVertex(edge, 1);
+                for (int k = 0; k < 3; ++k) {
+                    const int a = m_faceVertices[3 * f + k];
+                    const int b = m_faceVertices[3 * f + (k + 1) % 3];
+                    if ((a == v0 && b == v1) || (a == v1 && b == v0)) {
+                        m_faceEdges[3 * f + k] = edge;
+                    }
+                }
+                // Both faces of an edge have the angle pi at the edge.
+                m_edgeNormals[edge] += m_normals[f];
+            }
+        }
+        // Vertices that belong to no face keep a zero normal.
+        for (auto& normal : m_vertexNormals) {
+            if (normal.normSqr() > 0) normal = normal.normalize();
+        }
+        for (auto& normal : m_edgeNormals) normal = normal.normalize();
+        if (numFaces > 0) build(0, numFaces, 0);
+    }
+
+    const Vec3& getCentroid(int face) const { return m_centroids[face]; }
+    double getArea(int face) const { return m_areas[face]; }
+    bool isEmpty() const { return m_nodes.empty(); }
+    const Vec3& getLowerBound() const { return m_nodes[0].lower; }
+    const Vec3& getUpperBound() const { return m_nodes[0].upper; }
+
+    /// Append the faces whose bounding boxes overlap the given box.
+    void findFacesInBox(const Vec3& lower, const Vec3& upper,
+            std::vector<int>& faces) const {
+        if (isEmpty()) return;
+        std::vector<int> stack{0};
+        while (!stack.empty()) {
+            const Node& node = m_nodes[stack.back()];
+            stack.pop_back();
+            if (!boxesOverlap(node.lower, node.upper, lower, upper)) continue;
+            if (node.left < 0) {
+                for (int i = node.begin; i < node.end; ++i) {
+                    Vec3 faceLower, faceUpper;
+                    calcFaceBounds(m_order[i], faceLower, faceUpper);
+                    if (boxesOverlap(faceLower, faceUpper, lower, upper)) {
+                        faces.push_back(m_order[i]);
+                    }
+                }
+            } else {
+                stack.push_back(node.left);
+                stack.push_back(node.right);
+            }
+        }
+    }
+
+    /// The face containing the point on the mesh closest to `point`, or -1
+    /// if no point on the mesh is closer than maxDistance. `normal` is the
+    /// pseudo-normal of the feature of the face that contains `closest`.
+    int findClosestPoint(const Vec3& point, double maxDistance,
+            Vec3& closest, Vec3& normal) const {
+        if (isEmpty()) return -1;
+        double bestDistanceSquared = SimTK::square(maxDistance);
+        int bestFace = -1;
+        TriangleFeature bestFeature = FaceABC;
+        // Each level of the tree leaves at most one node on the stack, and
+        // the deepest internal node pushes two.
+        std::vector<int> stack;
+        stack.reserve(m_depth + 1);
+        stack.push_back(0);
+        while (!stack.empty()) {
+            const Node& node = m_nodes[stack.back()];
+            stack.pop_back();
+            if (calcDistanceSquaredToBox(point, node.lower, node.upper) >=
+                    bestDistanceSquared) {
+                continue;
+            }
+            if (node.left < 0) {
+                for (int i = node.begin; i < node.end; ++i) {
+                    const int face = m_order[i];
+                    TriangleFeature feature;
+                    const Vec3 candidate = findClosestPointOnTriangle(point,
+                            m_vertices[3 * face], m_vertices[3 * face + 1],
+                            m_vertices[3 * face + 2], feature);
+                    const double distanceSquared =
+                            (candidate - point).normSqr();
+                    if (distanceSquared < bestDistanceSquared) {
+                        bestDistanceSquared = distanceSquared;
+                        bestFace = face;
+                        bestFeature = feature;
+                        closest = candidate;
+                    }
+                }
+            } else {
+                // Visit the nearer child first.
+                const Node& left = m_nodes[node.left];
+                const Node& right = m_nodes[node.right];
+                if (calcDistanceSquaredToBox(point, left.lower, left.upper) <
+                        calcDistanceSquaredToBox(
+                                point, right.lower, right.upper)) {
+                    stack.push_back(node.right);
+                    stack.push_back(node.left);
+                } else {
+                    stack.push_back(node.left);
+                    stack.push_back(node.right);
+                }
+            }
+        }
+        if (bestFace >= 0) normal = getPseudoNormal(bestFace, bestFeature);
+        return bestFace;
+    }
+
+private:
+    struct Node {
+        Vec3 lower;
+        Vec3 upper;
+        // The range of m_order covered by this node.
+        int begin = 0;
+        int end = 0;
+        // The children, or -1 for a leaf.
+        int left = -1;
+        int right = -1;
+    };
+    static const int MaxFacesPerLeaf = 4;
+
+    const Vec3& getPseudoNormal(int face, TriangleFeature feature) const {
+        switch (feature) {
+        case VertexA:
+        case VertexB:
+        case VertexC:
+            return m_vertexNormals[m_faceVertices[3 * face + feature]];
+        case EdgeAB:
+        case EdgeBC:
+        case EdgeCA:
+            return m_edgeNormals[m_faceEdges[3 * face + feature - EdgeAB]];
+        default:
+            return m_normals[face];
+        }
+    }
+
+    void calcFaceBounds(int face, Vec3& lower, Vec3& upper) const {
+        lower = upper = m_vertices[3 * face];
+        for (int v = 1; v < 3; ++v) {
+            const Vec3& vertex = m_vertices[3 * face + v];
+            for (int k = 0; k < 3; ++k) {
+                lower[k] = std::min(lower[k], vertex[k]);
+                upper[k] = std::max(upper[k], vertex[k]);
+            }
+        }
+    }
+
+    int build(int begin, int end, int depth) {
+        m_depth = std::max(m_depth, depth);
+        Node node;
+        node.begin = begin;
+        node.end = end;
+        calcFaceBounds(m_order[begin], node.lower, node.upper);
+        Vec3 centroidLower = m_centroids[m_order[begin]];
+        Vec3 centroidUpper = centroidLower;
+        for (int i = begin; i < end; ++i) {
+            Vec3 faceLower, faceUpper;
+            calcFaceBounds(m_order[i], faceLower, faceUpper);
+            const Vec3& centroid = m_centroids[m_order[i]];
+            for (int k = 0; k < 3; ++k) {
+                node.lower[k] = std::min(node.lower[k], faceLower[k]);
+                node.upper[k] = std::max(node.upper[k], faceUpper[k]);
+                centroidLower[k] = std::min(centroidLower[k], centroid[k]);
+                centroidUpper[k] = std::max(centroidUpper[k], centroid[k]);
+            }
+        }
+        const int index = (int)m_nodes.size();
+        m_nodes.push_back(node);
+        if (end - begin <= MaxFacesPerLeaf) return index;
+
+        const Vec3 extent = centroidUpper - centroidLower;
+        int axis = 0;
+        if (extent[1] > extent[axis]) axis = 1;
+        if (extent[2] > extent[axis]) axis = 2;
+        const int middle = begin + (end - begin) / 2;
+        std::nth_element(m_order.begin() + begin, m_order.begin() + middle,
+                m_order.begin() + end, [&](int a, int b) {
+                    return m_centroids[a][axis] < m_centroids[b][axis];
+                });
+        // m_nodes may be reallocated while building the children.
+        const int left = build(begin, middle, depth + 1);
+        const int right = build(middle, end, depth + 1);
+        m_nodes[index].left = left;
+        m_nodes[index].right = right;
+        return index;
+    }
+
+    std::vector<Node> m_nodes;
+    // The depth of the deepest node; the root has depth 0.
+    int m_depth = 0;
+    std::vector<int> m_order;
+    // Three vertices per face.
+    std::vector<Vec3> m_vertices;
+    std::vector<Vec3> m_centroids;
+    std::vector<Vec3> m_normals;
+    std::vector<double> m_areas;
+    // The indices of the vertices and edges of each face in the mesh, in the
+    // order of TriangleFeature.
+    std::vector<int> m_faceVertices;
+    std::vector<int> m_faceEdges;
+    // The angle-weighted pseudo-normals, indexed as in the mesh.
+    std::vector<Vec3> m_vertexNormals;
+    std::vector<Vec3> m_edgeNormals;
+};
+
+//=============================================================================
+//  MESH CONTACT FORCE
+//=============================================================================
+MeshContactForce::MeshContactForce() {
+    constructProperties();
+}
+
+MeshContactForce::MeshContactForce(const std::string& name,
+        const ContactMesh& targetMesh, const ContactMesh& baseMesh) {
+    constructProperties();
+    setName(name);
+    connectSocket_target_mesh(targetMesh);
+    connectSocket_base_mesh(baseMesh);
+}
+
+void MeshContactForce::constructProperties() {
+    constructProperty_stiffness(1e6);
+    constructProperty_dissipation(0.0);
+    constructProperty_static_friction(0.0);
+    constructProperty_dynamic_friction(0.0);
+    constructProperty_viscous_friction(0.0);
+    constructProperty_transition_velocity(0.01);
+    constructProperty_search_distance(0.01);
+    constructProperty_num_threads(1);
+}
+
+void MeshContactForce::extendFinalizeFromProperties() {
+    Super::extendFinalizeFromProperties();
+    OPENSIM_THROW_IF_FRMOBJ(get_search_distance() <= 0, InvalidPropertyValue,
+            getProperty_search_distance().getName(),
+            "Search distance must be positive");
+    OPENSIM_THROW_IF_FRMOBJ(get_transition_velocity() <= 0,
+            InvalidPropertyValue, getProperty_transition_velocity().getName(),
+            "Transition velocity must be positive");
+    OPENSIM_THROW_IF_FRMOBJ(get_num_threads() < 0, InvalidPropertyValue,
+            getProperty_num_threads().getName(),
+            "Number of threads cannot be negative");
+    m_numThreads = get_num_threads();
+    if (m_numThreads == 0) {
+        m_numThreads = std::max(1, (int)std::thread::hardware_concurrency());
+    }
+}
+
+void MeshContactForce::extendAddToSystem(
+        SimTK::MultibodySystem& system) const {
+    // Creates the SimTK::Force::Custom that calls computeForce().
+    Super::extendAddToSystem(system);
+
+    m_contactInfoCV = addCacheVariable(
+            "contact_info", ContactInfo(), SimTK::Stage::Position);
+
+    // The meshes do not deform, so the hierarchies are built once, in the
+    // frames of the meshes.
+    const SimTK::ContactGeometry target =
+            getConnectee<ContactMesh>("target_mesh")
+                    .createSimTKContactGeometry();
+    m_targetBVH.reset(
+            new BVH(SimTK::ContactGeometry::TriangleMesh::getAs(target)));
+    const SimTK::ContactGeometry base =
+            getConnectee<ContactMesh>("base_mesh")
+                    .createSimTKContactGeometry();
+    m_baseBVH.reset(new BVH(SimTK::ContactGeometry::TriangleMesh::getAs(base)));
+
+    m_executor.reset();
+    if (m_numThreads > 1) {
+        m_executor.reset(new SimTK::ParallelExecutor(m_numThreads));
+    }
+}
+
+int MeshContactForce::getNumRanges(int n) const {
+    // A few ranges per thread balance the load.
+    return std::min(n, m_numThreads > 1 ? 4 * m_numThreads : 1);
+}
+
+void MeshContactForce::forEachRange(int n,
+        const std::function<void(int, int, int)>& function) const {
+    const int numRanges = getNumRanges(n);
+    const std::function<void(int)> callRange = [&](int range) {
+        function(range, (int)((long long)range * n / numRanges),
+                (int)((long long)(range + 1) * n / numRanges));
+    };
+    if (!m_executor || numRanges <= 1) {
+        for (int range = 0; range < numRanges; ++range) callRange(range);
+        return;
+    }
+    FunctionTask task(callRange);
+    m_executor->execute(task, numRanges);
+}
+
+const MeshContactForce::ContactInfo& MeshContactForce::getContactInfo(
+        const SimTK::State& s) const {
+    if (isCacheVariableValid(s, m_contactInfoCV)) {
+        return getCacheVariableValue(s, m_contactInfoCV);
+    }
+    ContactInfo& info = updCacheVariableValue(s, m_contactInfoCV);
+    info.candidates.clear();
+    info.contacts.clear();
+
+    const auto& target = getConnectee<ContactMesh>("target_mesh");
+    const auto& base = getConnectee<ContactMesh>("base_mesh");
+    // T: the frame of the target mesh; B: the frame of the base mesh.
+    const SimTK::Transform X_GT =
+            target.getFrame().getTransformInGround(s) * target.getTransform();
+    const SimTK::Transform X_GB =
+            base.getFrame().getTransformInGround(s) * base.getTransform();
+    const SimTK::Transform X_BT = ~X_GB * X_GT;
+    const SimTK::Transform X_TB = ~X_BT;
+    const double searchDistance = get_search_distance();
+
+    if (!m_targetBVH->isEmpty() && !m_baseBVH->isEmpty()) {
+        // Broad phase: the triangles of the target mesh within the bounding
+        // box of the base mesh (enlarged by the search distance), which is
+        // re-bounded in the frame of the target mesh.
+        const Vec3 lower = m_baseBVH->getLowerBound() - Vec3(searchDistance);
+        const Vec3 upper = m_baseBVH->getUpperBound() + Vec3(searchDistance);
+        Vec3 lowerInTarget(SimTK::Infinity);
+        Vec3 upperInTarget(-SimTK::Infinity);
+        for (int corner = 0; corner < 8; ++corner) {
+            const Vec3 cornerInTarget = X_TB *
+                    Vec3((corner & 1) ? upper[0] : lower[0],
+                            (corner & 2) ? upper[1] : lower[1],
+                            (corner & 4) ? upper[2] : lower[2]);
+            for (int k = 0; k < 3; ++k) {
+                lowerInTarget[k] = std::min(lowerInTarget[k], cornerInTarget[k]);
+                upperInTarget[k] = std::max(upperInTarget[k], cornerInTarget[k]);
+            }
+        }
+        m_targetBVH->findFacesInBox(
+                lowerInTarget, upperInTarget, info.candidates);
+    }
+
+    // Narrow phase: the candidates whose centroids are inside the base mesh.
+    const int numCandidates = (int)info.candidates.size();
+    std::vector<std::vector<Contact>> contactsPerRange(
+            getNumRanges(numCandidates));
+    forEachRange(numCandidates, [&](int range, int begin, int end) {
+        auto& contacts = contactsPerRange[range];
+        for (int i = begin; i < end; ++i) {
+            const int face = info.candidates[i];
+            const Vec3 centroid = X_BT * m_targetBVH->getCentroid(face);
+            Vec3 closest, normal;
+            const int baseFace = m_baseBVH->findClosestPoint(
+                    centroid, searchDistance, closest, normal);
+            if (baseFace < 0) continue;
+            // The centroid is inside the base mesh if the closest point is
+            // on the outward side of the centroid, according to the
+            // pseudo-normal at the closest point.
+            const Vec3 toSurface = closest - centroid;
+            if (SimTK::dot(toSurface, normal) <= 0) continue;
+            Contact contact;
+            contact.face = face;
+            contact.area = m_targetBVH->getArea(face);
+            contact.depth = toSurface.norm();
+            contact.point = X_GB * centroid;
+            contact.direction = X_GB.R() * (toSurface / contact.depth);
+            contacts.push_back(contact);
+        }
+    });
+    for (const auto& contacts : contactsPerRange) {
+        info.contacts.insert(
+                info.contacts.end(), contacts.begin(), contacts.end());
+    }
+
+    markCacheVariableValid(s, m_contactInfoCV);
+    return info;
+}
+
+int MeshContactForce::getNumContacts(const SimTK::State& s) const {
+    return (int)getContactInfo(s).contacts.size();
+}
+
+void MeshContactForce::computeForce(const SimTK::State& s,
+        SimTK::Vector_<SimTK::SpatialVec>& bodyForces,
+        SimTK::Vector& generalizedForces) const {
+    const ContactInfo& info = getContactInfo(s);
+    if (info.contacts.empty()) return;
+
+    const PhysicalFrame& targetFrame =
+            getConnectee<ContactMesh>("target_mesh").getFrame();
+    const PhysicalFrame& baseFrame =
+            getConnectee<ContactMesh>("base_mesh").getFrame();
+    const SimTK::SpatialVec V_GT = targetFrame.getVelocityInGround(s);
+    const SimTK::SpatialVec V_GB = baseFrame.getVelocityInGround(s);
+    const Vec3 targetOrigin = targetFrame.getPositionInGround(s);
+    const Vec3 baseOrigin = baseFrame.getPositionInGround(s);
+
+    const double stiffness = get_stiffness();
+    const double dissipation = get_dissipation();
+    const double us = get_static_friction();
+    const double ud = get_dynamic_friction();
+    const double uv = get_viscous_friction();
+    const double vt = get_transition_velocity();
+
+    // The resultant force on the target mesh and its moment about the ground
+    // origin, for each range of contacts.
+    const int numContacts = (int)info.contacts.size();
+    std::vector<SimTK::SpatialVec> resultants(getNumRanges(numContacts),
+            SimTK::SpatialVec(Vec3(0), Vec3(0)));
+    forEachRange(numContacts, [&](int range, int begin, int end) {
+        Vec3 moment(0);
+        Vec3 force(0);
+        for (int i = begin; i < end; ++i) {
+            const Contact& contact = info.contacts[i];
+            const Vec3& point = contact.point;
+            const Vec3& direction = contact.direction;
+            // The velocity of the target mesh relative to the base mesh.
+            const Vec3 velocity =
+                    (V_GT[1] + V_GT[0] % (point - targetOrigin)) -
+                    (V_GB[1] + V_GB[0] % (point - baseOrigin));
+            const double normalVelocity = SimTK::dot(velocity, direction);
+            const double fn = stiffness * contact.area * contact.depth *
+                              (1 - dissipation * normalVelocity);
+            if (fn <= 0) continue;
+            Vec3 contactForce = fn * direction;
+
+            const Vec3 slipVelocity = velocity - normalVelocity * direction;
+            const double vslip = slipVelocity.norm();
+            if (vslip > 0) {
+                const double vrel = vslip / vt;
+                const double ffriction =
+                        fn * (std::min(vrel, 1.0) *
+                                             (ud + 2 * (us - ud) /
+                                                           (1 + vrel * vrel)) +
+                                     uv * vslip);
+                contactForce -= (ffriction / vslip) * slipVelocity;
+            }
+            force += contactForce;
+            moment += point % contactForce;
+        }
+        resultants[range] = SimTK::SpatialVec(moment, force);
+    });
+    SimTK::SpatialVec resultant(Vec3(0), Vec3(0));
+    for (const auto& rangeResultant : resultants) resultant += rangeResultant;
+
+    // Shift the moments to the body origins.
+    const SimTK::MobilizedBody& targetBody = targetFrame.getMobilizedBody();
+    const SimTK::MobilizedBody& baseBody = baseFrame.getMobilizedBody();
+    const Vec3 targetBodyOrigin = targetBody.getBodyOriginLocation(s);
+    const Vec3 baseBodyOrigin = baseBody.getBodyOriginLocation(s);
+    bodyForces[targetBody.getMobilizedBodyIndex()] += SimTK::SpatialVec(
+            resultant[0] - targetBodyOrigin % resultant[1], resultant[1]);
+    bodyForces[baseBody.getMobilizedBodyIndex()] -= SimTK::SpatialVec(
+            resultant[0] - baseBodyOrigin % resultant[1], resultant[1]);
+}
+
+void MeshContactForce::calcBodyForces(const SimTK::State& s,
+        SimTK::Vector_<SimTK::SpatialVec>& bodyForces) const {
+    const SimTK::Force& force = getModel().getForceSubsystem().getForce(_index);
+    SimTK::Vector_<Vec3> particleForces(0);
+    SimTK::Vector mobilityForces(0);
+    force.calcForceContribution(s, bodyForces, particleForces, mobilityForces);
+}
+
+SimTK::SpatialVec MeshContactForce::getTargetMeshForce(
+        const SimTK::State& s) const {
+    const auto& targetFrame =
+            getConnectee<ContactMesh>("target_mesh").getFrame();
+    SimTK::Vector_<SimTK::SpatialVec> bodyForces(0);
+    calcBodyForces(s, bodyForces);
+    return bodyForces(targetFrame.getMobilizedBodyIndex());
+}
+
+//=============================================================================
+//  REPORTING
+//=============================================================================
+OpenSim::Array<std::string> MeshContactForce::getRecordLabels() const {
+    OpenSim::Array<std::string> labels("");
+    for (const std::string mesh : {".TargetMesh", ".BaseMesh"}) {
+        labels.append(getName() + mesh + ".force.X");
+        labels.append(getName() + mesh + ".force.Y");
+        labels.append(getName() + mesh + ".force.Z");
+        labels.append(getName() + mesh + ".torque.X");
+        labels.append(getName() + mesh + ".torque.Y");
+        labels.append(getName() + mesh + ".torque.Z");
+    }
+    return labels;
+}
+
+OpenSim::Array<double> MeshContactForce::getRecordValues(
+        const SimTK::State& s) const {
+    OpenSim::Array<double> values(1);
+    SimTK::Vector_<SimTK::SpatialVec> bodyForces(0);
+    calcBodyForces(s, bodyForces);
+    for (const std::string socket : {"target_mesh", "base_mesh"}) {
+        const auto& frame = getConnectee<ContactMesh>(socket).getFrame();
+        const SimTK::SpatialVec& bodyForce =
+                bodyForces(frame.getMobilizedBodyIndex());
+        SimTK::Vec3 force = bodyForce[1];
+        SimTK::Vec3 torque = bodyForce[0];
+        values.append(3, &force[0]);
+        values.append(3, &torque[0]);
+    }
+    return values;
+}
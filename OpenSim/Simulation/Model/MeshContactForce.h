@@ -0,0 +1,180 @@
+#ifndef OPENSIM_MESH_CONTACT_FORCE_H_
+#define OPENSIM_MESH_CONTACT_FORCE_H_
+/* -------------------------------------------------------------------------- *
+ *                        OpenSim: MeshContactForce.h                         *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "Force.h"
+#include "ContactMesh.h"
+
+#include <SimTKcommon/internal/ParallelExecutor.h>
+
+#include <functional>
+
+namespace OpenSim {
+
+/** An elastic foundation contact model between two meshes (e.g., the
+articular surfaces of a knee), computed by OpenSim rather than by Simbody's
+GeneralContactSubsystem, for meshes with many (e.g., tens of thousands of)
+triangles.
+
+A spring is placed at the centroid of each triangle of the target mesh. If the
+centroid is inside the base mesh, the spring is compressed by the distance
+from the centroid to the closest point on the base mesh, and applies the force
+
+    f = stiffness * area * depth * (1 + dissipation * depth_rate)
+
+(clamped to be non-negative) toward the closest point, where area is the area
+of the triangle. Friction opposes the tangential slip velocity as in
+HuntCrossleyForce, using the static, dynamic and viscous friction
+coefficients. An equal and opposite force is applied to the base mesh.
+
+Each mesh is stored in a bounding volume hierarchy (a tree of axis-aligned
+bounding boxes in the frame of the mesh), which is built once when the model's
+system is created. For each state, the triangles of the target mesh near the
+base mesh are found with the hierarchy of the target mesh, the closest points
+for those triangles are found with the hierarchy of the base mesh, and the
+triangles in contact are cached until the positions change. The per-triangle
+queries and forces are divided among num_threads threads.
+
+Penetrations deeper than search_distance are not detected, so search_distance
+should exceed the deepest penetration expected; smaller values make the search
+faster. The meshes should be closed, with normals pointing outward. Whether
+a centroid is inside the base mesh is decided with the angle-weighted
+pseudo-normal of the face, edge or vertex that contains the closest point, so
+the test is also correct where the closest point is on an edge or a vertex. */
+class OSIMSIMULATION_API MeshContactForce : public Force {
+    OpenSim_DECLARE_CONCRETE_OBJECT(MeshContactForce, Force);
+
+public:
+    //=========================================================================
+    // PROPERTIES
+    //=========================================================================
+    OpenSim_DECLARE_PROPERTY(stiffness, double,
+            "The stiffness of the elastic foundation: the pressure per unit "
+            "penetration depth (N/m^3). Default is 1e6.");
+    OpenSim_DECLARE_PROPERTY(dissipation, double,
+            "The dissipation coefficient, default is 0 (s/m).");
+    OpenSim_DECLARE_PROPERTY(static_friction, double,
+            "The coefficient of static friction, default is 0.");
+    OpenSim_DECLARE_PROPERTY(dynamic_friction, double,
+            "The coefficient of dynamic friction, default is 0.");
+    OpenSim_DECLARE_PROPERTY(viscous_friction, double,
+            "The coefficient of viscous friction, default is 0 (s/m).");
+    OpenSim_DECLARE_PROPERTY(transition_velocity, double,
+            "Slip velocity (creep) at which peak static friction occurs, "
+            "default is 0.01 (m/s).");
+    OpenSim_DECLARE_PROPERTY(search_distance, double,
+            "The deepest penetration that is detected, default is 0.01 (m).");
+    OpenSim_DECLARE_PROPERTY(num_threads, int,
+            "The number of threads that compute the contacts of the "
+            "triangles; 0 uses all available cores. Default is 1.");
+
+    //=========================================================================
+    // SOCKETS
+    //=========================================================================
+    OpenSim_DECLARE_SOCKET(target_mesh, ContactMesh,
+            "The mesh whose triangles carry the elastic foundation springs.");
+    OpenSim_DECLARE_SOCKET(base_mesh, ContactMesh,
+            "The mesh that the target mesh contacts.");
+
+    //=========================================================================
+    // PUBLIC METHODS
+    //=========================================================================
+    MeshContactForce();
+    MeshContactForce(const std::string& name, const ContactMesh& targetMesh,
+            const ContactMesh& baseMesh);
+
+    /// The number of triangles of the target mesh that are in contact with
+    /// the base mesh. The state must be realized to Stage::Position.
+    int getNumContacts(const SimTK::State& state) const;
+
+    /// Get a SimTK::SpatialVec containing the torque (about the body origin)
+    /// and force applied to the body of the target mesh, expressed in ground.
+    SimTK::SpatialVec getTargetMeshForce(const SimTK::State& state) const;
+
+    //=========================================================================
+    // REPORTING
+    //=========================================================================
+    /// The three forces (XYZ) and three torques (XYZ) applied to the body of
+    /// the target mesh followed by those applied to the body of the base
+    /// mesh, expressed in ground.
+    OpenSim::Array<std::string> getRecordLabels() const override;
+    OpenSim::Array<double> getRecordValues(
+            const SimTK::State& state) const override;
+
+protected:
+    void extendFinalizeFromProperties() override;
+    void extendAddToSystem(SimTK::MultibodySystem& system) const override;
+    void computeForce(const SimTK::State& state,
+            SimTK::Vector_<SimTK::SpatialVec>& bodyForces,
+            SimTK::Vector& generalizedForces) const override;
+
+private:
+    class BVH;
+
+    /// A triangle of the target mesh that is inside the base mesh.
+    struct Contact {
+        int face = -1;
+        double area = 0;
+        double depth = 0;
+        /// The centroid of the triangle, in ground.
+        SimTK::Vec3 point = SimTK::Vec3(0);
+        /// The unit direction of the force on the target mesh, in ground.
+        SimTK::Vec3 direction = SimTK::Vec3(0);
+    };
+    struct ContactInfo {
+        /// Triangles of the target mesh near the base mesh.
+        std::vector<int> candidates;
+        std::vector<Contact> contacts;
+        friend std::ostream& operator<<(
+                std::ostream& o, const ContactInfo&) {
+            o << "MeshContactForce::ContactInfo should not be serialized!"
+              << std::endl;
+            return o;
+        }
+    };
+
+    void constructProperties();
+    const ContactInfo& getContactInfo(const SimTK::State& state) const;
+    void calcBodyForces(const SimTK::State& s,
+            SimTK::Vector_<SimTK::SpatialVec>& bodyForces) const;
+    // The number of ranges that forEachRange() divides [0, n) into.
+    int getNumRanges(int n) const;
+    // Call function(range, begin, end) for consecutive ranges of [0, n) on
+    // the threads of m_executor.
+    void forEachRange(int n,
+            const std::function<void(int, int, int)>& function) const;
+
+    mutable CacheVariable<ContactInfo> m_contactInfoCV;
+    mutable SimTK::ResetOnCopy<std::shared_ptr<const BVH>> m_targetBVH;
+    mutable SimTK::ResetOnCopy<std::shared_ptr<const BVH>> m_baseBVH;
+    mutable SimTK::ResetOnCopy<std::unique_ptr<SimTK::ParallelExecutor>>
+            m_executor;
+    int m_numThreads = 1;
+
+//=============================================================================
+}; // END of class MeshContactForce
+//=============================================================================
+
+} // namespace OpenSim
+
+#endif // OPENSIM_MESH_CONTACT_FORCE_H_
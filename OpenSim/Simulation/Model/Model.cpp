@@ -40,12 +40,19 @@
 #include "MarkerSet.h"
 #include "ProbeSet.h"
 #include "SimTKcommon/internal/SystemGuts.h"
+#include <ctime>
+#include <fstream>
 #include <iostream>
+#include <iterator>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 
+#include <OpenSim/Common/CommonUtilities.h>
 #include <OpenSim/Common/Constant.h>
 #include <OpenSim/Common/IO.h>
 #include <OpenSim/Common/Logger.h>
+#include <OpenSim/Common/Profiler.h>
 #include <OpenSim/Common/ScaleSet.h>
 #include <OpenSim/Common/Storage.h>
 #include <OpenSim/Common/XMLDocument.h>
@@ -88,6 +95,10 @@ static TConcreteComponent* MultibodyGraphMakerPtrCast(void* p)
     return casted;
 }
 
+// Guards Model::_contentHash, which the const getContentHash() may set from
+// several threads.
+static std::mutex contentHashMutex;
+
 
 //=============================================================================
 // CONSTRUCTOR(S) AND DESTRUCTOR
@@ -146,6 +157,74 @@ Model::Model(const string &aFileName) :
     }
 }
 
+namespace {
+    // A model loaded by Model::loadFromFileCached(), and the state of its file
+    // at the time it was read.
+    struct CachedModelFile {
+        long long modificationTime;
+        long long readTime;
+        std::size_t contentHash;
+        std::unique_ptr<Model> prototype;
+    };
+
+    std::mutex modelFileCacheMutex;
+    std::unordered_map<std::string, CachedModelFile> modelFileCache;
+
+    std::size_t hashFileContents(const std::string& fileName) {
+        std::ifstream in(fileName, std::ios::in | std::ios::binary);
+        const std::string contents{std::istreambuf_iterator<char>(in),
+                                   std::istreambuf_iterator<char>()};
+        return std::hash<std::string>{}(contents);
+    }
+}
+
+Model* Model::loadFromFileCached(const std::string& aFileName)
+{
+    const long long readTime = static_cast<long long>(std::time(nullptr));
+    const long long modificationTime =
+            IO::GetFileModificationTime(aFileName);
+    OPENSIM_THROW_IF(modificationTime < 0, Exception,
+        "Model: Cannot open file " + aFileName +
+        ". It may not exist or you do not have permission to read it.");
+
+    // Relative file names are only unique within a working directory.
+    const std::string key = IO::getCwd() + "|" + aFileName;
+
+    // Loads are serialized: deserialization temporarily changes the working
+    // directory of the process (see Object::Object(const std::string&)).
+    std::lock_guard<std::mutex> lock(modelFileCacheMutex);
+    auto it = modelFileCache.find(key);
+    if (it != modelFileCache.end()) {
+        CachedModelFile& cached = it->second;
+        // Modification times have a resolution of one second, so the file
+        // could have been modified again within the second in which it was
+        // read without its modification time changing. The modification time
+        // can only be trusted if it precedes that second; otherwise, compare
+        // the contents.
+        if (cached.modificationTime == modificationTime &&
+                cached.modificationTime < cached.readTime)
+            return cached.prototype->clone();
+        if (cached.contentHash == hashFileContents(aFileName)) {
+            cached.modificationTime = modificationTime;
+            cached.readTime = readTime;
+            return cached.prototype->clone();
+        }
+    }
+
+    const std::size_t contentHash = hashFileContents(aFileName);
+    std::unique_ptr<Model> prototype(new Model(aFileName));
+    Model* model = prototype->clone();
+    modelFileCache[key] = CachedModelFile{modificationTime, readTime,
+                                          contentHash, std::move(prototype)};
+    return model;
+}
+
+void Model::clearModelFileCache()
+{
+    std::lock_guard<std::mutex> lock(modelFileCacheMutex);
+    modelFileCache.clear();
+}
+
 Model* Model::clone() const
 {
     // Invoke default copy constructor.
@@ -407,6 +486,22 @@ void Model::constructProperties()
 }
 
 // Append to the Model's validation log
+std::string Model::getContentHash() const {
+    // The model's own properties may have been edited since it was
+    // finalized, in which case the hash is not cached.
+    const bool upToDate = isObjectUpToDateWithProperties();
+    if (upToDate) {
+        std::lock_guard<std::mutex> lock(contentHashMutex);
+        if (!_contentHash.empty()) return _contentHash;
+    }
+    const std::string hash = ContentHash().update(dump()).toString();
+    if (upToDate) {
+        std::lock_guard<std::mutex> lock(contentHashMutex);
+        _contentHash = hash;
+    }
+    return hash;
+}
+
 void Model::appendToValidationLog(const std::string& note) {
     _validationLog.append(note);
 }
@@ -711,6 +806,11 @@ void Model::extendFinalizeFromProperties()
 {
     Super::extendFinalizeFromProperties();
 
+    {
+        std::lock_guard<std::mutex> lock(contentHashMutex);
+        _contentHash.clear();
+    }
+
     // wipe-out the existing System 
     _matter.reset();
     _forceSubsystem.reset();
@@ -1954,6 +2054,7 @@ void Model::computeControls(const SimTK::State& s, SimTK::Vector &controls) cons
     }
 
     for (const Controller& controller : this->_enabledControllers) {
+        Profiler::Scope scope(controller, "computeControls");
         controller.computeControls(s, controls);
     }
 }
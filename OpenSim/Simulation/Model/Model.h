@@ -275,6 +275,26 @@ public:
     **/
     explicit Model(const std::string& filename) SWIG_DECLARE_EXCEPTION;
 
+    /** Create a %Model from an OpenSim XML model file, reusing an earlier
+    load of the same file if possible. The first call for a file reads it
+    as Model(const std::string&) does and keeps the result in memory as a
+    prototype; later calls return a copy of the prototype instead of parsing
+    the file again, which is useful when the same model is loaded for many
+    trials. The prototype is reused without reading the file if the file's
+    modification time has not changed since it was read; otherwise, it is
+    reused if the file's contents still hash to the same value, and the file
+    is read again if they do not. This function is thread-safe.
+    The caller takes ownership of the returned %Model.
+
+    @param filename     Name of a file containing an OpenSim model in XML
+                        format; suffix is typically ".osim".
+    @see clearModelFileCache() **/
+    static Model* loadFromFileCached(const std::string& filename)
+            SWIG_DECLARE_EXCEPTION;
+
+    /** Release the prototypes kept by loadFromFileCached(). **/
+    static void clearModelFileCache();
+
     /** Satisfy all connections (Sockets and Inputs) in the model, using this
      * model as the root Component. This is a convenience form of
      * Component::finalizeConnections() that uses this model as root.
@@ -1067,6 +1087,15 @@ public:
     void appendToValidationLog(const std::string& note);
     void clearValidationLog() { _validationLog = ""; };
 
+    /**
+     * A hash (see ContentHash) of the serialized model, that is, of the
+     * properties of the model and all of its components. The hash is computed
+     * the first time it is requested after finalizeFromProperties() and reused
+     * until the model is finalized again, so finalize the model (e.g., with
+     * initSystem()) after editing its components.
+     */
+    std::string getContentHash() const;
+
     /**
      * Utility to get a reference to an Object based on its name and type
      * throws an exception if the object was not found.
@@ -1171,6 +1200,10 @@ private:
     // needed later.
     std::string _validationLog;
 
+    // The result of getContentHash(), or empty if it has not been computed
+    // since the model was last finalized.
+    mutable std::string _contentHash;
+
 
     //Units for length
     Units _lengthUnits;
@@ -28,6 +28,7 @@
 
 #include "GeometryPath.h"
 #include "Model.h"
+#include <OpenSim/Common/Profiler.h>
 #include <OpenSim/Common/XMLDocument.h>
 
 //=============================================================================
@@ -512,7 +513,10 @@ const Muscle::MuscleLengthInfo& Muscle::getMuscleLengthInfo(const SimTK::State&
     }
 
     MuscleLengthInfo& umli = updCacheVariableValue(s, _lengthInfoCV);
-    calcMuscleLengthInfo(s, umli);
+    {
+        Profiler::Scope scope(*this, "calcMuscleLengthInfo");
+        calcMuscleLengthInfo(s, umli);
+    }
     markCacheVariableValid(s, _lengthInfoCV);
     return umli;
 }
@@ -530,7 +534,10 @@ getFiberVelocityInfo(const SimTK::State& s) const
     }
 
     FiberVelocityInfo& ufvi = updCacheVariableValue(s, _velInfoCV);
-    calcFiberVelocityInfo(s, ufvi);
+    {
+        Profiler::Scope scope(*this, "calcFiberVelocityInfo");
+        calcFiberVelocityInfo(s, ufvi);
+    }
     markCacheVariableValid(s, _velInfoCV);
     return ufvi;
 }
@@ -549,7 +556,10 @@ getMuscleDynamicsInfo(const SimTK::State& s) const
     }
 
     MuscleDynamicsInfo& umdi = updCacheVariableValue(s, _dynamicsInfoCV);
-    calcMuscleDynamicsInfo(s, umdi);
+    {
+        Profiler::Scope scope(*this, "calcMuscleDynamicsInfo");
+        calcMuscleDynamicsInfo(s, umdi);
+    }
     markCacheVariableValid(s, _dynamicsInfoCV);
     return umdi;
 }
@@ -567,7 +577,10 @@ getMusclePotentialEnergyInfo(const SimTK::State& s) const
     }
 
     MusclePotentialEnergyInfo& umpei = updCacheVariableValue(s, _potentialEnergyInfoCV);
-    calcMusclePotentialEnergyInfo(s, umpei);
+    {
+        Profiler::Scope scope(*this, "calcMusclePotentialEnergyInfo");
+        calcMusclePotentialEnergyInfo(s, umpei);
+    }
     markCacheVariableValid(s, _potentialEnergyInfoCV);
     return umpei;
 }
@@ -47,11 +47,29 @@ SmoothSphereHalfSpaceForce::SmoothSphereHalfSpaceForce(const std::string& name,
     constructProperties();
 }
 
+void SmoothSphereHalfSpaceForce::extendFinalizeFromProperties() {
+    Super::extendFinalizeFromProperties();
+    const double tolerance = get_culling_tolerance();
+    OPENSIM_THROW_IF_FRMOBJ(tolerance < 0 || tolerance >= 0.5,
+            InvalidPropertyValue, getProperty_culling_tolerance().getName(),
+            "Culling tolerance must be in [0, 0.5)");
+    // The indentation at which the tanh factor that smooths the Hertz force
+    // equals the tolerance.
+    m_cullingIndentation = -SimTK::Infinity;
+    if (tolerance > 0) {
+        m_cullingIndentation =
+                std::atanh(2 * tolerance - 1) / get_hertz_smoothing();
+    }
+}
+
 void SmoothSphereHalfSpaceForce::extendAddToSystem(
         SimTK::MultibodySystem& system) const {
 
     Super::extendAddToSystem(system);
 
+    // The SimTK::Force::Custom created by Force calls computeForce().
+    if (get_culling_tolerance() > 0) return;
+
     double stiffness = get_stiffness();
     double dissipation = get_dissipation();
     double staticFriction = get_static_friction();
@@ -118,6 +136,86 @@ void SmoothSphereHalfSpaceForce::constructProperties() {
     constructProperty_hunt_crossley_smoothing(50.0);
     constructProperty_force_visualization_radius(0.01);
     constructProperty_force_visualization_scale_factor();
+    constructProperty_culling_tolerance(0);
+}
+
+void SmoothSphereHalfSpaceForce::computeForce(const SimTK::State& s,
+        SimTK::Vector_<SimTK::SpatialVec>& bodyForces,
+        SimTK::Vector& generalizedForces) const {
+    // Otherwise, SimTK::SmoothSphereHalfSpaceForce applies the force.
+    if (get_culling_tolerance() <= 0) return;
+
+    const auto& sphere = getConnectee<ContactSphere>("sphere");
+    const auto& halfSpace = getConnectee<ContactHalfSpace>("half_space");
+    const PhysicalFrame& sphereFrame = sphere.getFrame();
+    const PhysicalFrame& halfSpaceFrame = halfSpace.getFrame();
+
+    // The cull test needs only the indentation. Points with x > 0 in the
+    // frame of the half space are inside it, so the outward normal is -x.
+    const SimTK::Transform& X_GS = sphereFrame.getTransformInGround(s);
+    const SimTK::Transform& X_GF = halfSpaceFrame.getTransformInGround(s);
+    const SimTK::Transform X_GH = X_GF * halfSpace.getTransform();
+    const SimTK::Vec3 normal = -X_GH.R().x().asVec3();
+    const double radius = sphere.getRadius();
+    const SimTK::Vec3 sphereCenter = X_GS * sphere.get_location();
+    const double indentation = radius - ~normal * (sphereCenter - X_GH.p());
+
+    // A culled pair applies only the constant contact force, so there is
+    // nothing more to do if that force is zero.
+    const bool culled = indentation < m_cullingIndentation;
+    if (culled && get_constant_contact_force() == 0) return;
+
+    // The force is applied at the middle of the indentation.
+    const SimTK::Vec3 contactPoint =
+            sphereCenter - (radius - 0.5 * indentation) * normal;
+    const SimTK::Vec3 contactPointInSphere =
+            X_GS.shiftBaseStationToFrame(contactPoint);
+    const SimTK::Vec3 contactPointInHalfSpace =
+            X_GF.shiftBaseStationToFrame(contactPoint);
+
+    SimTK::Vec3 force = get_constant_contact_force() * normal;
+    if (!culled) {
+        const SimTK::Vec3 velocity =
+                sphereFrame.findStationVelocityInGround(
+                        s, contactPointInSphere) -
+                halfSpaceFrame.findStationVelocityInGround(
+                        s, contactPointInHalfSpace);
+        const double indentationVelocity = -~velocity * normal;
+        const SimTK::Vec3 tangentialVelocity =
+                velocity + indentationVelocity * normal;
+
+        // Smoothed Hertz force.
+        const double eps = 1e-16;
+        const double k = 0.5 * std::pow(get_stiffness(), 2.0 / 3.0);
+        const double fH = (4.0 / 3.0) * k * std::sqrt(radius * k) *
+                          std::pow(std::sqrt(SimTK::square(indentation) + eps),
+                                  1.5);
+        const double fHd = fH * (0.5 + 0.5 * std::tanh(get_hertz_smoothing() *
+                                                       indentation));
+        // Smoothed Hunt-Crossley force.
+        const double c = get_dissipation();
+        const double fHcd = fHd * (1 + 1.5 * c * indentationVelocity);
+        const double fn =
+                fHcd * (0.5 + 0.5 * std::tanh(get_hunt_crossley_smoothing() *
+                                              (indentationVelocity +
+                                                      2.0 / (3.0 * c))));
+        // Friction force.
+        const double us = get_static_friction();
+        const double ud = get_dynamic_friction();
+        const double uv = get_viscous_friction();
+        const double vslip = std::sqrt(tangentialVelocity.normSqr() + eps);
+        const double vrel = vslip / get_transition_velocity();
+        const double ffriction =
+                fn * (std::min(vrel, 1.0) *
+                                     (ud + 2 * (us - ud) / (1 + vrel * vrel)) +
+                             uv * vslip);
+
+        force += fn * normal - ffriction * tangentialVelocity / vslip;
+    }
+
+    applyForceToPoint(s, sphereFrame, contactPointInSphere, force, bodyForces);
+    applyForceToPoint(
+            s, halfSpaceFrame, contactPointInHalfSpace, -force, bodyForces);
 }
 
 //=============================================================================
@@ -200,12 +298,11 @@ SimTK::SpatialVec SmoothSphereHalfSpaceForce::getHalfSpaceForce(
 void SmoothSphereHalfSpaceForce::calcBodyForces(
         const SimTK::State& state,
         SimTK::Vector_<SimTK::SpatialVec>& bodyForces) const {
-    const Model& model = getModel();
-    const auto& forceSubsys = model.getForceSubsystem();
-    const SimTK::Force& abstractForce = forceSubsys.getForce(_index);
-    const auto& simtkForce =
-            static_cast<const SimTK::SmoothSphereHalfSpaceForce&>(
-                    abstractForce);
+    // If culling_tolerance is positive, the force at _index is the
+    // SimTK::Force::Custom created by Force, not a
+    // SimTK::SmoothSphereHalfSpaceForce, so use the base class.
+    const SimTK::Force& simtkForce =
+            getModel().getForceSubsystem().getForce(_index);
 
     SimTK::Vector_<SimTK::Vec3> particleForces(0);
     SimTK::Vector mobilityForces(0);
@@ -44,6 +44,24 @@ be adjusted for different contact scenarios or models with a very light mass.
 
 @see SimTK::SmoothSphereHalfSpaceForce
 
+\section smoothsphere_culling Skipping distant contacts
+
+Models with many contact spheres (e.g., several spheres per foot) evaluate
+every sphere-half space pair whenever forces are computed, even when most
+spheres are far from the half space and the smoothed Hertz force is
+negligible. If the culling_tolerance property is positive, the contact force
+is computed by this component instead of by SimTK::SmoothSphereHalfSpaceForce,
+and a pair is skipped whenever the factor that smooths the Hertz force,
+(1 + tanh(hertz_smoothing * indentation)) / 2, is below culling_tolerance.
+This test requires only the distance between the sphere and the half space.
+For a skipped pair, only the constant contact force is applied, along the
+normal of the half space; the neglected force is at most culling_tolerance
+times the (unsmoothed) Hunt-Crossley force at the current indentation. If
+constant_contact_force is 0, a skipped pair costs only this test.
+Skipping is useful in simulations and optimizations (e.g., Moco) that
+evaluate the contact forces many times. The default, 0, is the exact mode:
+no pair is skipped and SimTK::SmoothSphereHalfSpaceForce computes the force.
+
 The graph below compares the smooth approximation of the Hertz force to that
 from HuntCrossleyForce.
 
@@ -108,6 +126,12 @@ public:
             "force magnitude is equal to this value. If this property is not "
             "specified, the total weight of the model is used "
             "as the scale factor.")
+    OpenSim_DECLARE_PROPERTY(culling_tolerance, double,
+            "If positive, the Hertz and Hunt-Crossley forces are skipped "
+            "when the tanh factor that smooths the Hertz force is below "
+            "this value (i.e., the sphere is far from the half space), and "
+            "only the constant contact force is applied. Must be less than "
+            "0.5. Default is 0, which never skips the force.");
 
     //=========================================================================
     // SOCKETS
@@ -157,8 +181,13 @@ public:
     SimTK::SpatialVec getHalfSpaceForce(const SimTK::State& s) const;
 
 protected:
+    void extendFinalizeFromProperties() override;
     /// Create a SimTK::Force which implements this Force.
     void extendAddToSystem(SimTK::MultibodySystem& system) const override;
+    /// Compute the contact force if culling_tolerance is positive.
+    void computeForce(const SimTK::State& state,
+            SimTK::Vector_<SimTK::SpatialVec>& bodyForces,
+            SimTK::Vector& generalizedForces) const override;
     void extendRealizeInstance(const SimTK::State& state) const override;
     void generateDecorations(bool fixed, const ModelDisplayHints& hints,
             const SimTK::State& state,
@@ -168,6 +197,9 @@ private:
     // INITIALIZATION
     void constructProperties();
     mutable double m_forceVizScaleFactor;
+    // Pairs with an indentation below this value are skipped; -Infinity if
+    // culling_tolerance is 0.
+    double m_cullingIndentation = -SimTK::Infinity;
 
     void calcBodyForces(const SimTK::State& s,
                         SimTK::Vector_<SimTK::SpatialVec>& bodyForces) const;
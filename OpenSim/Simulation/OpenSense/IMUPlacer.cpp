@@ -92,6 +92,11 @@ bool IMUPlacer::run(bool visualizeResults) {
     if (_model.empty()) { _model.reset(new Model(get_model_file())); }
     TimeSeriesTable_<SimTK::Quaternion> quatTable(
             get_orientation_file_for_calibration());
+    // Only the first frame is used for calibration; don't rotate and convert
+    // the rest of the trial.
+    if (quatTable.getNumRows() > 1) {
+        quatTable.trimTo(quatTable.getIndependentColumn().front());
+    }
 
     const SimTK::Vec3& sensor_to_opensim_rotations =
             get_sensor_to_opensim_rotations();
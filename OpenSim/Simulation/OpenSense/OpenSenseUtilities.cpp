@@ -20,6 +20,7 @@
  * See the License for the specific language governing permissions and        *
  * limitations under the License.                                             *
  * -------------------------------------------------------------------------- */
+#include <OpenSim/Common/RotationKernels.h>
 #include <OpenSim/Common/STOFileAdapter.h>
 #include <OpenSim/Simulation/Model/Model.h>
 #include <OpenSim/Simulation/MarkersReference.h>
@@ -42,21 +43,19 @@ TimeSeriesTable_<SimTK::Rotation> OpenSenseUtilities::
 
     size_t nt = int(quaternionsTable.getNumRows());
 
-    std::vector<double> newTimes(nt, SimTK::NaN);
-    SimTK::Matrix_<SimTK::Rotation> matrix(int(nt), nc, Rotation());
+    SimTK::Matrix_<SimTK::Rotation> matrix(int(nt), nc);
 
-    int cnt = 0;
-    for (size_t i = 0; i < nt; ++i) {
-        newTimes[cnt] = times[i];
-        const auto& quatRow = quaternionsTable.getRowAtIndex(i);
-        for (int j = 0; j < nc; ++j) {
-            const Quaternion& quatO = quatRow[j];
-            matrix.updElt(cnt, j) = Rotation(quatO);
-        }
-        cnt++;
+    // Convert a column (sensor) at a time with the batched kernels.
+    const auto& quaternions = quaternionsTable.getMatrix();
+    QuaternionArrays quatColumn;
+    RotationMatrixArrays rotColumn;
+    for (int j = 0; j < nc; ++j) {
+        RotationKernels::loadColumn(quaternions, j, quatColumn);
+        RotationKernels::convertQuaternionsToRotations(quatColumn, rotColumn);
+        RotationKernels::storeColumn(rotColumn, j, matrix);
     }
 
-    TimeSeriesTable_<SimTK::Rotation> orientationTable(newTimes,
+    TimeSeriesTable_<SimTK::Rotation> orientationTable(times,
         matrix,
         quaternionsTable.getColumnLabels());
     orientationTable.updTableMetaData() = quaternionsTable.getTableMetaData();
@@ -71,18 +70,15 @@ void OpenSim::OpenSenseUtilities::rotateOrientationTable(
                 quaternionsTable,
         const SimTK::Rotation_<double>& rotationMatrix)
 {
-    SimTK::Rotation R_XG = rotationMatrix;
-
     int nc = int(quaternionsTable.getNumColumns());
-    size_t nt = quaternionsTable.getNumRows();
-
-    for (size_t i = 0; i < nt; ++i) {
-        auto quatRow = quaternionsTable.updRowAtIndex(i);
-        for (int j = 0; j < nc; ++j) {
-            // This can be done completely in Quaternions but this is easier to debug for now
-            Quaternion quatO = (R_XG * Rotation(quatRow[j])).convertRotationToQuaternion();
-            quatRow[j] = quatO;
-        }
+
+    // Rotate a column (sensor) at a time with the batched kernels.
+    auto& quaternions = quaternionsTable.updMatrix();
+    QuaternionArrays column;
+    for (int j = 0; j < nc; ++j) {
+        RotationKernels::loadColumn(quaternions, j, column);
+        RotationKernels::rotate(rotationMatrix, column);
+        RotationKernels::storeColumn(column, j, quaternions);
     }
     return;
 }
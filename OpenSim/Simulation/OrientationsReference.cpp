@@ -160,7 +160,7 @@ void OrientationsReference::getValuesAtTime(
 {
 
     // get values for time
-    SimTK::RowVector_<Rotation> row = _orientationData.getRow(time);
+    const auto row = _orientationData.getRow(time);
 
     int n = row.size();
     values.resize(n);
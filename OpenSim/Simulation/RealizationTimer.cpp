@@ -0,0 +1,80 @@
+/* -------------------------------------------------------------------------- *
+ *                       OpenSim: RealizationTimer.cpp                        *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "RealizationTimer.h"
+
+#include <OpenSim/Common/Stopwatch.h>
+
+#include <iomanip>
+#include <sstream>
+
+using namespace OpenSim;
+
+void RealizationTimer::realize(const SimTK::System& system,
+        const SimTK::State& state, SimTK::Stage stage) {
+    if (stage > SimTK::Stage::Report) stage = SimTK::Stage::Report;
+    for (SimTK::Stage g = state.getSystemStage().next(); g <= stage;
+            g = g.next()) {
+        Stopwatch watch;
+        system.realize(state, g);
+        m_timeInNs[g] += watch.getElapsedTimeInNs();
+        ++m_numRealizations[g];
+    }
+}
+
+void RealizationTimer::reset() {
+    m_timeInNs.fill(0);
+    m_numRealizations.fill(0);
+}
+
+double RealizationTimer::getTime(SimTK::Stage stage) const {
+    return SimTK::nsToSec(m_timeInNs[stage]);
+}
+
+int RealizationTimer::getNumRealizations(SimTK::Stage stage) const {
+    return m_numRealizations[stage];
+}
+
+double RealizationTimer::getTotalTime() const {
+    long long total = 0;
+    for (const auto& time : m_timeInNs) total += time;
+    return SimTK::nsToSec(total);
+}
+
+std::string RealizationTimer::getSummary() const {
+    std::ostringstream ss;
+    ss << std::left << std::setw(14) << "stage" << std::right
+       << std::setw(14) << "realizations" << std::setw(14) << "total (s)"
+       << std::setw(14) << "mean (ms)";
+    ss << std::fixed;
+    for (int level = 0; level < SimTK::Stage::NValid; ++level) {
+        const int count = m_numRealizations[level];
+        if (!count) continue;
+        const double seconds = SimTK::nsToSec(m_timeInNs[level]);
+        ss << "\n" << std::left << std::setw(14)
+           << SimTK::Stage(level).getName() << std::right << std::setw(14)
+           << count << std::setw(14) << std::setprecision(6) << seconds
+           << std::setw(14) << std::setprecision(4)
+           << 1000.0 * seconds / count;
+    }
+    return ss.str();
+}
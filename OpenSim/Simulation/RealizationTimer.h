@@ -0,0 +1,80 @@
+#ifndef OPENSIM_REALIZATION_TIMER_H_
+#define OPENSIM_REALIZATION_TIMER_H_
+/* -------------------------------------------------------------------------- *
+ *                        OpenSim: RealizationTimer.h                         *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "osimSimulationDLL.h"
+#include <SimTKcommon.h>
+
+#include <array>
+#include <string>
+
+namespace OpenSim {
+
+/** Realize states one stage at a time and record the real ("wall") time spent
+realizing each stage, to find which stages dominate the cost of an analysis
+or of reporting. Stages that a state has already realized are not realized
+again and are not counted.
+
+@code
+RealizationTimer timer;
+for (const auto& state : states) {
+    timer.realize(model.getSystem(), state, SimTK::Stage::Velocity);
+    // ...
+}
+log_info(timer.getSummary());
+@endcode
+
+Time spent in stages that are realized by other means (e.g., when a
+component calls SimTK::System::realize() itself) is not recorded, so realize
+to the highest stage that will be needed before using the state. */
+class OSIMSIMULATION_API RealizationTimer {
+public:
+    RealizationTimer() { reset(); }
+
+    /// Realize the state to the given stage (at most Stage::Report), one
+    /// stage at a time.
+    void realize(const SimTK::System& system, const SimTK::State& state,
+            SimTK::Stage stage);
+
+    /// Forget all recorded times.
+    void reset();
+
+    /// The total time, in seconds, spent realizing the given stage.
+    double getTime(SimTK::Stage stage) const;
+    /// The number of times the given stage was realized.
+    int getNumRealizations(SimTK::Stage stage) const;
+    /// The total time, in seconds, spent realizing all stages.
+    double getTotalTime() const;
+
+    /// A table of the number of realizations and the total and mean time of
+    /// each stage that was realized at least once.
+    std::string getSummary() const;
+
+private:
+    std::array<long long, SimTK::Stage::NValid> m_timeInNs;
+    std::array<int, SimTK::Stage::NValid> m_numRealizations;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_REALIZATION_TIMER_H_
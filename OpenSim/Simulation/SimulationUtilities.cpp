@@ -28,8 +28,17 @@
 
 #include <simbody/internal/Visualizer_InputListener.h>
 
+#include <OpenSim/Common/STOFileAdapter.h>
 #include <OpenSim/Common/TableUtilities.h>
 
+#include <condition_variable>
+#include <exception>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <mutex>
+#include <thread>
+
 using namespace OpenSim;
 
 SimTK::State OpenSim::simulate(Model& model,
@@ -392,6 +401,135 @@ void OpenSim::checkLabelsMatchModelStates(const Model& model,
     }
 }
 
+void OpenSim::detail::processChunksInOrder(int numChunks, int numThreads,
+        const std::function<void(int, int)>& process,
+        const std::function<void(int)>& finish) {
+    OPENSIM_THROW_IF(numThreads < 1, Exception,
+            "Expected numThreads to be positive, but got {}.", numThreads);
+    std::mutex mutex;
+    std::condition_variable chunkFinished;
+    int nextChunk = 0;
+    int nextChunkToFinish = 0;
+    // Processed chunks that wait for their preceding chunks to be finished.
+    std::vector<bool> processed(numChunks, false);
+    const int maxChunksWaiting = 2 * numThreads;
+    std::exception_ptr error;
+
+    auto processChunks = [&](int ithread) {
+        try {
+            while (true) {
+                int ichunk;
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    chunkFinished.wait(lock, [&]() {
+                        return error || nextChunk == numChunks ||
+                               nextChunk - nextChunkToFinish <
+                                       maxChunksWaiting;
+                    });
+                    if (error || nextChunk == numChunks) return;
+                    ichunk = nextChunk++;
+                }
+                process(ithread, ichunk);
+
+                std::lock_guard<std::mutex> lock(mutex);
+                if (error) return;
+                processed[ichunk] = true;
+                try {
+                    while (nextChunkToFinish < numChunks &&
+                            processed[nextChunkToFinish]) {
+                        finish(nextChunkToFinish);
+                        ++nextChunkToFinish;
+                    }
+                } catch (...) {
+                    error = std::current_exception();
+                }
+                chunkFinished.notify_all();
+            }
+        } catch (...) {
+            // process() threw; the mutex is not locked.
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!error) error = std::current_exception();
+            chunkFinished.notify_all();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int ithread = 1; ithread < numThreads; ++ithread) {
+        threads.emplace_back(processChunks, ithread);
+    }
+    processChunks(0);
+    for (auto& thread : threads) thread.join();
+    if (error) std::rethrow_exception(error);
+}
+
+namespace {
+// Write an element of an analyze() report in the format of STOFileAdapter.
+void writeReportElement(std::ostream& stream, double elem) {
+    stream << elem;
+}
+template <int M>
+void writeReportElement(std::ostream& stream, const SimTK::Vec<M>& elem) {
+    stream << elem[0];
+    for (int i = 1; i < M; ++i) stream << "," << elem[i];
+}
+void writeReportElement(std::ostream& stream, const SimTK::SpatialVec& elem) {
+    writeReportElement(stream, elem[0]);
+    stream << ",";
+    writeReportElement(stream, elem[1]);
+}
+} // anonymous namespace
+
+template <typename T>
+void OpenSim::analyzeToFile(Model model, const TimeSeriesTable& statesTable,
+        const TimeSeriesTable& controlsTable,
+        const std::vector<std::string>& outputPaths,
+        const std::string& fileName,
+        const TimeSeriesTable& discreteVariablesTable, int numThreads) {
+    std::ofstream stream;
+    auto startFile = [&](const std::vector<std::string>& labels) {
+        // Write the header with STOFileAdapter, and open the file to append
+        // rows.
+        TimeSeriesTable_<T> header;
+        header.setColumnLabels(labels);
+        STOFileAdapter_<T>::write(header, fileName);
+        stream.open(fileName, std::ios::app);
+        OPENSIM_THROW_IF(!stream, Exception,
+                "Could not open file '{}' to append results.", fileName);
+        stream << std::setprecision(std::numeric_limits<double>::digits10 + 1);
+    };
+    analyzeInChunks<T>(std::move(model), statesTable, controlsTable,
+            outputPaths, discreteVariablesTable, numThreads,
+            [&](const TimeSeriesTable_<T>& chunk) {
+                if (!stream.is_open()) startFile(chunk.getColumnLabels());
+                const auto& times = chunk.getIndependentColumn();
+                for (int irow = 0; irow < (int)chunk.getNumRows(); ++irow) {
+                    stream << times[irow];
+                    const auto row = chunk.getRowAtIndex(irow);
+                    for (int icol = 0; icol < row.size(); ++icol) {
+                        stream << "\t";
+                        writeReportElement(stream, row[icol]);
+                    }
+                    stream << "\n";
+                }
+            });
+}
+
+// Explicit template instantiations.
+namespace OpenSim {
+template OSIMSIMULATION_API void analyzeToFile<double>(Model,
+        const TimeSeriesTable&, const TimeSeriesTable&,
+        const std::vector<std::string>&, const std::string&,
+        const TimeSeriesTable&, int);
+template OSIMSIMULATION_API void analyzeToFile<SimTK::Vec3>(Model,
+        const TimeSeriesTable&, const TimeSeriesTable&,
+        const std::vector<std::string>&, const std::string&,
+        const TimeSeriesTable&, int);
+template OSIMSIMULATION_API void analyzeToFile<SimTK::SpatialVec>(Model,
+        const TimeSeriesTable&, const TimeSeriesTable&,
+        const std::vector<std::string>&, const std::string&,
+        const TimeSeriesTable&, int);
+} // namespace OpenSim
+
 TimeSeriesTableVec3 OpenSim::createSyntheticIMUAccelerationSignals(
         const Model& model,
         const TimeSeriesTable& statesTable, const TimeSeriesTable& controlsTable,
@@ -25,8 +25,11 @@
 
 #include "StatesTrajectory.h"
 #include "osimSimulationDLL.h"
+#include <algorithm>
+#include <functional>
 #include <regex>
 
+#include <SimTKcommon/internal/ParallelExecutor.h>
 #include <SimTKcommon/internal/State.h>
 
 #include <OpenSim/Common/Reporter.h>
@@ -191,116 +194,143 @@ OSIMSIMULATION_API void checkOrderSystemControls(const Model& model);
 OSIMSIMULATION_API void checkLabelsMatchModelStates(
         const Model& model, const std::vector<std::string>& labels);
 
+namespace detail {
+/// Call process(ithread, ichunk) for each chunk 0, ..., numChunks - 1 on
+/// numThreads threads (the calling thread is one of them), where ithread
+/// identifies the calling thread (0 <= ithread < numThreads). Then call
+/// finish(ichunk) for each chunk, in order, as soon as that chunk and all
+/// previous chunks are processed. finish() is called by one thread at a time,
+/// and at most 2 * numThreads processed chunks wait to be finished. If process()
+/// or finish() throws, no further chunks are started and the exception is
+/// rethrown once all threads have stopped.
+/// This is an implementation detail of analyzeInChunks() and
+/// EnsembleSimulation, and is not part of the API.
+OSIMSIMULATION_API void processChunksInOrder(int numChunks, int numThreads,
+        const std::function<void(int ithread, int ichunk)>& process,
+        const std::function<void(int ichunk)>& finish);
+} // namespace detail
+
 /// Calculate the requested outputs using the model in the problem and the
-/// provided states and controls tables.
-/// The controls table is used to set the model's controls vector.
-/// We assume the states and controls tables contain the same time points.
-/// The output paths can be regular expressions. For example,
-/// ".*activation" gives the activation of all muscles.
+/// provided states and controls tables, and pass the report to appendChunk()
+/// one chunk of consecutive rows at a time, in time order. See analyze() for
+/// a description of the arguments.
 ///
-/// The output paths must correspond to outputs that match the type provided in
-/// the template argument, otherwise they are not included in the report.
+/// The output paths are matched against the model's outputs once, before any
+/// state is evaluated. Each state is realized only to the highest stage that
+/// the selected outputs depend on (at least SimTK::Stage::Velocity, at which
+/// the controls are applied).
 ///
-/// Controls missing from the controls table are given a value of 0.
-///
-/// If you analysis depends on the values of discrete variables in the state,
-/// you may provide those values via the optional argument
-/// "discreteVariablesTable". This table should contain column labels with the
-/// following format: <path_to_component>/<discrete_var_name>. For example,
-/// "/forceset/muscle/implicitderiv_normalized_tendon_force".
+/// If numThreads is not 1, the rows are divided among numThreads threads
+/// (0 uses all processor cores), each of which evaluates the outputs with its
+/// own copy of the model.
 ///
-/// @note The provided trajectory is not modified to satisfy kinematic
-/// constraints, but SimTK::Motions in the Model (e.g., PositionMotion) are
-/// applied. Therefore, this function expects that you've provided a trajectory
-/// that already satisfies kinematic constraints. If your provided trajectory
-/// does not satisfy kinematic constraints, many outputs will be incorrect.
-/// For example, in a model with a patella whose location is determined by a
-/// CoordinateCouplerConstraint, the length of a muscle that crosses the patella
-/// will be incorrect.
+/// If the tables have no rows, appendChunk() is called once with an empty
+/// chunk that has the column labels of the report.
 /// @ingroup simulationutil
 template <typename T>
-TimeSeriesTable_<T> analyze(Model model, const TimeSeriesTable& statesTable,
+void analyzeInChunks(Model model, const TimeSeriesTable& statesTable,
         const TimeSeriesTable& controlsTable,
         const std::vector<std::string>& outputPaths,
-        const TimeSeriesTable& discreteVariablesTable = {}) {
+        const TimeSeriesTable& discreteVariablesTable, int numThreads,
+        const std::function<void(const TimeSeriesTable_<T>& chunk)>&
+                appendChunk) {
+
+    OPENSIM_THROW_IF(statesTable.getNumRows() != controlsTable.getNumRows(),
+            Exception,
+            "Expected statesTable and controlsTable to contain the "
+            "same number of rows, but statesTable contains {} rows "
+            "and controlsTable contains {} rows.",
+            statesTable.getNumRows(), controlsTable.getNumRows());
+    OPENSIM_THROW_IF(discreteVariablesTable.getNumColumns() &&
+                             discreteVariablesTable.getNumRows() !=
+                                     statesTable.getNumRows(),
+            Exception,
+            "Expected discreteVariablesTable to contain the "
+            "same number of rows as statesTable and controlsTable, "
+            "but discreteVariablesTable contains {} rows "
+            "and statesTable contains {} rows.",
+            discreteVariablesTable.getNumRows(), statesTable.getNumRows());
+    OPENSIM_THROW_IF(numThreads < 0, Exception,
+            "Expected numThreads to be non-negative, but got {}.", numThreads);
 
     // Initialize the system so we can access the outputs.
     model.initSystem();
 
-    // Create the reporter object to which we'll add the output data to create
-    // the report.
-    auto* reporter = new TableReporter_<T>();
-
-    // Convenience function for populating the reporter.
-    auto populateReporter = [](const std::vector<std::string>& outputPaths,
-            const AbstractOutput& output, TableReporter_<T>* reporter) {
-        auto thisOutputPath = output.getPathName();
-        for (const auto& outputPathArg : outputPaths) {
-                if (std::regex_match(
-                        thisOutputPath, std::regex(outputPathArg))) {
-                    // Make sure the output type agrees with the template.
-                    if (dynamic_cast<const Output<T>*>(&output)) {
-                        log_debug("Adding output {} of type {}.",
-                                output.getPathName(), output.getTypeName());
-                        reporter->addToReport(output);
-                    } else {
-                        log_warn("Ignoring output {} of type {}.",
-                                output.getPathName(), output.getTypeName());
-                    }
+    // Select the outputs whose paths match one of the provided paths and
+    // whose type agrees with the template argument. Outputs are identified
+    // by the path of their owner and their name, so that they can be found
+    // in copies of the model.
+    std::vector<std::regex> patterns;
+    for (const auto& outputPath : outputPaths) {
+        patterns.emplace_back(outputPath);
+    }
+    struct SelectedOutput {
+        std::string ownerPath; // Empty for the model itself.
+        std::string name;
+    };
+    std::vector<SelectedOutput> selectedOutputs;
+    std::vector<std::string> labels;
+    SimTK::Stage realizationStage = SimTK::Stage::Velocity;
+    auto selectOutput = [&](const AbstractOutput& output,
+                                const std::string& ownerPath) {
+        const auto thisOutputPath = output.getPathName();
+        for (const auto& pattern : patterns) {
+            if (!std::regex_match(thisOutputPath, pattern)) continue;
+            // Make sure the output type agrees with the template.
+            if (const auto* typedOutput =
+                            dynamic_cast<const Output<T>*>(&output)) {
+                log_debug("Adding output {} of type {}.",
+                        output.getPathName(), output.getTypeName());
+                selectedOutputs.push_back({ownerPath, output.getName()});
+                for (const auto& channel : typedOutput->getChannels()) {
+                    labels.push_back(channel.second.getPathName());
                 }
+                realizationStage = std::max(
+                        realizationStage, output.getDependsOnStage());
+            } else {
+                log_warn("Ignoring output {} of type {}.",
+                        output.getPathName(), output.getTypeName());
             }
+            return;
+        }
     };
 
-    // Loop through all the outputs for all components in the model, and if
-    // the output path matches one provided in the argument and the output type
-    // agrees with the template argument type, add it to the report.
+    // Loop through all the outputs for all components in the model, and then
+    // the outputs of the top-level model.
     for (const auto& comp : model.getComponentList()) {
         for (const auto& outputName : comp.getOutputNames()) {
-            const auto& output = comp.getOutput(outputName);
-            populateReporter(outputPaths, output, reporter);
+            selectOutput(comp.getOutput(outputName),
+                    comp.getAbsolutePathString());
         }
     }
-
-    // Check if any output paths match outputs of the top-level model.
     for (const auto& outputName : model.getOutputNames()) {
-        const auto& output = model.getOutput(outputName);
-        populateReporter(outputPaths, output, reporter);
+        selectOutput(model.getOutput(outputName), "");
     }
 
-    // Add the reporter to the model.
-    model.addComponent(reporter);
-    model.initSystem();
-
-    const auto statesTraj =
-            StatesTrajectory::createFromStatesTable(model, statesTable);
-
-    const std::vector<std::string>& controlNames =
-            controlsTable.getColumnLabels();
-    const std::unordered_map<std::string, int> controlMap =
-            createSystemControlIndexMap(model);
-    SimTK::Vector controls((int)controlsTable.getNumColumns(), 0.0);
-
-    OPENSIM_THROW_IF(statesTable.getNumRows() != controlsTable.getNumRows(),
-            Exception,
-            "Expected statesTable and controlsTable to contain the "
-            "same number of rows, but statesTable contains {} rows "
-            "and controlsTable contains {} rows.",
-            statesTable.getNumRows(), controlsTable.getNumRows());
-
-    // If the table for discrete variables was provided, get references
-    // to the components associated with each discrete variable.
-    std::vector<std::pair<std::string, SimTK::ReferencePtr<const Component>>>
-    discreteComponentRefs;
-    if (discreteVariablesTable.getNumColumns()) {
-        OPENSIM_THROW_IF(discreteVariablesTable.getNumRows() !=
-                         statesTable.getNumRows(), Exception,
-            "Expected discreteVariablesTable to contain the "
-            "same number of rows as statesTable and controlsTable, "
-            "but discreteVariablesTable contains {} rows "
-            "and statesTable contains {} rows.",
-            discreteVariablesTable.getNumRows(), statesTable.getNumRows());
-
-        // The labels for each discrete variable are in the following format:
+    // The objects that one thread uses to evaluate the outputs.
+    struct Worker {
+        std::unique_ptr<Model> copy;
+        const Model* model = nullptr;
+        std::vector<const typename Output<T>::Channel*> channels;
+        std::vector<std::pair<std::string,
+                SimTK::ReferencePtr<const Component>>> discreteComponentRefs;
+        std::unordered_map<std::string, int> controlMap;
+    };
+    auto initializeWorker = [&](Worker& worker, const Model& localModel) {
+        worker.model = &localModel;
+        for (const auto& selected : selectedOutputs) {
+            const Component& owner = selected.ownerPath.empty()
+                    ? localModel
+                    : localModel.getComponent(selected.ownerPath);
+            const auto& output = dynamic_cast<const Output<T>&>(
+                    owner.getOutput(selected.name));
+            for (const auto& channel : output.getChannels()) {
+                worker.channels.push_back(&channel.second);
+            }
+        }
+        // If the table for discrete variables was provided, get references
+        // to the components associated with each discrete variable. The
+        // labels for each discrete variable are in the following format:
         //      <path_to_component>/<discrete_var_name>
         // We can use ComponentPath to split up the component path from the
         // discrete variable name.
@@ -310,51 +340,182 @@ TimeSeriesTable_<T> analyze(Model model, const TimeSeriesTable& statesTable,
                     discreteVarPath.getComponentName();
             const std::string& componentPath =
                     discreteVarPath.getParentPathString();
-            const auto& component = model.getComponent(componentPath);
-            discreteComponentRefs.emplace_back(discreteVarName, &component);
+            const auto& component = localModel.getComponent(componentPath);
+            worker.discreteComponentRefs.emplace_back(
+                    discreteVarName, &component);
         }
-    }
-
-    // Loop through the states trajectory to create the report.
-    for (int itime = 0; itime < (int)statesTraj.getSize(); ++itime) {
-        // Get the current state.
-        auto state = statesTraj[itime];
+        worker.controlMap = createSystemControlIndexMap(localModel);
+    };
 
-        // Enforce any SimTK::Motion's included in the model.
-        model.getSystem().prescribe(state);
+    const int numRows = (int)statesTable.getNumRows();
+    if (numRows == 0) {
+        TimeSeriesTable_<T> chunk;
+        chunk.setColumnLabels(labels);
+        appendChunk(chunk);
+        return;
+    }
+    // Chunks are small enough to balance the load among threads and to
+    // stream the report, and large enough that creating the states for
+    // each chunk is cheap.
+    const int chunkSize = 100;
+    const int numChunks = (numRows + chunkSize - 1) / chunkSize;
+    if (numThreads == 0) {
+        numThreads = SimTK::ParallelExecutor::getNumProcessors();
+    }
+    numThreads = std::max(1, std::min(numThreads, numChunks));
+
+    // Each additional thread uses its own copy of the model, since evaluating
+    // an output modifies the output. The copies are made before the threads
+    // start, and each thread initializes its own copy.
+    std::vector<Worker> workers(numThreads);
+    initializeWorker(workers[0], model);
+    for (int ithread = 1; ithread < numThreads; ++ithread) {
+        workers[ithread].copy.reset(model.clone());
+    }
+    std::vector<TimeSeriesTable_<T>> chunks(numChunks);
 
-        // Create a SimTK::Vector of the control values for the current state.
-        const auto& controlsRow = controlsTable.getRowAtIndex(itime);
-        for (int icontrol = 0; icontrol < (int)controlNames.size();
-                ++icontrol) {
-            controls[controlMap.at(controlNames[icontrol])] =
-                    controlsRow[icontrol];
+    const std::vector<std::string>& controlNames =
+            controlsTable.getColumnLabels();
+    const auto process = [&](int ithread, int ichunk) {
+        Worker& worker = workers[ithread];
+        if (!worker.model) {
+            worker.copy->initSystem();
+            initializeWorker(worker, *worker.copy);
+        }
+        const Model& localModel = *worker.model;
+        const int begin = ichunk * chunkSize;
+        const int end = std::min(begin + chunkSize, numRows);
+
+        TimeSeriesTable chunkStates;
+        chunkStates.setColumnLabels(statesTable.getColumnLabels());
+        chunkStates.updTableMetaData() = statesTable.getTableMetaData();
+        const auto& times = statesTable.getIndependentColumn();
+        for (int itime = begin; itime < end; ++itime) {
+            chunkStates.appendRow(
+                    times[itime], statesTable.getRowAtIndex(itime));
         }
+        const auto statesTraj = StatesTrajectory::createFromStatesTable(
+                localModel, chunkStates);
+
+        TimeSeriesTable_<T>& report = chunks[ichunk];
+        report.setColumnLabels(labels);
+        SimTK::RowVector_<T> row((int)worker.channels.size());
+        SimTK::Vector controls((int)controlsTable.getNumColumns(), 0.0);
+        for (int itime = begin; itime < end; ++itime) {
+            // Get the current state.
+            auto state = statesTraj[itime - begin];
+
+            // Enforce any SimTK::Motion's included in the model.
+            localModel.getSystem().prescribe(state);
+
+            // Create a SimTK::Vector of the control values for the current
+            // state.
+            const auto& controlsRow = controlsTable.getRowAtIndex(itime);
+            for (int icontrol = 0; icontrol < (int)controlNames.size();
+                    ++icontrol) {
+                controls[worker.controlMap.at(controlNames[icontrol])] =
+                        controlsRow[icontrol];
+            }
 
-        // Set the controls on the state object.
-        model.realizeVelocity(state);
-        model.setControls(state, controls);
+            // Set the controls on the state object.
+            localModel.realizeVelocity(state);
+            localModel.setControls(state, controls);
 
-        // Apply discrete variables to the state.
-        if (discreteVariablesTable.getNumColumns()) {
-           const auto& labels = discreteVariablesTable.getColumnLabels();
-            for (int idv = 0; idv < (int)labels.size(); ++idv) {
-                const auto& label = labels[idv];
+            // Apply discrete variables to the state.
+            for (int idv = 0; idv < (int)worker.discreteComponentRefs.size();
+                    ++idv) {
                 const auto& discreteCol =
-                        discreteVariablesTable.getDependentColumn(label);
-                const auto& component = discreteComponentRefs[idv].second.getRef();
+                        discreteVariablesTable.getDependentColumnAtIndex(idv);
+                const auto& component =
+                        worker.discreteComponentRefs[idv].second.getRef();
                 component.setDiscreteVariableValue(state,
-                        discreteComponentRefs[idv].first, discreteCol[itime]);
+                        worker.discreteComponentRefs[idv].first,
+                        discreteCol[itime]);
             }
-        }
 
-        // Generate report results for the current state.
-        model.realizeReport(state);
-    }
+            // Evaluate the outputs for the current state.
+            localModel.getSystem().realize(state, realizationStage);
+            for (int ichan = 0; ichan < (int)worker.channels.size(); ++ichan) {
+                row[ichan] = worker.channels[ichan]->getValue(state);
+            }
+            report.appendRow(state.getTime(), row);
+        }
+    };
+    const auto finish = [&](int ichunk) {
+        appendChunk(chunks[ichunk]);
+        // Release the memory for this chunk.
+        chunks[ichunk] = TimeSeriesTable_<T>();
+    };
+    detail::processChunksInOrder(numChunks, numThreads, process, finish);
+}
 
-    return reporter->getTable();
+/// Calculate the requested outputs using the model in the problem and the
+/// provided states and controls tables.
+/// The controls table is used to set the model's controls vector.
+/// We assume the states and controls tables contain the same time points.
+/// The output paths can be regular expressions. For example,
+/// ".*activation" gives the activation of all muscles.
+///
+/// The output paths must correspond to outputs that match the type provided in
+/// the template argument, otherwise they are not included in the report.
+///
+/// Controls missing from the controls table are given a value of 0.
+///
+/// If you analysis depends on the values of discrete variables in the state,
+/// you may provide those values via the optional argument
+/// "discreteVariablesTable". This table should contain column labels with the
+/// following format: <path_to_component>/<discrete_var_name>. For example,
+/// "/forceset/muscle/implicitderiv_normalized_tendon_force".
+///
+/// Long trajectories can be analyzed on several threads with numThreads (0
+/// uses all processor cores); see analyzeInChunks(). Use analyzeToFile() to
+/// write the report to a file as it is computed instead of holding it in
+/// memory.
+///
+/// @note The provided trajectory is not modified to satisfy kinematic
+/// constraints, but SimTK::Motions in the Model (e.g., PositionMotion) are
+/// applied. Therefore, this function expects that you've provided a trajectory
+/// that already satisfies kinematic constraints. If your provided trajectory
+/// does not satisfy kinematic constraints, many outputs will be incorrect.
+/// For example, in a model with a patella whose location is determined by a
+/// CoordinateCouplerConstraint, the length of a muscle that crosses the patella
+/// will be incorrect.
+/// @ingroup simulationutil
+template <typename T>
+TimeSeriesTable_<T> analyze(Model model, const TimeSeriesTable& statesTable,
+        const TimeSeriesTable& controlsTable,
+        const std::vector<std::string>& outputPaths,
+        const TimeSeriesTable& discreteVariablesTable = {},
+        int numThreads = 1) {
+    TimeSeriesTable_<T> report;
+    analyzeInChunks<T>(std::move(model), statesTable, controlsTable,
+            outputPaths, discreteVariablesTable, numThreads,
+            [&](const TimeSeriesTable_<T>& chunk) {
+                if (report.getNumColumns() == 0 && report.getNumRows() == 0) {
+                    report.setColumnLabels(chunk.getColumnLabels());
+                }
+                const auto& times = chunk.getIndependentColumn();
+                for (int irow = 0; irow < (int)chunk.getNumRows(); ++irow) {
+                    report.appendRow(times[irow], chunk.getRowAtIndex(irow));
+                }
+            });
+    return report;
 }
 
+/// Calculate the requested outputs as analyze() does, and write the report
+/// to an STO file with STOFileAdapter_<T>, one chunk of rows at a time as
+/// they are computed, so that the report of a long trajectory need not fit
+/// in memory. T may be double, SimTK::Vec3, or SimTK::SpatialVec.
+/// @ingroup simulationutil
+template <typename T>
+OSIMSIMULATION_API void analyzeToFile(Model model,
+        const TimeSeriesTable& statesTable,
+        const TimeSeriesTable& controlsTable,
+        const std::vector<std::string>& outputPaths,
+        const std::string& fileName,
+        const TimeSeriesTable& discreteVariablesTable = {},
+        int numThreads = 1);
+
 /// Calculate "synthetic" acceleration signals equivalent to signals recorded
 /// from inertial measurement units (IMUs). First, this utility computes the
 /// linear acceleration for each frame included in 'framePaths' using Frame's
@@ -139,6 +139,13 @@ TimeSeriesTable StatesTrajectory::exportToTable(const Model& model,
     table.setColumnLabels(stateVars);
     size_t numDepColumns = stateVars.size();
 
+    // Resolve the requested state variables once rather than per row.
+    std::vector<Component::StateVariableHandle> handles;
+    handles.reserve(requestedStateVars.size());
+    for (const auto& stateVar : requestedStateVars) {
+        handles.push_back(model.getStateVariableHandle(stateVar));
+    }
+
     // Fill up the table with the data.
     for (size_t itime = 0; itime < getSize(); ++itime) {
         const auto& state = get(itime);
@@ -151,7 +158,7 @@ TimeSeriesTable StatesTrajectory::exportToTable(const Model& model,
         } else {
             for (unsigned icol = 0; icol < numDepColumns; ++icol) {
                 row[static_cast<int>(icol)] =
-                    model.getStateVariableValue(state, stateVars[icol]);
+                    model.getStateVariableValue(state, handles[icol]);
             }
         }
 
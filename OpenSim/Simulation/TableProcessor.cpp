@@ -0,0 +1,147 @@
+/* -------------------------------------------------------------------------- *
+ * OpenSim: TableProcessor.cpp                                                *
+ * -------------------------------------------------------------------------- *
+ * Copyright (c) 2019 Stanford University and the Authors                     *
+ *                                                                            *
+ * Author(s): Christopher Dembia, Nicholas Bianco, Prasanna Sritharan         *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0          *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "TableProcessor.h"
+
+#include <OpenSim/Common/CommonUtilities.h>
+#include <OpenSim/Common/IO.h>
+#include <OpenSim/Common/STOFileAdapter.h>
+
+#include <limits>
+
+using namespace OpenSim;
+
+namespace {
+MemoizationCache<TimeSeriesTable> memoizedTables;
+}
+
+void TableProcessor::setMemoizationEnabled(bool enabled) {
+    memoizedTables.setEnabled(enabled);
+}
+
+bool TableProcessor::getMemoizationEnabled() {
+    return memoizedTables.getEnabled();
+}
+
+void TableProcessor::setCacheDirectory(std::string directory) {
+    memoizedTables.setDirectory(std::move(directory));
+}
+
+std::string TableProcessor::getCacheDirectory() {
+    return memoizedTables.getDirectory();
+}
+
+void TableProcessor::clearMemoizedTables() { memoizedTables.clear(); }
+
+std::string TableProcessor::getSourcePath(
+        const std::string& relativeToDirectory) const {
+    OPENSIM_THROW_IF_FRMOBJ(get_filepath().empty() && !m_tableProvided,
+            Exception, "No source table.");
+    OPENSIM_THROW_IF_FRMOBJ(!get_filepath().empty() && m_tableProvided,
+            Exception,
+            "Expected either an in-memory table or a filepath, but "
+            "both were provided.");
+    if (m_tableProvided) return {};
+    std::string path = get_filepath();
+    if (!relativeToDirectory.empty()) {
+        using SimTK::Pathname;
+        path = Pathname::getAbsolutePathnameUsingSpecifiedWorkingDirectory(
+                relativeToDirectory, path);
+    }
+    return path;
+}
+
+std::string TableProcessor::computeHash(
+        const std::string& relativeToDirectory, const Model* model) const {
+    const std::string path = getSourcePath(relativeToDirectory);
+    ContentHash hash;
+    hash.update(getConcreteClassName());
+    if (m_tableProvided) {
+        for (const auto& key : m_table.getTableMetaDataKeys()) {
+            hash.update(key);
+            hash.update(m_table.getTableMetaDataAsString(key));
+        }
+        for (const auto& label : m_table.getColumnLabels()) {
+            hash.update(label);
+        }
+        for (const auto& time : m_table.getIndependentColumn()) {
+            hash.update(time);
+        }
+        const auto& matrix = m_table.getMatrix();
+        for (int j = 0; j < matrix.ncol(); ++j) {
+            for (int i = 0; i < matrix.nrow(); ++i) hash.update(matrix(i, j));
+        }
+    } else {
+        hash.update(path);
+        hash.updateWithFile(path);
+    }
+    for (int i = 0; i < getProperty_operators().size(); ++i) {
+        hash.update(get_operators(i).dump());
+    }
+    if (model) hash.update(model->getContentHash());
+    return hash.toString();
+}
+
+TimeSeriesTable TableProcessor::process(
+        std::string relativeToDirectory, const Model* model) const {
+    if (!memoizedTables.getEnabled()) {
+        return processWithoutMemoization(relativeToDirectory, model);
+    }
+    const std::string hash = computeHash(relativeToDirectory, model);
+    if (auto memoized = memoizedTables.find(hash)) {
+        log_debug("TableProcessor: using the memoized table {}.", hash);
+        return *memoized;
+    }
+
+    TimeSeriesTable table;
+    const std::string directory = memoizedTables.getDirectory();
+    const std::string cachePath =
+            directory.empty() ? "" : directory + "/" + hash + ".sto";
+    if (!cachePath.empty() && IO::FileExists(cachePath)) {
+        log_debug("TableProcessor: reading the cached table '{}'.", cachePath);
+        table = TimeSeriesTable(cachePath);
+    } else {
+        table = processWithoutMemoization(relativeToDirectory, model);
+        if (!cachePath.empty()) {
+            // Write every digit, so that the table read from the cache is
+            // identical to the table processed now.
+            writeFileAtomically(cachePath, [&](const std::string& path) {
+                STOFileAdapter::write(table, path,
+                        std::numeric_limits<double>::max_digits10);
+            });
+        }
+    }
+    memoizedTables.insert(hash, std::make_shared<const TimeSeriesTable>(table));
+    return table;
+}
+
+TimeSeriesTable TableProcessor::processWithoutMemoization(
+        const std::string& relativeToDirectory, const Model* model) const {
+    const std::string path = getSourcePath(relativeToDirectory);
+    TimeSeriesTable table;
+    if (m_tableProvided) {
+        table = m_table;
+    } else {
+        table = TimeSeriesTable(path);
+    }
+
+    for (int i = 0; i < getProperty_operators().size(); ++i) {
+        get_operators(i).operate(table, model);
+    }
+    return table;
+}
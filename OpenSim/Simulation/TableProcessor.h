@@ -79,32 +79,7 @@ public:
     contains such an operator, then the operator will throw an exception
     if you do not provide a model when invoking this function. */
     TimeSeriesTable process(std::string relativeToDirectory,
-            const Model* model = nullptr) const {
-        OPENSIM_THROW_IF_FRMOBJ(get_filepath().empty() && !m_tableProvided,
-                Exception, "No source table.");
-        OPENSIM_THROW_IF_FRMOBJ(!get_filepath().empty() && m_tableProvided,
-                Exception,
-                "Expected either an in-memory table or a filepath, but "
-                "both were provided.");
-        TimeSeriesTable table;
-        if (m_tableProvided) {
-            table = m_table;
-        } else {
-            std::string path = get_filepath();
-            if (!relativeToDirectory.empty()) {
-                using SimTK::Pathname;
-                path = Pathname::
-                        getAbsolutePathnameUsingSpecifiedWorkingDirectory(
-                                relativeToDirectory, path);
-            }
-            table = TimeSeriesTable(path);
-        }
-
-        for (int i = 0; i < getProperty_operators().size(); ++i) {
-            get_operators(i).operate(table, model);
-        }
-        return table;
-    }
+            const Model* model = nullptr) const;
     /** Same as above, but paths are evaluated with respect to the current
     working directory. */
     TimeSeriesTable process(const Model* model = nullptr) const {
@@ -154,7 +129,48 @@ public:
         return append(right);
     }
 
+    /// @name Memoization
+    /// When memoization is enabled, process() returns a copy of a table that
+    /// was processed earlier (by any TableProcessor) with the same inputs,
+    /// instead of reading and processing the source table again. The inputs
+    /// are identified by computeHash(). Memoization assumes that each
+    /// operator's result depends only on the operator's properties, the table,
+    /// and the model; files read by an operator are not hashed.
+    /// Only the result of the full sequence of operators is memoized; two
+    /// processors that share leading operators do not share the table produced
+    /// by those operators.
+    /// @{
+    /** Enable or disable memoization for all TableProcessor%s. Memoization is
+    disabled by default. */
+    static void setMemoizationEnabled(bool enabled);
+    static bool getMemoizationEnabled();
+    /** If not empty, processed tables are also written to this (existing)
+    directory, as `<hash>.sto` files, and process() reads the file for a hash
+    that is not in memory (e.g., in a later run) instead of processing the
+    source table. The files are written with 17 significant digits (so the
+    tables read from them are identical to the processed tables), each to a
+    temporary file that is then renamed, so that processes sharing the
+    directory never read a partially written file. The files are never
+    removed by OpenSim. This is empty by default. */
+    static void setCacheDirectory(std::string directory);
+    static std::string getCacheDirectory();
+    /** Remove all memoized tables from memory. */
+    static void clearMemoizedTables();
+    /** A hash of the source table (the contents of the file, if a filepath
+    is provided), the operators and their properties, and the model (if
+    provided; see Model::getContentHash()). Two calls to process() with the same hash produce the same
+    table. */
+    std::string computeHash(const std::string& relativeToDirectory,
+            const Model* model = nullptr) const;
+    /// @}
+
 private:
+    // Throw if the source table is missing, and obtain the absolute path to
+    // the source table (empty if the table was provided in memory).
+    std::string getSourcePath(const std::string& relativeToDirectory) const;
+    TimeSeriesTable processWithoutMemoization(
+            const std::string& relativeToDirectory, const Model* model) const;
+
     bool m_tableProvided = false;
     TimeSeriesTable m_table;
 };
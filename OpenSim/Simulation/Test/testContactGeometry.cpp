@@ -27,6 +27,8 @@
 //      1. Analytical contact sphere-plane geometry 
 //      2. Mesh-based sphere on analytical plane geometry
 //      3. Intermediate frames are handled correctly.
+//      4. MeshContactForce between a mesh sphere and a mesh cube, at rest
+//         and sliding with friction.
 //
 //==============================================================================
 #include <iostream>
@@ -44,6 +46,7 @@
 #include <OpenSim/Simulation/Model/ContactSphere.h>
 #include <OpenSim/Simulation/Model/ElasticFoundationForce.h>
 #include <OpenSim/Simulation/Model/HuntCrossleyForce.h>
+#include <OpenSim/Simulation/Model/MeshContactForce.h>
 #include <OpenSim/Simulation/Model/Model.h>
 #include <OpenSim/Simulation/Model/PhysicalOffsetFrame.h>
 #include <OpenSim/Simulation/SimbodyEngine/FreeJoint.h>
@@ -77,6 +80,7 @@ int testBallToBallContact(bool useElasticFoundation, bool useMesh1, bool useMesh
 void compareHertzAndMeshContactResults();
 template <typename ContactType> // e.g., HuntCrossley.
 void testIntermediateFrames();
+void testMeshContactForce();
 
 int main()
 {
@@ -97,6 +101,8 @@ int main()
 
         testIntermediateFrames<OpenSim::HuntCrossleyForce>();
         testIntermediateFrames<OpenSim::ElasticFoundationForce>();
+
+        testMeshContactForce();
     }
     catch (const OpenSim::Exception& e) {
         e.print(cerr);
@@ -595,20 +601,124 @@ void testIntermediateFrames() {
     SimTK_TEST_EQ_TOL(stateWeld.getY(), stateIntermedFrameXY.getY(), 1e-10);
 }
 
+void testMeshContactForce() {
+    cout << "Testing MeshContactForce" << endl;
+    const double stiffness = 1.0e6 / radius;
+    // The sphere penetrates the top of the cube by 5 mm.
+    const double penetration = 0.005;
+
+    auto createModel = [&](int numThreads) -> std::unique_ptr<Model> {
+        auto model = std::unique_ptr<Model>(new Model());
+        model->setGravity(Vec3(0));
+        auto* ball = new OpenSim::Body("ball", mass, Vec3(0), Inertia(1.0));
+        model->addBody(ball);
+        model->addJoint(new FreeJoint("free", model->getGround(), Vec3(0),
+                Vec3(0), *ball, Vec3(0), Vec3(0)));
+        // The top face of the cube is at y = 0.
+        auto* cube = new ContactMesh("cube.obj", Vec3(0, -0.5, 0), Vec3(0),
+                model->getGround(), "cube");
+        auto* sphere = new ContactMesh(
+                mesh_files[0], Vec3(0), Vec3(0), *ball, "sphere");
+        model->addContactGeometry(cube);
+        model->addContactGeometry(sphere);
+        auto* force = new MeshContactForce("contact", *sphere, *cube);
+        force->set_stiffness(stiffness);
+        force->set_num_threads(numThreads);
+        model->addForce(force);
+        model->finalizeConnections();
+        return model;
+    };
 
+    // Every triangle of the sphere whose centroid is below the top of the
+    // cube pushes the ball up in proportion to the depth of its centroid.
+    double expectedForce = 0;
+    int expectedNumContacts = 0;
+    {
+        SimTK::PolygonalMesh mesh;
+        mesh.loadFile(mesh_files[0]);
+        const SimTK::ContactGeometry::TriangleMesh triangles(mesh);
+        for (int f = 0; f < triangles.getNumFaces(); ++f) {
+            const double y = triangles.getFaceCentroid(f)[1] + radius -
+                             penetration;
+            if (y < 0) {
+                expectedForce += stiffness * triangles.getFaceArea(f) * -y;
+                ++expectedNumContacts;
+            }
+        }
+    }
+    ASSERT(expectedNumContacts > 0);
+
+    SimTK::SpatialVec serialForce;
+    for (int numThreads : {1, 2}) {
+        auto model = createModel(numThreads);
+        SimTK::State& state = model->initSystem();
+        state.updQ()[4] = radius - penetration;
+        model->realizeDynamics(state);
+
+        const auto& force = model->getComponent<MeshContactForce>("/forceset/contact");
+        ASSERT(force.getNumContacts(state) == expectedNumContacts);
+        const SimTK::SpatialVec ballForce = force.getTargetMeshForce(state);
+        ASSERT_EQUAL(ballForce[1][1], expectedForce, 1e-10 * expectedForce);
+        ASSERT_EQUAL(ballForce[1][0], 0.0, 1e-6 * expectedForce);
+        ASSERT_EQUAL(ballForce[1][2], 0.0, 1e-6 * expectedForce);
+        if (numThreads == 1) {
+            serialForce = ballForce;
+        } else {
+            // The threads only change the order in which forces are summed.
+            for (int i = 0; i < 2; ++i) {
+                for (int k = 0; k < 3; ++k) {
+                    ASSERT_EQUAL(ballForce[i][k], serialForce[i][k],
+                            1e-12 * expectedForce);
+                }
+            }
+        }
 
+        // No force when the sphere is above the cube.
+        state.updQ()[4] = radius + 0.01;
+        model->realizeDynamics(state);
+        ASSERT(force.getNumContacts(state) == 0);
+        ASSERT_EQUAL(force.getTargetMeshForce(state)[1].norm(), 0.0, 1e-15);
+    }
 
+    // A sphere sliding along the top of the cube: the friction on each
+    // triangle follows the law of HuntCrossleyForce, and the slip velocity is
+    // the same for every triangle, so the total friction is the total normal
+    // force times the effective coefficient of friction.
+    {
+        const double staticFriction = 0.8;
+        const double dynamicFriction = 0.5;
+        const double viscousFriction = 0.1;
+        const double transitionVelocity = 0.01;
+        auto model = createModel(1);
+        auto& force = model->updComponent<MeshContactForce>(
+                "/forceset/contact");
+        force.set_static_friction(staticFriction);
+        force.set_dynamic_friction(dynamicFriction);
+        force.set_viscous_friction(viscousFriction);
+        force.set_transition_velocity(transitionVelocity);
+        SimTK::State& state = model->initSystem();
+        state.updQ()[4] = radius - penetration;
+        // Slower and faster than the transition velocity.
+        for (double slipSpeed : {0.004, 0.2}) {
+            state.updU()[3] = slipSpeed;
+            model->realizeDynamics(state);
+            const double vrel = slipSpeed / transitionVelocity;
+            const double mu = std::min(vrel, 1.0) *
+                                      (dynamicFriction +
+                                              2 * (staticFriction -
+                                                          dynamicFriction) /
+                                                      (1 + vrel * vrel)) +
+                              viscousFriction * slipSpeed;
+            const SimTK::SpatialVec ballForce =
+                    force.getTargetMeshForce(state);
+            ASSERT_EQUAL(ballForce[1][1], expectedForce, 1e-10 * expectedForce);
+            ASSERT_EQUAL(ballForce[1][0], -mu * expectedForce,
+                    1e-6 * expectedForce);
+            ASSERT_EQUAL(ballForce[1][2], 0.0, 1e-6 * expectedForce);
+        }
+    }
 
-
-
-
-
-
-
-
-
-
-
-
-
-
+    // The number of threads cannot be negative.
+    auto model = createModel(-1);
+    ASSERT_THROW(InvalidPropertyValue, model->initSystem());
+}
@@ -0,0 +1,176 @@
+/* -------------------------------------------------------------------------- *
+ *                    OpenSim: testEnsembleSimulation.cpp                     *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include <OpenSim/Actuators/ModelFactory.h>
+#include <OpenSim/Simulation/Manager/EnsembleSimulation.h>
+#include <OpenSim/Simulation/StatesTrajectory.h>
+
+using namespace OpenSim;
+
+namespace {
+const std::string position = "/slider/position/value";
+const std::string speed = "/slider/position/speed";
+
+// The position of the sliding mass at time t under a constant force.
+double calcPosition(double x0, double v0, double force, double mass, double t) {
+    return x0 + v0 * t + 0.5 * force / mass * t * t;
+}
+}
+
+void testMembers() {
+    EnsembleSimulation ensemble(ModelFactory::createSlidingPointMass());
+    ensemble.setFinalTime(1.0);
+    ensemble.setReportInterval(0.1);
+    ensemble.setIntegratorAccuracy(1e-10);
+    ensemble.addOutput("/slider/position|value");
+    ensemble.addOutput("/slider/position|speed");
+    SimTK_TEST_MUST_THROW_EXC(ensemble.addOutput("/body"), Exception);
+    // Members are simulated in order on one thread, so the member after the
+    // member with a different mass reuses the same model.
+    ensemble.setNumThreads(1);
+
+    EnsembleMember member;
+    ensemble.addMember(member);
+    member.setStateVariableValue(position, 0.5)
+          .setStateVariableValue(speed, -1.0);
+    ensemble.addMember(member);
+    EnsembleMember force;
+    force.setActuatorOverride("/forceset/actuator", 3.0);
+    ensemble.addMember(force);
+    force.setModelPropertyValue("/body", "mass", 2.0);
+    ensemble.addMember(force);
+    // The mass is restored for the next member.
+    EnsembleMember restored;
+    restored.setActuatorOverride("/forceset/actuator", 3.0);
+    ensemble.addMember(restored);
+    SimTK_TEST(ensemble.getNumMembers() == 5);
+
+    const auto results = ensemble.run();
+    SimTK_TEST(results.size() == 5);
+    const double expected[5] = {calcPosition(0, 0, 0, 1, 1),
+            calcPosition(0.5, -1.0, 0, 1, 1), calcPosition(0, 0, 3.0, 1, 1),
+            calcPosition(0, 0, 3.0, 2.0, 1), calcPosition(0, 0, 3.0, 1, 1)};
+    for (int i = 0; i < 5; ++i) {
+        const auto& result = results[i];
+        SimTK_TEST(result.success);
+        SimTK_TEST(!result.cancelled);
+        SimTK_TEST(result.message.empty());
+        SimTK_TEST_EQ(result.finalTime, 1.0);
+        SimTK_TEST(result.outputValues.size() == 2);
+        SimTK_TEST_EQ_TOL(result.outputValues[0], expected[i], 1e-8);
+
+        // The states at the initial time and at each report time.
+        const auto& states = result.states;
+        SimTK_TEST(states.getNumRows() == 11);
+        SimTK_TEST_EQ_TOL(states.getIndependentColumn()[3], 0.3, 1e-12);
+        SimTK_TEST_EQ_TOL(states.getDependentColumn(position)[10],
+                expected[i], 1e-8);
+        SimTK_TEST_EQ(states.getDependentColumn(speed)[10],
+                result.outputValues[1]);
+    }
+    SimTK_TEST_EQ(results[1].states.getDependentColumn(position)[0], 0.5);
+
+    // The states table can be converted to a StatesTrajectory.
+    Model model = ModelFactory::createSlidingPointMass();
+    model.initSystem();
+    const auto trajectory = StatesTrajectory::createFromStatesTable(
+            model, results[2].states);
+    SimTK_TEST(trajectory.getSize() == 11);
+}
+
+void testThreadsAndHandler() {
+    EnsembleSimulation ensemble(ModelFactory::createSlidingPointMass());
+    ensemble.setFinalTime(0.5);
+    ensemble.setRecordStates(false);
+    ensemble.addOutput("/slider/position|value");
+    const int numMembers = 20;
+    for (int i = 0; i < numMembers; ++i) {
+        EnsembleMember member;
+        member.setStateVariableValue(speed, 0.1 * i);
+        if (i % 3 == 0) member.setModelPropertyValue("/body", "mass", 1.0 + i);
+        member.setActuatorOverride("/forceset/actuator", 1.0);
+        ensemble.addMember(member);
+    }
+    ensemble.setNumThreads(4);
+
+    std::vector<int> order;
+    ensemble.run([&](int imember, EnsembleResult& result) {
+        order.push_back(imember);
+        SimTK_TEST(result.success);
+        SimTK_TEST(result.states.getNumRows() == 0);
+        const double mass = imember % 3 == 0 ? 1.0 + imember : 1.0;
+        SimTK_TEST_EQ_TOL(result.outputValues[0],
+                calcPosition(0, 0.1 * imember, 1.0, mass, 0.5), 1e-6);
+    });
+    SimTK_TEST(order.size() == (size_t)numMembers);
+    for (int i = 0; i < numMembers; ++i) SimTK_TEST(order[i] == i);
+
+    // An exception from the handler stops the ensemble.
+    SimTK_TEST_MUST_THROW_EXC(
+            ensemble.run([](int imember, EnsembleResult&) {
+                if (imember == 2) OPENSIM_THROW(Exception, "Stop.");
+            }),
+            Exception);
+}
+
+void testCancelAndFailure() {
+    EnsembleSimulation ensemble(ModelFactory::createSlidingPointMass());
+    ensemble.setFinalTime(2.0);
+    ensemble.setReportInterval(0.1);
+    ensemble.setNumThreads(2);
+    // Stop members that move further than 1.2 m.
+    ensemble.setCancelCondition([](int, const SimTK::State& state) {
+        return std::abs(state.getQ()[0]) > 1.2;
+    });
+    EnsembleMember slow;
+    slow.setStateVariableValue(speed, 0.2);
+    ensemble.addMember(slow);
+    EnsembleMember fast;
+    fast.setStateVariableValue(speed, 5.0);
+    ensemble.addMember(fast);
+    EnsembleMember invalid;
+    invalid.setModelPropertyValue("/body", "not_a_property", 1.0);
+    ensemble.addMember(invalid);
+
+    const auto results = ensemble.run();
+    SimTK_TEST(results[0].success);
+    SimTK_TEST(!results[0].cancelled);
+    SimTK_TEST_EQ(results[0].finalTime, 2.0);
+    SimTK_TEST(results[1].success);
+    SimTK_TEST(results[1].cancelled);
+    SimTK_TEST_EQ_TOL(results[1].finalTime, 0.3, 1e-12);
+    SimTK_TEST(results[1].states.getNumRows() == 4);
+    SimTK_TEST(!results[2].success);
+    SimTK_TEST(results[2].message.find("not_a_property") != std::string::npos);
+
+    SimTK_TEST_MUST_THROW_EXC(ensemble.setReportInterval(0), Exception);
+    SimTK_TEST_MUST_THROW_EXC(ensemble.setNumThreads(-1), Exception);
+    SimTK_TEST_MUST_THROW_EXC(ensemble.setIntegratorAccuracy(-1), Exception);
+}
+
+int main() {
+    SimTK_START_TEST("testEnsembleSimulation");
+        SimTK_SUBTEST(testMembers);
+        SimTK_SUBTEST(testThreadsAndHandler);
+        SimTK_SUBTEST(testCancelAndFailure);
+    SimTK_END_TEST();
+}
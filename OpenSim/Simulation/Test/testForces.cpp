@@ -66,6 +66,7 @@ void testExpressionBasedBushingForceRotational();
 void testElasticFoundation();
 void testHuntCrossleyForce();
 void testSmoothSphereHalfSpaceForce();
+void testSmoothSphereHalfSpaceForceCulling();
 void testCoordinateLimitForce();
 void testCoordinateLimitForceRotational();
 void testExpressionBasedPointToPointForce();
@@ -138,6 +139,12 @@ int main() {
         failures.push_back("testSmoothSphereHalfSpaceForce");
     }
 
+    try { testSmoothSphereHalfSpaceForceCulling(); }
+    catch (const std::exception& e){
+        cout << e.what() <<endl;
+        failures.push_back("testSmoothSphereHalfSpaceForceCulling");
+    }
+
     try { testCoordinateLimitForce(); }
     catch (const std::exception& e){
         cout << e.what() <<endl; failures.push_back("testCoordinateLimitForce");
@@ -1420,6 +1427,82 @@ void testSmoothSphereHalfSpaceForce()
     ASSERT(isEqual);
 }
 
+// With a positive culling_tolerance, the force is computed by OpenSim and is
+// skipped when the ball is far from the floor; the forces must agree with
+// SimTK::SmoothSphereHalfSpaceForce.
+void testSmoothSphereHalfSpaceForceCulling()
+{
+    using namespace SimTK;
+
+    Model exactModel{"BouncingBall_SmoothSphereHalfSpace.osim"};
+    Model cullingModel{"BouncingBall_SmoothSphereHalfSpace.osim"};
+    auto& culling = cullingModel.updComponent<
+            OpenSim::SmoothSphereHalfSpaceForce>("forceset/contact");
+    culling.set_culling_tolerance(1e-8);
+
+    State& exactState = exactModel.initSystem();
+    State& cullingState = cullingModel.initSystem();
+    const auto& exact = exactModel.getComponent<
+            OpenSim::SmoothSphereHalfSpaceForce>("forceset/contact");
+
+    // The radius of the ball is 0.5 m: far from the floor, resting in the
+    // floor with 5 mm of indentation, and at the surface of the floor.
+    for (double height : {1.5, 0.495, 0.5}) {
+        exactModel.getCoordinateSet()[4].setValue(exactState, height);
+        cullingModel.getCoordinateSet()[4].setValue(cullingState, height);
+        exactModel.realizeDynamics(exactState);
+        cullingModel.realizeDynamics(cullingState);
+        Array<double> exactForce = exact.getRecordValues(exactState);
+        Array<double> cullingForce = culling.getRecordValues(cullingState);
+        for (int i = 0; i < exactForce.getSize(); ++i) {
+            ASSERT_EQUAL(cullingForce[i], exactForce[i],
+                    1e-6 * (1 + std::abs(exactForce[i])));
+        }
+    }
+
+    // Moving into the floor while sliding along it, so that the dissipation
+    // and friction terms contribute.
+    for (Model* model : {&exactModel, &cullingModel}) {
+        State& state = model == &exactModel ? exactState : cullingState;
+        model->getCoordinateSet()[4].setValue(state, 0.495);
+        model->getCoordinateSet()[3].setSpeedValue(state, 0.2);
+        model->getCoordinateSet()[4].setSpeedValue(state, -0.1);
+        model->getCoordinateSet()[5].setSpeedValue(state, -0.05);
+        model->realizeDynamics(state);
+    }
+    Array<double> exactForce = exact.getRecordValues(exactState);
+    Array<double> cullingForce = culling.getRecordValues(cullingState);
+    // The friction force opposes the sliding velocity.
+    ASSERT(exactForce[0] < 0 && exactForce[2] > 0);
+    for (int i = 0; i < exactForce.getSize(); ++i) {
+        ASSERT_EQUAL(cullingForce[i], exactForce[i],
+                1e-6 * (1 + std::abs(exactForce[i])));
+    }
+    for (Model* model : {&exactModel, &cullingModel}) {
+        State& state = model == &exactModel ? exactState : cullingState;
+        for (int i = 3; i < 6; ++i) {
+            model->getCoordinateSet()[i].setSpeedValue(state, 0);
+        }
+    }
+
+    // The ball settles to rest on the floor.
+    const double mass = cullingModel.getBodySet().get("ball").getMass();
+    cullingModel.getCoordinateSet()[4].setValue(cullingState, 0.5);
+    Manager manager(cullingModel);
+    manager.setIntegratorAccuracy(1e-6);
+    cullingState.setTime(0.0);
+    manager.initialize(cullingState);
+    cullingState = manager.integrate(2.0);
+    cullingModel.realizeDynamics(cullingState);
+    Array<double> contactForce = culling.getRecordValues(cullingState);
+    ASSERT_EQUAL(contactForce[0], 0.0, 1e-4);
+    ASSERT_EQUAL(contactForce[1], -mass * gravity_vec[1], 1e-3);
+    ASSERT_EQUAL(contactForce[2], 0.0, 1e-4);
+
+    culling.set_culling_tolerance(0.5);
+    ASSERT_THROW(InvalidPropertyValue, cullingModel.initSystem());
+}
+
 void testCoordinateLimitForce() {
     using namespace SimTK;
 
@@ -82,6 +82,9 @@ void testUpdateMarkerWeights();
 // Verify that the track() solution is also effected by updating marker
 // weights and marker error is being reduced as its weighting increases.
 void testTrackWithUpdateMarkerWeights();
+// Verify that trackWithinBudget() tracks the motion, adapts its accuracy to
+// the time budget, and reports frame statistics.
+void testTrackWithinBudget();
 
 // Verify that solver does not confuse/mismanage markers when reference
 // has more markers than the model, order is changed or marker reference
@@ -118,6 +121,11 @@ int main()
         cout << e.what() << endl;
         failures.push_back("testTrackWithUpdateMarkerWeights");
     }
+    try { testTrackWithinBudget(); }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testTrackWithinBudget");
+    }
 
     try { testNumberOfMarkersMismatch(); }
     catch (const std::exception& e) {
@@ -576,6 +584,82 @@ void testTrackWithUpdateMarkerWeights()
     }
 }
 
+void testTrackWithinBudget()
+{
+    cout << "\ntestInverseKinematicsSolver::testTrackWithinBudget()" << endl;
+    std::unique_ptr<Model> pendulum{ constructPendulumWithMarkers() };
+    Coordinate& coord = pendulum->getCoordinateSet()[0];
+
+    SimTK::State state = pendulum->initSystem();
+
+    StatesTrajectory states;
+    double dt = 0.01;
+    auto calcAngle = [](double time) { return 0.5 * std::sin(2 * time); };
+    for (int i = 0; i < 101; ++i) {
+        state.updTime() = i*dt;
+        coord.setValue(state, calcAngle(state.getTime()));
+        states.append(state);
+    }
+
+    SimTK::RowVector_<SimTK::Vec3> biases(3, SimTK::Vec3(0));
+    std::shared_ptr<MarkersReference> markersRef(
+            new MarkersReference(generateMarkerDataFromModelAndStates(
+                    *pendulum, states, biases, 0.0),
+                    Set<MarkerWeight>()));
+
+    SimTK::Array_<CoordinateReference> coordRefs;
+    coord.setValue(state, 0.0);
+    state.updTime() = 0;
+    InverseKinematicsSolver ikSolver(*pendulum, markersRef, coordRefs);
+    ikSolver.setAccuracy(1e-6);
+    ikSolver.assemble(state);
+
+    // Without a budget, the accuracy is not changed.
+    for (int i = 1; i < 50; ++i) {
+        state.updTime() = i*dt;
+        TrackingFrameReport report = ikSolver.trackWithinBudget(state);
+        SimTK_ASSERT_ALWAYS(report.withinBudget && report.accuracy == 1e-6,
+                "trackWithinBudget() changed the accuracy without a budget.");
+        SimTK_ASSERT_ALWAYS(SimTK::isFinite(report.goal) &&
+                            SimTK::isFinite(report.errorNorm),
+                "trackWithinBudget() did not report the achieved error.");
+        SimTK_ASSERT_ALWAYS(
+                abs(calcAngle(state.getTime()) - coord.getValue(state)) < 1e-4,
+                "trackWithinBudget() failed to track the motion.");
+    }
+    SimTK_ASSERT_ALWAYS(ikSolver.getNumFramesOverBudget() == 0,
+            "Expected no frames over budget.");
+    const double p50 = ikSolver.getFrameDurationPercentile(0.5);
+    const double p99 = ikSolver.getFrameDurationPercentile(0.99);
+    cout << "frame duration p50: " << p50 << " s, p99: " << p99 << " s"
+         << endl;
+    SimTK_ASSERT_ALWAYS(0 < p50 && p50 <= p99,
+            "Unexpected frame duration percentiles.");
+
+    // With an impossible budget, the accuracy is loosened to the limit, but
+    // the solver still tracks the motion approximately.
+    ikSolver.resetFrameStatistics();
+    SimTK_ASSERT_ALWAYS(
+            SimTK::isNaN(ikSolver.getFrameDurationPercentile(0.5)),
+            "Expected no frame durations after reset.");
+    ikSolver.setTimeBudget(1e-12);
+    ikSolver.setLoosestAccuracy(1e-2);
+    TrackingFrameReport report;
+    for (int i = 50; i < 101; ++i) {
+        state.updTime() = i*dt;
+        report = ikSolver.trackWithinBudget(state);
+        SimTK_ASSERT_ALWAYS(!report.withinBudget,
+                "Expected frame to exceed the budget.");
+        SimTK_ASSERT_ALWAYS(
+                abs(calcAngle(state.getTime()) - coord.getValue(state)) < 0.05,
+                "trackWithinBudget() failed to track the motion.");
+    }
+    SimTK_ASSERT_ALWAYS(report.accuracy == 1e-2,
+            "Expected the accuracy to be loosened to the limit.");
+    SimTK_ASSERT_ALWAYS(ikSolver.getNumFramesOverBudget() == 51,
+            "Expected all frames to be over budget.");
+}
+
 void testNumberOfMarkersMismatch()
 {
     cout << 
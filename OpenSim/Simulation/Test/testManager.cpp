@@ -37,6 +37,8 @@ Manager Tests:
 4. testConstructors: Ensure different constructors work as intended.
 5. testIntegratorInterface: Ensure setting integrator options works as intended.
 6. testExceptions: Test that misuse actually triggers exceptions.
+7. testRealTimeStepping: Advance a falling ball with fixed steps and check
+   the positions and the step timing statistics.
 
 //=============================================================================*/
 #include <OpenSim/Simulation/Model/Model.h>
@@ -56,6 +58,7 @@ void testExcitationUpdatesWithManager();
 void testConstructors();
 void testIntegratorInterface();
 void testExceptions();
+void testRealTimeStepping();
 
 int main()
 {
@@ -97,6 +100,12 @@ int main()
         failures.push_back("testExceptions");
     }
 
+    try { testRealTimeStepping(); }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testRealTimeStepping");
+    }
+
     if (!failures.empty()) {
         cout << "Done, with failure(s): " << failures << endl;
         return 1;
@@ -478,3 +487,88 @@ void testExceptions()
     manager.setIntegratorAccuracy(1e-4);
     manager.setIntegratorMinimumStepSize(0.01);
 }
+
+void testRealTimeStepping()
+{
+    cout << "Running testRealTimeStepping" << endl;
+
+    using SimTK::Vec3;
+
+    Model model;
+    model.setName("ball");
+    auto ball = new Body("ball", 0.7, Vec3(0.1),
+        SimTK::Inertia::sphere(0.5));
+    model.addBody(ball);
+    auto freeJoint = new FreeJoint("freeJoint", model.getGround(), Vec3(0),
+        Vec3(0), *ball, Vec3(0), Vec3(0));
+    model.addJoint(freeJoint);
+    const double g = 9.81;
+    model.setGravity(Vec3(0, -g, 0));
+
+    SimTK::State& state = model.initSystem();
+    const Coordinate& height =
+        freeJoint->getCoordinate(FreeJoint::Coord::TranslationY);
+    height.setValue(state, 2.0);
+
+    const double h = 0.001;
+    const int numSteps = 1000;
+    for (const auto method : {Manager::RealTimeMethod::ExplicitEuler,
+            Manager::RealTimeMethod::SemiExplicitEuler}) {
+        Manager manager(model);
+        // Misuse.
+        ASSERT_THROW(Exception, manager.step());
+        ASSERT_THROW(Exception, manager.initializeRealTime(state, 0));
+
+        manager.initializeRealTime(state, h, method);
+        ASSERT_EQUAL(h, manager.getRealTimeStepSize(), 0.0);
+        ASSERT_EQUAL(h, manager.getRealTimeDeadline(), 0.0);
+        ASSERT_THROW(Exception, manager.initialize(state));
+        ASSERT_THROW(Exception, manager.initializeRealTime(state, h));
+        ASSERT_THROW(Exception, manager.integrate(1.0));
+
+        for (int n = 1; n <= numSteps; ++n) {
+            const SimTK::State& s = manager.step();
+            SimTK_TEST(&s == &manager.getState());
+            SimTK_TEST_EQ(s.getTime(), n * h);
+            // The speed after k steps is -g k h. The explicit method moves
+            // with the speed at the start of each step (k = 0, ..., n - 1);
+            // the semi-explicit method moves with the speed at the end of
+            // each step (k = 1, ..., n).
+            const int offset =
+                method == Manager::RealTimeMethod::ExplicitEuler ? -1 : 1;
+            SimTK_TEST_EQ_TOL(height.getSpeedValue(s), -g * n * h, 1e-10);
+            SimTK_TEST_EQ_TOL(height.getValue(s),
+                2.0 - 0.5 * g * h * h * n * (n + offset), 1e-10);
+        }
+
+        // Timing statistics.
+        SimTK_TEST(manager.getNumRealTimeSteps() == numSteps);
+        SimTK_TEST(manager.getMaxRealTimeStepDuration() > 0);
+        const auto& histogram = manager.getRealTimeHistogram();
+        SimTK_TEST(histogram.size() == 20);
+        int numCounted = 0;
+        for (const int count : histogram) numCounted += count;
+        SimTK_TEST(numCounted == numSteps);
+        SimTK_TEST_EQ(manager.getRealTimeHistogramBinWidth(), h / 10);
+        SimTK_TEST(manager.getRealTimeOverrun() ==
+                   (manager.getNumRealTimeOverruns() > 0));
+
+        // Every step overruns a deadline that cannot be met.
+        manager.setRealTimeDeadline(1e-15);
+        SimTK_TEST(manager.getNumRealTimeSteps() == 0);
+        manager.clearRealTimeOverrun();
+        SimTK_TEST(!manager.getRealTimeOverrun());
+        manager.step();
+        manager.step();
+        SimTK_TEST(manager.getRealTimeOverrun());
+        SimTK_TEST(manager.getNumRealTimeOverruns() == 2);
+        SimTK_TEST(manager.getRealTimeHistogram().back() == 2);
+        SimTK_TEST_EQ(manager.getState().getTime(), (numSteps + 2) * h);
+        ASSERT_THROW(Exception, manager.setRealTimeDeadline(0));
+
+        manager.resetRealTimeStatistics();
+        SimTK_TEST(manager.getNumRealTimeSteps() == 0);
+        SimTK_TEST(manager.getNumRealTimeOverruns() == 0);
+        SimTK_TEST(manager.getMaxRealTimeStepDuration() == 0);
+    }
+}
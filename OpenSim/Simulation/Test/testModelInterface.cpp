@@ -35,6 +35,7 @@ using namespace std;
 void testModelFinalizePropertiesAndConnections();
 void testModelTopologyErrors();
 void testDoesNotSegfaultWithUnusualConnections();
+void testLoadFromFileCached();
 
 int main() {
     LoadOpenSimLibrary("osimActuators");
@@ -43,6 +44,7 @@ int main() {
         SimTK_SUBTEST(testModelFinalizePropertiesAndConnections);
         SimTK_SUBTEST(testModelTopologyErrors);
         SimTK_SUBTEST(testDoesNotSegfaultWithUnusualConnections);
+        SimTK_SUBTEST(testLoadFromFileCached);
     SimTK_END_TEST();
 }
 
@@ -262,3 +264,38 @@ void testDoesNotSegfaultWithUnusualConnections()
         // a runtime exception (for now... ;))
     }
 }
+
+void testLoadFromFileCached()
+{
+    // Work on a copy of the model file, since the test modifies it.
+    const std::string fileName = "arm26_loadFromFileCached.osim";
+    Model original("arm26.osim");
+    original.print(fileName);
+
+    std::unique_ptr<Model> first(Model::loadFromFileCached(fileName));
+    std::unique_ptr<Model> second(Model::loadFromFileCached(fileName));
+    SimTK_TEST(first.get() != second.get());
+    SimTK_TEST(*first == *second);
+    SimTK_TEST(first->getInputFileName() == fileName);
+
+    // The copies are independent of each other and of the prototype.
+    first->setName("edited");
+    std::unique_ptr<Model> third(Model::loadFromFileCached(fileName));
+    SimTK_TEST(third->getName() == original.getName());
+    third->initSystem();
+
+    // Changes to the file are picked up, even if they are made within the
+    // resolution of the file's modification time.
+    original.setName("arm26_renamed");
+    original.print(fileName);
+    std::unique_ptr<Model> fourth(Model::loadFromFileCached(fileName));
+    SimTK_TEST(fourth->getName() == "arm26_renamed");
+
+    Model::clearModelFileCache();
+    std::unique_ptr<Model> fifth(Model::loadFromFileCached(fileName));
+    SimTK_TEST(fifth->getName() == "arm26_renamed");
+
+    SimTK_TEST_MUST_THROW_EXC(
+            Model::loadFromFileCached("no_such_model_file.osim"),
+            OpenSim::Exception);
+}
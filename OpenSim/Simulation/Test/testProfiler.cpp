@@ -0,0 +1,217 @@
+/* -------------------------------------------------------------------------- *
+ *                         OpenSim: testProfiler.cpp                          *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include <OpenSim/Common/Constant.h>
+#include <OpenSim/Common/Profiler.h>
+#include <OpenSim/Simulation/Control/PrescribedController.h>
+#include <OpenSim/Simulation/Manager/Manager.h>
+#include <OpenSim/Simulation/Model/Model.h>
+
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+using namespace OpenSim;
+
+namespace {
+const Profiler::Entry* findEntry(const std::vector<Profiler::Entry>& entries,
+        const std::string& name, const std::string& label) {
+    for (const auto& entry : entries) {
+        if ((entry.type == name || entry.path == name) &&
+                entry.label == label) {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+void simulate(Model& model, double finalTime) {
+    SimTK::State& state = model.initSystem();
+    Manager manager(model);
+    manager.initialize(state);
+    manager.integrate(finalTime);
+}
+
+std::string readFile(const std::string& fileName) {
+    std::ifstream stream(fileName);
+    std::stringstream contents;
+    contents << stream.rdbuf();
+    return contents.str();
+}
+}
+
+void testDisabled() {
+    Profiler::reset();
+    SimTK_TEST(!Profiler::isEnabled());
+    Model model("arm26.osim");
+    simulate(model, 0.01);
+    SimTK_TEST(Profiler::getInstanceEntries().empty());
+    SimTK_TEST(Profiler::getTypeEntries().empty());
+}
+
+void testEntries() {
+    Model model("arm26.osim");
+    auto* controller = new PrescribedController();
+    controller->setName("controller");
+    controller->addActuator(model.getMuscles().get("BIClong"));
+    controller->prescribeControlForActuator("BIClong", new Constant(0.5));
+    model.addController(controller);
+    model.finalizeConnections();
+
+    Profiler::reset();
+    Profiler::setEnabled(true);
+    simulate(model, 0.01);
+    Profiler::setEnabled(false);
+
+    const auto types = Profiler::getTypeEntries();
+    const auto instances = Profiler::getInstanceEntries();
+    for (const auto& label : {"computeForce", "calcMuscleLengthInfo",
+                 "calcFiberVelocityInfo", "calcMuscleDynamicsInfo"}) {
+        const auto* type = findEntry(types, "Thelen2003Muscle", label);
+        SimTK_TEST(type != nullptr);
+        const auto* instance = findEntry(instances, "/forceset/TRIlong", label);
+        SimTK_TEST(instance != nullptr);
+        SimTK_TEST(instance->type == "Thelen2003Muscle");
+        SimTK_TEST(instance->numCalls > 0);
+        // The type entry sums the entries of the 6 muscles.
+        SimTK_TEST(type->numCalls > instance->numCalls);
+    }
+    SimTK_TEST(findEntry(types, "GeometryPath", "computePath") != nullptr);
+    SimTK_TEST(findEntry(types, "Model", "realizeTopology") != nullptr);
+    SimTK_TEST(findEntry(types, "Thelen2003Muscle", "realizeAcceleration") !=
+               nullptr);
+    const auto* controls =
+            findEntry(instances, "/controllerset/controller", "computeControls");
+    SimTK_TEST(controls != nullptr);
+    SimTK_TEST(controls->type == "PrescribedController");
+
+    double previousTime = SimTK::Infinity;
+    for (const auto& entry : instances) {
+        SimTK_TEST(entry.exclusiveTime >= 0);
+        SimTK_TEST(entry.inclusiveTime >= entry.exclusiveTime);
+        // Sorted by decreasing exclusive time.
+        SimTK_TEST(entry.exclusiveTime <= previousTime);
+        previousTime = entry.exclusiveTime;
+    }
+
+    // Recording stops when the profiler is disabled.
+    const long long numCalls =
+            findEntry(Profiler::getInstanceEntries(), "/forceset/TRIlong",
+                    "computeForce")->numCalls;
+    simulate(model, 0.01);
+    SimTK_TEST(findEntry(Profiler::getInstanceEntries(), "/forceset/TRIlong",
+                       "computeForce")->numCalls == numCalls);
+
+    std::stringstream summary;
+    Profiler::printSummary(summary);
+    SimTK_TEST(summary.str().find("/forceset/TRIlong computeForce") !=
+               std::string::npos);
+
+    Profiler::reset();
+    SimTK_TEST(Profiler::getInstanceEntries().empty());
+}
+
+void testExport() {
+    Model model("arm26.osim");
+    Profiler::reset();
+    Profiler::setEnabled(true);
+    simulate(model, 0.01);
+    Profiler::setEnabled(false);
+
+    // The muscles compute their paths while computing their forces or
+    // lengths.
+    Profiler::printFlameGraph("testProfiler_flamegraph.txt");
+    std::ifstream folded("testProfiler_flamegraph.txt");
+    std::string line;
+    bool foundNestedPath = false;
+    while (std::getline(folded, line)) {
+        // Each line ends with a number of microseconds.
+        SimTK_TEST(std::stoll(line.substr(line.rfind(' ') + 1)) > 0);
+        if (line.find("(Thelen2003Muscle);") != std::string::npos &&
+                line.find("computePath (GeometryPath) ") !=
+                        std::string::npos) {
+            foundNestedPath = true;
+        }
+    }
+    SimTK_TEST(foundNestedPath);
+
+    Profiler::printChromeTrace("testProfiler_trace.json");
+    const std::string trace = readFile("testProfiler_trace.json");
+    SimTK_TEST(trace.find("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[") ==
+               0);
+    SimTK_TEST(trace.find("{\"name\":\"computeForce\","
+                          "\"cat\":\"Thelen2003Muscle\",\"ph\":\"X\"") !=
+               std::string::npos);
+    SimTK_TEST(trace.find("\"args\":{\"path\":\"/forceset/TRIlong\"}}") !=
+               std::string::npos);
+
+    // Limit the number of trace events.
+    Profiler::reset();
+    Profiler::setMaxTraceEvents(0);
+    SimTK_TEST(Profiler::getMaxTraceEvents() == 0);
+    Profiler::setEnabled(true);
+    simulate(model, 0.01);
+    Profiler::setEnabled(false);
+    SimTK_TEST(!Profiler::getInstanceEntries().empty());
+    Profiler::printChromeTrace("testProfiler_trace.json");
+    SimTK_TEST(readFile("testProfiler_trace.json") ==
+               "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n]}\n");
+    Profiler::setMaxTraceEvents(1000000);
+    SimTK_TEST_MUST_THROW_EXC(
+            Profiler::setMaxTraceEvents(-1), OpenSim::Exception);
+    Profiler::reset();
+}
+
+void testThreads() {
+    // Each thread records its calls separately; the entries sum them.
+    Model model("arm26.osim");
+    Profiler::reset();
+    Profiler::setEnabled(true);
+    simulate(model, 0.01);
+    Profiler::setEnabled(false);
+    const long long numCalls = findEntry(Profiler::getTypeEntries(),
+            "Thelen2003Muscle", "computeForce")->numCalls;
+
+    Profiler::reset();
+    Profiler::setEnabled(true);
+    std::vector<std::thread> threads;
+    for (int ithread = 0; ithread < 2; ++ithread) {
+        threads.emplace_back([] {
+            Model threadModel("arm26.osim");
+            simulate(threadModel, 0.01);
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    Profiler::setEnabled(false);
+    SimTK_TEST(findEntry(Profiler::getTypeEntries(), "Thelen2003Muscle",
+                       "computeForce")->numCalls == 2 * numCalls);
+    Profiler::reset();
+}
+
+int main() {
+    SimTK_START_TEST("testProfiler");
+        SimTK_SUBTEST(testDisabled);
+        SimTK_SUBTEST(testEntries);
+        SimTK_SUBTEST(testExport);
+        SimTK_SUBTEST(testThreads);
+    SimTK_END_TEST();
+}
@@ -116,9 +116,61 @@ void testTableReporterLabels() {
     SimTK_TEST(headings[1] == "height");
 }
 
+void testChannelArray() {
+    Model model;
+    model.setName("world");
+
+    auto* ball = new OpenSim::Body("ball", 1., Vec3(0), Inertia(0));
+    model.addBody(ball);
+
+    auto* slider = new SliderJoint("slider", model.getGround(), Vec3(0),
+        Vec3(0,0,Pi/2.), *ball, Vec3(0), Vec3(0,0,Pi/2.));
+    model.addJoint(slider);
+
+    auto* reporter = new TableReporter();
+    reporter->addToReport(slider->getCoordinate().getOutput("value"));
+    reporter->addToReport(slider->getCoordinate().getOutput("speed"));
+    model.addComponent(reporter);
+
+    State& state = model.initSystem();
+    const Coordinate& coord = slider->getCoordinate();
+    coord.setValue(state, 0.3);
+    coord.setSpeedValue(state, -1.2);
+
+    ChannelArray<double> channels;
+    for (const auto& name : {"value", "speed", "acceleration"}) {
+        channels.append(dynamic_cast<const Output<double>::Channel&>(
+                coord.getOutput(name).getChannel(name)));
+    }
+    SimTK_TEST(channels.size() == 3);
+    SimTK_TEST(channels.getDependsOnStage() == Stage::Acceleration);
+
+    // The stage is checked once for all channels.
+    RowVector values;
+    model.realizeVelocity(state);
+    SimTK_TEST_MUST_THROW(channels.evaluate(state, values));
+
+    model.realizeAcceleration(state);
+    channels.evaluate(state, values);
+    SimTK_TEST(values.size() == 3);
+    SimTK_TEST_EQ(values[0], 0.3);
+    SimTK_TEST_EQ(values[1], -1.2);
+    SimTK_TEST_EQ(values[2], coord.getAccelerationValue(state));
+
+    // A copy of the model reports the outputs of its own components.
+    Model copy(model);
+    State& copyState = copy.initSystem();
+    copy.getCoordinateSet().get("slider_coord_0").setValue(copyState, 0.7);
+    copy.realizeReport(copyState);
+    const auto& table = copy.getComponent<TableReporter>("reporter").getTable();
+    SimTK_TEST(table.getNumRows() == 1);
+    SimTK_TEST_EQ(table.getRowAtIndex(0)[0], 0.7);
+}
+
 int main() {
     SimTK_START_TEST("testReporters");
         SimTK_SUBTEST(testConsoleReporterLabels);
         SimTK_SUBTEST(testTableReporterLabels);
+        SimTK_SUBTEST(testChannelArray);
     SimTK_END_TEST();
 };
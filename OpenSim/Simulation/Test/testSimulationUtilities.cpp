@@ -24,6 +24,8 @@
 #include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
 #include <OpenSim/Simulation/Model/Model.h>
 #include <OpenSim/Simulation/SimbodyEngine/FreeJoint.h>
+#include <OpenSim/Simulation/SimbodyEngine/PinJoint.h>
+#include <OpenSim/Actuators/CoordinateActuator.h>
 #include <OpenSim/Simulation/SimulationUtilities.h>
 #include <OpenSim/Common/LoadOpenSimLibrary.h>
 
@@ -31,12 +33,14 @@ using namespace OpenSim;
 using namespace std;
 
 void testUpdatePre40KinematicsFor40MotionType();
+void testAnalyze();
 
 int main() {
     LoadOpenSimLibrary("osimActuators");
 
     SimTK_START_TEST("testSimulationUtilities");
         SimTK_SUBTEST(testUpdatePre40KinematicsFor40MotionType);
+        SimTK_SUBTEST(testAnalyze);
     SimTK_END_TEST();
 }
 
@@ -174,22 +178,78 @@ void testUpdatePre40KinematicsFor40MotionType() {
     }
 }
 
+// analyze() must give the same report with any number of threads, and
+// analyzeToFile() must write that report.
+void testAnalyze() {
+    using SimTK::Vec3;
+    Model model;
+    auto* body = new Body("body", 1.0, Vec3(0, -1, 0), SimTK::Inertia(0.1));
+    model.addBody(body);
+    auto* pin = new PinJoint("pin", model.getGround(), *body);
+    pin->updCoordinate().setName("q");
+    model.addJoint(pin);
+    auto* actuator = new CoordinateActuator("q");
+    actuator->setName("actuator");
+    actuator->setOptimalForce(10.0);
+    model.addForce(actuator);
+    model.finalizeConnections();
+
+    // More rows than fit in one chunk.
+    const int numRows = 350;
+    TimeSeriesTable states;
+    states.setColumnLabels({"/jointset/pin/q/value", "/jointset/pin/q/speed"});
+    TimeSeriesTable controls;
+    controls.setColumnLabels({"/forceset/actuator"});
+    for (int i = 0; i < numRows; ++i) {
+        const double time = 0.01 * i;
+        SimTK::RowVector stateValues(2);
+        stateValues[0] = std::sin(time);
+        stateValues[1] = std::cos(time);
+        states.appendRow(time, stateValues);
+        controls.appendRow(time, SimTK::RowVector(1, 0.5 * time));
+    }
 
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
+    const std::vector<std::string> doubleOutputs{
+            ".*/q\\|value", "/forceset/actuator\\|actuation"};
+    const auto serial = analyze<double>(model, states, controls,
+            doubleOutputs);
+    SimTK_TEST(serial.getNumRows() == (size_t)numRows);
+    SimTK_TEST(serial.getColumnLabels() ==
+               std::vector<std::string>({"/jointset/pin/q|value",
+                       "/forceset/actuator|actuation"}));
+    for (int i = 0; i < numRows; ++i) {
+        const double time = 0.01 * i;
+        SimTK_TEST_EQ(serial.getIndependentColumn()[i], time);
+        SimTK_TEST_EQ(serial.getRowAtIndex(i)[0], std::sin(time));
+        SimTK_TEST_EQ(serial.getRowAtIndex(i)[1], 10.0 * 0.5 * time);
+    }
+    const auto parallel = analyze<double>(model, states, controls,
+            doubleOutputs, {}, 3);
+    SimTK_TEST(parallel.getColumnLabels() == serial.getColumnLabels());
+    SimTK_TEST(parallel.getIndependentColumn() ==
+               serial.getIndependentColumn());
+    SimTK_TEST_EQ(parallel.getMatrix(), serial.getMatrix());
+
+    // An empty trajectory gives an empty report with the column labels.
+    TimeSeriesTable emptyStates;
+    emptyStates.setColumnLabels(states.getColumnLabels());
+    TimeSeriesTable emptyControls;
+    emptyControls.setColumnLabels(controls.getColumnLabels());
+    const auto empty = analyze<double>(model, emptyStates, emptyControls,
+            doubleOutputs, {}, 2);
+    SimTK_TEST(empty.getNumRows() == 0);
+    SimTK_TEST(empty.getColumnLabels() == serial.getColumnLabels());
+
+    // Accelerations require realizing to Stage::Acceleration.
+    const std::vector<std::string> vec3Outputs{".*linear_acceleration"};
+    const auto accelerations = analyze<Vec3>(model, states, controls,
+            vec3Outputs, {}, 2);
+    SimTK_TEST(accelerations.getNumColumns() > 0);
+    SimTK_TEST(accelerations.getNumRows() == (size_t)numRows);
+    const std::string fileName = "testSimulationUtilities_analyze.sto";
+    analyzeToFile<Vec3>(model, states, controls, vec3Outputs, fileName, {}, 2);
+    const TimeSeriesTable_<Vec3> fromFile(fileName);
+    SimTK_TEST(fromFile.getColumnLabels() == accelerations.getColumnLabels());
+    SimTK_TEST(fromFile.getNumRows() == (size_t)numRows);
+    SimTK_TEST_EQ_TOL(fromFile.getMatrix(), accelerations.getMatrix(), 1e-12);
+}
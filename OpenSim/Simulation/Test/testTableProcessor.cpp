@@ -19,11 +19,16 @@
 #define CATCH_CONFIG_MAIN
 #include <OpenSim/Auxiliary/catch.hpp>
 #include <OpenSim/Common/CommonUtilities.h>
+#include <OpenSim/Common/IO.h>
 #include <OpenSim/Common/STOFileAdapter.h>
 #include <OpenSim/Simulation/TableProcessor.h>
 
 using namespace OpenSim;
 
+namespace {
+int numOperations = 0;
+}
+
 TEST_CASE("TableProcessor") {
     Object::registerType(TableProcessor());
 
@@ -32,6 +37,7 @@ TEST_CASE("TableProcessor") {
 
     public:
         void operate(TimeSeriesTable& table, const Model*) const override {
+            ++numOperations;
             table.appendRow(10.0, ~createVectorLinspace(
                                           (int)table.getNumColumns(), 0, 1));
         }
@@ -75,4 +81,79 @@ TEST_CASE("TableProcessor") {
             CHECK(out.getNumRows() == 4);
         }
     }
+
+    SECTION("Memoization") {
+        const std::string filepath = "testTableProcessor_memoization.sto";
+        STOFileAdapter::write(table, filepath);
+        TableProcessor::setMemoizationEnabled(true);
+        numOperations = 0;
+        TableProcessor proc = TableProcessor(filepath) | MyTableOperator();
+        const std::string hash = proc.computeHash({});
+        TimeSeriesTable first = proc.process();
+        TimeSeriesTable second =
+                (TableProcessor(filepath) | MyTableOperator()).process();
+        CHECK(numOperations == 1);
+        CHECK(second.getNumRows() == 4);
+        CHECK((second.getMatrix() - first.getMatrix()).normRMS() == 0);
+
+        // Changing the source file changes the hash.
+        table.appendRow(5.0, ~createVectorLinspace(2, 0, 1));
+        STOFileAdapter::write(table, filepath);
+        CHECK(proc.computeHash({}) != hash);
+        CHECK(proc.process().getNumRows() == 5);
+        CHECK(numOperations == 2);
+
+        // Processed tables are read from the cache directory.
+        TableProcessor::clearMemoizedTables();
+        TableProcessor::setCacheDirectory(".");
+        proc.process();
+        CHECK(numOperations == 3);
+        const std::string cachePath = "./" + proc.computeHash({}) + ".sto";
+        CHECK(IO::FileExists(cachePath));
+        TableProcessor::clearMemoizedTables();
+        CHECK(proc.process().getNumRows() == 5);
+        CHECK(numOperations == 3);
+
+        // Cached tables keep every digit of the processed table.
+        TableProcessor inMemory = TableProcessor(table) | MyTableOperator();
+        const TimeSeriesTable processed = inMemory.process();
+        TableProcessor::clearMemoizedTables();
+        const TimeSeriesTable fromCache = inMemory.process();
+        CHECK(numOperations == 4);
+        CHECK(fromCache.getIndependentColumn() ==
+                processed.getIndependentColumn());
+        CHECK((fromCache.getMatrix() - processed.getMatrix()).normRMS() == 0);
+        const std::string inMemoryCachePath =
+                "./" + inMemory.computeHash({}) + ".sto";
+
+        TableProcessor::setCacheDirectory("");
+        TableProcessor::setMemoizationEnabled(false);
+        TableProcessor::clearMemoizedTables();
+        std::remove(cachePath.c_str());
+        std::remove(inMemoryCachePath.c_str());
+    }
+
+    SECTION("Cache files are written atomically") {
+        const std::string path = "testTableProcessor_atomic.sto";
+        std::remove(path.c_str());
+        std::string temporaryPath;
+        auto write = [&](const std::string& p) {
+            temporaryPath = p;
+            STOFileAdapter::write(table, p);
+        };
+        // A failed write leaves no file behind.
+        CHECK_THROWS(writeFileAtomically(path, [&](const std::string& p) {
+            write(p);
+            OPENSIM_THROW(Exception, "Write failed.");
+        }));
+        CHECK(temporaryPath != path);
+        CHECK(IO::EndsWith(temporaryPath, ".sto"));
+        CHECK(!IO::FileExists(temporaryPath));
+        CHECK(!IO::FileExists(path));
+
+        writeFileAtomically(path, write);
+        CHECK(!IO::FileExists(temporaryPath));
+        CHECK(TimeSeriesTable(path).getNumRows() == table.getNumRows());
+        std::remove(path.c_str());
+    }
 }
@@ -42,6 +42,7 @@
 #include "Model/ElasticFoundationForce.h"
 #include "Model/HuntCrossleyForce.h"
 #include "Model/SmoothSphereHalfSpaceForce.h"
+#include "Model/MeshContactForce.h"
 #include "Model/Ligament.h"
 #include "Model/Blankevoort1991Ligament.h"
 #include "Model/JointSet.h"
@@ -74,6 +75,7 @@
 #include "Model/Ground.h"
 
 #include "Manager/Manager.h"
+#include "Manager/EnsembleSimulation.h"
 
 #include "Control/ControlSet.h"
 #include "Control/ControlSetController.h"
@@ -130,6 +132,7 @@
 #include "OpenSense/OpenSenseUtilities.h"
 #include "OpenSense/IMU.h"
 #include "SimulationUtilities.h"
+#include "RealizationTimer.h"
 
 #include "RegisterTypes_osimSimulation.h"   // to expose RegisterTypes_osimSimulation
 
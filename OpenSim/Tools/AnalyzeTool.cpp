@@ -23,6 +23,7 @@
 #include "AnalyzeTool.h"
 #include <OpenSim/Common/IO.h>
 #include <OpenSim/Common/GCVSplineSet.h>
+#include <OpenSim/Common/Stopwatch.h>
 
 #include <OpenSim/Simulation/Control/ControlLinear.h>
 #include <OpenSim/Simulation/Control/ControlSet.h>
@@ -33,6 +34,7 @@
 #include <OpenSim/Analyses/MuscleAnalysis.h>
 #include <OpenSim/Analyses/ProbeReporter.h>
 #include <OpenSim/Simulation/Model/PrescribedForce.h>
+#include <OpenSim/Simulation/RealizationTimer.h>
 #include <OpenSim/Actuators/Thelen2003Muscle.h>
 
 using namespace OpenSim;
@@ -663,7 +665,14 @@ void AnalyzeTool::run(SimTK::State& s, Model &aModel, int iInitial, int iFinal,
     // model defaults.
     SimTK::Vector stateValues = aModel.getStateVariableValues(s);
 
+    // Realize each state once, only as far as the analyses that are on
+    // require, and keep track of the time spent realizing each stage.
+    const SimTK::Stage requiredStage = analysisSet.getRequiredStage();
+    RealizationTimer realizationTimer;
+    const bool telemetry = Logger::isTelemetryEnabled();
+
     for(int i=iInitial;i<=iFinal;i++) {
+        Stopwatch frameWatch;
         // tPrev = t;
         aStatesStore.getTime(i,s.updTime()); // time
         t = s.getTime();
@@ -694,16 +703,25 @@ void AnalyzeTool::run(SimTK::State& s, Model &aModel, int iInitial, int iFinal,
                     "time = {}. Reason: {}.", t, e.what());
             }
         }
-        // Make sure model is at least ready to provide kinematics
-        aModel.getMultibodySystem().realize(s, SimTK::Stage::Velocity);
+        realizationTimer.realize(aModel.getMultibodySystem(), s,
+                requiredStage);
 
         if(i==iInitial) {
             analysisSet.begin(s);
+            // Each analysis records at most one row per frame.
+            analysisSet.ensureStorageCapacity(iFinal - iInitial + 1);
         } else if(i==iFinal) {
             analysisSet.end(s);
         // Step
         } else {
             analysisSet.step(s,i);
         }
+        if (telemetry) {
+            Logger::telemetry("AnalyzeTool.frame", {{"frame", i}, {"time", t},
+                    {"duration", frameWatch.getElapsedTime()}});
+        }
     }
+
+    log_debug("Time spent realizing states to {} for the analyses:\n{}",
+            requiredStage.getName(), realizationTimer.getSummary());
 }
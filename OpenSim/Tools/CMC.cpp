@@ -940,12 +940,22 @@ computeControls(SimTK::State& s, ControlSet &controlSet)
 
 
     // ROOT SOLVE FOR EXCITATIONS
+    // The predictor was already integrated at xmin and xmax (with zero
+    // target forces) to bound the optimization, so the function values at
+    // the bracket end points are simply those forces less the desired
+    // forces. Handing them to the root solver saves two integrations of the
+    // actuator system per control step.
+    Array<double> fa(0.0,N),fb(0.0,N);
+    for(i=0;i<N;i++) {
+        fa[i] = fmin[i] - _f[i];
+        fb[i] = (xmax[i]==xmin[i] ? fmin[i] : fmax[i]) - _f[i];
+    }
     _predictor->setTargetForces(&_f[0]);
     RootSolver rootSolver(_predictor);
     Array<double> tol(4.0e-3,N);
     Array<double> fErrors(0.0,N);
     Array<double> controls(0.0,N);
-    controls = rootSolver.solve(s, xmin,xmax,tol);
+    controls = rootSolver.solve(s, xmin,xmax,fa,fb,tol);
     if(_verbose) {
         log_info("CMC::computeControls, root solve (tFinal = {}):", _tf);
         log_info(" -- controls = {}", _tf, controls);
@@ -12,6 +12,15 @@
 #include <OpenSim/Simulation/InverseKinematicsSolver.h>
 #include <OpenSim/Simulation/OrientationsReference.h>
 
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <thread>
 
 using namespace OpenSim;
 using namespace SimTK;
@@ -40,6 +49,59 @@ void IMUInverseKinematicsTool::constructProperties()
     constructProperty_orientations_file("");
     OrientationWeightSet orientationWeights;
     constructProperty_orientation_weights(orientationWeights);
+    constructProperty_num_threads(1);
+    constructProperty_chunk_size(500);
+}
+
+namespace {
+// Append the rows of the table to a file whose header was written by
+// STOFileAdapter, in the same format.
+void appendRows(std::ofstream& stream, const TimeSeriesTable& table) {
+    constexpr auto prec = std::numeric_limits<double>::digits10 + 1;
+    stream << std::setprecision(prec);
+    const auto& times = table.getIndependentColumn();
+    for (size_t irow = 0; irow < table.getNumRows(); ++irow) {
+        stream << times[irow];
+        const auto row = table.getRowAtIndex(irow);
+        for (int icol = 0; icol < row.size(); ++icol) {
+            stream << "\t" << row[icol];
+        }
+        stream << "\n";
+    }
+}
+// A table with the column labels and metadata of the given table, but no rows.
+TimeSeriesTable createEmptyCopy(const TimeSeriesTable& table) {
+    TimeSeriesTable copy;
+    copy.setColumnLabels(table.getColumnLabels());
+    copy.updTableMetaData() = table.getTableMetaData();
+    return copy;
+}
+// Write the header of the table with STOFileAdapter, and open the file to
+// append rows.
+void startStreamingTable(const TimeSeriesTable& header,
+        const std::string& fileName, std::ofstream& stream) {
+    STOFileAdapter_<double>::write(header, fileName);
+    stream.open(fileName, std::ios::app);
+    OPENSIM_THROW_IF(!stream, Exception,
+            "Could not open file '{}' to append results.", fileName);
+}
+}
+
+void IMUInverseKinematicsTool::resolveOutputPaths(
+        const std::string& orientationsFileName, std::string& resultsDir,
+        std::string& outName) const {
+    // form resultsDir either from results_directory or output_motion_file
+    resultsDir = get_results_directory();
+    if (resultsDir.empty() && !get_output_motion_file().empty())
+        resultsDir = IO::getParentDirectory(get_output_motion_file());
+    outName = IO::GetFileNameFromURI(get_output_motion_file());
+    if (outName.empty()) {
+        bool isAbsolutePath;
+        string directory, fileName, extension;
+        SimTK::Pathname::deconstructPathname(orientationsFileName,
+                isAbsolutePath, directory, fileName, extension);
+        outName = "ik_" + fileName;
+    }
 }
 /**
 void IMUInverseKinematicsTool::
@@ -139,12 +201,24 @@ void IMUInverseKinematicsTool::runInverseKinematicsWithOrientationsFromFile(
 
     // Rotate data so Y-Axis is up
     OpenSenseUtilities::rotateOrientationTable(quatTable, sensorToOpenSim);
-    //Trim to time window required by Tool
-    quatTable.trim(getStartTime(), getEndTime());
 
     TimeSeriesTable_<SimTK::Rotation> orientationsData =
         OpenSenseUtilities::convertQuaternionsToRotations(quatTable);
 
+    if (get_num_threads() != 1) {
+        if (visualizeResults || model.getAnalysisSet().getSize()) {
+            log_warn("IMUInverseKinematicsTool: Visualization and analyses "
+                     "require num_threads = 1; tracking all frames in "
+                     "sequence.");
+        } else {
+            std::string resultsDir, outName;
+            resolveOutputPaths(orientationsFileName, resultsDir, outName);
+            trackOrientationsInChunks(
+                    model, orientationsData, resultsDir, outName);
+            return;
+        }
+    }
+
     OrientationsReference oRefs(orientationsData, &get_orientation_weights());
 
     SimTK::Array_<CoordinateReference> coordinateReferences;
@@ -211,24 +285,13 @@ void IMUInverseKinematicsTool::runInverseKinematicsWithOrientationsFromFile(
     }
 
     auto report = ikReporter->getTable();
-    // form resultsDir either from results_directory or output_motion_file
-    auto resultsDir = get_results_directory();
-    if (resultsDir.empty() && !get_output_motion_file().empty())
-        resultsDir = IO::getParentDirectory(get_output_motion_file());
+    std::string resultsDir, outName;
+    resolveOutputPaths(orientationsFileName, resultsDir, outName);
     if (!resultsDir.empty()) {
         IO::makeDir(resultsDir);
         // directory will be restored on block exit
         // by changing dir all other files are created in resultsDir
         auto cwd = IO::CwdChanger::changeTo(resultsDir);
-        std::string outName = get_output_motion_file();
-        outName = IO::GetFileNameFromURI(outName);
-        if (outName.empty()) {
-            bool isAbsolutePath;
-            string directory, fileName, extension;
-            SimTK::Pathname::deconstructPathname(orientationsFileName,
-                    isAbsolutePath, directory, fileName, extension);
-            outName = "ik_" + fileName;
-        }
         std::string outputFile = outName;
 
         // Convert to degrees to compare with marker-based IK
@@ -255,6 +318,200 @@ void IMUInverseKinematicsTool::runInverseKinematicsWithOrientationsFromFile(
     ikReporter->clearTable();
 }
 
+void IMUInverseKinematicsTool::trackOrientationsInChunks(Model& model,
+        const TimeSeriesTable_<SimTK::Rotation>& orientationsData,
+        const std::string& resultsDir, const std::string& outName) {
+    OPENSIM_THROW_IF_FRMOBJ(get_num_threads() < 0, Exception,
+            "Expected num_threads to be non-negative, but got {}.",
+            get_num_threads());
+    OPENSIM_THROW_IF_FRMOBJ(get_chunk_size() < 1, Exception,
+            "Expected chunk_size to be positive, but got {}.",
+            get_chunk_size());
+    const int chunkSize = get_chunk_size();
+    const auto& times = orientationsData.getIndependentColumn();
+    const int numFrames = (int)times.size();
+    OPENSIM_THROW_IF_FRMOBJ(numFrames == 0, Exception,
+            "No orientations to track in the time range [{}, {}].",
+            getStartTime(), getEndTime());
+    const int numChunks = (numFrames + chunkSize - 1) / chunkSize;
+    int numThreads = get_num_threads();
+    if (numThreads == 0) {
+        numThreads = std::max(1, (int)std::thread::hardware_concurrency());
+    }
+    numThreads = std::min(numThreads, numChunks);
+    log_info("Tracking {} frames in {} chunks of up to {} frames on {} "
+             "threads.", numFrames, numChunks, chunkSize, numThreads);
+
+    // The files are opened by full path rather than with IO::CwdChanger,
+    // since the working directory is shared by all threads.
+    std::string motionFile;
+    std::string errorsFile;
+    if (!resultsDir.empty()) {
+        IO::makeDir(resultsDir);
+        motionFile = resultsDir + "/" + outName;
+        if (outName.rfind(".") == std::string::npos) motionFile += ".mot";
+        errorsFile = resultsDir + "/" + outName + "_orientationErrors.sto";
+    } else {
+        log_info("IMUInverseKinematicsTool: No output files were generated, "
+            "set output_motion_file to generate output files.");
+    }
+
+    // The results of a chunk, in the same form as the results of tracking
+    // all frames in sequence.
+    struct ChunkResults {
+        TimeSeriesTable coordinates;
+        TimeSeriesTable orientationErrors;
+    };
+    std::mutex mutex;
+    std::condition_variable chunkWritten;
+    int nextChunk = 0;
+    int nextChunkToWrite = 0;
+    // Finished chunks that wait for their preceding chunks to be written.
+    std::map<int, ChunkResults> finishedChunks;
+    const int maxChunksInMemory = 2 * numThreads;
+    std::ofstream motionStream;
+    std::ofstream errorsStream;
+    std::exception_ptr error;
+
+    // Called with the mutex locked.
+    auto writeChunk = [&](ChunkResults& results) {
+        if (motionFile.empty()) return;
+        if (!motionStream.is_open()) {
+            TimeSeriesTable header = createEmptyCopy(results.coordinates);
+            header.updTableMetaData().setValueForKey<string>("name", outName);
+            startStreamingTable(header, motionFile, motionStream);
+            if (get_report_errors()) {
+                startStreamingTable(
+                        createEmptyCopy(results.orientationErrors),
+                        errorsFile, errorsStream);
+            }
+        }
+        appendRows(motionStream, results.coordinates);
+        if (get_report_errors()) {
+            appendRows(errorsStream, results.orientationErrors);
+        }
+    };
+
+    // Each thread tracks with its own copy of the model.
+    std::vector<std::unique_ptr<Model>> models;
+    for (int ithread = 0; ithread < numThreads; ++ithread) {
+        models.emplace_back(model.clone());
+    }
+
+    auto trackChunks = [&](Model& localModel) {
+        try {
+            SimTK::State& s = localModel.initSystem();
+            const SimTK::State defaultState = s;
+            const auto coordinates = localModel.getComponentList<Coordinate>();
+            SimTK::Array_<string> coordinateNames;
+            for (const auto& coord : coordinates) {
+                coordinateNames.push_back(coord.getName());
+            }
+            SimTK::RowVector coordinateValues((int)coordinateNames.size());
+            SimTK::Array_<CoordinateReference> coordinateReferences;
+
+            while (true) {
+                int ichunk;
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    chunkWritten.wait(lock, [&]() {
+                        return error || nextChunk == numChunks ||
+                               nextChunk - nextChunkToWrite <
+                                       maxChunksInMemory;
+                    });
+                    if (error || nextChunk == numChunks) return;
+                    ichunk = nextChunk++;
+                }
+                const int begin = ichunk * chunkSize;
+                const int end = std::min(begin + chunkSize, numFrames);
+
+                TimeSeriesTable_<SimTK::Rotation> chunkData;
+                chunkData.setColumnLabels(orientationsData.getColumnLabels());
+                for (int iframe = begin; iframe < end; ++iframe) {
+                    chunkData.appendRow(times[iframe],
+                            orientationsData.getRowAtIndex(iframe));
+                }
+                InverseKinematicsSolver ikSolver(localModel, nullptr,
+                        std::make_shared<OrientationsReference>(
+                                chunkData, &get_orientation_weights()),
+                        coordinateReferences);
+                ikSolver.setAccuracy(1e-4);
+
+                ChunkResults results;
+                results.coordinates.setColumnLabels(coordinateNames);
+                const int nos = ikSolver.getNumOrientationSensorsInUse();
+                SimTK::Array_<double> orientationErrors(nos, 0.0);
+                if (get_report_errors()) {
+                    SimTK::Array_<string> labels;
+                    for (int i = 0; i < nos; ++i) {
+                        labels.push_back(
+                                ikSolver.getOrientationSensorNameForIndex(i));
+                    }
+                    results.orientationErrors.setColumnLabels(labels);
+                    results.orientationErrors.updTableMetaData()
+                            .setValueForKey<string>(
+                                    "name", "OrientationErrors");
+                }
+
+                // Seed the chunk by assembling from the default pose.
+                s = defaultState;
+                s.updTime() = times[begin];
+                ikSolver.assemble(s);
+                for (int iframe = begin; iframe < end; ++iframe) {
+                    s.updTime() = times[iframe];
+                    ikSolver.track(s);
+                    int icoord = 0;
+                    for (const auto& coord : coordinates) {
+                        coordinateValues[icoord++] = coord.getValue(s);
+                    }
+                    results.coordinates.appendRow(
+                            times[iframe], coordinateValues);
+                    if (get_report_errors()) {
+                        ikSolver.computeCurrentOrientationErrors(
+                                orientationErrors);
+                        results.orientationErrors.appendRow(
+                                times[iframe], orientationErrors);
+                    }
+                }
+                // Convert to degrees to compare with marker-based IK
+                // but only for rotational coordinates
+                localModel.getSimbodyEngine().convertRadiansToDegrees(
+                        results.coordinates);
+                log_info("Solved chunk {} of {} (time {} s to {} s).",
+                        ichunk + 1, numChunks, times[begin], times[end - 1]);
+
+                std::lock_guard<std::mutex> lock(mutex);
+                if (error) return;
+                finishedChunks[ichunk] = std::move(results);
+                auto it = finishedChunks.begin();
+                while (it != finishedChunks.end() &&
+                        it->first == nextChunkToWrite) {
+                    writeChunk(it->second);
+                    it = finishedChunks.erase(it);
+                    ++nextChunkToWrite;
+                }
+                chunkWritten.notify_all();
+            }
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!error) error = std::current_exception();
+            chunkWritten.notify_all();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int ithread = 1; ithread < numThreads; ++ithread) {
+        threads.emplace_back(trackChunks, std::ref(*models[ithread]));
+    }
+    trackChunks(*models[0]);
+    for (auto& thread : threads) thread.join();
+
+    if (error) std::rethrow_exception(error);
+    if (!motionFile.empty()) {
+        log_info("Wrote IK with IMU tracking results to: '{}'.", motionFile);
+    }
+}
+
 
 // main driver
 bool IMUInverseKinematicsTool::run(bool visualizeResults)
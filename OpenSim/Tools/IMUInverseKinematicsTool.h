@@ -69,6 +69,14 @@ public:
  * model minimize the weighted least-squares error with observations of IMU 
  * orientations in their spatial coordinates. 
  *
+ * Long recordings can be processed in parallel by setting num_threads. The
+ * frames are then split into chunks, and the first frame of each chunk is
+ * solved by assembling the model from its default pose rather than by
+ * tracking from the previous frame. If the default pose is far from the
+ * recorded motion, assembly may converge to a different solution than
+ * tracking would; in that case, use num_threads = 1. Visualization and the
+ * model's analyses require num_threads = 1.
+ *
  * @author Ajay Seth
  */
 class OSIMTOOLS_API IMUInverseKinematicsTool
@@ -87,6 +95,14 @@ public:
             "Set of orientation weights identified by orientation name with "
             "weight being a positive scalar. If not provided, all IMU "
             "orientations are tracked with weight 1.0.");
+    OpenSim_DECLARE_PROPERTY(num_threads, int,
+            "Number of threads used to track the orientations. The default, "
+            "1, tracks all frames in sequence. 0 uses all processor cores. "
+            "With more than one thread, the frames are tracked in chunks of "
+            "chunk_size frames (see below).");
+    OpenSim_DECLARE_PROPERTY(chunk_size, int,
+            "Number of frames in each chunk when num_threads is not 1. "
+            "Default 500.");
 
     //=============================================================================
 // METHODS
@@ -115,6 +131,24 @@ public:
 private:
     void constructProperties();
 
+    /** The directory and file name (without the directory) of the output
+    motion file. The directory is empty if no output files are requested. */
+    void resolveOutputPaths(const std::string& orientationsFileName,
+            std::string& resultsDir, std::string& outName) const;
+
+    /** Track the orientations with num_threads threads. The frames are split
+    into chunks of chunk_size frames. Each thread tracks one chunk at a time
+    with its own copy of the model and its own InverseKinematicsSolver; the
+    pose at the first frame of a chunk is found by assembling the model from
+    its default pose, and the following frames are tracked from the previous
+    frame. Chunks are appended to the output files in order as they complete,
+    and at most two chunks per thread are held in memory, so that the memory
+    used does not grow with the length of the recording. The model's analyses
+    are not run. */
+    void trackOrientationsInChunks(Model& model,
+            const TimeSeriesTable_<SimTK::Rotation>& orientationsData,
+            const std::string& resultsDir, const std::string& outName);
+
 //=============================================================================
 };  // END of class IMUInverseKinematicsTool
 //=============================================================================
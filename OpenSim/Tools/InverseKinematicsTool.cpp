@@ -188,10 +188,17 @@ bool InverseKinematicsTool::run()
             new Storage(Nframes, "ModelMarkerErrors") : nullptr;
 
         Stopwatch watch;
+        const bool telemetry = Logger::isTelemetryEnabled();
 
         for (int i = start_ix; i <= final_ix; ++i) {
+            Stopwatch frameWatch;
             s.updTime() = times[i];
             ikSolver.track(s);
+            if (telemetry) {
+                Logger::telemetry("InverseKinematicsTool.frame",
+                        {{"frame", i}, {"time", s.getTime()},
+                                {"duration", frameWatch.getElapsedTime()}});
+            }
             // show progress line every 1000 frames so users see progress
             if (std::remainder(i - start_ix, 1000) == 0 && i != start_ix)
                 log_info("Solved {} frame(s)...", i - start_ix);
@@ -390,8 +390,9 @@ bool MarkerPlacer::processModel(Model* aModel,
     _outputStorage->getStateVector(0)->setTime(s.getTime());
 
     if(_printResultFiles) {
-        auto cwd = IO::CwdChanger::changeTo(aPathToSubject);
-
+        // The file names already include aPathToSubject, so the working
+        // directory is left unchanged (it is shared by the threads of
+        // ScaleTool::runSubjects()).
         if (_outputModelFileNameProp.isValidFileName()) {
             aModel->print(aPathToSubject + _outputModelFileName);
             log_info("Wrote model file '{}' from model {}.",
@@ -314,16 +314,23 @@ bool ModelScaler::processModel(Model* aModel, const string& aPathToSubject,
         aModel->scale(s, theScaleSet, _preserveMassDist, aSubjectMass);
 
         if(_printResultFiles) {
-            auto cwd = IO::CwdChanger::changeTo(aPathToSubject);
-
+            // The files are written by full path rather than with
+            // IO::CwdChanger so that several subjects can be scaled
+            // concurrently (see ScaleTool::runSubjects()).
             if (_outputModelFileNameProp.isValidFileName()) {
-                if (aModel->print(_outputModelFileName))
+                const std::string modelPath = SimTK::Pathname::
+                    getAbsolutePathnameUsingSpecifiedWorkingDirectory(
+                        aPathToSubject, _outputModelFileName);
+                if (aModel->print(modelPath))
                     log_info("Wrote model file '{}' from model.",
                         _outputModelFileName, aModel->getName());
             }
 
             if (_outputScaleFileNameProp.isValidFileName()) {
-                if (theScaleSet.print(_outputScaleFileName))
+                const std::string scalePath = SimTK::Pathname::
+                    getAbsolutePathnameUsingSpecifiedWorkingDirectory(
+                        aPathToSubject, _outputScaleFileName);
+                if (theScaleSet.print(scalePath))
                     log_info("Wrote scale file '{}' for model {}.",
                         _outputScaleFileName, aModel->getName());
             }
@@ -29,6 +29,12 @@
 #include <OpenSim/Simulation/Model/Model.h>
 #include "GenericModelMaker.h"
 
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <thread>
+
 //=============================================================================
 // STATICS
 //=============================================================================
@@ -260,10 +266,14 @@ bool ScaleTool::run() const {
         throw Exception(msg, __FILE__, __LINE__);
     }
 
+    return processModel(*model);
+}
+
+bool ScaleTool::processModel(Model& model) const {
     if (!isDefaultModelScaler() && getModelScaler().getApply())
     {
         const ModelScaler& scaler = getModelScaler();
-        if(!scaler.processModel(model.get(), getPathToSubject(), getSubjectMass())) {
+        if(!scaler.processModel(&model, getPathToSubject(), getSubjectMass())) {
             return false;
         }
     }
@@ -276,7 +286,7 @@ bool ScaleTool::run() const {
     if (!isDefaultMarkerPlacer())
     {
         const MarkerPlacer& placer = getMarkerPlacer();
-        if(!placer.processModel(model.get(), getPathToSubject())) {
+        if(!placer.processModel(&model, getPathToSubject())) {
             return false;
         }
     }
@@ -287,3 +297,90 @@ bool ScaleTool::run() const {
     }
     return true;
 }
+
+bool ScaleTool::runSubjects(const std::vector<std::string>& setupFileNames,
+        int numThreads) {
+    OPENSIM_THROW_IF(numThreads < 0, Exception,
+            "Expected numThreads to be non-negative, but got {}.", numThreads);
+    const int numSubjects = (int)setupFileNames.size();
+    if (numSubjects == 0) return true;
+    if (numThreads == 0) {
+        numThreads = std::max(1, (int)std::thread::hardware_concurrency());
+    }
+    numThreads = std::min(numThreads, numSubjects);
+
+    // Read the setup files and load each distinct generic model once. The
+    // paths to the subjects are made absolute so that no file name depends
+    // on the working directory.
+    std::vector<std::unique_ptr<ScaleTool>> tools;
+    std::vector<const Model*> genericModels;
+    std::map<std::string, std::unique_ptr<Model>> modelsByFile;
+    for (const auto& setupFileName : setupFileNames) {
+        tools.emplace_back(new ScaleTool(setupFileName));
+        ScaleTool& tool = *tools.back();
+        tool.setPathToSubject(SimTK::Pathname::getAbsoluteDirectoryPathname(
+                tool.getPathToSubject()));
+        const GenericModelMaker& maker = tool.getGenericModelMaker();
+        const std::string key =
+                SimTK::Pathname::
+                        getAbsolutePathnameUsingSpecifiedWorkingDirectory(
+                                tool.getPathToSubject(),
+                                maker.getModelFileName()) +
+                "\n" +
+                SimTK::Pathname::
+                        getAbsolutePathnameUsingSpecifiedWorkingDirectory(
+                                tool.getPathToSubject(),
+                                maker.getMarkerSetFileName());
+        auto it = modelsByFile.find(key);
+        if (it == modelsByFile.end()) {
+            it = modelsByFile.emplace(key,
+                    std::unique_ptr<Model>(tool.createModel())).first;
+        }
+        genericModels.push_back(it->second.get());
+    }
+    log_info("Scaling {} subjects with {} generic models on {} threads.",
+            numSubjects, modelsByFile.size(), numThreads);
+
+    std::vector<char> succeeded(numSubjects, false);
+    std::atomic<int> nextSubject(0);
+    std::mutex cloneMutex;
+    auto scaleSubjects = [&]() {
+        int isubject;
+        while ((isubject = nextSubject++) < numSubjects) {
+            const ScaleTool& tool = *tools[isubject];
+            try {
+                OPENSIM_THROW_IF(genericModels[isubject] == nullptr,
+                        Exception, "ScaleTool: No model specified.");
+                std::unique_ptr<Model> model;
+                {
+                    // The generic model is shared by the threads.
+                    std::lock_guard<std::mutex> lock(cloneMutex);
+                    model.reset(genericModels[isubject]->clone());
+                }
+                model->setName(tool.getName());
+                succeeded[isubject] = tool.processModel(*model);
+            } catch (const std::exception& e) {
+                log_error("Subject {} ('{}'): {}", tool.getName(),
+                        setupFileNames[isubject], e.what());
+            }
+            log_info("Finished subject {} ({} of {}).", tool.getName(),
+                    isubject + 1, numSubjects);
+        }
+    };
+    std::vector<std::thread> threads;
+    for (int ithread = 1; ithread < numThreads; ++ithread) {
+        threads.emplace_back(scaleSubjects);
+    }
+    scaleSubjects();
+    for (auto& thread : threads) thread.join();
+
+    bool allSucceeded = true;
+    for (int isubject = 0; isubject < numSubjects; ++isubject) {
+        if (!succeeded[isubject]) {
+            log_error("Scaling failed for subject {} ('{}').",
+                    tools[isubject]->getName(), setupFileNames[isubject]);
+            allSucceeded = false;
+        }
+    }
+    return allSucceeded;
+}
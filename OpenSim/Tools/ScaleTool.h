@@ -115,6 +115,18 @@ public:
      * @returns whether or not the scale procedure was successful. */
     bool run() const;
 
+    /** Scale several subjects, each described by a setup file as read by
+     * ScaleTool(const std::string&). Up to numThreads subjects are
+     * processed at the same time (0 uses all processor cores), each with its
+     * own copy of its generic model. Subjects whose setup files name the same
+     * generic model and marker set file share one parsed generic model,
+     * which is loaded only once. Each subject's result files are written as
+     * soon as that subject is done.
+     * @returns whether every subject was scaled successfully; the subjects
+     * that failed are logged. */
+    static bool runSubjects(const std::vector<std::string>& setupFileNames,
+            int numThreads = 1);
+
     bool isDefaultGenericModelMaker() const
     { return _genericModelMakerProp.getValueIsDefault(); }
     bool isDefaultModelScaler() const
@@ -157,6 +169,9 @@ protected:
 private:
     void setNull();
     void setupProperties();
+    /** Run the ModelScaler and the MarkerPlacer on a model created by
+     * createModel(). */
+    bool processModel(Model& model) const;
 //=============================================================================
 };  // END of class ScaleTool
 //=============================================================================
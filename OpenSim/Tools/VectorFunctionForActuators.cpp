@@ -57,12 +57,18 @@ VectorFunctionForActuators(SimTK::System *aActuatorSystem, Model* model, CMCActu
     _model = model;
     _CMCActuatorSubsystem = actSubsystem;
     _CMCActuatorSystem = aActuatorSystem;
-    _integrator = new SimTK::RungeKuttaMersonIntegrator(*aActuatorSystem);
+    _integrator.reset(
+            new SimTK::RungeKuttaMersonIntegrator(*aActuatorSystem));
     _integrator->setAccuracy( 5.0e-6 );
     _integrator->setMaximumStepSize(1.0e-3);
 
     // Don't project constraints while inside the controller
     _integrator->setProjectInterpolatedStates( false );
+
+    // The time stepper (and thus the integrator's internal workspace) is
+    // allocated once here and only re-initialized in evaluate().
+    _timeStepper.reset(
+            new SimTK::TimeStepper(*aActuatorSystem, *_integrator));
     _f.setSize(getNX());
 }
 //_____________________________________________________________________________
@@ -98,7 +104,9 @@ setNull()
     _CMCActuatorSystem    = NULL;
     _CMCActuatorSubsystem = NULL;
     _model             = NULL;
-    _integrator        = NULL;
+    _controller        = NULL;
+    _timeStepper.reset();
+    _integrator.reset();
 }
 
 //_____________________________________________________________________________
@@ -252,19 +260,22 @@ evaluate(const SimTK::State& s, const double *aX, double *rF)
     int i;
     int N = getNX();
 
-    CMC& controller=  dynamic_cast<CMC&>(_model->updControllerSet().get("CMC" ));
+    if(_controller == NULL) {
+        _controller = &dynamic_cast<CMC&>(
+                _model->updControllerSet().get("CMC"));
+    }
+    CMC& controller = *_controller;
     controller.updControlSet().setControlValues(_tf, aX);
 
-    // create a Manager that will integrate just the actuator subsystem and use only the 
-    // CMC controller
+    // Integrate just the actuator subsystem using only the CMC controller.
+    // The integrator and time stepper are reused from previous calls.
     SimTK::State& actSysState = _CMCActuatorSystem->updDefaultState();
     getCMCActSubsys()->updZ(actSysState) = _model->getMultibodySystem()
                                             .getDefaultSubsystem().getZ(s);
     actSysState.setTime(_ti);
 
-    SimTK::TimeStepper ts(*_CMCActuatorSystem, *_integrator);
-    ts.initialize(actSysState);
-    ts.stepTo(_tf);
+    _timeStepper->initialize(actSysState);
+    _timeStepper->stepTo(_tf);
 
     const Set<const Actuator>& forceSet = controller.getActuatorSet();
     // Vector function values
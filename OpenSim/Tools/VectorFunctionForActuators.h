@@ -29,16 +29,19 @@
 
 #include <OpenSim/Common/Array.h>
 #include <OpenSim/Common/VectorFunctionUncoupledNxN.h>
+#include <memory>
 
 namespace SimTK {
 class Integrator;
 class System;
+class TimeStepper;
 }
 
 //=============================================================================
 //=============================================================================
 namespace OpenSim { 
 
+class CMC;
 class CMCActuatorSubsystem;
 class Model;
 
@@ -76,9 +79,16 @@ protected:
     /** Actuator SubSystem  */
     CMCActuatorSubsystem* _CMCActuatorSubsystem;
     /** Integrator. */
-    SimTK::Integrator* _integrator;
+    std::unique_ptr<SimTK::Integrator> _integrator;
+    /** Time stepper driving the integrator. It is created once and
+    re-initialized on each evaluation so that the integrator workspace is
+    reused across calls. */
+    std::unique_ptr<SimTK::TimeStepper> _timeStepper;
     /** Model */
     Model* _model;
+    /** The CMC controller whose controls are being evaluated (found lazily
+    in the model's controller set). */
+    CMC* _controller;
 
 
 //=============================================================================